@@ -18,6 +18,7 @@
 #include <utime.h>
 #include <inttypes.h>
 #include <regex>
+#include <thread>
 
 #include "crypto.hpp"
 #include "duckdb.hpp"
@@ -86,13 +87,14 @@ CachingFileSystem::OpenFile(const string &fullUrl,
 	unique_ptr<FileHandle> cacheOnWriteHandle;
 	string cacheOnWritePath;
 	unique_lock<mutex> cacheOnWriteFileLock;
+	shared_ptr<CachedFileBlocks> cachedBlocks;
 
 	/* the file is already in cache, read from the cache */
 	if (requestCache && openFlags.OpenForReading() != 0 &&
 		localfs.FileExists(cacheFilePath))
 	{
-		/* we track access times in the file system */
-		FileCacheManager::UpdateAccessTime(cacheFilePath);
+		/* we track access times in the cache index */
+		cacheManager->RecordCacheAccess(cacheFilePath);
 
 		/*
 		 * S3 files may be opened with FILE_FLAGS_DIRECT_IO to skip internal
@@ -126,16 +128,33 @@ CachingFileSystem::OpenFile(const string &fullUrl,
 		{
 			if (openFlags.OpenForReading())
 			{
-				/*
-				* File is eligible for caching, but not yet in the cache. Register it
-				* as a cache candidate.
-				*
-				* We do this after OpenFile has had the opportunity to throw an exception
-				* if the file is not accessible, in which case we do not want to try
-				* caching.
-				*/
-				cacheManager->queue.RecordCacheCandidate(url, cacheFilePath,
-														 remoteFs->GetFileSize(*wrappedHandle));
+				int64_t fileSize = remoteFs->GetFileSize(*wrappedHandle);
+				int64_t blockSize = 0;
+				string blocksDir;
+
+				if (cacheManager->UseBlockCache(opener, fileSize, blockSize) &&
+					cacheManager->TryGetCacheBlocksDir(cacheFilePath, fileSize,
+													   remoteFs->GetLastModifiedTime(*wrappedHandle),
+													   blockSize, blocksDir))
+				{
+					/*
+					 * File is too large to cache as a whole, cache the blocks
+					 * that are read instead.
+					 */
+					cachedBlocks = cacheManager->GetCachedFileBlocks(blocksDir, fileSize, blockSize);
+				}
+				else
+				{
+					/*
+					* File is eligible for caching, but not yet in the cache. Register it
+					* as a cache candidate.
+					*
+					* We do this after OpenFile has had the opportunity to throw an exception
+					* if the file is not accessible, in which case we do not want to try
+					* caching.
+					*/
+					cacheManager->queue.RecordCacheCandidate(url, cacheFilePath, fileSize);
+				}
 			}
 			else if (openFlags.OpenForWriting())
 			{
@@ -169,14 +188,19 @@ CachingFileSystem::OpenFile(const string &fullUrl,
 	}
 
 	/* wrap the file handles */
-	return make_uniq<CachingFSFileHandle>(*this,
-										url,
-										openFlags,
-										context,
-										std::move(wrappedHandle),
-										std::move(cacheOnWriteHandle),
-										cacheOnWritePath,
-										std::move(cacheOnWriteFileLock));
+	unique_ptr<CachingFSFileHandle> handle =
+		make_uniq<CachingFSFileHandle>(*this,
+									   url,
+									   openFlags,
+									   context,
+									   std::move(wrappedHandle),
+									   std::move(cacheOnWriteHandle),
+									   cacheOnWritePath,
+									   std::move(cacheOnWriteFileLock));
+
+	handle->cachedBlocks = cachedBlocks;
+
+	return std::move(handle);
 }
 
 
@@ -238,6 +262,215 @@ CachingFileSystem::CleanUpCacheOnWriteFile(CachingFSFileHandle &pg_lakeHandle)
 }
 
 
+/*
+ * ReadThroughBlockCache reads a range of a remote file that is cached in
+ * blocks. Blocks that are in the cache are read locally, and consecutive
+ * missing blocks are fetched with a single remote read and added to the
+ * cache.
+ */
+void
+CachingFileSystem::ReadThroughBlockCache(CachingFSFileHandle &pg_lakeHandle, char *buffer,
+										 int64_t byteCount, int64_t location)
+{
+	CachedFileBlocks &cachedBlocks = *pg_lakeHandle.cachedBlocks;
+
+	if (byteCount <= 0)
+		return;
+
+	int64_t blockIndex = location / cachedBlocks.blockSize;
+	int64_t lastBlockIndex = (location + byteCount - 1) / cachedBlocks.blockSize;
+
+	while (blockIndex <= lastBlockIndex)
+	{
+		if (IsBlockCached(cachedBlocks, blockIndex) &&
+			ReadCachedBlock(pg_lakeHandle, blockIndex, buffer, byteCount, location))
+		{
+			blockIndex++;
+			continue;
+		}
+
+		/* find the end of the run of missing blocks */
+		int64_t endBlockIndex = blockIndex + 1;
+
+		while (endBlockIndex <= lastBlockIndex && !IsBlockCached(cachedBlocks, endBlockIndex))
+			endBlockIndex++;
+
+		FetchBlocks(pg_lakeHandle, blockIndex, endBlockIndex, buffer, byteCount, location);
+
+		blockIndex = endBlockIndex;
+	}
+}
+
+
+/*
+ * IsBlockCached returns whether a block is in the cache, according to the
+ * bitmap or otherwise the file system, since blocks survive restarts.
+ */
+bool
+CachingFileSystem::IsBlockCached(CachedFileBlocks &cachedBlocks, int64_t blockIndex)
+{
+	if (cachedBlocks.IsBlockPresent(blockIndex))
+		return true;
+
+	if (!localfs.FileExists(cachedBlocks.GetBlockPath(blockIndex)))
+		return false;
+
+	cachedBlocks.SetBlockPresent(blockIndex, true);
+	return true;
+}
+
+
+/*
+ * CopyOverlappingRange copies the part of the data at dataOffset in the file
+ * that overlaps with the requested range into the read buffer.
+ */
+static void
+CopyOverlappingRange(const char *data, int64_t dataOffset, int64_t dataLength,
+					 char *buffer, int64_t byteCount, int64_t location)
+{
+	int64_t start = MaxValue<int64_t>(dataOffset, location);
+	int64_t end = MinValue<int64_t>(dataOffset + dataLength, location + byteCount);
+
+	if (start >= end)
+		return;
+
+	memcpy(buffer + (start - location), data + (start - dataOffset), end - start);
+}
+
+
+/*
+ * ReadCachedBlock reads the part of a cached block that overlaps with the
+ * requested range into the read buffer, and returns false if the block
+ * turned out not to be available.
+ */
+bool
+CachingFileSystem::ReadCachedBlock(CachingFSFileHandle &pg_lakeHandle, int64_t blockIndex, char *buffer,
+								   int64_t byteCount, int64_t location)
+{
+	CachedFileBlocks &cachedBlocks = *pg_lakeHandle.cachedBlocks;
+	string blockPath = cachedBlocks.GetBlockPath(blockIndex);
+	int64_t blockOffset = blockIndex * cachedBlocks.blockSize;
+	int64_t blockLength = cachedBlocks.GetBlockLength(blockIndex);
+
+	int64_t start = MaxValue<int64_t>(blockOffset, location);
+	int64_t end = MinValue<int64_t>(blockOffset + blockLength, location + byteCount);
+
+	try
+	{
+		unique_ptr<FileHandle> blockHandle = localfs.OpenFile(blockPath, FileFlags::FILE_FLAGS_READ);
+
+		if (localfs.GetFileSize(*blockHandle) != blockLength)
+		{
+			/* block file is incomplete, fetch it again */
+			cachedBlocks.SetBlockPresent(blockIndex, false);
+			return false;
+		}
+
+		localfs.Read(*blockHandle, buffer + (start - location), end - start, start - blockOffset);
+	}
+	catch (std::exception &ex)
+	{
+		/* block was removed from the cache concurrently */
+		cachedBlocks.SetBlockPresent(blockIndex, false);
+		return false;
+	}
+
+	/* we track access times in the cache index */
+	shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(*pg_lakeHandle.context);
+	cacheManager->RecordCacheAccess(blockPath);
+
+	return true;
+}
+
+
+/*
+ * FetchBlocks reads the blocks from startBlockIndex up to endBlockIndex from
+ * the remote file, copies the requested part into the read buffer, and adds
+ * the blocks to the cache as long as they fit.
+ */
+void
+CachingFileSystem::FetchBlocks(CachingFSFileHandle &pg_lakeHandle, int64_t startBlockIndex, int64_t endBlockIndex,
+							   char *buffer, int64_t byteCount, int64_t location)
+{
+	CachedFileBlocks &cachedBlocks = *pg_lakeHandle.cachedBlocks;
+	FileHandle &wrappedHandle = *pg_lakeHandle.wrappedHandle;
+
+	int64_t fetchOffset = startBlockIndex * cachedBlocks.blockSize;
+	int64_t fetchEnd = MinValue<int64_t>(endBlockIndex * cachedBlocks.blockSize, cachedBlocks.fileSize);
+	int64_t fetchLength = fetchEnd - fetchOffset;
+
+	unique_ptr<char[]> data(new char [fetchLength]);
+
+	wrappedHandle.file_system.Read(wrappedHandle, data.get(), fetchLength, fetchOffset);
+
+	CopyOverlappingRange(data.get(), fetchOffset, fetchLength, buffer, byteCount, location);
+
+	for (int64_t blockIndex = startBlockIndex; blockIndex < endBlockIndex; blockIndex++)
+	{
+		char *blockData = data.get() + (blockIndex - startBlockIndex) * cachedBlocks.blockSize;
+
+		/* cache is full, leave the remaining blocks to ManageCache */
+		if (!WriteCachedBlock(pg_lakeHandle, blockIndex, blockData))
+			break;
+	}
+}
+
+
+/*
+ * WriteCachedBlock adds a block to the cache, unless the cache would grow
+ * beyond its maximum size, in which case it returns false. Failing to write
+ * the block is not an error, since the read itself already succeeded.
+ */
+bool
+CachingFileSystem::WriteCachedBlock(CachingFSFileHandle &pg_lakeHandle, int64_t blockIndex, char *blockData)
+{
+	CachedFileBlocks &cachedBlocks = *pg_lakeHandle.cachedBlocks;
+	shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(*pg_lakeHandle.context);
+
+	string blockPath = cachedBlocks.GetBlockPath(blockIndex);
+	int64_t blockLength = cachedBlocks.GetBlockLength(blockIndex);
+
+	if (!cacheManager->TryReserveCacheSpace(blockLength))
+	{
+		PGDUCK_SERVER_DEBUG("not adding %s to cache: cache is full", blockPath.c_str());
+		return false;
+	}
+
+	/* readers do not take locks, so use a staging file per thread */
+	string stagingBlockPath = blockPath + "." +
+							  to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) +
+							  cacheManager->STAGING_SUFFIX;
+
+	try
+	{
+		FileUtils::EnsureLocalDirectoryExists(*pg_lakeHandle.context, cachedBlocks.blocksDir);
+
+		unique_ptr<FileHandle> stagingHandle =
+			localfs.OpenFile(stagingBlockPath,
+							 FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+
+		stagingHandle->Write(blockData, blockLength);
+		stagingHandle->Close();
+
+		/* completed write successfully, do an atomic rename */
+		localfs.MoveFile(stagingBlockPath, blockPath);
+
+		cachedBlocks.SetBlockPresent(blockIndex, true);
+		cacheManager->RecordCachedFile(blockPath, pg_lakeHandle.path, blockLength, true);
+		cacheManager->queue.RecordAccess(blockPath);
+	}
+	catch (std::exception &ex)
+	{
+		/* blocks directory was removed concurrently, or the disk is full */
+		PGDUCK_SERVER_DEBUG("could not add %s to cache: %s", blockPath.c_str(), ex.what());
+	}
+
+	cacheManager->ReleaseCacheSpace(blockLength);
+
+	return true;
+}
+
+
 /*
  * Glob is the file system function for listing files.
  *
@@ -323,6 +556,7 @@ CachingFileSystem::RemoveFile(const string &filename,
 	{
 		bool waitForLock = true;
 		cacheManager->RemoveCacheFile(*context, filename, waitForLock);
+		cacheManager->RemoveCachedBlocks(*context, filename);
 	}
 }
 
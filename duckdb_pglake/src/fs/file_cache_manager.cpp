@@ -16,8 +16,13 @@
  */
 
 #include <utime.h>
+#include <unistd.h>
 #include <sys/stat.h>
 #include <inttypes.h>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <thread>
 
 #include "duckdb.hpp"
 #include "duckdb/common/local_file_system.hpp"
@@ -39,6 +44,53 @@ const string CACHE_DIR_SETTING = "pg_lake_cache_dir";
 */
 const string CACHE_ON_WRITE_MAX_SIZE = "pg_lake_cache_on_write_max_size";
 
+/*
+ * Size of the blocks in which large files are cached, 0 disables caching
+ * in blocks. Values between 1MB and 8MB give a good balance between the
+ * number of requests and the amount of data read beyond what was asked.
+ */
+const string CACHE_BLOCK_SIZE_SETTING = "pg_lake_cache_block_size";
+
+/*
+ * Minimum size of a file to cache it in blocks as it is read, rather than
+ * as a whole by ManageCache.
+ */
+const string CACHE_BLOCK_MIN_FILE_SIZE_SETTING = "pg_lake_cache_block_min_file_size";
+
+/*
+ * Maximum number of files that a single ManageCache call downloads
+ * concurrently.
+ */
+const string CACHE_MAX_CONCURRENT_DOWNLOADS_SETTING = "pg_lake_cache_max_concurrent_downloads";
+
+/*
+ * Maximum number of files that are downloaded concurrently in the background
+ * for scans that are about to read them, 0 disables prefetching.
+ */
+const string CACHE_MAX_CONCURRENT_PREFETCHES_SETTING = "pg_lake_cache_max_concurrent_prefetches";
+
+/* default for the concurrent downloads setting when not set */
+const int64_t DEFAULT_CACHE_MAX_CONCURRENT_DOWNLOADS = 4;
+
+/* default for the concurrent prefetches setting when not set */
+const int64_t DEFAULT_CACHE_MAX_CONCURRENT_PREFETCHES = 2;
+
+/* defaults for the block cache settings when not set */
+const int64_t DEFAULT_CACHE_BLOCK_SIZE = 4 * 1024 * 1024;
+const int64_t DEFAULT_CACHE_BLOCK_MIN_FILE_SIZE = 256 * 1024 * 1024;
+
+/*
+ * Staging files of blocks are written by readers without holding a lock, so
+ * we only remove the ones that are clearly abandoned.
+ */
+const time_t ABANDONED_BLOCK_STAGING_SECONDS = 600;
+
+/*
+ * The cache index is kept up-to-date by the cache operations themselves, so
+ * we only occasionally reconcile it with the contents of the cache directory.
+ */
+const time_t CACHE_INDEX_RECONCILE_SECONDS = 3600;
+
 
 /*
  * The file cache is shared across clients by retrieving a global instance
@@ -87,6 +139,26 @@ IsFinalizedCachePath(string cacheFilePath)
 }
 
 
+/*
+ * IsCacheBlockPath returns whether the given file path belongs to a block
+ * (or a block staging file) of a file that is cached in blocks.
+ */
+static bool
+IsCacheBlockPath(const string &filePath)
+{
+	string blocksDir = FileUtils::ExtractDirName(filePath);
+
+	if (blocksDir.empty())
+		return false;
+
+	/* strip the trailing slash to get the name of the blocks directory */
+	string blocksDirName = FileUtils::ExtractFileName(blocksDir.substr(0, blocksDir.length() - 1));
+
+	return StringUtil::StartsWith(blocksDirName, CACHE_BLOCKS_DIR_PREFIX) &&
+		   StringUtil::StartsWith(FileUtils::ExtractFileName(filePath), CACHE_BLOCK_PREFIX);
+}
+
+
 /*
  * GetURLForCacheFilePath converts a cache file path to a URL.
  */
@@ -311,7 +383,7 @@ FileCacheManager::CacheFileInternal(ClientContext &context, string url, bool for
 	if (!force && file_system.FileExists(finalCacheFilePath))
 	{
 		/* count explicit cache operation as an access */
-		UpdateAccessTime(finalCacheFilePath);
+		RecordCacheAccess(finalCacheFilePath);
 
 		/* we do not want to cache the file again, so 0 bytes copied */
 		return 0;
@@ -332,6 +404,7 @@ FileCacheManager::CacheFileInternal(ClientContext &context, string url, bool for
 
 	/* completed copy successfully, do an atomic rename */
 	file_system.MoveFile(stagingCacheFilePath, finalCacheFilePath);
+	RecordCachedFile(finalCacheFilePath, url, size, false);
 
 	PGDUCK_SERVER_LOG("successfully added %s to cache (%" PRIu64 \
 					  " bytes)", finalCacheFilePath.c_str(), size);
@@ -453,6 +526,9 @@ FileCacheManager::RemoveCacheFileInternal(FileSystem &file_system, string finalC
 			PGDUCK_SERVER_LOG("removing %s from cache", filePath.c_str());
 			file_system.RemoveFile(filePath);
 		}
+
+		/* also forget files that were removed by someone else */
+		RemoveFromCacheIndex(filePath);
 	}
 	catch(const std::exception& e)
 	{
@@ -467,16 +543,215 @@ FileCacheManager::RemoveCacheFileInternal(FileSystem &file_system, string finalC
 }
 
 
+/*
+ * UseBlockCache returns whether a remote file of the given size should be
+ * cached in blocks as it is read and if so sets the block size.
+ */
+bool
+FileCacheManager::UseBlockCache(optional_ptr<FileOpener> opener, int64_t fileSize, int64_t &blockSize)
+{
+	Value setting;
+
+	blockSize = DEFAULT_CACHE_BLOCK_SIZE;
+
+	if (opener->TryGetCurrentSetting(CACHE_BLOCK_SIZE_SETTING, setting) && !setting.IsNull())
+		blockSize = setting.GetValue<int64_t>();
+
+	if (blockSize <= 0)
+		/* caching in blocks is disabled */
+		return false;
+
+	int64_t minFileSize = DEFAULT_CACHE_BLOCK_MIN_FILE_SIZE;
+
+	if (opener->TryGetCurrentSetting(CACHE_BLOCK_MIN_FILE_SIZE_SETTING, setting) && !setting.IsNull())
+		minFileSize = setting.GetValue<int64_t>();
+
+	return fileSize > 0 && fileSize >= minFileSize;
+}
+
+
+/*
+ * TryGetCacheBlocksDir returns whether the file at the given cache file path
+ * can be cached in blocks and if so sets the directory for its blocks.
+ *
+ * The blocks directory is constructed as:
+ * <cache_dir>/<protocol>/<host>/<directory>/pgl-blocks.<filename>.<version>
+ */
+bool
+FileCacheManager::TryGetCacheBlocksDir(string cacheFilePath, int64_t fileSize, timestamp_t lastModified,
+									   int64_t blockSize, string &blocksDir)
+{
+	string cacheFileName = FileUtils::ExtractFileName(cacheFilePath);
+	string originalFileName = cacheFileName.substr(CACHE_FILE_PREFIX.length());
+
+	/* the version does not contain dots, so it can be found after the last one */
+	string version = to_string(fileSize) + "-" +
+					 to_string(Timestamp::GetEpochSeconds(lastModified)) + "-" +
+					 to_string(blockSize);
+
+	string blocksDirName = CACHE_BLOCKS_DIR_PREFIX + originalFileName + "." + version;
+
+	/* cannot create directories with >255 characters */
+	if (blocksDirName.size() > 255)
+		return false;
+
+	blocksDir = FileUtils::ExtractDirName(cacheFilePath) + blocksDirName;
+
+	return true;
+}
+
+
+/*
+ * GetCachedFileBlocks returns the shared bitmap of cached blocks for the given
+ * blocks directory.
+ */
+shared_ptr<CachedFileBlocks>
+FileCacheManager::GetCachedFileBlocks(string blocksDir, int64_t fileSize, int64_t blockSize)
+{
+	lock_guard<mutex> lock(cachedBlocksMapLock);
+
+	auto it = cachedBlocksMap.find(blocksDir);
+	if (it != cachedBlocksMap.end())
+		return it->second;
+
+	shared_ptr<CachedFileBlocks> cachedBlocks =
+		make_shared_ptr<CachedFileBlocks>(blocksDir, fileSize, blockSize);
+
+	cachedBlocksMap[blocksDir] = cachedBlocks;
+	return cachedBlocks;
+}
+
+
+/*
+ * RemoveCachedBlocks removes all cached blocks of the given URL, across all
+ * versions of the file, and returns whether there were any.
+ */
+bool
+FileCacheManager::RemoveCachedBlocks(ClientContext &context, string url)
+{
+	FileOpener *opener = context.client_data->file_opener.get();
+
+	string cacheDir;
+	string cacheFilePath;
+
+	if (!TryGetCacheDir(opener, cacheDir) ||
+		!TryGetCacheFilePath(cacheDir, url, cacheFilePath))
+		return false;
+
+	LocalFileSystem localfs;
+	string cacheFileDir = FileUtils::ExtractDirName(cacheFilePath);
+
+	if (!localfs.DirectoryExists(cacheFileDir))
+		return false;
+
+	string originalFileName = FileUtils::ExtractFileName(cacheFilePath).substr(CACHE_FILE_PREFIX.length());
+	string blocksDirPrefix = CACHE_BLOCKS_DIR_PREFIX + originalFileName + ".";
+	vector<string> blocksDirs;
+
+	localfs.ListFiles(cacheFileDir, [&](const string &fileName, bool isDirectory) {
+		/* the remainder should only be the version, which does not contain dots */
+		if (isDirectory && StringUtil::StartsWith(fileName, blocksDirPrefix) &&
+			fileName.find('.', blocksDirPrefix.length()) == std::string::npos)
+			blocksDirs.push_back(cacheFileDir + fileName);
+	});
+
+	for (const string &blocksDir : blocksDirs)
+	{
+		PGDUCK_SERVER_LOG("removing blocks in %s from cache", blocksDir.c_str());
+
+		localfs.ListFiles(blocksDir, [&](const string &fileName, bool isDirectory) {
+			RemoveFromCacheIndex(blocksDir + "/" + fileName);
+		});
+
+		localfs.RemoveDirectory(blocksDir);
+
+		lock_guard<mutex> lock(cachedBlocksMapLock);
+		cachedBlocksMap.erase(blocksDir);
+	}
+
+	return !blocksDirs.empty();
+}
+
+
+/*
+ * RemoveCacheBlock removes a single block from the cache and clears it in
+ * the bitmap of the file. Readers that still see the block as present will
+ * fail to open it and fetch it again.
+ */
+void
+FileCacheManager::RemoveCacheBlock(FileSystem &file_system, const string &blockFilePath)
+{
+	if (file_system.FileExists(blockFilePath))
+		file_system.RemoveFile(blockFilePath);
+
+	RemoveFromCacheIndex(blockFilePath);
+
+	string blocksDir = FileUtils::ExtractDirName(blockFilePath);
+	blocksDir.erase(blocksDir.length() - 1);
+
+	string blockName = FileUtils::ExtractFileName(blockFilePath);
+	int64_t blockIndex = std::stoll(blockName.substr(CACHE_BLOCK_PREFIX.length()));
+
+	{
+		lock_guard<mutex> lock(cachedBlocksMapLock);
+
+		auto it = cachedBlocksMap.find(blocksDir);
+		if (it != cachedBlocksMap.end())
+			it->second->SetBlockPresent(blockIndex, false);
+	}
+
+	/* remove the directory once the last block is gone, fails otherwise */
+	rmdir(blocksDir.c_str());
+}
+
+
+/*
+ * GetURLForCacheBlockPath converts the path of a cached block to the URL of
+ * the file it belongs to.
+ */
+string
+FileCacheManager::GetURLForCacheBlockPath(string &cacheDir, const string &blockFilePath)
+{
+	string blocksDir = FileUtils::ExtractDirName(blockFilePath);
+	blocksDir.erase(blocksDir.length() - 1);
+
+	/* strip the prefix and the version from pgl-blocks.<filename>.<version> */
+	string blocksDirName = FileUtils::ExtractFileName(blocksDir);
+	size_t versionDotIndex = blocksDirName.rfind('.');
+
+	if (versionDotIndex == std::string::npos || versionDotIndex < CACHE_BLOCKS_DIR_PREFIX.length())
+		throw InvalidInputException(blockFilePath + " is not a cache block path");
+
+	string originalFileName = blocksDirName.substr(CACHE_BLOCKS_DIR_PREFIX.length(),
+												   versionDotIndex - CACHE_BLOCKS_DIR_PREFIX.length());
+
+	/* the blocks directory sits where the whole file would be cached */
+	return GetURLForCacheFilePath(cacheDir,
+								  FileUtils::ExtractDirName(blocksDir) + CACHE_FILE_PREFIX + originalFileName);
+}
+
 
 /*
- * ManageCache implements a simple cache management approach where we prune
- * the least recently used files, until there is enough space for all recently
- * accessed candidates, and then we download them one by one.
+ * ManageCache implements a frequency-aware cache management approach, similar
+ * to TinyLFU. The candidate queue acts as the admission window: a candidate is
+ * only downloaded if it fits in the cache, or if it is accessed more frequently
+ * than each of the least recently used files that would need to be removed
+ * to make room for it. That way, a single scan over many cold files cannot
+ * flush frequently used files out of the cache.
+ *
+ * Blocks of files that are cached in blocks are added by readers, and are
+ * pruned one by one in the same order as whole files.
+ *
+ * Only the eviction decisions are made under manageCacheLock, the downloads
+ * run concurrently after releasing it.
  */
 vector<CacheAction>
 FileCacheManager::ManageCache(ClientContext &context, int64_t maxCacheSize)
 {
-	lock_guard<mutex> lock(manageCacheLock);
+	unique_lock<mutex> lock(manageCacheLock);
+
+	/* readers that add blocks to the cache stay within the same size */
+	maxCacheSizeHint = maxCacheSize;
 
 	FileOpener *opener = context.client_data->file_opener.get();
 	FileSystem &file_system = FileSystem::GetFileSystem(context);
@@ -494,7 +769,8 @@ FileCacheManager::ManageCache(ClientContext &context, int64_t maxCacheSize)
 	/* keep track of actions taken by this function */
 	vector<CacheAction> actions;
 
-	uint64_t queueSize = 0;
+	/* make room for downloads of concurrent ManageCache calls as well */
+	int64_t reservedSize = inFlightDownloadSize;
 
 	for (CacheItem& cacheCandidate : cacheCandidates)
 	{
@@ -518,228 +794,783 @@ FileCacheManager::ManageCache(ClientContext &context, int64_t maxCacheSize)
 		if (file_system.FileExists(cacheCandidate.cacheFilePath))
 			continue;
 
-		queueSize += cacheCandidate.fileSize;
 		cacheCandidate.needsDownload = true;
+		cacheCandidate.frequency = queue.EstimateFrequency(cacheCandidate.cacheFilePath);
 	}
 
-	/* get all the files in the cache directory */
-	vector<OpenFileInfo> cachedFileNames = file_system.Glob(cacheDir + "**");
-
-	/* construct a combined list of cached files and candidates */
-	vector<CacheItem> cacheFiles = cacheCandidates;
+	/* get all the files in the cache from the index, rather than the file system */
+	vector<CacheItem> cachedFiles = GetCacheIndexItems(context, cacheDir, actions);
 
 	int64_t totalCacheSize = 0;
 
-	for (const OpenFileInfo& cachedFilePath : cachedFileNames)
+	for (CacheItem& cachedFile : cachedFiles)
 	{
-		/* skip and remove files that failed during staging */
-		if (StringUtil::EndsWith(cachedFilePath.path, STAGING_SUFFIX))
-		{
-			/* remove the staging suffix from a copy of the path */
-			string finalCacheFilePath = cachedFilePath.path;
-			finalCacheFilePath.erase(finalCacheFilePath.length() - STAGING_SUFFIX.length());
+		cachedFile.frequency = queue.EstimateFrequency(cachedFile.cacheFilePath);
 
-			bool waitForLock = false;
+		/* count the total size of the cache */
+		totalCacheSize += cachedFile.fileSize;
+	}
 
-			/*
-			* We pass finalCacheFilePath as the locking is based on the finalCacheFilePath.
-			* We also pass the staging file (e.g., cachedFilePath) as the actual file to remove
-			* from the cache.
-			*/
-			FileCacheManager::CacheRemoveStatus status =
-				RemoveCacheFileInternal(file_system, finalCacheFilePath, cachedFilePath.path, waitForLock);
+	/* sort from oldest to newest access time, oldest files are the victims */
+	std::sort(cachedFiles.begin(), cachedFiles.end());
+
+	idx_t nextVictim = 0;
+
+	/* the cache might exceed the maximum size, regardless of candidates */
+	while (nextVictim < cachedFiles.size() && totalCacheSize + reservedSize >= maxCacheSize)
+		EvictCacheItem(context, cachedFiles[nextVictim++], totalCacheSize, actions);
+
+	/* consider the most frequently accessed candidates first */
+	std::sort(cacheCandidates.begin(), cacheCandidates.end(),
+			  [](const CacheItem &a, const CacheItem &b) {
+				  if (a.frequency != b.frequency)
+					  return a.frequency > b.frequency;
+
+				  return b < a;
+			  });
+
+	/* collect the candidates to download */
+	vector<CacheItem> downloads;
+
+	for (CacheItem& cacheCandidate : cacheCandidates)
+	{
+		if (!cacheCandidate.needsDownload)
+			continue;
+
+		/* find the victims that need to be removed to make room */
+		idx_t victimEnd = nextVictim;
+		int64_t freedSize = 0;
+		bool admit = true;
 
+		while (totalCacheSize - freedSize + reservedSize + cacheCandidate.fileSize >= maxCacheSize)
+		{
 			/*
-			 * A concurrent cache operation is happening on the same file, so we have not removed
-			 * the file from the cache. We skip the file from the cache management in this iteration.
+			 * If we run out of victims, the space is taken by more frequently
+			 * accessed candidates.
 			 */
-			if (status == FileCacheManager::CacheRemoveStatus::LOCK_NOT_ACQUIRED)
+			if (victimEnd >= cachedFiles.size() ||
+				cachedFiles[victimEnd].frequency >= cacheCandidate.frequency)
 			{
-				actions.push_back({
-					.url = GetURLForCacheFilePath(cacheDir, finalCacheFilePath),
-					.fileSize = 0,
-					.action = SKIPPED_CONCURRENT_MODIFY
-				});
+				admit = false;
+				break;
 			}
 
-			continue;
-		}
-
-		if (!IsFinalizedCachePath(cachedFilePath.path))
-		{
-			/* unexpected file in cache; maybe warn, but probably just skip */
-			continue;
+			freedSize += cachedFiles[victimEnd].fileSize;
+			victimEnd++;
 		}
 
-		struct stat cachedFileStat;
-		if (stat(cachedFilePath.path.c_str(), &cachedFileStat) < 0)
+		if (!admit)
 		{
-			/* file was concurrently removed/finished caching? */
+			actions.push_back({
+				.url = cacheCandidate.url,
+				.fileSize = cacheCandidate.fileSize,
+				.action = SKIPPED_INFREQUENT
+			});
 			continue;
 		}
 
-		/* construct file metadata */
-		CacheItem cachedFile = {
-			.url = GetURLForCacheFilePath(cacheDir, cachedFilePath.path),
-			.cacheFilePath = cachedFilePath.path,
-			.fileSize = cachedFileStat.st_size,
-			.lastAccessTime = cachedFileStat.st_atime,
-			.isCandidate = false,
-			.needsDownload = false
-		};
+		while (nextVictim < victimEnd)
+			EvictCacheItem(context, cachedFiles[nextVictim++], totalCacheSize, actions);
 
-		/* make a deep copy and push it onto the vector */
-		cacheFiles.push_back(cachedFile);
+		reservedSize += cacheCandidate.fileSize;
 
-		/* count the total size of the cache */
-		totalCacheSize += cachedFile.fileSize;
+		downloads.push_back(cacheCandidate);
+		inFlightDownloadSize += cacheCandidate.fileSize;
 	}
 
-	/* sort from oldest to newest access time */
-	std::sort(cacheFiles.begin(), cacheFiles.end());
-
-	/* remove items until we have enough space for all candidates */
-	for (CacheItem& cacheFile : cacheFiles)
-	{
-		if (totalCacheSize + queueSize < maxCacheSize)
-			/* we have enough space to fit our queue */
-			break;
-
-		if (!cacheFile.isCandidate)
-		{
-			PGDUCK_SERVER_LOG("removing %s from cache (%" PRIu64 \
-							  " bytes)", cacheFile.cacheFilePath.c_str(), cacheFile.fileSize);
+	/*
+	 * Eviction decisions are made, so we can let other ManageCache calls
+	 * proceed while we download. They account for our downloads via
+	 * inFlightDownloadSize, and per-file locks prevent them from touching
+	 * the files we are downloading.
+	 */
+	lock.unlock();
 
-			/* for background tasks, we skip if lock cannot be acquired */
-			bool waitForLock = false;
-			CacheActionType action = REMOVED;
+	DownloadCacheFiles(context, downloads, actions);
 
-			/* remove the file to free up space */
-			FileCacheManager::CacheRemoveStatus status =
-				RemoveCacheFile(context, cacheFile.url, waitForLock);
-			if (status == FileCacheManager::CacheRemoveStatus::LOCK_NOT_ACQUIRED)
-			{
-				action = SKIPPED_CONCURRENT_MODIFY;
-			}
-			else
-			{
-				totalCacheSize -= cacheFile.fileSize;
-			}
+	return actions;
+}
 
-			actions.push_back({
-				.url = cacheFile.url,
-				.fileSize = cacheFile.fileSize,
-				.action = action
-			});
-		}
-		else if (cacheFile.needsDownload)
-		{
-			/* a candidate is among the older files, don't download it */
-			cacheFile.needsDownload = false;
-			queueSize -= cacheFile.fileSize;
 
-			actions.push_back({
-				.url = cacheFile.url,
-				.fileSize = cacheFile.fileSize,
-				.action = SKIPPED_TOO_OLD
-			});
-		}
-	}
+/*
+ * EvictCacheItem removes a cached file or block to make room in the cache.
+ */
+void
+FileCacheManager::EvictCacheItem(ClientContext &context, CacheItem &cacheFile,
+								 int64_t &totalCacheSize, vector<CacheAction> &actions)
+{
+	FileSystem &file_system = FileSystem::GetFileSystem(context);
 
-	/* download all the remaining candidates */
-	for (const CacheItem& cacheFile : cacheFiles)
+	if (cacheFile.isBlock)
 	{
-		if (!cacheFile.needsDownload)
-			continue;
-
-		try
-		{
-			/* we already took the lock */
-			bool withLock = false;
-			bool force = false;
-			CacheActionType action = ADDED;
+		PGDUCK_SERVER_DEBUG("removing block %s from cache (%" PRIu64 \
+							" bytes)", cacheFile.cacheFilePath.c_str(), cacheFile.fileSize);
+
+		RemoveCacheBlock(file_system, cacheFile.cacheFilePath);
+		totalCacheSize -= cacheFile.fileSize;
+
+		actions.push_back({
+			.url = cacheFile.url,
+			.fileSize = cacheFile.fileSize,
+			.action = BLOCK_REMOVED
+		});
+		return;
+	}
 
-			/* for background tasks, we skip if lock cannot be acquired */
-			bool waitForLock = false;
+	PGDUCK_SERVER_LOG("removing %s from cache (%" PRIu64 \
+					  " bytes)", cacheFile.cacheFilePath.c_str(), cacheFile.fileSize);
 
-			int64_t cached = CacheFile(context, cacheFile.url, force, waitForLock);
-			if (cached == -1)
-			{
-				action = SKIPPED_CONCURRENT_MODIFY;
-			}
+	/* for background tasks, we skip if lock cannot be acquired */
+	bool waitForLock = false;
+	CacheActionType action = REMOVED;
 
-			actions.push_back({
-				.url = cacheFile.url,
-				.fileSize = cacheFile.fileSize,
-				.action = action
-			});
-		}
-		catch (std::exception &ex)
-		{
-			actions.push_back({
-				.url = cacheFile.url,
-				.fileSize = cacheFile.fileSize,
-				.action = ADD_FAILED
-			});
-		}
+	/* remove the file to free up space */
+	FileCacheManager::CacheRemoveStatus status =
+		RemoveCacheFile(context, cacheFile.url, waitForLock);
+	if (status == FileCacheManager::CacheRemoveStatus::LOCK_NOT_ACQUIRED)
+	{
+		action = SKIPPED_CONCURRENT_MODIFY;
+	}
+	else
+	{
+		totalCacheSize -= cacheFile.fileSize;
 	}
 
-	return actions;
+	actions.push_back({
+		.url = cacheFile.url,
+		.fileSize = cacheFile.fileSize,
+		.action = action
+	});
 }
 
 
 /*
- * ListCache returns a list of cached files.
+ * DownloadCacheFiles downloads the given cache candidates using a bounded
+ * number of concurrent transfers, and adds the outcomes to actions in the
+ * order of the candidates.
  */
-vector<CacheItem>
-FileCacheManager::ListCache(ClientContext &context)
+void
+FileCacheManager::DownloadCacheFiles(ClientContext &context, vector<CacheItem> &downloads,
+									 vector<CacheAction> &actions)
 {
+	if (downloads.empty())
+		return;
+
 	FileOpener *opener = context.client_data->file_opener.get();
-	FileSystem &file_system = FileSystem::GetFileSystem(context);
+	Value setting;
+	int64_t maxConcurrentDownloads = DEFAULT_CACHE_MAX_CONCURRENT_DOWNLOADS;
 
-	/* determine the cache directory */
-	string cacheDir;
+	if (opener->TryGetCurrentSetting(CACHE_MAX_CONCURRENT_DOWNLOADS_SETTING, setting) && !setting.IsNull())
+		maxConcurrentDownloads = MaxValue<int64_t>(setting.GetValue<int64_t>(), 1);
 
-	if (!TryGetCacheDir(opener, cacheDir))
-		/* caching not configured */
-		throw InvalidInputException("caching is currently disabled");
+	vector<CacheAction> downloadActions(downloads.size());
+	std::atomic<idx_t> nextDownloadIndex(0);
 
-	/* construct a combined list of cached files */
-	vector<CacheItem> cacheFiles;
+	auto downloadWorker = [&](ClientContext &workerContext) {
+		idx_t downloadIndex;
 
-	/* get all the files in the cache directory */
-	vector<OpenFileInfo> cachedFileNames = file_system.Glob(cacheDir + "**");
+		while ((downloadIndex = nextDownloadIndex++) < downloads.size())
+			downloadActions[downloadIndex] = DownloadCacheFile(workerContext, downloads[downloadIndex]);
+	};
 
-	for (const OpenFileInfo& cachedFilePath : cachedFileNames)
-	{
-		/* skip files that are in progress or failed during staging */
-		if (!IsFinalizedCachePath(cachedFilePath.path))
+	/*
+	 * A ClientContext cannot be used by multiple threads, so other threads
+	 * use their own connection, like prefetch workers do.
+	 */
+	DatabaseInstance &db = *context.db;
+
+	auto threadWorker = [&]() {
+		try
+		{
+			Connection connection(db);
+
+			downloadWorker(*connection.context);
+		}
+		catch (std::exception &ex)
+		{
+			/* remaining downloads are picked up by the other downloaders */
+			PGDUCK_SERVER_DEBUG("cache download thread failed: %s", ex.what());
+		}
+	};
+
+	/* the current thread is one of the downloaders */
+	idx_t threadCount = MinValue<idx_t>(maxConcurrentDownloads, downloads.size());
+	vector<std::thread> threads;
+
+	try
+	{
+		for (idx_t threadIndex = 1; threadIndex < threadCount; threadIndex++)
+			threads.emplace_back(threadWorker);
+	}
+	catch (std::system_error &ex)
+	{
+		/* continue with the threads we have, which need to be joined */
+		PGDUCK_SERVER_LOG("could only start %zu cache download threads: %s",
+						  threads.size(), ex.what());
+	}
+
+	downloadWorker(context);
+
+	for (std::thread &thread : threads)
+		thread.join();
+
+	actions.insert(actions.end(), downloadActions.begin(), downloadActions.end());
+}
+
+
+/*
+ * DownloadCacheFile adds a single cache candidate to the cache and returns
+ * the outcome, including how long the download took.
+ */
+CacheAction
+FileCacheManager::DownloadCacheFile(ClientContext &context, const CacheItem &cacheFile)
+{
+	CacheActionType action = ADDED;
+	auto startTime = std::chrono::steady_clock::now();
+
+	try
+	{
+		bool force = false;
+
+		/* for background tasks, we skip if lock cannot be acquired */
+		bool waitForLock = false;
+
+		int64_t cached = CacheFile(context, cacheFile.url, force, waitForLock);
+		if (cached == -1)
+		{
+			action = SKIPPED_CONCURRENT_MODIFY;
+		}
+	}
+	catch (std::exception &ex)
+	{
+		action = ADD_FAILED;
+	}
+
+	inFlightDownloadSize -= cacheFile.fileSize;
+
+	auto duration = std::chrono::steady_clock::now() - startTime;
+
+	return {
+		.url = cacheFile.url,
+		.fileSize = cacheFile.fileSize,
+		.action = action,
+		.downloadTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()
+	};
+}
+
+
+/*
+ * PrefetchFiles schedules background downloads of files that a scan is about
+ * to read, such that later files are cached by the time they are opened.
+ * Files are only prefetched while they fit in the headroom of the cache, and
+ * at most pg_lake_cache_max_concurrent_prefetches files are downloaded at
+ * a time.
+ *
+ * Returns the number of files that were scheduled, without waiting for the
+ * downloads.
+ */
+int64_t
+FileCacheManager::PrefetchFiles(ClientContext &context, vector<string> &urls, vector<int64_t> &fileSizes,
+								int64_t maxCacheSize)
+{
+	FileOpener *opener = context.client_data->file_opener.get();
+	FileSystem &file_system = FileSystem::GetFileSystem(context);
+
+	/* determine the cache directory */
+	string cacheDir;
+
+	if (!TryGetCacheDir(opener, cacheDir))
+		/* prefetching is only a hint, so there is nothing to do */
+		return 0;
+
+	Value setting;
+	int64_t maxConcurrentPrefetches = DEFAULT_CACHE_MAX_CONCURRENT_PREFETCHES;
+
+	if (opener->TryGetCurrentSetting(CACHE_MAX_CONCURRENT_PREFETCHES_SETTING, setting) && !setting.IsNull())
+		maxConcurrentPrefetches = setting.GetValue<int64_t>();
+
+	if (maxConcurrentPrefetches <= 0)
+		return 0;
+
+	/*
+	 * We only use space that is not taken by cached files and downloads.
+	 * Scans wait for this call, so we use the running size of the index
+	 * rather than walking the index or the cache directory.
+	 */
+	int64_t headroom;
+
+	{
+		lock_guard<mutex> lock(cacheIndexLock);
+
+		/* the index is loaded by the first ManageCache call */
+		if (cacheIndexDir != cacheDir)
+			return 0;
+
+		headroom = maxCacheSize - cacheIndexSize - inFlightDownloadSize;
+	}
+
+	vector<CacheItem> prefetches;
+
+	for (idx_t fileIndex = 0; fileIndex < urls.size() && fileIndex < fileSizes.size(); fileIndex++)
+	{
+		string &url = urls[fileIndex];
+		int64_t fileSize = fileSizes[fileIndex];
+		int64_t blockSize;
+
+		if (fileSize <= 0 || fileSize > headroom)
+			continue;
+
+		/* large files are cached in blocks as they are read */
+		if (UseBlockCache(opener, fileSize, blockSize))
+			continue;
+
+		string cacheFilePath;
+
+		if (!TryGetCacheFilePath(cacheDir, url, cacheFilePath) ||
+			file_system.FileExists(cacheFilePath))
+			continue;
+
+		headroom -= fileSize;
+
+		prefetches.push_back({
+			.url = url,
+			.cacheFilePath = cacheFilePath,
+			.fileSize = fileSize,
+			.lastAccessTime = time(NULL),
+			.isCandidate = true,
+			.needsDownload = true,
+			.isBlock = false
+		});
+	}
+
+	/* prefetch threads keep the cache manager and database alive */
+	shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(context);
+	shared_ptr<DatabaseInstance> db = context.db;
+	int64_t scheduled = 0;
+
+	lock_guard<mutex> lock(prefetchLock);
+
+	for (CacheItem& prefetch : prefetches)
+	{
+		/* a concurrent scan might already have scheduled the same file */
+		if (!prefetchURLs.insert(prefetch.url).second)
+			continue;
+
+		inFlightDownloadSize += prefetch.fileSize;
+		prefetchQueue.push_back(prefetch);
+		scheduled++;
+	}
+
+	while (prefetchThreadCount < maxConcurrentPrefetches &&
+		   prefetchThreadCount < (int64_t) prefetchQueue.size())
+	{
+		prefetchThreadCount++;
+
+		std::thread([cacheManager, db]() {
+			cacheManager->PrefetchWorker(*db);
+		}).detach();
+	}
+
+	return scheduled;
+}
+
+
+/*
+ * PrefetchWorker downloads files from the prefetch queue until it is empty.
+ * It uses its own connection, since the connection that scheduled the files
+ * continues with the scan.
+ */
+void
+FileCacheManager::PrefetchWorker(DatabaseInstance &db)
+{
+	try
+	{
+		Connection connection(db);
+
+		while (true)
+		{
+			CacheItem prefetch;
+
+			{
+				lock_guard<mutex> lock(prefetchLock);
+
+				if (prefetchQueue.empty())
+				{
+					prefetchThreadCount--;
+					return;
+				}
+
+				prefetch = prefetchQueue.front();
+				prefetchQueue.pop_front();
+			}
+
+			CacheAction action = DownloadCacheFile(*connection.context, prefetch);
+
+			PGDUCK_SERVER_DEBUG("prefetch of %s into cache %s in %" PRId64 " ms",
+								prefetch.url.c_str(), action.action == ADDED ? "succeeded" : "skipped",
+								action.downloadTimeMs);
+
+			lock_guard<mutex> lock(prefetchLock);
+			prefetchURLs.erase(prefetch.url);
+		}
+	}
+	catch (std::exception &ex)
+	{
+		PGDUCK_SERVER_LOG("could not prefetch files into cache: %s", ex.what());
+	}
+
+	lock_guard<mutex> lock(prefetchLock);
+	prefetchThreadCount--;
+}
+
+
+/*
+ * ListCache returns a list of cached files.
+ */
+vector<CacheItem>
+FileCacheManager::ListCache(ClientContext &context)
+{
+	FileOpener *opener = context.client_data->file_opener.get();
+
+	/* determine the cache directory */
+	string cacheDir;
+
+	if (!TryGetCacheDir(opener, cacheDir))
+		/* caching not configured */
+		throw InvalidInputException("caching is currently disabled");
+
+	/* construct a combined list of cached files */
+	vector<CacheItem> cacheFiles;
+
+	/* ListCache does not remove staging files, so ignore actions */
+	vector<CacheAction> actions;
+
+	for (const CacheItem& cachedFile : GetCacheIndexItems(context, cacheDir, actions))
+	{
+		/* blocks are not listed as files */
+		if (cachedFile.isBlock)
+			continue;
+
+		/* make a deep copy and push it onto the vector */
+		cacheFiles.push_back(cachedFile);
+	}
+
+	return cacheFiles;
+}
+
+
+/*
+ * GetCacheIndexItems returns all files and blocks in the cache index, after
+ * loading or reconciling the index against the cache directory if needed.
+ *
+ * Access times that were recorded in memory since the last call are written
+ * to the file system, such that they survive restarts.
+ */
+vector<CacheItem>
+FileCacheManager::GetCacheIndexItems(ClientContext &context, string &cacheDir, vector<CacheAction> &actions)
+{
+	bool needsReconcile;
+
+	{
+		lock_guard<mutex> lock(cacheIndexLock);
+
+		needsReconcile = cacheIndexDir != cacheDir ||
+						 difftime(time(NULL), cacheIndexReconcileTime) >= CACHE_INDEX_RECONCILE_SECONDS;
+	}
+
+	if (needsReconcile)
+		ReconcileCacheIndex(context, cacheDir, actions);
+
+	vector<CacheItem> cacheItems;
+	vector<std::pair<string, time_t>> accessTimes;
+
+	{
+		lock_guard<mutex> lock(cacheIndexLock);
+
+		for (const auto& entry : cacheIndex)
+		{
+			cacheItems.push_back({
+				.url = entry.second.url,
+				.cacheFilePath = entry.first,
+				.fileSize = entry.second.fileSize,
+				.lastAccessTime = entry.second.lastAccessTime,
+				.isCandidate = false,
+				.needsDownload = false,
+				.isBlock = entry.second.isBlock
+			});
+		}
+
+		for (const string& cacheFilePath : dirtyAccessPaths)
+		{
+			auto it = cacheIndex.find(cacheFilePath);
+			if (it != cacheIndex.end())
+				accessTimes.push_back({cacheFilePath, it->second.lastAccessTime});
+		}
+
+		dirtyAccessPaths.clear();
+	}
+
+	/* persist the access times outside of the lock */
+	for (auto& accessTime : accessTimes)
+		SetAccessTime(accessTime.first, accessTime.second);
+
+	return cacheItems;
+}
+
+
+/*
+ * ReconcileCacheIndex rebuilds the cache index from the files in the cache
+ * directory, and removes staging files that were left behind by failed
+ * downloads.
+ *
+ * Walking a large cache directory can take seconds, so we do it when the
+ * index is first used and then only occasionally, to pick up changes that
+ * were made to the directory by others.
+ */
+void
+FileCacheManager::ReconcileCacheIndex(ClientContext &context, string &cacheDir, vector<CacheAction> &actions)
+{
+	lock_guard<mutex> reconcileLock(cacheIndexReconcileLock);
+
+	FileSystem &file_system = FileSystem::GetFileSystem(context);
+	time_t scanStartTime = time(NULL);
+
+	unordered_map<string, CacheIndexEntry> scannedIndex;
+
+	/* get all the files in the cache directory */
+	vector<OpenFileInfo> cachedFileNames = file_system.Glob(cacheDir + "**");
+
+	for (const OpenFileInfo& cachedFilePath : cachedFileNames)
+	{
+		/* blocks of large files are evicted individually with all other files */
+		if (IsCacheBlockPath(cachedFilePath.path))
 		{
+			struct stat blockFileStat;
+			if (stat(cachedFilePath.path.c_str(), &blockFileStat) < 0)
+			{
+				/* block was concurrently removed? */
+				continue;
+			}
+
+			if (StringUtil::EndsWith(cachedFilePath.path, STAGING_SUFFIX))
+			{
+				/* remove blocks that a reader failed to finish writing */
+				if (difftime(time(NULL), blockFileStat.st_mtime) > ABANDONED_BLOCK_STAGING_SECONDS)
+					file_system.RemoveFile(cachedFilePath.path);
+
+				continue;
+			}
+
+			scannedIndex[cachedFilePath.path] = {
+				.url = GetURLForCacheBlockPath(cacheDir, cachedFilePath.path),
+				.fileSize = blockFileStat.st_size,
+				.lastAccessTime = blockFileStat.st_atime,
+				.hitCount = 0,
+				.indexedTime = scanStartTime,
+				.isBlock = true
+			};
+			continue;
+		}
+
+		/* skip and remove files that failed during staging */
+		if (StringUtil::EndsWith(cachedFilePath.path, STAGING_SUFFIX))
+		{
+			/* remove the staging suffix from a copy of the path */
+			string finalCacheFilePath = cachedFilePath.path;
+			finalCacheFilePath.erase(finalCacheFilePath.length() - STAGING_SUFFIX.length());
+
+			bool waitForLock = false;
+
+			/*
+			* We pass finalCacheFilePath as the locking is based on the finalCacheFilePath.
+			* We also pass the staging file (e.g., cachedFilePath) as the actual file to remove
+			* from the cache.
+			*/
+			FileCacheManager::CacheRemoveStatus status =
+				RemoveCacheFileInternal(file_system, finalCacheFilePath, cachedFilePath.path, waitForLock);
+
+			/*
+			 * A concurrent cache operation is happening on the same file, so we have not removed
+			 * the file from the cache. We skip the file from the cache management in this iteration.
+			 */
+			if (status == FileCacheManager::CacheRemoveStatus::LOCK_NOT_ACQUIRED)
+			{
+				actions.push_back({
+					.url = GetURLForCacheFilePath(cacheDir, finalCacheFilePath),
+					.fileSize = 0,
+					.action = SKIPPED_CONCURRENT_MODIFY
+				});
+			}
+
+			continue;
+		}
+
+		if (!IsFinalizedCachePath(cachedFilePath.path))
+		{
+			/* unexpected file in cache; maybe warn, but probably just skip */
 			continue;
 		}
 
 		struct stat cachedFileStat;
 		if (stat(cachedFilePath.path.c_str(), &cachedFileStat) < 0)
 		{
-			/* file was concurrently removed? */
+			/* file was concurrently removed/finished caching? */
 			continue;
 		}
 
 		/* construct file metadata */
-		CacheItem cachedFile = {
+		scannedIndex[cachedFilePath.path] = {
 			.url = GetURLForCacheFilePath(cacheDir, cachedFilePath.path),
-			.cacheFilePath = cachedFilePath.path,
 			.fileSize = cachedFileStat.st_size,
 			.lastAccessTime = cachedFileStat.st_atime,
-			.isCandidate = false,
-			.needsDownload = false
+			.hitCount = 0,
+			.indexedTime = scanStartTime,
+			.isBlock = false
 		};
+	}
 
-		/* make a deep copy and push it onto the vector */
-		cacheFiles.push_back(cachedFile);
+	lock_guard<mutex> lock(cacheIndexLock);
+
+	if (cacheIndexDir == cacheDir)
+	{
+		/* keep the access statistics we gathered since the last scan */
+		for (auto& entry : scannedIndex)
+		{
+			auto it = cacheIndex.find(entry.first);
+			if (it == cacheIndex.end())
+				continue;
+
+			entry.second.hitCount = it->second.hitCount;
+			entry.second.lastAccessTime = MaxValue(entry.second.lastAccessTime,
+												   it->second.lastAccessTime);
+		}
+
+		/* keep files that were added while we were scanning */
+		for (auto& entry : cacheIndex)
+		{
+			if (entry.second.indexedTime >= scanStartTime)
+				scannedIndex.insert(entry);
+		}
 	}
 
-	return cacheFiles;
+	cacheIndex = std::move(scannedIndex);
+	cacheIndexDir = cacheDir;
+
+	cacheIndexSize = 0;
+
+	for (auto& entry : cacheIndex)
+		cacheIndexSize += entry.second.fileSize;
+
+	cacheIndexReconcileTime = scanStartTime;
+}
+
+
+/*
+ * RecordCachedFile adds a file or block that was just written to the cache
+ * directory to the cache index.
+ */
+void
+FileCacheManager::RecordCachedFile(const string &cacheFilePath, string url, int64_t fileSize, bool isBlock)
+{
+	lock_guard<mutex> lock(cacheIndexLock);
+
+	auto it = cacheIndex.find(cacheFilePath);
+	if (it != cacheIndex.end())
+		cacheIndexSize -= it->second.fileSize;
+
+	cacheIndexSize += fileSize;
+
+	CacheIndexEntry &entry = cacheIndex[cacheFilePath];
+
+	entry.url = url;
+	entry.fileSize = fileSize;
+	entry.lastAccessTime = time(NULL);
+	entry.indexedTime = entry.lastAccessTime;
+	entry.isBlock = isBlock;
+}
+
+
+/*
+ * RemoveFromCacheIndex removes a file or block that was removed from the
+ * cache directory from the cache index.
+ */
+void
+FileCacheManager::RemoveFromCacheIndex(const string &cacheFilePath)
+{
+	lock_guard<mutex> lock(cacheIndexLock);
+
+	auto it = cacheIndex.find(cacheFilePath);
+	if (it != cacheIndex.end())
+	{
+		cacheIndexSize -= it->second.fileSize;
+		cacheIndex.erase(it);
+	}
+
+	dirtyAccessPaths.erase(cacheFilePath);
+}
+
+
+/*
+ * TryReserveCacheSpace reserves space for a block that a reader is about to
+ * add to the cache, and returns false if the cache would grow beyond the
+ * maximum size of the last ManageCache call. The reservation counts as an
+ * in-flight download until ReleaseCacheSpace is called.
+ *
+ * Until ManageCache has run, the maximum size is unknown and blocks are
+ * always added.
+ */
+bool
+FileCacheManager::TryReserveCacheSpace(int64_t size)
+{
+	int64_t maxCacheSize = maxCacheSizeHint;
+
+	lock_guard<mutex> lock(cacheIndexLock);
+
+	if (maxCacheSize >= 0 && cacheIndexSize + inFlightDownloadSize + size > maxCacheSize)
+		return false;
+
+	inFlightDownloadSize += size;
+	return true;
+}
+
+
+/*
+ * ReleaseCacheSpace releases space reserved by TryReserveCacheSpace, after
+ * the block was recorded in the cache index or could not be written.
+ */
+void
+FileCacheManager::ReleaseCacheSpace(int64_t size)
+{
+	inFlightDownloadSize -= size;
+}
+
+
+/*
+ * RecordCacheAccess records that a cached file or block was read. The access
+ * time is only kept in memory until the next GetCacheIndexItems call, to
+ * avoid a file system write on every read.
+ */
+void
+FileCacheManager::RecordCacheAccess(string &cacheFilePath)
+{
+	/* frequently accessed files are protected from eviction by new candidates */
+	queue.RecordAccess(cacheFilePath);
+
+	{
+		lock_guard<mutex> lock(cacheIndexLock);
+
+		auto it = cacheIndex.find(cacheFilePath);
+		if (it != cacheIndex.end())
+		{
+			it->second.lastAccessTime = time(NULL);
+			it->second.hitCount++;
+			dirtyAccessPaths.insert(cacheFilePath);
+			return;
+		}
+	}
+
+	/* not indexed yet, the next scan picks up the access time */
+	UpdateAccessTime(cacheFilePath);
 }
 
 
@@ -870,12 +1701,22 @@ FileCacheManager::RemoveCacheFileActivityFromMapIfNeeded(const string& cacheFile
  */
 void
 FileCacheManager::UpdateAccessTime(string &filePath)
+{
+	SetAccessTime(filePath, time(NULL));
+}
+
+
+/*
+ * SetAccessTime sets the access and modification times of a file to the
+ * given time.
+ */
+void
+FileCacheManager::SetAccessTime(const string &filePath, time_t accessTime)
 {
 	struct utimbuf newTimes;
 
-	/* set access and modification times to current time */
-	newTimes.actime = time(NULL);
-	newTimes.modtime = time(NULL);
+	newTimes.actime = accessTime;
+	newTimes.modtime = accessTime;
 
 	/*
 	 * Update the access and modification times for the file. We
@@ -225,9 +225,71 @@ UncacheFileExec(ClientContext &context, TableFunctionInput &data_p, DataChunk &o
 	shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(context);
 	FileCacheManager::CacheRemoveStatus status =
 		cacheManager->RemoveCacheFile(context, functionData.url, waitForLock);
+	bool removedBlocks = cacheManager->RemoveCachedBlocks(context, functionData.url);
 
 	/* Set return values */
-	output.SetValue(0,0, Value(status == FileCacheManager::CacheRemoveStatus::FILE_EXISTS));
+	output.SetValue(0,0, Value(status == FileCacheManager::CacheRemoveStatus::FILE_EXISTS || removedBlocks));
+	output.SetCardinality(1);
+
+	functionData.finished = true;
+}
+
+
+/*
+ * PrefetchFilesFunctionData defines the custom state for pg_lake_prefetch_files.
+ */
+struct PrefetchFilesFunctionData : public TableFunctionData
+{
+	/* Function arguments */
+	vector<string> urls;
+	vector<int64_t> fileSizes;
+	int64_t maxCacheSize;
+
+	/* Function state */
+	bool finished = false;
+};
+
+/*
+ * PrefetchFilesBind implements the bind phase for pg_lake_prefetch_files.
+ */
+static unique_ptr<FunctionData>
+PrefetchFilesBind(ClientContext &context, TableFunctionBindInput &input, vector<LogicalType> &return_types, vector<string> &names)
+{
+	/* Get the arguments */
+	auto functionData = make_uniq<PrefetchFilesFunctionData>();
+
+	for (const Value &url : ListValue::GetChildren(input.inputs[0]))
+		functionData->urls.push_back(url.ToString());
+
+	for (const Value &fileSize : ListValue::GetChildren(input.inputs[1]))
+		functionData->fileSizes.push_back(fileSize.IsNull() ? 0 : fileSize.GetValue<int64_t>());
+
+	functionData->maxCacheSize = input.inputs[2].GetValue<int64_t>();
+
+	/* Set the return type */
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("scheduled");
+
+	return std::move(functionData);
+}
+
+/*
+ * PrefetchFilesExec implements the execution for pg_lake_prefetch_files.
+ */
+static void
+PrefetchFilesExec(ClientContext &context, TableFunctionInput &data_p, DataChunk &output)
+{
+	auto &functionData = (PrefetchFilesFunctionData &)*data_p.bind_data;
+	if (functionData.finished)
+		return;
+
+	/* Do the work, downloads happen in the background */
+	shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(context);
+	int64_t scheduled = cacheManager->PrefetchFiles(context, functionData.urls, functionData.fileSizes,
+													functionData.maxCacheSize);
+
+	/* Set return values */
+	output.SetValue(0,0, Value(scheduled));
 	output.SetCardinality(1);
 
 	functionData.finished = true;
@@ -265,9 +327,11 @@ static unique_ptr<FunctionData> ManageCacheBind(ClientContext &context,
 	return_types.emplace_back(LogicalType::VARCHAR);
 	return_types.emplace_back(LogicalType::BIGINT);
 	return_types.emplace_back(LogicalType::VARCHAR);
+	return_types.emplace_back(LogicalType::BIGINT);
 	names.emplace_back("url");
 	names.emplace_back("file_size");
 	names.emplace_back("action");
+	names.emplace_back("download_time_ms");
 
 	return std::move(functionData);
 }
@@ -306,8 +370,11 @@ static void ManageCacheExec(ClientContext &context, TableFunctionInput &data_p,
 			case REMOVED:
 				output.SetValue(2, rowInChunk, Value("removed"));
 				break;
-			case SKIPPED_TOO_OLD:
-				output.SetValue(2, rowInChunk, Value("skipped (newer files will be cached)"));
+			case BLOCK_REMOVED:
+				output.SetValue(2, rowInChunk, Value("removed block"));
+				break;
+			case SKIPPED_INFREQUENT:
+				output.SetValue(2, rowInChunk, Value("skipped (cached files are used more frequently)"));
 				break;
 			case SKIPPED_TOO_LARGE:
 				output.SetValue(2, rowInChunk, Value("skipped (larger than max cache size)"));
@@ -317,6 +384,8 @@ static void ManageCacheExec(ClientContext &context, TableFunctionInput &data_p,
 				break;
 		}
 
+		output.SetValue(3, rowInChunk, Value(action.downloadTimeMs));
+
 		rowInChunk++;
 		functionData.actionOffset++;
 	}
@@ -720,6 +789,20 @@ PgLakeFileSystemFunctions::RegisterFunctions(ExtensionLoader &loader)
 	    loader.RegisterFunction(pg_lake_manage_cache);
 	}
 
+	/* pg_lake_prefetch_files function definition */
+	{
+		TableFunctionSet pg_lake_prefetch_files("pg_lake_prefetch_files");
+
+		/* pg_lake_prefetch_files(urls varchar[], file_sizes bigint[], max_cache_size bigint) */
+		pg_lake_prefetch_files.AddFunction(
+			TableFunction({LogicalType::LIST(LogicalType::VARCHAR),
+						   LogicalType::LIST(LogicalType::BIGINT),
+						   LogicalTypeId::BIGINT},
+						  PrefetchFilesExec, PrefetchFilesBind));
+
+	    loader.RegisterFunction(pg_lake_prefetch_files);
+	}
+
 	/* pg_lake_list_cache function definition */
 	{
 		TableFunctionSet pg_lake_list_cache("pg_lake_list_cache");
@@ -826,6 +909,10 @@ PgLakeFileSystemFunctions::RegisterFunctions(ExtensionLoader &loader)
 	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
 	config.AddExtensionOption(CACHE_DIR_SETTING, "PgLake Cache Directory", LogicalType::VARCHAR);
 	config.AddExtensionOption(CACHE_ON_WRITE_MAX_SIZE, "PgLake cache-on-write max size", LogicalType::BIGINT);
+	config.AddExtensionOption(CACHE_BLOCK_SIZE_SETTING, "PgLake cache block size for large files", LogicalType::BIGINT);
+	config.AddExtensionOption(CACHE_BLOCK_MIN_FILE_SIZE_SETTING, "PgLake minimum size of files cached in blocks", LogicalType::BIGINT);
+	config.AddExtensionOption(CACHE_MAX_CONCURRENT_DOWNLOADS_SETTING, "PgLake maximum number of concurrent cache downloads", LogicalType::BIGINT);
+	config.AddExtensionOption(CACHE_MAX_CONCURRENT_PREFETCHES_SETTING, "PgLake maximum number of concurrent prefetch downloads", LogicalType::BIGINT);
 	config.AddExtensionOption(PG_LAKE_REGION_SETTING, "The region of the server", LogicalType::VARCHAR);
 	config.AddExtensionOption(MANAGED_STORAGE_BUCKET_SETTING, "PgLake managed storage bucket location", LogicalType::VARCHAR);
 	config.AddExtensionOption(MANAGED_STORAGE_KEY_ID_SETTING, "PgLake managed storage customer key ID", LogicalType::VARCHAR);
@@ -47,6 +47,12 @@ public:
 	unique_lock<mutex> cacheOnWriteFileLock;
 	int64_t cacheOnWriteWrittenBytes = 0;
 
+	/*
+	 * When a large remote file is read, we cache the blocks that are
+	 * read and serve later reads from those blocks when possible.
+	 */
+	shared_ptr<CachedFileBlocks> cachedBlocks;
+
 	/* client context to which this file handle belongs */
 	optional_ptr<ClientContext> context;
 
@@ -103,6 +109,9 @@ public:
 			LocalFileSystem localfs;
 			localfs.MoveFile(pg_lakeHandle.cacheOnWritePath + ".pgl-stage", pg_lakeHandle.cacheOnWritePath);
 
+			shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(*context);
+			cacheManager->RecordCachedFile(cacheOnWritePath, path, cacheOnWriteWrittenBytes, false);
+
 			cacheOnWriteHandle = nullptr;
 		}
 	 }
@@ -129,6 +138,14 @@ public:
 	/* Custom functions */
 	bool ShouldCacheOnWrite(CachingFSFileHandle &pg_lakeHandle, int64_t additionalByteCount);
 	void CleanUpCacheOnWriteFile(CachingFSFileHandle &pg_lakeHandle);
+	void ReadThroughBlockCache(CachingFSFileHandle &pg_lakeHandle, char *buffer,
+							   int64_t byteCount, int64_t location);
+	bool IsBlockCached(CachedFileBlocks &cachedBlocks, int64_t blockIndex);
+	bool ReadCachedBlock(CachingFSFileHandle &pg_lakeHandle, int64_t blockIndex, char *buffer,
+						 int64_t byteCount, int64_t location);
+	void FetchBlocks(CachingFSFileHandle &pg_lakeHandle, int64_t startBlockIndex, int64_t endBlockIndex,
+					 char *buffer, int64_t byteCount, int64_t location);
+	bool WriteCachedBlock(CachingFSFileHandle &pg_lakeHandle, int64_t blockIndex, char *blockData);
 
 	/* Custom overrides */
 	duckdb::unique_ptr<FileHandle> OpenFile(const string &path, FileOpenFlags openFlags,
@@ -150,6 +167,12 @@ public:
 		if (pg_lakeHandle.context->interrupted)
 			throw InterruptException();
 
+		if (pg_lakeHandle.cachedBlocks != nullptr)
+		{
+			ReadThroughBlockCache(pg_lakeHandle, (char *) buffer, byteCount, location);
+			return;
+		}
+
 		wrappedHandle.file_system.Read(wrappedHandle, buffer, byteCount, location);
 	}
 
@@ -161,6 +184,22 @@ public:
 		if (pg_lakeHandle.context->interrupted)
 			throw InterruptException();
 
+		if (pg_lakeHandle.cachedBlocks != nullptr)
+		{
+			/* read from the current position and move past the bytes read */
+			int64_t location = wrappedHandle.file_system.SeekPosition(wrappedHandle);
+			int64_t bytesRead = MinValue<int64_t>(byteCount,
+												  pg_lakeHandle.cachedBlocks->fileSize - location);
+
+			if (bytesRead <= 0)
+				return 0;
+
+			ReadThroughBlockCache(pg_lakeHandle, (char *) buffer, bytesRead, location);
+			wrappedHandle.file_system.Seek(wrappedHandle, location + bytesRead);
+
+			return bytesRead;
+		}
+
 		return wrappedHandle.file_system.Read(wrappedHandle, buffer, byteCount);
 	}
 
@@ -232,6 +271,10 @@ public:
 
 			localfs.MoveFile(pg_lakeHandle.cacheOnWritePath + ".pgl-stage", pg_lakeHandle.cacheOnWritePath);
 
+			shared_ptr<FileCacheManager> cacheManager = FileCacheManager::Get(*pg_lakeHandle.context);
+			cacheManager->RecordCachedFile(pg_lakeHandle.cacheOnWritePath, pg_lakeHandle.path,
+										   pg_lakeHandle.cacheOnWriteWrittenBytes, false);
+
 			pg_lakeHandle.cacheOnWriteHandle = nullptr;
 		}
 	}
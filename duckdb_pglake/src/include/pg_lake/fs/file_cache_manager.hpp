@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "duckdb.hpp"
 #include "duckdb/storage/object_cache.hpp"
 #include "pg_lake/utils/pgduck_log_utils.h"
@@ -25,6 +27,10 @@ namespace duckdb {
 
 extern const string CACHE_DIR_SETTING;
 extern const string CACHE_ON_WRITE_MAX_SIZE;
+extern const string CACHE_BLOCK_SIZE_SETTING;
+extern const string CACHE_BLOCK_MIN_FILE_SIZE_SETTING;
+extern const string CACHE_MAX_CONCURRENT_DOWNLOADS_SETTING;
+extern const string CACHE_MAX_CONCURRENT_PREFETCHES_SETTING;
 extern const string NO_CACHE_PREFIX;
 
 /*
@@ -41,6 +47,21 @@ extern const string NO_CACHE_PREFIX;
 */
 const string CACHE_FILE_PREFIX = "pgl-cache.";
 
+/*
+ * Files that are too large to cache as a whole are cached in aligned blocks
+ * as they are read. The blocks are stored as separate files in a directory
+ * next to where the whole file would be cached:
+ *
+ * s3/mybucket/pgl-blocks.data.parquet.<version>/pgl-block.0
+ * s3/mybucket/pgl-blocks.data.parquet.<version>/pgl-block.7
+ *
+ * The version is derived from the size and last modified time of the remote
+ * file and the block size, such that blocks of different versions of a file
+ * never mix.
+ */
+const string CACHE_BLOCKS_DIR_PREFIX = "pgl-blocks.";
+const string CACHE_BLOCK_PREFIX = "pgl-block.";
+
 
 /*
  * CacheItem represents a file in cache or the cache queue.
@@ -66,6 +87,12 @@ public:
 	/* whether the cache candidate needs to be downloaded */
 	bool needsDownload;
 
+	/* whether this is a single block of a file cached in blocks */
+	bool isBlock;
+
+	/* estimated access frequency, used to decide on admission */
+	uint32_t frequency;
+
 	/* item1 < item2 means item1 is older than item2 */
 	bool operator<(const CacheItem& other) const
 	{
@@ -91,7 +118,8 @@ enum CacheActionType
 	ADDED,
 	ADD_FAILED,
 	REMOVED,
-	SKIPPED_TOO_OLD,
+	BLOCK_REMOVED,
+	SKIPPED_INFREQUENT,
 	SKIPPED_TOO_LARGE,
 	SKIPPED_CONCURRENT_MODIFY
 };
@@ -110,11 +138,90 @@ public:
 
 	/* whether the file was cached or removed (or caching failed) */
 	CacheActionType action;
+
+	/* time spent downloading the file, for added files */
+	int64_t downloadTimeMs;
+};
+
+/*
+ * FrequencySketch estimates how often cache files are accessed using a
+ * count-min sketch of small counters. All counters are halved after a
+ * number of increments, such that the estimates favour recent popularity
+ * (as in TinyLFU).
+ */
+class FrequencySketch
+{
+public:
+	FrequencySketch() : counters(SKETCH_DEPTH * SKETCH_WIDTH, 0) {}
+
+	void Increment(const string &key)
+	{
+		size_t hash = std::hash<string>()(key);
+		bool incremented = false;
+
+		for (idx_t row = 0; row < SKETCH_DEPTH; row++)
+		{
+			uint8_t &counter = counters[row * SKETCH_WIDTH + GetColumn(hash, row)];
+
+			if (counter < MAX_COUNT)
+			{
+				counter++;
+				incremented = true;
+			}
+		}
+
+		if (incremented && ++incrementCount >= RESET_INCREMENT_COUNT)
+			Halve();
+	}
+
+	uint32_t Estimate(const string &key)
+	{
+		size_t hash = std::hash<string>()(key);
+		uint32_t estimate = MAX_COUNT;
+
+		for (idx_t row = 0; row < SKETCH_DEPTH; row++)
+			estimate = MinValue<uint32_t>(estimate, counters[row * SKETCH_WIDTH + GetColumn(hash, row)]);
+
+		return estimate;
+	}
+
+private:
+	static constexpr idx_t SKETCH_DEPTH = 4;
+	static constexpr idx_t SKETCH_WIDTH = 1 << 16;
+	static constexpr uint8_t MAX_COUNT = 15;
+	static constexpr idx_t RESET_INCREMENT_COUNT = 10 * SKETCH_WIDTH;
+
+	/* SKETCH_DEPTH rows of SKETCH_WIDTH counters */
+	vector<uint8_t> counters;
+
+	/* number of increments since the counters were last halved */
+	idx_t incrementCount = 0;
+
+	/* derive a column per row by mixing the hash with a per-row constant */
+	static idx_t GetColumn(size_t hash, idx_t row)
+	{
+		static constexpr uint64_t SEEDS[SKETCH_DEPTH] = {
+			0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL,
+			0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL
+		};
+
+		uint64_t mixed = (static_cast<uint64_t>(hash) + row) * SEEDS[row];
+
+		return (mixed ^ (mixed >> 32)) & (SKETCH_WIDTH - 1);
+	}
+
+	void Halve()
+	{
+		for (uint8_t &counter : counters)
+			counter >>= 1;
+
+		incrementCount /= 2;
+	}
 };
 
 /*
  * FileCacheQueue tracks a set of files that were recently accessed and therefore
- * should perhaps be cached.
+ * should perhaps be cached, as well as how frequently cache files are accessed.
  */
 class FileCacheQueue
 {
@@ -136,10 +243,35 @@ public:
 			entry.fileSize = fileSize;
 			entry.isCandidate = true;
 			entry.needsDownload = false;
+			entry.isBlock = false;
+			entry.frequency = 0;
 		}
 
 		/* always update last access time */
 		entry.lastAccessTime = time(NULL);
+
+		frequencySketch.Increment(cacheFilePath);
+	}
+
+	/*
+	 * RecordAccess reports that a cached file or block has been accessed.
+	 */
+	void RecordAccess(const string &cacheFilePath)
+	{
+		lock_guard<mutex> glock(lock);
+
+		frequencySketch.Increment(cacheFilePath);
+	}
+
+	/*
+	 * EstimateFrequency returns how often the given cache file was accessed
+	 * recently.
+	 */
+	uint32_t EstimateFrequency(const string &cacheFilePath)
+	{
+		lock_guard<mutex> glock(lock);
+
+		return frequencySketch.Estimate(cacheFilePath);
 	}
 
 	/*
@@ -161,9 +293,97 @@ public:
 private:
     unordered_map<string, CacheItem> queue;
 
+	FrequencySketch frequencySketch;
+
     mutex lock;
 };
 
+/*
+ * CachedFileBlocks tracks which blocks of a remote file are present in the
+ * cache, such that reads mostly do not need to check the file system.
+ *
+ * The bitmap is only a hint: blocks cached before a restart are found on
+ * disk, and blocks that are evicted concurrently are fetched again.
+ */
+class CachedFileBlocks
+{
+public:
+	/* directory that contains the block files */
+	string blocksDir;
+
+	/* size of the remote file */
+	int64_t fileSize;
+
+	/* size of all blocks, except possibly the last one */
+	int64_t blockSize;
+
+	CachedFileBlocks(string blocksDirP, int64_t fileSizeP, int64_t blockSizeP)
+		: blocksDir(blocksDirP), fileSize(fileSizeP), blockSize(blockSizeP)
+	{
+		int64_t blockCount = (fileSize + blockSize - 1) / blockSize;
+
+		presentBlocks.resize((blockCount + 63) / 64, 0);
+	}
+
+	string GetBlockPath(int64_t blockIndex)
+	{
+		return blocksDir + "/" + CACHE_BLOCK_PREFIX + to_string(blockIndex);
+	}
+
+	int64_t GetBlockLength(int64_t blockIndex)
+	{
+		return MinValue<int64_t>(blockSize, fileSize - blockIndex * blockSize);
+	}
+
+	bool IsBlockPresent(int64_t blockIndex)
+	{
+		lock_guard<mutex> glock(lock);
+
+		return (presentBlocks[blockIndex / 64] & (1ULL << (blockIndex % 64))) != 0;
+	}
+
+	void SetBlockPresent(int64_t blockIndex, bool present)
+	{
+		lock_guard<mutex> glock(lock);
+
+		if (present)
+			presentBlocks[blockIndex / 64] |= (1ULL << (blockIndex % 64));
+		else
+			presentBlocks[blockIndex / 64] &= ~(1ULL << (blockIndex % 64));
+	}
+
+private:
+	/* one bit per block, set if the block is known to be cached */
+	vector<uint64_t> presentBlocks;
+
+	mutex lock;
+};
+
+/*
+ * CacheIndexEntry describes a file or block in the cache directory.
+ */
+struct CacheIndexEntry
+{
+public:
+	/* URL of the file */
+	string url;
+
+	/* size of the file or block in the cache */
+	int64_t fileSize;
+
+	/* last access time, written to the file system lazily */
+	time_t lastAccessTime;
+
+	/* number of reads since the entry was indexed */
+	int64_t hitCount;
+
+	/* time at which the entry was added to the index */
+	time_t indexedTime;
+
+	/* whether this is a single block of a file cached in blocks */
+	bool isBlock;
+};
+
 class FileCacheActivity {
 
 private:
@@ -224,12 +444,29 @@ public:
 	CacheRemoveStatus RemoveCacheFileInternal(FileSystem& file_system, string filePath, string finalCacheFilePath, bool waitForLock);
 	vector<CacheAction> ManageCache(ClientContext &context, int64_t maxCacheSize);
 	vector<CacheItem> ListCache(ClientContext &context);
+	int64_t PrefetchFiles(ClientContext &context, vector<string> &urls, vector<int64_t> &fileSizes,
+						  int64_t maxCacheSize);
 	void ErrorIfPathHasGlob(ClientContext &context, string url);
 	string GetURLForCacheFilePath(string &cacheDir, const string &cacheFilePath);
 	CacheLockStatus GetCacheStatusWithLock(string cacheFilePath, bool waitForLock);
 	void RemoveCacheFileActivityFromMapIfNeeded(const string& cacheFilePath);
 
+	bool UseBlockCache(optional_ptr<FileOpener> opener, int64_t fileSize, int64_t &blockSize);
+	bool TryGetCacheBlocksDir(string cacheFilePath, int64_t fileSize, timestamp_t lastModified,
+							  int64_t blockSize, string &blocksDir);
+	shared_ptr<CachedFileBlocks> GetCachedFileBlocks(string blocksDir, int64_t fileSize, int64_t blockSize);
+	bool RemoveCachedBlocks(ClientContext &context, string url);
+	void RemoveCacheBlock(FileSystem &file_system, const string &blockFilePath);
+	string GetURLForCacheBlockPath(string &cacheDir, const string &blockFilePath);
+
+	void RecordCachedFile(const string &cacheFilePath, string url, int64_t fileSize, bool isBlock);
+	bool TryReserveCacheSpace(int64_t size);
+	void ReleaseCacheSpace(int64_t size);
+	void RecordCacheAccess(string &cacheFilePath);
+	vector<CacheItem> GetCacheIndexItems(ClientContext &context, string &cacheDir, vector<CacheAction> &actions);
+
 	static void UpdateAccessTime(string &filePath);
+	static void SetAccessTime(const string &filePath, time_t accessTime);
 
 	/* required ObjectCacheEntry functions */
 	static string ObjectType() {
@@ -253,8 +490,9 @@ private:
 	mutex cacheActivityMapAccessLock;
 
 	/*
-	* Our current concurrency model is prevent concurrent ManageCache operations.
-	* This mutex is used to enforce that.
+	* Our current concurrency model is prevent concurrent ManageCache operations
+	* from making eviction decisions at the same time. This mutex is used to
+	* enforce that. Downloads happen after releasing it.
 	*
 	* But not that we allow multiple CacheFile and UncacheFile operations to run
 	* concurrently with each other and with ManageCache. Note that operations
@@ -266,10 +504,66 @@ private:
 	*/
 	mutex manageCacheLock;
 
+	/* total size of files being downloaded by ManageCache and prefetch calls */
+	std::atomic<int64_t> inFlightDownloadSize{0};
+
+	/* maximum size of the cache in the last ManageCache call, -1 if unknown */
+	std::atomic<int64_t> maxCacheSizeHint{-1};
+
+	/*
+	 * Index of the files and blocks in the cache directory by cache file
+	 * path, such that ManageCache and ListCache do not need to walk the
+	 * directory every time.
+	 */
+	unordered_map<string, CacheIndexEntry> cacheIndex;
+
+	/* total size of the files and blocks in the cache index */
+	int64_t cacheIndexSize = 0;
+
+	/* paths of entries whose access time is not yet written to disk */
+	unordered_set<string> dirtyAccessPaths;
+
+	/* cache directory from which the index was loaded */
+	string cacheIndexDir;
+
+	/* time of the last walk over the cache directory */
+	time_t cacheIndexReconcileTime = 0;
+
+	/* any access to the cache index should be protected by this */
+	mutex cacheIndexLock;
+
+	/* prevents concurrent walks over the cache directory */
+	mutex cacheIndexReconcileLock;
+
+	/* files that scans are about to read, waiting to be downloaded */
+	std::deque<CacheItem> prefetchQueue;
+
+	/* URLs that are queued or being downloaded by prefetch threads */
+	unordered_set<string> prefetchURLs;
+
+	/* number of running prefetch threads */
+	int64_t prefetchThreadCount = 0;
+
+	/* any access to the prefetch state should be protected by this */
+	mutex prefetchLock;
+
+	/* bitmaps of cached blocks by blocks directory */
+	unordered_map<string, shared_ptr<CachedFileBlocks>> cachedBlocksMap;
+
+	/* any access to the cachedBlocksMap should be protected by this */
+	mutex cachedBlocksMapLock;
+
 	shared_ptr<FileCacheActivity> GetFileCacheActivity(const string& path);
 	unique_lock<mutex> TryAcquireCachePathLock(const string& path, bool waitForLock, bool &acquired);
 
 	int64_t CacheFileInternal(ClientContext &context, string url, bool force);
+	void EvictCacheItem(ClientContext &context, CacheItem &cacheFile, int64_t &totalCacheSize,
+						vector<CacheAction> &actions);
+	void ReconcileCacheIndex(ClientContext &context, string &cacheDir, vector<CacheAction> &actions);
+	void RemoveFromCacheIndex(const string &cacheFilePath);
+	void DownloadCacheFiles(ClientContext &context, vector<CacheItem> &downloads, vector<CacheAction> &actions);
+	CacheAction DownloadCacheFile(ClientContext &context, const CacheItem &cacheFile);
+	void PrefetchWorker(DatabaseInstance &db);
 };
 
 } // namespace duckdb
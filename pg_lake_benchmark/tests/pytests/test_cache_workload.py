@@ -0,0 +1,91 @@
+import pytest
+from utils_pytest import *
+
+hot_file_count = 4
+cold_file_count = 12
+round_count = 10
+
+
+def create_files(pgduck_conn, prefix, file_count):
+    urls = []
+
+    for i in range(file_count):
+        url = f"s3://{TEST_BUCKET}/test_cache_workload/{prefix}_{i}.csv"
+
+        # Generate a ~150KB file
+        run_command(
+            f"""
+            COPY (SELECT s, 'hello-'||s as h FROM generate_series(1,10000) as g(s))
+            TO '{url}';
+        """,
+            pgduck_conn,
+        )
+        urls.append(url)
+
+    return urls
+
+
+def file_size(pgduck_conn, url):
+    results = run_query(f"SELECT pg_lake_file_size('{url}')", pgduck_conn)
+    return int(results[0][0])
+
+
+def read_files(pgduck_conn, urls):
+    """
+    Read the given files and return the number of them that were cached
+    at the time of the read.
+    """
+    results = run_query("SELECT url FROM pg_lake_list_cache()", pgduck_conn)
+    cached_urls = set(result[0] for result in results)
+
+    for url in urls:
+        run_query(f"SELECT count(*) FROM '{url}'", pgduck_conn)
+
+    return len([url for url in urls if url in cached_urls])
+
+
+def test_cache_workload_mixed_hot_cold(s3, pgduck_conn):
+    """
+    Measure the cache hit rate of a small set of frequently read files, while
+    larger scans over files that are read only once pass through the cache.
+    """
+    hot_urls = create_files(pgduck_conn, "hot", hot_file_count)
+    cold_urls = create_files(pgduck_conn, "cold", cold_file_count)
+
+    # Start from an empty cache
+    run_command("CALL pg_lake_manage_cache(0)", pgduck_conn)
+
+    # Enough for the hot files, but not for the cold ones
+    cache_size = sum(file_size(pgduck_conn, url) for url in hot_urls) * 3 // 2
+
+    # Warm up the cache with the hot files
+    for _ in range(3):
+        read_files(pgduck_conn, hot_urls)
+    run_command(f"CALL pg_lake_manage_cache({cache_size})", pgduck_conn)
+
+    hot_hits = 0
+    cold_hits = 0
+
+    for round_nr in range(round_count):
+        hot_hits += read_files(pgduck_conn, hot_urls)
+
+        # Every other round, scan all cold files once
+        if round_nr % 2 == 0:
+            cold_hits += read_files(pgduck_conn, cold_urls)
+
+        run_command(f"CALL pg_lake_manage_cache({cache_size})", pgduck_conn)
+
+    hot_hit_rate = hot_hits / (hot_file_count * round_count)
+    total_hit_rate = (hot_hits + cold_hits) / (
+        hot_file_count * round_count + cold_file_count * ((round_count + 1) // 2)
+    )
+
+    print(f"hot hit rate: {hot_hit_rate:.2f}, overall hit rate: {total_hit_rate:.2f}")
+
+    # Scans over cold files should not flush the hot files out of the cache
+    assert hot_hit_rate == 1.0
+
+    # Wipe the cache
+    run_command("CALL pg_lake_manage_cache(0)", pgduck_conn)
+
+    pgduck_conn.rollback()
@@ -1,3 +1,4 @@
+import time
 import pytest
 from utils_pytest import *
 from decimal import Decimal
@@ -84,6 +85,46 @@ def test_tpch_pushdown(pg_conn, s3, pg_lake_benchmark_extension, with_default_lo
     pg_conn.rollback()
 
 
+@pytest.mark.parametrize("fetch_batch_size", [1, 1000])
+def test_tpch_fetch_batch_size(
+    pg_conn, s3, pg_lake_benchmark_extension, with_default_location, fetch_batch_size
+):
+    """
+    Measure the TPC-H queries, and a scan that returns all of lineitem, with
+    rows fetched one at a time and in chunked rows mode.
+    """
+    location = f"s3://{TEST_BUCKET}/tpch"
+    run_command(
+        f"""select lake_tpch.gen(location => '{location}',
+                                table_type => 'pg_lake_iceberg',
+                                scale_factor => 0.01)""",
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    queries = run_query("select query_nr, query from lake_tpch.queries()", pg_conn)
+    queries.append([0, "select * from lineitem"])
+
+    run_command(f"SET pg_lake_engine.fetch_batch_size TO {fetch_batch_size}", pg_conn)
+
+    total_time = 0
+
+    for query_nr, query in queries:
+        start_time = time.perf_counter()
+        run_query(query, pg_conn)
+        query_time = time.perf_counter() - start_time
+        total_time += query_time
+
+        print(
+            f"fetch_batch_size {fetch_batch_size}, query {query_nr}: {query_time:.3f}s"
+        )
+
+    print(f"fetch_batch_size {fetch_batch_size}, total: {total_time:.3f}s")
+
+    run_command("RESET pg_lake_engine.fetch_batch_size", pg_conn)
+    pg_conn.rollback()
+
+
 def test_tpch_answers(
     pg_conn, pgduck_conn, s3, pg_lake_benchmark_extension, with_default_location
 ):
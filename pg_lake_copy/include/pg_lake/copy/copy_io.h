@@ -18,9 +18,53 @@
 #ifndef PG_LAKE_COPY_IO_H
 #define PG_LAKE_COPY_IO_H
 
+#include "pg_lake/pgduck/client.h"
+
+struct CopyFromStdinState;
+
+/*
+ * CopyPipe is a named pipe through which pgduck_server reads the input of
+ * a COPY .. FROM STDIN, or writes the output of a COPY .. TO STDOUT, while
+ * we exchange the data with the client.
+ */
+typedef struct CopyPipe
+{
+	/* path of the named pipe, removed at the end of the transaction */
+	char	   *path;
+
+	/* our end of the pipe */
+	int			fd;
+
+	/*
+	 * The other end of the pipe, which we keep open until pgduck_server is
+	 * done with the pipe, such that we do not see EOF (or get EPIPE) before
+	 * pgduck_server opens it.
+	 */
+	int			placeholderFd;
+
+	/* state of the COPY .. FROM STDIN protocol, or NULL */
+	struct CopyFromStdinState *clientState;
+
+	/* data received from the client that is not yet written to the pipe */
+	char	   *pendingData;
+	int			pendingOffset;
+	int			pendingLength;
+
+	/* whether we wrote all client data to the pipe */
+	bool		inputComplete;
+}			CopyPipe;
+
 
 void		CopyInputToFile(char *filePath, int columnCount, bool isBinary);
 void		CopyFileToOutput(char *filePath, int columnCount, bool isBinary);
+CopyPipe   *CreateCopyInputPipe(void);
+CopyPipe   *CreateCopyOutputPipe(void);
+void		BeginCopyInputToPipe(CopyPipe * copyPipe, int columnCount, bool isBinary);
+bool		PumpCopyInputToPipe(CopyPipe * copyPipe, PGDuckConnection * pgDuckConn);
+void		CopyInputToPipe(CopyPipe * copyPipe, PGDuckConnection * pgDuckConn);
+void		CopyPipeToOutput(CopyPipe * copyPipe, PGDuckConnection * pgDuckConn,
+							 int columnCount, bool isBinary);
+void		CloseCopyPipe(CopyPipe * copyPipe);
 
 
 #endif
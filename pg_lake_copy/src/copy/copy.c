@@ -137,6 +137,7 @@ PG_FUNCTION_INFO_V1(pg_lake_last_copy_pushed_down_test);
 /* settings */
 bool		EnablePgLakeCopy = true;
 bool		EnablePgLakeCopyJson = true;
+bool		EnablePgLakeCopyStdioStreaming = true;
 
 /*
  * For COPY .. FROM, we convert incoming tuples into CSV format via a callback.
@@ -148,6 +149,9 @@ bool		EnablePgLakeCopyJson = true;
 static PGDuckConnection * CurrentCopyFromConnection = NULL;
 static StringInfoData CopyFromBuffer;
 
+/* pipe from which pgduck_server reads the input of COPY .. FROM STDIN */
+static CopyPipe * CurrentCopyFromPipe = NULL;
+
 
 /*
  * LastCopyPushedDownTest is used purely for tests do detect whether a COPY command
@@ -443,23 +447,43 @@ ProcessPgLakeCopyFrom(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	 */
 	TupleDesc	tupleDesc = BuildTupleDescriptorForRelation(relation, copyStmt->attlist);
 
-	if (IsCopyFromStdin(copyStmt))
-	{
-		sourcePath = GenerateTempFileName(TEMP_FILE_PATTERN, ensureCleanup);
+	/*
+	 * we send the expected column count to make pedantic clients happy
+	 */
+	int			columnCount = tupleDesc->natts;
 
-		/*
-		 * we send the expected column count to make pedantic clients happy
-		 */
-		int			columnCount = tupleDesc->natts;
+	bool		isBinary = true;
 
-		bool		isBinary = true;
+	/*
+	 * When pgduck_server reads the input from a pipe, we feed the pipe with
+	 * incoming bytes while the query runs. Otherwise, the input is in a
+	 * temporary file.
+	 */
+	CopyPipe   *inputPipe = NULL;
 
+	if (IsCopyFromStdin(copyStmt))
+	{
 		/*
-		 * We copy the incoming bytes to a file first and then try to convert
-		 * that file. We could perhaps optimize this in the future by copying
-		 * via a named pipe.
+		 * DuckDB reads CSV and JSON sequentially, which means it can read
+		 * them from a named pipe while the client sends the data. Other
+		 * formats need random access.
 		 */
-		CopyInputToFile(sourcePath, columnCount, isBinary);
+		if (EnablePgLakeCopyStdioStreaming &&
+			(sourceFormat == DATA_FORMAT_CSV || sourceFormat == DATA_FORMAT_JSON))
+		{
+			inputPipe = CreateCopyInputPipe();
+			sourcePath = inputPipe->path;
+		}
+		else
+		{
+			sourcePath = GenerateTempFileName(TEMP_FILE_PATTERN, ensureCleanup);
+
+			/*
+			 * We copy the incoming bytes to a file first and then try to
+			 * convert that file.
+			 */
+			CopyInputToFile(sourcePath, columnCount, isBinary);
+		}
 	}
 
 	/*
@@ -529,7 +553,23 @@ ProcessPgLakeCopyFrom(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	 */
 	if (doCopyPushdown)
 	{
-		*rowsProcessed = AddQueryResultToTable(relationId, readQuery, tupleDesc);
+		if (inputPipe != NULL)
+		{
+			PendingQueryResultInsertion *insertion =
+				StartAddQueryResultToTable(relationId, readQuery, tupleDesc);
+
+			BeginCopyInputToPipe(inputPipe, columnCount, isBinary);
+			CopyInputToPipe(inputPipe, insertion->write->connection);
+
+			*rowsProcessed = FinishAddQueryResultToTable(insertion);
+
+			CloseCopyPipe(inputPipe);
+		}
+		else
+		{
+			*rowsProcessed = AddQueryResultToTable(relationId, readQuery, tupleDesc);
+		}
+
 		return;
 	}
 
@@ -541,6 +581,13 @@ ProcessPgLakeCopyFrom(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	/* start the transmit command */
 	SendQueryToPGDuck(pgDuckConn, readQuery);
 
+	if (inputPipe != NULL)
+	{
+		/* DuckDB may need to read input before the transmit can start */
+		BeginCopyInputToPipe(inputPipe, columnCount, isBinary);
+		CopyInputToPipe(inputPipe, pgDuckConn);
+	}
+
 	/* check the initial result */
 	PGresult   *result = PQgetResult(pgDuckConn->conn);
 
@@ -564,6 +611,7 @@ ProcessPgLakeCopyFrom(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	 * might trigger a reconnect, causing lots of confusion.
 	 */
 	CurrentCopyFromConnection = pgDuckConn;
+	CurrentCopyFromPipe = inputPipe;
 
 	/*
 	 * Some compilers get confused by using writeOptions after PG_TRY, even
@@ -594,8 +642,12 @@ ProcessPgLakeCopyFrom(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	{
 		ReleasePGDuckConnection(pgDuckConn);
 		CurrentCopyFromConnection = NULL;
+		CurrentCopyFromPipe = NULL;
 	}
 	PG_END_TRY();
+
+	if (inputPipe != NULL)
+		CloseCopyPipe(inputPipe);
 }
 
 
@@ -886,8 +938,26 @@ ProcessPgLakeCopyTo(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	int			maximumLineLength = GetCSVDestReceiverMaxLineSize(dest);
 
 	char	   *destinationPath = copyStmt->filename;
+	List	   *writeOptions = copyStmt->options;
+	CopyPipe   *outputPipe = NULL;
 
-	if (IsCopyToStdout(copyStmt))
+	if (IsCopyToStdout(copyStmt) && EnablePgLakeCopyStdioStreaming)
+	{
+		/*
+		 * In case of COPY .. TO STDOUT, pgduck_server writes into a named
+		 * pipe and we send the data to the client while it is being written.
+		 * DuckDB would otherwise write to a temporary file, since the pipe
+		 * already exists.
+		 */
+		outputPipe = CreateCopyOutputPipe();
+		destinationPath = outputPipe->path;
+
+		DefElem    *useTmpFileOption =
+			makeDefElem("use_tmp_file", (Node *) makeBoolean(false), -1);
+
+		writeOptions = lappend(list_copy(writeOptions), useTmpFileOption);
+	}
+	else if (IsCopyToStdout(copyStmt))
 	{
 		/*
 		 * In case of COPY .. TO STDOUT, we first write to another temporary
@@ -913,12 +983,30 @@ ProcessPgLakeCopyTo(CopyStmt *copyStmt, ParseState *pstate, Relation relation,
 	/* we do not write Parquet field IDs for regular COPY TO */
 	DataFileSchema *schema = NULL;
 
+	if (outputPipe != NULL)
+	{
+		/*
+		 * Convert the CSV file into the pipe, and send the output to the
+		 * client as it is written.
+		 */
+		PendingWrite *write =
+			StartConvertCSVFileTo(tempCSVPath, tupleDesc, maximumLineLength,
+								  destinationPath, destinationFormat,
+								  destinationCompression, writeOptions, schema);
+
+		CopyPipeToOutput(outputPipe, write->connection, tupleDesc->natts, true);
+		FinishPendingWrite(write);
+		CloseCopyPipe(outputPipe);
+
+		return;
+	}
+
 	/*
 	 * Copy the CSV file to the destination path in the desired format.
 	 */
 	ConvertCSVFileTo(tempCSVPath, tupleDesc, maximumLineLength,
 					 destinationPath, destinationFormat, destinationCompression,
-					 copyStmt->options, schema);
+					 writeOptions, schema);
 
 	if (IsCopyToStdout(copyStmt))
 	{
@@ -1485,16 +1573,28 @@ CopyReceivedTransmitDataToBuffer(void *outbuf, int minread, int maxread)
 /*
  * ReceiveCopyData receives bytes via CopyData messages and writes
  * them to the buffer.
+ *
+ * When pgduck_server reads the input of the COPY from a pipe, we keep
+ * feeding the pipe until data arrives.
  */
 static bool
 ReceiveCopyData(PGDuckConnection * pgDuckConnection, StringInfo buffer)
 {
 	PGconn	   *conn = pgDuckConnection->conn;
-	int			async = 0;
+	int			async = CurrentCopyFromPipe != NULL && !CurrentCopyFromPipe->inputComplete;
 	char	   *copyBuffer = NULL;
 
 	int			bytesReceived = PQgetCopyData(conn, &copyBuffer, async);
 
+	while (bytesReceived == 0)
+	{
+		/* wait in blocking mode once all input is in the pipe */
+		if (!PumpCopyInputToPipe(CurrentCopyFromPipe, pgDuckConnection))
+			async = 0;
+
+		bytesReceived = PQgetCopyData(conn, &copyBuffer, async);
+	}
+
 	if (bytesReceived < 0)
 	{
 		/* COPY requires one additional PQgetResult at the end */
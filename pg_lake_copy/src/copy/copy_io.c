@@ -23,17 +23,27 @@
  */
 #include "postgres.h"
 #include "miscadmin.h"
+#include "libpq-fe.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "pg_lake/copy/copy_io.h"
+#include "pg_lake/storage/local_storage.h"
 #include "lib/stringinfo.h"
 #include "libpq/pqformat.h"
 #include "storage/fd.h"
+#include "storage/latch.h"
 #include "utils/memutils.h"
+#include "utils/resowner.h"
+#include "utils/wait_event.h"
 
 #include "libpq/libpq.h"
 
 #define MAX_READ_SIZE (65536)
 
+#define PIPE_FILE_PATTERN "pg_lake_copy_pipe"
+
 /*
  * CopyFromStdinState is a simplified version of CopyFromState
  * in PostgreSQL to use in ReceiveDataFromClient with names
@@ -53,6 +63,9 @@ static int	ReceiveDataFromClient(CopyFromStdinState * cstate, char *databuf);
 static void SendCopyBegin(int columnCount, bool isBinary);
 static void SendCopyEnd(void);
 static void SendCopyData(char *sendBuffer, int sendBufferLength);
+static CopyPipe * CreateCopyPipe(int ourFlags, int placeholderFlags);
+static void WaitForPipeOrConnection(CopyPipe * copyPipe, uint32 pipeEvents,
+									PGDuckConnection * pgDuckConn);
 
 
 /*
@@ -345,3 +358,288 @@ SendCopyData(char *sendBuffer, int sendBufferLength)
 	pq_sendbytes(&buf, sendBuffer, sendBufferLength);
 	pq_endmessage(&buf);
 }
+
+
+/*
+ * CreateCopyInputPipe creates a named pipe from which pgduck_server can read
+ * the input of a COPY .. FROM STDIN while the client sends it.
+ *
+ * Only formats that DuckDB reads sequentially (CSV, JSON) can be read from
+ * a pipe.
+ */
+CopyPipe *
+CreateCopyInputPipe(void)
+{
+	/* open the read end first, otherwise opening the write end fails */
+	CopyPipe   *copyPipe = CreateCopyPipe(O_WRONLY, O_RDONLY);
+
+	copyPipe->clientState = palloc0(sizeof(CopyFromStdinState));
+	copyPipe->clientState->fe_msgbuf = makeStringInfo();
+	copyPipe->pendingData = palloc(MAX_READ_SIZE);
+
+	return copyPipe;
+}
+
+
+/*
+ * CreateCopyOutputPipe creates a named pipe into which pgduck_server can
+ * write the output of a COPY .. TO STDOUT, which we send to the client while
+ * it is being written.
+ */
+CopyPipe *
+CreateCopyOutputPipe(void)
+{
+	return CreateCopyPipe(O_RDONLY, O_WRONLY);
+}
+
+
+/*
+ * CreateCopyPipe creates a named pipe in the temporary directory and opens
+ * both ends in non-blocking mode. We open the placeholder end first when it
+ * is the read end, since opening the write end fails when there are no
+ * readers.
+ */
+static CopyPipe *
+CreateCopyPipe(int ourFlags, int placeholderFlags)
+{
+	bool		ensureCleanup = true;
+	CopyPipe   *copyPipe = palloc0(sizeof(CopyPipe));
+
+	copyPipe->path = GenerateTempFileName(PIPE_FILE_PATTERN, ensureCleanup);
+
+	if (mkfifo(copyPipe->path, S_IRUSR | S_IWUSR) < 0)
+		ereport(ERROR, (errcode_for_file_access(),
+						errmsg("could not create pipe \"%s\": %m", copyPipe->path)));
+
+	if (placeholderFlags == O_RDONLY)
+	{
+		copyPipe->placeholderFd = OpenTransientFile(copyPipe->path,
+													placeholderFlags | O_NONBLOCK);
+		copyPipe->fd = OpenTransientFile(copyPipe->path, ourFlags | O_NONBLOCK);
+	}
+	else
+	{
+		copyPipe->fd = OpenTransientFile(copyPipe->path, ourFlags | O_NONBLOCK);
+		copyPipe->placeholderFd = OpenTransientFile(copyPipe->path,
+													placeholderFlags | O_NONBLOCK);
+	}
+
+	if (copyPipe->fd < 0 || copyPipe->placeholderFd < 0)
+		ereport(ERROR, (errcode_for_file_access(),
+						errmsg("could not open pipe \"%s\": %m", copyPipe->path)));
+
+	return copyPipe;
+}
+
+
+/*
+ * BeginCopyInputToPipe tells the client we are ready for data.
+ */
+void
+BeginCopyInputToPipe(CopyPipe * copyPipe, int columnCount, bool isBinary)
+{
+	SendCopyInResponseToClient(columnCount, isBinary);
+}
+
+
+/*
+ * PumpCopyInputToPipe moves client data into the pipe until the pipe is
+ * full, in which case we wait until pgduck_server reads from the pipe or
+ * sends data on the given connection. Received data is consumed, such that
+ * the caller can check the connection afterwards without blocking.
+ *
+ * Returns false when all client data was written to the pipe, after
+ * closing our end of the pipe to signal EOF to pgduck_server.
+ */
+bool
+PumpCopyInputToPipe(CopyPipe * copyPipe, PGDuckConnection * pgDuckConn)
+{
+	if (copyPipe->inputComplete)
+		return false;
+
+	while (true)
+	{
+		if (copyPipe->pendingOffset >= copyPipe->pendingLength)
+		{
+			/* get the next batch of data from the client */
+			copyPipe->pendingOffset = 0;
+			copyPipe->pendingLength =
+				ReceiveDataFromClient(copyPipe->clientState, copyPipe->pendingData);
+
+			if (copyPipe->pendingLength == 0)
+			{
+				/* pgduck_server sees EOF once we close the only write end */
+				CloseTransientFile(copyPipe->fd);
+				copyPipe->fd = -1;
+				copyPipe->inputComplete = true;
+
+				return false;
+			}
+		}
+
+		ssize_t		bytesWritten = write(copyPipe->fd,
+										 copyPipe->pendingData + copyPipe->pendingOffset,
+										 copyPipe->pendingLength - copyPipe->pendingOffset);
+
+		if (bytesWritten > 0)
+		{
+			copyPipe->pendingOffset += bytesWritten;
+			continue;
+		}
+
+		if (errno == EINTR)
+			continue;
+
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			ereport(ERROR, (errcode_for_file_access(),
+							errmsg("could not write to pipe \"%s\": %m",
+								   copyPipe->path)));
+
+		/* pipe is full */
+		WaitForPipeOrConnection(copyPipe, WL_SOCKET_WRITEABLE, pgDuckConn);
+
+		return true;
+	}
+}
+
+
+/*
+ * CopyInputToPipe moves client data into the pipe until all data is written
+ * or pgduck_server returns a result on the given connection (e.g. an error,
+ * or the start of a COPY .. TO STDOUT).
+ */
+void
+CopyInputToPipe(CopyPipe * copyPipe, PGDuckConnection * pgDuckConn)
+{
+	while (PQisBusy(pgDuckConn->conn) && PumpCopyInputToPipe(copyPipe, pgDuckConn))
+		;
+}
+
+
+/*
+ * CopyPipeToOutput sends the data that pgduck_server writes into the pipe to
+ * the client as part of a COPY .. TO STDOUT, until the command on the
+ * given connection completes. The caller should check the result of the
+ * command afterwards.
+ */
+void
+CopyPipeToOutput(CopyPipe * copyPipe, PGDuckConnection * pgDuckConn,
+				 int columnCount, bool isBinary)
+{
+	SendCopyBegin(columnCount, isBinary);
+
+	/* allocate on the heap since it's quite big */
+	char	   *sendBuffer = palloc(MAX_READ_SIZE);
+
+	while (true)
+	{
+		ssize_t		bytesRead = read(copyPipe->fd, sendBuffer, MAX_READ_SIZE);
+
+		if (bytesRead > 0)
+		{
+			SendCopyData(sendBuffer, bytesRead);
+			continue;
+		}
+
+		/* all write ends are closed */
+		if (bytesRead == 0)
+			break;
+
+		if (errno == EINTR)
+			continue;
+
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			ereport(ERROR, (errcode_for_file_access(),
+							errmsg("could not read from pipe \"%s\": %m",
+								   copyPipe->path)));
+
+		/*
+		 * Once the command is done, pgduck_server wrote everything it is
+		 * going to write, so an empty pipe means we are done.
+		 */
+		if (copyPipe->placeholderFd < 0)
+			break;
+
+		if (!PQisBusy(pgDuckConn->conn))
+		{
+			/* read the remaining data until EOF */
+			CloseTransientFile(copyPipe->placeholderFd);
+			copyPipe->placeholderFd = -1;
+			continue;
+		}
+
+		/* pipe is empty */
+		WaitForPipeOrConnection(copyPipe, WL_SOCKET_READABLE, pgDuckConn);
+	}
+
+	SendCopyEnd();
+
+	pfree(sendBuffer);
+}
+
+
+/*
+ * WaitForPipeOrConnection waits until the pipe is ready for the given events
+ * or pgduck_server sends data on the connection, in which case we consume it.
+ */
+static void
+WaitForPipeOrConnection(CopyPipe * copyPipe, uint32 pipeEvents,
+						PGDuckConnection * pgDuckConn)
+{
+	PGconn	   *conn = pgDuckConn->conn;
+	WaitEvent	occurredEvents[4];
+
+#if PG_VERSION_NUM >= 170000
+	WaitEventSet *waitSet = CreateWaitEventSet(CurrentResourceOwner, 4);
+#else
+	WaitEventSet *waitSet = CreateWaitEventSet(CurrentMemoryContext, 4);
+#endif
+
+	AddWaitEventToSet(waitSet, WL_LATCH_SET, PGINVALID_SOCKET, MyLatch, NULL);
+	AddWaitEventToSet(waitSet, WL_EXIT_ON_PM_DEATH, PGINVALID_SOCKET, NULL, NULL);
+	AddWaitEventToSet(waitSet, pipeEvents, copyPipe->fd, NULL, NULL);
+	AddWaitEventToSet(waitSet, WL_SOCKET_READABLE, PQsocket(conn), NULL, NULL);
+
+	int			eventCount = WaitEventSetWait(waitSet, -1L, occurredEvents,
+											  lengthof(occurredEvents),
+											  PG_WAIT_EXTENSION);
+
+	FreeWaitEventSet(waitSet);
+	ResetLatch(MyLatch);
+
+	CHECK_FOR_INTERRUPTS();
+
+	for (int eventIndex = 0; eventIndex < eventCount; eventIndex++)
+	{
+		WaitEvent  *event = &occurredEvents[eventIndex];
+
+		/* data available in socket? */
+		if ((event->events & WL_SOCKET_READABLE) && event->fd == PQsocket(conn))
+		{
+			if (!PQconsumeInput(conn))
+			{
+				/* the owner of the connection releases it */
+				pgDuckConn->discardOnRelease = true;
+				ereport(ERROR, (errmsg("lost connection to query engine")));
+			}
+		}
+	}
+}
+
+
+/*
+ * CloseCopyPipe closes our ends of the pipe. The pipe itself is removed
+ * along with the other temporary files.
+ */
+void
+CloseCopyPipe(CopyPipe * copyPipe)
+{
+	if (copyPipe->fd >= 0)
+		CloseTransientFile(copyPipe->fd);
+
+	if (copyPipe->placeholderFd >= 0)
+		CloseTransientFile(copyPipe->placeholderFd);
+
+	copyPipe->fd = -1;
+	copyPipe->placeholderFd = -1;
+}
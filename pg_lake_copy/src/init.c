@@ -68,6 +68,17 @@ _PG_init(void)
 							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
 							 NULL, NULL, NULL);
 
+	DefineCustomBoolVariable(
+							 "pg_lake_copy.enable_stdio_streaming",
+							 gettext_noop("Streams COPY .. FROM STDIN and COPY .. TO STDOUT "
+										  "through a pipe instead of a temporary file"),
+							 NULL,
+							 &EnablePgLakeCopyStdioStreaming,
+							 true,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL, NULL, NULL);
+
 	RegisterUtilityStatementHandler(CreateTableFromFileHandler, NULL);
 	RegisterUtilityStatementHandler(PgLakeCopyHandler, NULL);
 }
@@ -22,12 +22,22 @@
 #include "tcop/dest.h"
 #include "nodes/pg_list.h"
 
+/*
+ * CSVDataCallback is called with each line written by a CSV DestReceiver
+ * created with CreateCSVDestReceiverForCallback.
+ */
+typedef void (*CSVDataCallback) (void *arg, const char *data, int length);
+
 extern PGDLLEXPORT DestReceiver *CreateCSVDestReceiver(char *filename, List *copyOptions,
 													   CopyDataFormat targetFormat);
 extern PGDLLEXPORT DestReceiver *CreateCSVDestReceiverExtended(char *filename,
 															   List *copyOptions,
 															   CopyDataFormat targetFormat,
 															   bool sessionLifetime);
+extern PGDLLEXPORT DestReceiver *CreateCSVDestReceiverForCallback(CSVDataCallback callback,
+																  void *callbackArg,
+																  List *copyOptions,
+																  CopyDataFormat targetFormat);
 extern PGDLLEXPORT int GetCSVDestReceiverMaxLineSize(DestReceiver *dest);
 extern PGDLLEXPORT uint64 GetCSVDestReceiverFileSize(DestReceiver *dest);
 
@@ -23,27 +23,46 @@
 #include "nodes/pg_list.h"
 
 #define DEFAULT_PGDUCK_SERVER_CONNINFO "host=/tmp port=5332"
+#define DEFAULT_PGDUCK_CONNECTION_POOL_SIZE 2
+#define DEFAULT_PGDUCK_FETCH_BATCH_SIZE 1000
+
+/* result format codes in the PG wire protocol */
+#define PGDUCK_TEXT_RESULT_FORMAT 0
+#define PGDUCK_BINARY_RESULT_FORMAT 1
 
 #define DEFAULT_DUCKDB_MAX_LINE_SIZE (2097152)
 #define DUCKDB_MAX_SAFE_CSV_LINE_SIZE 32000000
 
 /* settings */
 extern char *PgduckServerConninfo;
+extern int	PgduckConnectionPoolSize;
+extern int	PgduckFetchBatchSize;
+extern bool PgduckEnableBinaryResults;
 
 typedef struct PGDuckConnection
 {
 	uint32		connectionId;
 	PGconn	   *conn;
 
+	/* close the connection on release instead of returning it to the pool */
+	bool		discardOnRelease;
+
+	/* settings changed with SET, which are reset before pooling */
+	List	   *sessionSettings;
+
 }			PGDuckConnection;
 
 extern PGDLLEXPORT PGDuckConnection * GetPGDuckConnection(void);
 extern PGDLLEXPORT void ReleasePGDuckConnection(PGDuckConnection * pgDuckConnection);
 extern PGDLLEXPORT int64 ExecuteCommandInPGDuck(char *query);
 extern PGDLLEXPORT List *ExecuteCommandsInPGDuck(List *commands);
+extern PGDLLEXPORT List *ExecuteCommandsOnPGDuckConnection(PGDuckConnection * pgDuckConnection,
+														   List *commands);
 extern PGDLLEXPORT bool ExecuteOptionalCommandInPGDuck(char *command);
 extern PGDLLEXPORT PGresult *ExecuteQueryOnPGDuckConnection(PGDuckConnection * pgDuckConnection,
 															const char *query);
+extern PGDLLEXPORT PGresult *ExecuteBinaryQueryOnPGDuckConnection(PGDuckConnection * pgDuckConnection,
+																   const char *query);
 extern PGDLLEXPORT PGresult *WaitForResult(PGDuckConnection * conn);
 extern PGDLLEXPORT PGresult *WaitForLastResult(PGDuckConnection * conn);
 extern PGDLLEXPORT void SendQueryToPGDuck(PGDuckConnection * conn, char *query);
@@ -52,5 +71,11 @@ extern PGDLLEXPORT void ThrowIfPGDuckResultHasError(PGDuckConnection * conn, PGr
 extern PGDLLEXPORT char *GetSingleValueFromPGDuck(char *query);
 extern PGDLLEXPORT void SendQueryWithParams(PGDuckConnection * pgduckConn, char *queryString,
 											int numParams, const char **parameterValues);
+extern PGDLLEXPORT void SendScanQueryWithParams(PGDuckConnection * pgduckConn, char *queryString,
+												int numParams, const char **parameterValues);
+extern PGDLLEXPORT void SendQueryWithResultFormat(PGDuckConnection * pgduckConn, char *queryString,
+												  int numParams, const char **parameterValues,
+												  int resultFormat, int batchSize);
+extern PGDLLEXPORT bool IsPGDuckRowBatchResult(PGresult *result);
 
 #endif
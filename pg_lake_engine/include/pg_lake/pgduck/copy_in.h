@@ -0,0 +1,42 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "access/tupdesc.h"
+#include "pg_lake/pgduck/client.h"
+
+/*
+ * PGDuckCopyIn represents a stream of rows that is sent to a temporary
+ * table in pgduck_server via the COPY-in sub-protocol.
+ */
+typedef struct PGDuckCopyIn
+{
+	/* connection on which the temporary table exists */
+	PGDuckConnection *connection;
+
+	/* name of the temporary table */
+	char	   *tableName;
+
+	/* whether the connection is still in COPY-in mode */
+	bool		inProgress;
+}			PGDuckCopyIn;
+
+extern PGDLLEXPORT PGDuckCopyIn * StartPGDuckCopyIn(TupleDesc tupleDesc);
+extern PGDLLEXPORT void SendPGDuckCopyInData(void *copyIn, const char *data, int length);
+extern PGDLLEXPORT int64 FinishPGDuckCopyIn(PGDuckCopyIn * copyIn);
+extern PGDLLEXPORT void EndPGDuckCopyIn(PGDuckCopyIn * copyIn);
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "libpq-fe.h"
+
+#include "fmgr.h"
+
+/*
+ * PGDuckResultColumn describes how to convert the values of a column in a
+ * pgduck_server result into datums of the target type.
+ */
+typedef struct PGDuckResultColumn
+{
+	/* whether the values are in binary format */
+	bool		isBinary;
+
+	/*
+	 * Whether the binary values can be received as the target type. If not,
+	 * they are received as the wire type and converted via text.
+	 */
+	bool		receiveAsTarget;
+
+	/* receive function of the target type, or of the wire type */
+	FmgrInfo	receiveFunction;
+	Oid			receiveIOParam;
+
+	/* output function of the wire type, when converting via text */
+	FmgrInfo	wireOutputFunction;
+}			PGDuckResultColumn;
+
+extern PGDLLEXPORT void InitPGDuckResultColumn(PGDuckResultColumn * resultColumn,
+											   PGresult *result, int columnIndex,
+											   Oid targetTypeId);
+extern PGDLLEXPORT Datum PGDuckResultValueToDatum(PGDuckResultColumn * resultColumn,
+												  PGresult *result, int rowIndex,
+												  int columnIndex,
+												  FmgrInfo *inputFunction,
+												  Oid inputIOParam, int32 typmod);
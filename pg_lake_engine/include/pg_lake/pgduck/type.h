@@ -121,6 +121,7 @@ extern PGDLLEXPORT bool IsStructType(const char *typeName);
 extern PGDLLEXPORT bool IsArrayType(const char *typeName);
 extern PGDLLEXPORT bool IsMapType(const char *typeName);
 extern PGDLLEXPORT const char *QuoteDuckDBFieldName(char *fieldName);
+extern PGDLLEXPORT char *QuoteDuckDBLiteral(const char *value);
 extern PGDLLEXPORT PGType GetAttributePGType(Oid relationId, AttrNumber attrNo);
 
 /* The schema to install our types */
@@ -20,6 +20,7 @@
 #include "access/tupdesc.h"
 #include "pg_lake/copy/copy_format.h"
 #include "pg_lake/parquet/field.h"
+#include "pg_lake/pgduck/copy_in.h"
 #include "nodes/pg_list.h"
 
 /* pg_lake_table.target_row_group_size_mb */
@@ -35,6 +36,22 @@ typedef enum ParquetVersion
 /* pg_lake_table.default_parquet_version */
 extern PGDLLEXPORT int DefaultParquetVersion;
 
+/*
+ * PendingWrite is a write to a data file that was sent to pgduck_server,
+ * but whose completion we did not wait for yet.
+ */
+typedef struct PendingWrite
+{
+	/* connection on which the write runs */
+	PGDuckConnection *connection;
+
+	/* whether the connection was taken from the pool for the write */
+	bool		releaseConnection;
+
+	/* whether to reset preserve_insertion_order after the write */
+	bool		resetInsertionOrder;
+}			PendingWrite;
+
 extern PGDLLEXPORT void ConvertCSVFileTo(char *csvFilePath,
 										 TupleDesc tupleDesc,
 										 int maxLineSize,
@@ -43,6 +60,22 @@ extern PGDLLEXPORT void ConvertCSVFileTo(char *csvFilePath,
 										 CopyDataCompression destinationCompression,
 										 List *formatOptions,
 										 DataFileSchema * schema);
+extern PGDLLEXPORT PendingWrite * StartConvertCSVFileTo(char *csvFilePath,
+														TupleDesc tupleDesc,
+														int maxLineSize,
+														char *destinationPath,
+														CopyDataFormat destinationFormat,
+														CopyDataCompression destinationCompression,
+														List *formatOptions,
+														DataFileSchema * schema);
+extern PGDLLEXPORT PendingWrite * StartConvertPGDuckCopyInTo(PGDuckCopyIn * copyIn,
+															 TupleDesc tupleDesc,
+															 char *destinationPath,
+															 CopyDataFormat destinationFormat,
+															 CopyDataCompression destinationCompression,
+															 List *formatOptions,
+															 DataFileSchema * schema);
+extern PGDLLEXPORT int64 FinishPendingWrite(PendingWrite * write);
 extern PGDLLEXPORT int64 WriteQueryResultTo(char *query,
 											char *destinationPath,
 											CopyDataFormat destinationFormat,
@@ -51,4 +84,12 @@ extern PGDLLEXPORT int64 WriteQueryResultTo(char *query,
 											bool queryHasRowId,
 											DataFileSchema * schema,
 											TupleDesc queryTupleDesc);
+extern PGDLLEXPORT PendingWrite * StartWriteQueryResultTo(char *query,
+														  char *destinationPath,
+														  CopyDataFormat destinationFormat,
+														  CopyDataCompression destinationCompression,
+														  List *formatOptions,
+														  bool queryHasRowId,
+														  DataFileSchema * schema,
+														  TupleDesc queryTupleDesc);
 extern PGDLLEXPORT void AppendFields(StringInfo map, DataFileSchema * schema);
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "nodes/pg_list.h"
+
 /* Maximum lengths based on AWS S3 limitations */
 #define MAX_S3_BUCKET_NAME_LENGTH 63	/* Maximum length for an S3 bucket
 										 * name */
@@ -32,5 +34,14 @@
     2 /* null terminator and one extra space */ \
 )
 
+/*
+ * BlobReceiveFunction is called by GetBlobsFromURIs for each blob, with the
+ * index of its URI in the list.
+ */
+typedef void (*BlobReceiveFunction) (int blobIndex, const char *content,
+									 size_t contentLength, void *context);
+
 extern PGDLLEXPORT char *GetTextFromURI(const char *textFileUri);
 extern PGDLLEXPORT char *GetBlobFromURI(const char *blobFileUri, size_t *contentLength);
+extern PGDLLEXPORT void GetBlobsFromURIs(List *blobFileUris, BlobReceiveFunction receiveFn,
+										 void *context);
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+/* backend-local handle of a shared LRU cache */
+typedef struct SharedLRUCache SharedLRUCache;
+
+/*
+ * SharedLRUCacheStats are the counters and the size of a shared LRU cache,
+ * as returned by the cache stats functions.
+ */
+typedef struct SharedLRUCacheStats
+{
+	uint64		hits;
+	uint64		misses;
+	uint64		evictions;
+	int64		entryCount;
+	int64		usedBytes;
+	int64		areaSize;
+}			SharedLRUCacheStats;
+
+extern PGDLLEXPORT SharedLRUCache * CreateSharedLRUCache(const char *name, int sizeKB);
+extern PGDLLEXPORT size_t SharedLRUCacheShmemSize(SharedLRUCache * cache);
+extern PGDLLEXPORT void SharedLRUCacheShmemInit(SharedLRUCache * cache);
+extern PGDLLEXPORT bool SharedLRUCacheIsReady(SharedLRUCache * cache);
+extern PGDLLEXPORT size_t SharedLRUCacheMaxEntrySize(SharedLRUCache * cache);
+extern PGDLLEXPORT bool SharedLRUCacheLookup(SharedLRUCache * cache,
+											 const char *key, size_t keySize,
+											 char **value, size_t *valueSize);
+extern PGDLLEXPORT void SharedLRUCacheInsert(SharedLRUCache * cache,
+											 const char *key, size_t keySize,
+											 const char *value, size_t valueSize);
+extern PGDLLEXPORT void SharedLRUCacheGetStats(SharedLRUCache * cache,
+											   SharedLRUCacheStats * stats);
@@ -0,0 +1,12 @@
+CREATE FUNCTION lake_engine.pgduck_connection_pool_stats(
+    OUT pool_hits bigint,
+    OUT pool_misses bigint,
+    OUT idle_connections int)
+ RETURNS record
+ LANGUAGE C
+ STRICT
+AS 'MODULE_PATHNAME', $function$pgduck_connection_pool_stats$function$;
+COMMENT ON FUNCTION lake_engine.pgduck_connection_pool_stats()
+ IS 'query engine connection pool statistics of the current session';
+REVOKE ALL ON FUNCTION lake_engine.pgduck_connection_pool_stats() FROM public;
+GRANT EXECUTE ON FUNCTION lake_engine.pgduck_connection_pool_stats() TO lake_write;
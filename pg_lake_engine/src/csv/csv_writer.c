@@ -55,6 +55,7 @@
 typedef enum CopyDest
 {
 	COPY_FILE,					/* to file */
+	COPY_CALLBACK,				/* to callback function */
 	/* other options removed, since we only supported COPY_FILE */
 } CopyDest;
 
@@ -90,6 +91,8 @@ typedef struct CopyToStateData
 	char	   *filename;		/* filename, or NULL for STDOUT */
 	bool		is_program;
 	copy_data_dest_cb data_dest_cb; /* function for writing data */
+	CSVDataCallback dataCallback;	/* used if copy_dest == COPY_CALLBACK */
+	void	   *dataCallbackArg;	/* argument passed to dataCallback */
 
 	CopyFormatOptions opts;
 	Node	   *whereClause;	/* WHERE condition (or NULL) */
@@ -125,6 +128,7 @@ static const char BinarySignature[11] = "PGCOPY\n\377\r\n\0";
 
 /* non-export function prototypes */
 static void EndCopy(CopyToState cstate);
+static void OpenCopyToFile(CopyToState cstate);
 static void CopyOneRowTo(CopyToState cstate, TupleTableSlot *slot);
 static void CopyAttributeOutText(CopyToState cstate, const char *string);
 static void CopyAttributeOutCSV(CopyToState cstate, const char *string,
@@ -215,6 +219,13 @@ CopySendEndOfRow(CopyToState cstate)
 						 errmsg("could not write to COPY file: %m")));
 			}
 			break;
+		case COPY_CALLBACK:
+			/* the receiving end always expects \n line endings */
+			if (!cstate->opts.binary)
+				CopySendChar(cstate, '\n');
+
+			cstate->dataCallback(cstate->dataCallbackArg, fe_msgbuf->data, fe_msgbuf->len);
+			break;
 		default:
 			/* we only use COPY to emit files */
 			Assert(false);
@@ -293,7 +304,8 @@ EndCopy(CopyToState cstate)
 /*
  * CreateCopyToState creates the CopyToState.
  *
- * It is derived from BeginCopyTo and DoCopy.
+ * It is derived from BeginCopyTo and DoCopy. The filename can be NULL
+ * when writing to a callback.
  */
 static CopyToState
 CreateCopyToState(char *filename, List *copyOptions)
@@ -302,7 +314,7 @@ CreateCopyToState(char *filename, List *copyOptions)
 	 * Prevent write to relative path ... too easy to shoot oneself in the
 	 * foot by overwriting a database file ...
 	 */
-	if (!is_absolute_path(filename))
+	if (filename != NULL && !is_absolute_path(filename))
 		ereport(ERROR,
 				(errcode(ERRCODE_INVALID_NAME),
 				 errmsg("relative path not allowed for COPY to file")));
@@ -349,7 +361,7 @@ CreateCopyToState(char *filename, List *copyOptions)
 	cstate->fe_msgbuf = makeStringInfo();
 
 	cstate->copy_dest = COPY_FILE;	/* default */
-	cstate->filename = pstrdup(filename);
+	cstate->filename = filename != NULL ? pstrdup(filename) : NULL;
 
 	cstate->maxLineSize = 0;
 	cstate->bytes_processed = 0;
@@ -360,15 +372,11 @@ CreateCopyToState(char *filename, List *copyOptions)
 }
 
 /*
- * Setup CopyToState to write to the given file.
+ * OpenCopyToFile creates the file that the CopyToState writes to.
  */
 static void
-StartCopyTo(CopyToState cstate, TupleDesc tupDesc)
+OpenCopyToFile(CopyToState cstate)
 {
-	ListCell   *cur;
-
-	MemoryContext oldcontext = MemoryContextSwitchTo(cstate->copycontext);
-
 	/* create the file */
 	mode_t		oumask = umask(S_IWGRP | S_IWOTH);
 
@@ -411,6 +419,20 @@ StartCopyTo(CopyToState cstate, TupleDesc tupDesc)
 		ereport(ERROR,
 				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
 				 errmsg("\"%s\" is a directory", cstate->filename)));
+}
+
+/*
+ * Setup CopyToState to write to the given file or callback.
+ */
+static void
+StartCopyTo(CopyToState cstate, TupleDesc tupDesc)
+{
+	ListCell   *cur;
+
+	MemoryContext oldcontext = MemoryContextSwitchTo(cstate->copycontext);
+
+	if (cstate->copy_dest == COPY_FILE)
+		OpenCopyToFile(cstate);
 
 
 	/* get the attribute names from the tuple descriptor */
@@ -1180,6 +1202,26 @@ CreateCSVDestReceiverExtended(char *filename, List *copyOptions,
 }
 
 
+/*
+ * CreateCSVDestReceiverForCallback creates a DestReceiver that passes each
+ * CSV line (including the line ending) to the given callback instead of
+ * writing it to a file.
+ */
+DestReceiver *
+CreateCSVDestReceiverForCallback(CSVDataCallback callback, void *callbackArg,
+								 List *copyOptions, CopyDataFormat targetFormat)
+{
+	DR_copy    *self =
+		(DR_copy *) CreateCSVDestReceiver(NULL, copyOptions, targetFormat);
+
+	self->cstate->copy_dest = COPY_CALLBACK;
+	self->cstate->dataCallback = callback;
+	self->cstate->dataCallbackArg = callbackArg;
+
+	return (DestReceiver *) self;
+}
+
+
 /*
  * GetCSVDestReceiverMaxLineSize returns the maximum line size observed
  * by the CSV writer.
@@ -75,6 +75,43 @@ _PG_init(void)
 							   GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
 							   NULL, NULL, NULL);
 
+	DefineCustomIntVariable(
+							"pg_lake_engine.connection_pool_size",
+							gettext_noop("Maximum number of idle query engine connections "
+										 "each backend keeps open for reuse."),
+							gettext_noop("Set to 0 to close connections to the query "
+										 "engine as soon as they are released."),
+							&PgduckConnectionPoolSize,
+							DEFAULT_PGDUCK_CONNECTION_POOL_SIZE, 0, 64,
+							PGC_USERSET,
+							0,
+							NULL, NULL, NULL);
+
+	DefineCustomIntVariable(
+							"pg_lake_engine.fetch_batch_size",
+							gettext_noop("Number of rows to fetch from the query engine "
+										 "per result batch."),
+							gettext_noop("Batches larger than 1 row require libpq 17 or "
+										 "later, older versions always fetch rows one "
+										 "at a time."),
+							&PgduckFetchBatchSize,
+							DEFAULT_PGDUCK_FETCH_BATCH_SIZE, 1, INT_MAX,
+							PGC_USERSET,
+							0,
+							NULL, NULL, NULL);
+
+	DefineCustomBoolVariable(
+							 "pg_lake_engine.enable_binary_results",
+							 gettext_noop("Fetch scan results from the query engine in "
+										  "binary format where possible."),
+							 gettext_noop("Binary format avoids converting numeric and "
+										  "temporal values to text and back."),
+							 &PgduckEnableBinaryResults,
+							 true,
+							 PGC_USERSET,
+							 0,
+							 NULL, NULL, NULL);
+
 	DefineCustomBoolVariable(
 							 "pg_lake_engine.enable_cache_manager",
 							 gettext_noop("When enabled, a background worker will "
@@ -233,7 +233,15 @@ ManageCache(void)
 			char	   *fileSizeStr = PQgetvalue(result, rowIndex, 1);
 			char	   *action = PQgetvalue(result, rowIndex, 2);
 
-			if (strcmp(action, "added") == 0)
+			if (strcmp(action, "added") == 0 && columnCount >= 4)
+			{
+				char	   *downloadTimeStr = PQgetvalue(result, rowIndex, 3);
+
+				ereport(LOG, (errmsg(BACKGROUND_WORKER_NAME ": "
+									 "added %s (%s bytes) to cache in %s ms",
+									 url, fileSizeStr, downloadTimeStr)));
+			}
+			else if (strcmp(action, "added") == 0)
 			{
 				ereport(LOG, (errmsg(BACKGROUND_WORKER_NAME ": "
 									 "added %s (%s bytes) to cache",
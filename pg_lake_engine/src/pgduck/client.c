@@ -15,14 +15,21 @@
  * limitations under the License.
  */
 
+#include <ctype.h>
+
 #include "postgres.h"
 #include "miscadmin.h"
 #include "libpq-fe.h"
 
 #include "access/hash.h"
+#include "access/htup_details.h"
 #include "access/xact.h"
+#include "funcapi.h"
 #include "pg_lake/pgduck/client.h"
+#include "storage/ipc.h"
 #include "storage/latch.h"
+#include "utils/builtins.h"
+#include "utils/formatting.h"
 #include "utils/memutils.h"
 #include "utils/timestamp.h"
 #include "utils/wait_event.h"
@@ -43,8 +50,21 @@ static void PGDuckClientSubtransactionCallback(SubXactEvent event,
 											   SubTransactionId mySubid,
 											   SubTransactionId parentSubid,
 											   void *arg);
-static uint32 ReleaseAllPGDuckConnections(SubTransactionId subTransactionId);
-static void CancelRunningCommandOnConnection(PGconn *conn);
+static uint32 ReleaseAllPGDuckConnections(SubTransactionId subTransactionId,
+										  bool isCommit);
+static PGconn *TakeIdlePGDuckConnection(void);
+static void ReturnConnectionToPool(PGconn *conn, char *conninfo, List *sessionSettings,
+								   bool discard);
+static bool IsReusableConnection(PGconn *conn);
+static bool ResetSessionSettings(PGconn *conn, List *sessionSettings);
+static void TrackSessionSettings(PGDuckConnection * pgDuckConnection, const char *query);
+static void TrackSessionSetting(PGDuckConnection * pgDuckConnection, const char *statement);
+static void CloseIdlePGDuckConnections(int code, Datum arg);
+static void DropIdlePGDuckConnections(void);
+static bool CancelRunningCommandOnConnection(PGconn *conn);
+static PGresult *ExecuteQueryWithResultFormat(PGDuckConnection * pgDuckConnection,
+											  const char *query, int resultFormat);
+static int	SendQueryWithFormat(PGconn *conn, const char *query, int resultFormat);
 static bool CancelQuery(PGconn *conn);
 static bool StartCancelQuery(PGconn *conn);
 static bool FinishCancelQuery(PGconn *conn, TimestampTz endtime, bool consume_input);
@@ -53,6 +73,9 @@ static bool WaitForLastResultWithTimeout(PGconn *conn, TimestampTz endtime,
 
 /* query engine settings */
 char	   *PgduckServerConninfo = DEFAULT_PGDUCK_SERVER_CONNINFO;
+int			PgduckConnectionPoolSize = DEFAULT_PGDUCK_CONNECTION_POOL_SIZE;
+int			PgduckFetchBatchSize = DEFAULT_PGDUCK_FETCH_BATCH_SIZE;
+bool		PgduckEnableBinaryResults = true;
 
 /* monotonically increasing key */
 static uint32 ConnectionId = 0;
@@ -62,6 +85,29 @@ static HTAB *PgDuckConnectionHash = NULL;
 static MemoryContext PgDuckConnectionMemoryContext = NULL;
 static bool IsPGDuckClientInitialized = false;
 
+/*
+ * IdlePGDuckConnection is a pooled connection along with the connection
+ * string it was opened with.
+ */
+typedef struct IdlePGDuckConnection
+{
+	PGconn	   *conn;
+	char	   *conninfo;
+}			IdlePGDuckConnection;
+
+/*
+ * Connections that were released cleanly and can be reused by a later
+ * GetPGDuckConnection call, possibly in a later transaction. Allocated
+ * in PgDuckConnectionMemoryContext.
+ */
+static List *IdlePgDuckConnections = NIL;
+
+/* connection pool statistics for the current backend */
+static int64 ConnectionPoolHits = 0;
+static int64 ConnectionPoolMisses = 0;
+
+PG_FUNCTION_INFO_V1(pgduck_connection_pool_stats);
+
 /* hash entry */
 typedef struct PgDuckServerConnectionHashEntry
 {
@@ -69,6 +115,9 @@ typedef struct PgDuckServerConnectionHashEntry
 	SubTransactionId subTransactionId;
 	PGDuckConnection pgDuckConnection;
 
+	/* connection string the connection was opened with */
+	char	   *conninfo;
+
 }			PgDuckServerConnectionHashEntry;
 
 /*
@@ -86,6 +135,7 @@ InitializePGDuckClient(void)
 
 	RegisterXactCallback(PGDuckClientTransactionCallback, NULL);
 	RegisterSubXactCallback(PGDuckClientSubtransactionCallback, NULL);
+	on_proc_exit(CloseIdlePGDuckConnections, 0);
 
 	SetupPgDuckConnectionHash();
 
@@ -126,27 +176,39 @@ SetupPgDuckConnectionHash(void)
 
 
 /*
- * GetPGDuckConnection returns the main PGDuck connection.
+ * GetPGDuckConnection returns a connection to pgduck_server, reusing an idle
+ * connection from the pool when one is available.
  */
 PGDuckConnection *
 GetPGDuckConnection(void)
 {
 	InitializePGDuckClient();
 
-	PGconn	   *connection = PQconnectdb(PgduckServerConninfo);
+	PGconn	   *connection = TakeIdlePGDuckConnection();
 
-	if (PQstatus(connection) != CONNECTION_OK)
+	if (connection != NULL)
+	{
+		ConnectionPoolHits++;
+	}
+	else
 	{
-		char		PG_USED_FOR_ASSERTS_ONLY *errorMessage = pstrdup(PQerrorMessage(connection));
+		ConnectionPoolMisses++;
+
+		connection = PQconnectdb(PgduckServerConninfo);
+
+		if (PQstatus(connection) != CONNECTION_OK)
+		{
+			char		PG_USED_FOR_ASSERTS_ONLY *errorMessage = pstrdup(PQerrorMessage(connection));
 
-		PQfinish(connection);
+			PQfinish(connection);
 
 #ifdef USE_ASSERT_CHECKING
-		ereport(ERROR, (errmsg("could not start query engine: %s", errorMessage)));
+			ereport(ERROR, (errmsg("could not start query engine: %s", errorMessage)));
 #else
-		/* hide internals from users */
-		ereport(ERROR, (errmsg("could not start query engine")));
+			/* hide internals from users */
+			ereport(ERROR, (errmsg("could not start query engine")));
 #endif
+		}
 	}
 
 	int			connectionId = ConnectionId++;
@@ -157,9 +219,13 @@ GetPGDuckConnection(void)
 	if (!found)
 	{
 		entry->subTransactionId = GetCurrentSubTransactionId();
+		entry->conninfo = MemoryContextStrdup(PgDuckConnectionMemoryContext,
+											  PgduckServerConninfo);
 
 		entry->pgDuckConnection.conn = connection;
 		entry->pgDuckConnection.connectionId = connectionId;
+		entry->pgDuckConnection.discardOnRelease = false;
+		entry->pgDuckConnection.sessionSettings = NIL;
 	}
 
 	return &entry->pgDuckConnection;
@@ -167,8 +233,8 @@ GetPGDuckConnection(void)
 
 
 /*
- * ReleasePGDuckConnection closes the current connection to the
- * pgduck_server, if any.
+ * ReleasePGDuckConnection hands the connection back to the pool if it is
+ * idle and the pool has room, and closes it otherwise.
  */
 void
 ReleasePGDuckConnection(PGDuckConnection * pgDuckConnection)
@@ -190,8 +256,311 @@ ReleasePGDuckConnection(PGDuckConnection * pgDuckConnection)
 		return;
 	}
 
-	if (entry->pgDuckConnection.conn != NULL)
-		PQfinish(entry->pgDuckConnection.conn);
+	ReturnConnectionToPool(entry->pgDuckConnection.conn,
+						   entry->conninfo,
+						   entry->pgDuckConnection.sessionSettings,
+						   entry->pgDuckConnection.discardOnRelease);
+
+	pgDuckConnection->sessionSettings = NIL;
+}
+
+
+/*
+ * TakeIdlePGDuckConnection removes a usable connection from the pool and
+ * returns it, or returns NULL if there is none.
+ */
+static PGconn *
+TakeIdlePGDuckConnection(void)
+{
+	while (IdlePgDuckConnections != NIL)
+	{
+		IdlePGDuckConnection *idleConnection = llast(IdlePgDuckConnections);
+
+		/* pg_lake_engine.pgduck_server_conninfo changed, drop the pool */
+		if (strcmp(idleConnection->conninfo, PgduckServerConninfo) != 0)
+		{
+			DropIdlePGDuckConnections();
+			break;
+		}
+
+		PGconn	   *conn = idleConnection->conn;
+
+		IdlePgDuckConnections = list_delete_last(IdlePgDuckConnections);
+		pfree(idleConnection->conninfo);
+		pfree(idleConnection);
+
+		/*
+		 * pgduck_server may have restarted or closed the connection while it
+		 * was idle. The socket is non-blocking, so consuming input only picks
+		 * up an EOF or error that is already pending.
+		 */
+		if (PQconsumeInput(conn) && !PQisBusy(conn) && IsReusableConnection(conn))
+			return conn;
+
+		PQfinish(conn);
+	}
+
+	return NULL;
+}
+
+
+/*
+ * ReturnConnectionToPool adds the connection to the idle pool, unless the
+ * connection is not in a reusable state, the caller asked to discard it,
+ * it was opened with a different connection string than the current one,
+ * its session settings cannot be reset, or the pool is already full, in
+ * which case it is closed.
+ *
+ * Takes ownership of conninfo and sessionSettings.
+ */
+static void
+ReturnConnectionToPool(PGconn *conn, char *conninfo, List *sessionSettings, bool discard)
+{
+	if (conn == NULL || discard || !IsReusableConnection(conn) ||
+		strcmp(conninfo, PgduckServerConninfo) != 0 ||
+		list_length(IdlePgDuckConnections) >= PgduckConnectionPoolSize ||
+		!ResetSessionSettings(conn, sessionSettings))
+	{
+		if (conn != NULL)
+			PQfinish(conn);
+
+		pfree(conninfo);
+		list_free_deep(sessionSettings);
+		return;
+	}
+
+	list_free_deep(sessionSettings);
+
+	MemoryContext oldContext = MemoryContextSwitchTo(PgDuckConnectionMemoryContext);
+
+	IdlePGDuckConnection *idleConnection = palloc0(sizeof(IdlePGDuckConnection));
+
+	idleConnection->conn = conn;
+	idleConnection->conninfo = conninfo;
+
+	IdlePgDuckConnections = lappend(IdlePgDuckConnections, idleConnection);
+
+	MemoryContextSwitchTo(oldContext);
+}
+
+
+/*
+ * ResetSessionSettings resets the settings that were changed on the
+ * connection, such that they do not leak into the next user of a pooled
+ * connection, and returns whether it succeeded.
+ */
+static bool
+ResetSessionSettings(PGconn *conn, List *sessionSettings)
+{
+	ListCell   *settingCell = NULL;
+
+	foreach(settingCell, sessionSettings)
+	{
+		char	   *settingName = lfirst(settingCell);
+		char	   *command = psprintf("RESET %s", settingName);
+		PGresult   *result = PQexec(conn, command);
+		bool		success = PQresultStatus(result) == PGRES_COMMAND_OK;
+
+		PQclear(result);
+		pfree(command);
+
+		if (!success)
+			return false;
+	}
+
+	return true;
+}
+
+
+/*
+ * TrackSessionSettings records the settings changed by SET commands in the
+ * query, such that we can reset the session state before the connection is
+ * returned to the pool.
+ *
+ * Queries sent over the simple query protocol can contain several
+ * statements, so we look at every statement. We naively split on
+ * semicolons, which at worst makes us reset a setting that was not
+ * changed. Resetting a setting that does not exist fails, in which case
+ * the connection is closed rather than pooled.
+ */
+static void
+TrackSessionSettings(PGDuckConnection * pgDuckConnection, const char *query)
+{
+	const char *statement = query;
+
+	while (statement != NULL)
+	{
+		TrackSessionSetting(pgDuckConnection, statement);
+
+		statement = strchr(statement, ';');
+		if (statement != NULL)
+			statement++;
+	}
+}
+
+
+/*
+ * TrackSessionSetting records the setting changed by a SET statement, or
+ * forgets it after a RESET statement. SET GLOBAL is not session state. If
+ * we cannot tell which setting is changed, the connection is discarded on
+ * release.
+ */
+static void
+TrackSessionSetting(PGDuckConnection * pgDuckConnection, const char *statement)
+{
+	const char *position = statement;
+	bool		isReset = false;
+
+	while (isspace((unsigned char) *position))
+		position++;
+
+	if (pg_strncasecmp(position, "SET", 3) == 0 && isspace((unsigned char) position[3]))
+		position += 3;
+	else if (pg_strncasecmp(position, "RESET", 5) == 0 && isspace((unsigned char) position[5]))
+	{
+		position += 5;
+		isReset = true;
+	}
+	else
+		return;
+
+	while (isspace((unsigned char) *position))
+		position++;
+
+	if (pg_strncasecmp(position, "GLOBAL", 6) == 0 && isspace((unsigned char) position[6]))
+		return;
+
+	if ((pg_strncasecmp(position, "SESSION", 7) == 0 && isspace((unsigned char) position[7])) ||
+		(pg_strncasecmp(position, "LOCAL", 5) == 0 && isspace((unsigned char) position[5])))
+	{
+		while (!isspace((unsigned char) *position))
+			position++;
+		while (isspace((unsigned char) *position))
+			position++;
+	}
+
+	int			nameLength = 0;
+
+	while (isalnum((unsigned char) position[nameLength]) ||
+		   position[nameLength] == '_' || position[nameLength] == '.')
+		nameLength++;
+
+	if (nameLength == 0)
+	{
+		pgDuckConnection->discardOnRelease = true;
+		return;
+	}
+
+	MemoryContext oldContext = MemoryContextSwitchTo(PgDuckConnectionMemoryContext);
+	char	   *settingName = asc_tolower(position, nameLength);
+
+	if (isReset && strcmp(settingName, "all") == 0)
+	{
+		list_free_deep(pgDuckConnection->sessionSettings);
+		pgDuckConnection->sessionSettings = NIL;
+		pfree(settingName);
+		MemoryContextSwitchTo(oldContext);
+		return;
+	}
+
+	ListCell   *settingCell = NULL;
+
+	foreach(settingCell, pgDuckConnection->sessionSettings)
+	{
+		char	   *trackedName = lfirst(settingCell);
+
+		if (strcmp(trackedName, settingName) != 0)
+			continue;
+
+		if (isReset)
+		{
+			pgDuckConnection->sessionSettings =
+				foreach_delete_current(pgDuckConnection->sessionSettings, settingCell);
+			pfree(trackedName);
+		}
+
+		break;
+	}
+
+	if (isReset || settingCell != NULL)
+		pfree(settingName);
+	else
+		pgDuckConnection->sessionSettings =
+			lappend(pgDuckConnection->sessionSettings, settingName);
+
+	MemoryContextSwitchTo(oldContext);
+}
+
+
+/*
+ * IsReusableConnection returns whether the connection is healthy and has no
+ * command or unread results in flight.
+ */
+static bool
+IsReusableConnection(PGconn *conn)
+{
+	return PQstatus(conn) == CONNECTION_OK &&
+		PQtransactionStatus(conn) == PQTRANS_IDLE;
+}
+
+
+/*
+ * CloseIdlePGDuckConnections closes all pooled connections on backend exit,
+ * such that pgduck_server sees a clean Terminate message.
+ */
+static void
+CloseIdlePGDuckConnections(int code, Datum arg)
+{
+	DropIdlePGDuckConnections();
+}
+
+
+/*
+ * DropIdlePGDuckConnections closes and forgets all pooled connections.
+ */
+static void
+DropIdlePGDuckConnections(void)
+{
+	ListCell   *connCell = NULL;
+
+	foreach(connCell, IdlePgDuckConnections)
+	{
+		IdlePGDuckConnection *idleConnection = lfirst(connCell);
+
+		PQfinish(idleConnection->conn);
+		pfree(idleConnection->conninfo);
+		pfree(idleConnection);
+	}
+
+	list_free(IdlePgDuckConnections);
+	IdlePgDuckConnections = NIL;
+}
+
+
+/*
+ * pgduck_connection_pool_stats returns the pgduck_server connection pool
+ * hit and miss counters of the current backend.
+ */
+Datum
+pgduck_connection_pool_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupleDesc;
+
+	if (get_call_result_type(fcinfo, NULL, &tupleDesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	Datum		values[3];
+	bool		nulls[3];
+
+	memset(nulls, 0, sizeof(nulls));
+
+	values[0] = Int64GetDatum(ConnectionPoolHits);
+	values[1] = Int64GetDatum(ConnectionPoolMisses);
+	values[2] = Int32GetDatum(list_length(IdlePgDuckConnections));
+
+	HeapTuple	tuple = heap_form_tuple(BlessTupleDesc(tupleDesc), values, nulls);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
 }
 
 
@@ -206,6 +575,8 @@ SendQueryToPGDuck(PGDuckConnection * pgDuckConnection, char *query)
 	/* use text format */
 	int			format = 0;
 
+	TrackSessionSettings(pgDuckConnection, query);
+
 	/*
 	 * Even though we don't have parameters, we use PQsendQueryParams because
 	 * it uses extended query protocol, which activates streaming results on
@@ -271,9 +642,35 @@ ExecuteCommandInPGDuck(char *command)
 List *
 ExecuteCommandsInPGDuck(List *commands)
 {
+	PGDuckConnection *pgDuckConn = GetPGDuckConnection();
 	List	   *rowsAffected = NIL;
 
-	PGDuckConnection *pgDuckConn = GetPGDuckConnection();
+	PG_TRY();
+	{
+		rowsAffected = ExecuteCommandsOnPGDuckConnection(pgDuckConn, commands);
+	}
+	PG_FINALLY();
+	{
+		ReleasePGDuckConnection(pgDuckConn);
+	}
+	PG_END_TRY();
+
+	return rowsAffected;
+}
+
+
+/*
+ * ExecuteCommandsOnPGDuckConnection executes the given commands on the given
+ * connection and for writes it returns list of the number of affected rows,
+ * or -1 otherwise.
+ *
+ * On error, the connection is marked to be discarded, and the caller remains
+ * responsible for releasing it.
+ */
+List *
+ExecuteCommandsOnPGDuckConnection(PGDuckConnection * pgDuckConn, List *commands)
+{
+	List	   *rowsAffected = NIL;
 
 	PG_TRY();
 	{
@@ -297,9 +694,14 @@ ExecuteCommandsInPGDuck(List *commands)
 			rowsAffected = lappend_int(rowsAffected, rowsAffectedValue);
 		}
 	}
-	PG_FINALLY();
+	PG_CATCH();
 	{
-		ReleasePGDuckConnection(pgDuckConn);
+		/*
+		 * Command lists may change session settings and reset them at the
+		 * end, so do not let another caller reuse a half-applied session.
+		 */
+		pgDuckConn->discardOnRelease = true;
+		PG_RE_THROW();
 	}
 	PG_END_TRY();
 
@@ -351,13 +753,41 @@ ExecuteOptionalCommandInPGDuck(char *command)
 PGresult *
 ExecuteQueryOnPGDuckConnection(PGDuckConnection * pgDuckConnection,
 							   const char *query)
+{
+	return ExecuteQueryWithResultFormat(pgDuckConnection, query,
+										PGDUCK_TEXT_RESULT_FORMAT);
+}
+
+
+/*
+ * ExecuteBinaryQueryOnPGDuckConnection executes the given query in PGDuck on
+ * the given connection, and requests the results in binary format. Columns
+ * of types that pgduck_server cannot send in binary format are still sent as
+ * text, which can be checked via PQfformat.
+ */
+PGresult *
+ExecuteBinaryQueryOnPGDuckConnection(PGDuckConnection * pgDuckConnection,
+									 const char *query)
+{
+	return ExecuteQueryWithResultFormat(pgDuckConnection, query,
+										PGDUCK_BINARY_RESULT_FORMAT);
+}
+
+
+/*
+ * ExecuteQueryWithResultFormat executes the given query in PGDuck on the given
+ * connection with the given result format.
+ */
+static PGresult *
+ExecuteQueryWithResultFormat(PGDuckConnection * pgDuckConnection,
+							 const char *query, int resultFormat)
 {
 	PGconn	   *conn = pgDuckConnection->conn;
 #ifdef USE_ASSERT_CHECKING
 	elog(DEBUG2, "PGDuck: %s", query);
 #endif
 
-	int			sentQuery = PQsendQuery(conn, query);
+	int			sentQuery = SendQueryWithFormat(conn, query, resultFormat);
 
 	if (sentQuery == 0)
 	{
@@ -366,19 +796,37 @@ ExecuteQueryOnPGDuckConnection(PGDuckConnection * pgDuckConnection,
 		/* may have lost connection, retry once */
 		pgDuckConnection = GetPGDuckConnection();
 		conn = pgDuckConnection->conn;
-		sentQuery = PQsendQuery(conn, query);
+		sentQuery = SendQueryWithFormat(conn, query, resultFormat);
 		if (sentQuery == 0)
 		{
 			ereport(ERROR, (errmsg("lost connection to query engine")));
 		}
 	}
 
+	TrackSessionSettings(pgDuckConnection, query);
+
 	PGresult   *result = WaitForLastResult(pgDuckConnection);
 
 	return result;
 }
 
 
+/*
+ * SendQueryWithFormat sends the query over the connection, and returns 0 if
+ * it could not be sent. Only the extended query protocol allows binary
+ * results, so we use the simple query protocol for text results, which
+ * also allows multiple statements in the query.
+ */
+static int
+SendQueryWithFormat(PGconn *conn, const char *query, int resultFormat)
+{
+	if (resultFormat == PGDUCK_TEXT_RESULT_FORMAT)
+		return PQsendQuery(conn, query);
+
+	return PQsendQueryParams(conn, query, 0, NULL, NULL, NULL, NULL, resultFormat);
+}
+
+
 /*
  * WaitForResult waits for a result from a prior asynchronous execution function call
  * while also checking for signals and postmaster death.
@@ -490,7 +938,7 @@ ThrowIfPGDuckResultHasError(PGDuckConnection * pgDuckConnection, PGresult *resul
 	ExecStatusType resultStatus = PQresultStatus(result);
 
 	if (resultStatus == PGRES_TUPLES_OK || resultStatus == PGRES_COMMAND_OK ||
-		resultStatus == PGRES_SINGLE_TUPLE)
+		IsPGDuckRowBatchResult(result))
 	{
 		return;
 	}
@@ -545,11 +993,13 @@ PGDuckClientTransactionCallback(XactEvent event, void *arg)
 	if (event == XACT_EVENT_ABORT || event == XACT_EVENT_PARALLEL_ABORT ||
 		event == XACT_EVENT_PRE_COMMIT || event == XACT_EVENT_PARALLEL_PRE_COMMIT)
 	{
-		int			releasedConnections = ReleaseAllPGDuckConnections(InvalidSubTransactionId);
+		bool		isCommit = event == XACT_EVENT_PRE_COMMIT ||
+			event == XACT_EVENT_PARALLEL_PRE_COMMIT;
+		int			releasedConnections =
+			ReleaseAllPGDuckConnections(InvalidSubTransactionId, isCommit);
 
 		/* we expect all callers to release connections on successful commits */
-		if ((event == XACT_EVENT_PRE_COMMIT || event == XACT_EVENT_PARALLEL_PRE_COMMIT) &&
-			releasedConnections > 0)
+		if (isCommit && releasedConnections > 0)
 		{
 			elog(WARNING, "released %d connections on transaction commit",
 				 releasedConnections);
@@ -567,9 +1017,11 @@ PGDuckClientTransactionCallback(XactEvent event, void *arg)
  *
  * If subTransactionId is not InvalidSubTransactionId, it releases only the
  * connections that are established within the given sub-transaction.
+ *
+ * Connections released on abort are closed rather than returned to the pool.
  */
 static uint32
-ReleaseAllPGDuckConnections(SubTransactionId subTransactionId)
+ReleaseAllPGDuckConnections(SubTransactionId subTransactionId, bool isCommit)
 {
 	int			releasedConnections = 0;
 	HASH_SEQ_STATUS status;
@@ -582,7 +1034,15 @@ ReleaseAllPGDuckConnections(SubTransactionId subTransactionId)
 			entry->subTransactionId == subTransactionId)
 		{
 			/* cancel any running command on the connection */
-			CancelRunningCommandOnConnection(entry->pgDuckConnection.conn);
+			bool		cancelled = CancelRunningCommandOnConnection(entry->pgDuckConnection.conn);
+
+			/*
+			 * The owner did not get to release the connection, so it may
+			 * have been interrupted halfway through changing session state.
+			 * Only pool connections that are left behind on commit.
+			 */
+			if (!cancelled || !isCommit)
+				entry->pgDuckConnection.discardOnRelease = true;
 
 			/* release the connection */
 			ReleasePGDuckConnection(&entry->pgDuckConnection);
@@ -619,7 +1079,8 @@ PGDuckClientSubtransactionCallback(SubXactEvent event, SubTransactionId mySubid,
 	if (event == SUBXACT_EVENT_ABORT_SUB ||
 		event == SUBXACT_EVENT_COMMIT_SUB)
 	{
-		int			releasedConnections = ReleaseAllPGDuckConnections(mySubid);
+		int			releasedConnections =
+			ReleaseAllPGDuckConnections(mySubid, event == SUBXACT_EVENT_COMMIT_SUB);
 
 		/* we expect all callers to release connections on successful commits */
 		if (event == SUBXACT_EVENT_COMMIT_SUB && releasedConnections > 0)
@@ -630,21 +1091,22 @@ PGDuckClientSubtransactionCallback(SubXactEvent event, SubTransactionId mySubid,
 
 
 /*
- * CancelRunningCommandOnConnection cancels a pending query and then closes the connection.
+ * CancelRunningCommandOnConnection cancels a pending query, if any, and returns
+ * whether the connection is left idle and usable.
  */
-static void
+static bool
 CancelRunningCommandOnConnection(PGconn *conn)
 {
 	if (conn == NULL)
 	{
 		/* no active connection */
-		return;
+		return false;
 	}
 
 	if (PQstatus(conn) != CONNECTION_OK)
 	{
 		/* connection is broken, nothing to do */
-		return;
+		return false;
 	}
 
 	if (PQtransactionStatus(conn) == PQTRANS_ACTIVE)
@@ -652,12 +1114,14 @@ CancelRunningCommandOnConnection(PGconn *conn)
 		/* a query is still running, cancel it */
 		if (!CancelQuery(conn))
 		{
-			return;
+			return false;
 		}
 	}
 
 	/* we currently don't have "idle in transaction" status */
 	Assert(PQtransactionStatus(conn) == PQTRANS_IDLE);
+
+	return true;
 }
 
 
@@ -837,17 +1301,19 @@ WaitForLastResultWithTimeout(PGconn *conn, TimestampTz endtime,
 			if (res == NULL)
 				break;			/* query is complete */
 
-			bool		isCopyOut = PQresultStatus(res) == PGRES_COPY_OUT;
+			bool		isCopy = PQresultStatus(res) == PGRES_COPY_OUT ||
+				PQresultStatus(res) == PGRES_COPY_IN;
 
 			PQclear(last_res);
 			last_res = res;
 
-			if (isCopyOut)
+			if (isCopy)
 			{
 				/*
 				 * We prefer not to wait for CopyOut responses, because the
 				 * logic is complex and closing the connection might be more
-				 * effective at stopping the command.
+				 * effective at stopping the command. CopyIn responses never
+				 * complete unless we send the rest of the data.
 				 *
 				 * This is not a real failure condition, but we treat it as
 				 * such since we failed to complete cancellation.
@@ -919,14 +1385,53 @@ GetSingleValueFromPGDuck(char *query)
 
 /*
 * SendQueryWithParams sends a query with parameters to the pgduck server.
-* It is a wrapper around PQsendQueryParams() followed by PQsetSingleRowMode().
+* It is a wrapper around PQsendQueryParams() followed by switching the
+* connection to chunked (or single-row) mode, such that results are streamed
+* in batches of at most pg_lake_engine.fetch_batch_size rows.
 */
 void
 SendQueryWithParams(PGDuckConnection * pgduckConn, char *queryString,
 					int numParams, const char **parameterValues)
+{
+	SendQueryWithResultFormat(pgduckConn, queryString, numParams, parameterValues,
+							  PGDUCK_TEXT_RESULT_FORMAT, PgduckFetchBatchSize);
+}
+
+
+/*
+ * SendScanQueryWithParams is like SendQueryWithParams, but requests results
+ * in binary format when pg_lake_engine.enable_binary_results is enabled.
+ *
+ * pgduck_server only uses binary format for columns of common scalar types,
+ * the remaining columns are still sent as text. Callers should therefore use
+ * PGDuckResultColumn to convert values.
+ */
+void
+SendScanQueryWithParams(PGDuckConnection * pgduckConn, char *queryString,
+						int numParams, const char **parameterValues)
+{
+	int			resultFormat = PgduckEnableBinaryResults ?
+		PGDUCK_BINARY_RESULT_FORMAT : PGDUCK_TEXT_RESULT_FORMAT;
+
+	SendQueryWithResultFormat(pgduckConn, queryString, numParams, parameterValues,
+							  resultFormat, PgduckFetchBatchSize);
+}
+
+
+/*
+ * SendQueryWithResultFormat sends a query with parameters to the pgduck
+ * server, requesting the given result format and streaming the results in
+ * batches of at most batchSize rows.
+ */
+void
+SendQueryWithResultFormat(PGDuckConnection * pgduckConn, char *queryString,
+						  int numParams, const char **parameterValues,
+						  int resultFormat, int batchSize)
 {
 	PGconn	   *conn = pgduckConn->conn;
 
+	TrackSessionSettings(pgduckConn, queryString);
+
 	/*
 	 * Notice that we pass NULL for paramTypes, thus forcing the remote server
 	 * to infer types for all parameters.  Since we explicitly cast every
@@ -935,17 +1440,45 @@ SendQueryWithParams(PGDuckConnection * pgduckConn, char *queryString,
 	 * remote server has the same OIDs we do for the parameters' types.
 	 */
 	if (!PQsendQueryParams(conn, queryString, numParams,
-						   NULL, parameterValues, NULL, NULL, 0))
+						   NULL, parameterValues, NULL, NULL, resultFormat))
 	{
 		ereport(ERROR, (errcode(ERRCODE_IO_ERROR),
 						errmsg("lost connection to query engine")));
 	}
 
-	/* postgres lets to set single row mode after sending the query */
-	int			singleRowMode = PQsetSingleRowMode(conn);
+	/* postgres lets to set single row/chunked mode after sending the query */
+	int			rowMode;
 
-	if (singleRowMode == 0)
+#if PG_VERSION_NUM >= 170000
+	if (batchSize > 1)
+		rowMode = PQsetChunkedRowsMode(conn, batchSize);
+	else
+		rowMode = PQsetSingleRowMode(conn);
+#else
+	rowMode = PQsetSingleRowMode(conn);
+#endif
+
+	if (rowMode == 0)
 	{
-		elog(ERROR, "could not set single row mode for connection");
+		elog(ERROR, "could not set row mode for connection");
 	}
 }
+
+
+/*
+ * IsPGDuckRowBatchResult returns whether the result is one of the partial
+ * result sets returned after SendQueryWithParams, as opposed to the final
+ * (empty) PGRES_TUPLES_OK result or an error.
+ */
+bool
+IsPGDuckRowBatchResult(PGresult *result)
+{
+	ExecStatusType resultStatus = PQresultStatus(result);
+
+#if PG_VERSION_NUM >= 170000
+	if (resultStatus == PGRES_TUPLES_CHUNK)
+		return true;
+#endif
+
+	return resultStatus == PGRES_SINGLE_TUPLE;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Functions for streaming rows into pgduck_server.
+ *
+ * Rows are sent as CSV over the COPY-in sub-protocol after a "receive <table>"
+ * command, and pgduck_server appends them to a temporary table that has one
+ * VARCHAR column per table column. The caller can then convert the rows
+ * using the same casts as when reading an intermediate CSV file, without
+ * writing a local file and reading it back.
+ *
+ * Temporary tables only exist on a single connection, so the connection is
+ * held from StartPGDuckCopyIn until EndPGDuckCopyIn.
+ */
+#include "postgres.h"
+
+#include "access/tupdesc.h"
+#include "pg_lake/pgduck/client.h"
+#include "pg_lake/pgduck/copy_in.h"
+#include "utils/builtins.h"
+
+
+/* prefix of temporary tables used for receiving rows */
+#define COPY_IN_TABLE_PREFIX "pg_lake_copy_in_"
+
+
+/*
+ * StartPGDuckCopyIn creates a temporary table in pgduck_server with a
+ * VARCHAR column for each non-dropped column in the tuple descriptor and
+ * starts streaming rows into it.
+ */
+PGDuckCopyIn *
+StartPGDuckCopyIn(TupleDesc tupleDesc)
+{
+	PGDuckConnection *connection = GetPGDuckConnection();
+	PGDuckCopyIn *copyIn = palloc0(sizeof(PGDuckCopyIn));
+
+	copyIn->connection = connection;
+	copyIn->tableName = psprintf(COPY_IN_TABLE_PREFIX "%u", connection->connectionId);
+
+	StringInfoData createCommand;
+
+	initStringInfo(&createCommand);
+	appendStringInfo(&createCommand, "CREATE OR REPLACE TEMP TABLE %s (",
+					 copyIn->tableName);
+
+	bool		hasColumns = false;
+
+	for (int attnum = 1; attnum <= tupleDesc->natts; attnum++)
+	{
+		Form_pg_attribute column = TupleDescAttr(tupleDesc, attnum - 1);
+
+		if (column->attisdropped)
+			continue;
+
+		appendStringInfo(&createCommand, "%s%s VARCHAR",
+						 hasColumns ? ", " : "",
+						 quote_identifier(NameStr(column->attname)));
+
+		hasColumns = true;
+	}
+
+	appendStringInfoString(&createCommand, ")");
+
+	if (!hasColumns)
+		elog(ERROR, "cannot stream rows without columns");
+
+	/*
+	 * On errors, the connection is discarded at the end of the
+	 * (sub)transaction, since it might still be in COPY-in mode.
+	 */
+	PGresult   *result = ExecuteQueryOnPGDuckConnection(connection, createCommand.data);
+
+	CheckPGDuckResult(connection, result);
+	PQclear(result);
+
+	/* receive is only supported in the simple query protocol */
+	char	   *receiveCommand = psprintf("receive %s", copyIn->tableName);
+
+	if (!PQsendQuery(connection->conn, receiveCommand))
+		ereport(ERROR, (errmsg("lost connection to query engine")));
+
+	result = WaitForResult(connection);
+
+	if (PQresultStatus(result) != PGRES_COPY_IN)
+	{
+		/* throws if the result is an error */
+		CheckPGDuckResult(connection, result);
+
+		PQclear(result);
+		ereport(ERROR, (errmsg("unexpected response from query engine")));
+	}
+
+	PQclear(result);
+
+	copyIn->inProgress = true;
+
+	return copyIn;
+}
+
+
+/*
+ * SendPGDuckCopyInData sends a chunk of CSV data to pgduck_server. Chunks do
+ * not need to be aligned with rows.
+ *
+ * The copyIn argument is untyped such that the function can be used as a
+ * CSVDataCallback.
+ */
+void
+SendPGDuckCopyInData(void *copyIn, const char *data, int length)
+{
+	PGDuckConnection *connection = ((PGDuckCopyIn *) copyIn)->connection;
+
+	/*
+	 * Connections are in blocking mode, so this only returns after the data
+	 * is buffered or sent. Errors in pgduck_server are reported when we
+	 * finish.
+	 */
+	if (PQputCopyData(connection->conn, data, length) != 1)
+		ereport(ERROR, (errmsg("lost connection to query engine")));
+}
+
+
+/*
+ * FinishPGDuckCopyIn ends the stream of rows and returns the number of rows
+ * that pgduck_server received.
+ */
+int64
+FinishPGDuckCopyIn(PGDuckCopyIn * copyIn)
+{
+	PGDuckConnection *connection = copyIn->connection;
+
+	if (PQputCopyEnd(connection->conn, NULL) != 1)
+		ereport(ERROR, (errmsg("lost connection to query engine")));
+
+	copyIn->inProgress = false;
+
+	PGresult   *result = WaitForLastResult(connection);
+
+	CheckPGDuckResult(connection, result);
+
+	int64		rowCount = -1;
+	char	   *commandTuples = PQcmdTuples(result);
+
+	if (*commandTuples != '\0')
+		rowCount = atol(commandTuples);
+
+	PQclear(result);
+
+	return rowCount;
+}
+
+
+/*
+ * EndPGDuckCopyIn drops the temporary table and releases the connection.
+ *
+ * On errors, we do not get here and the connection is discarded at the end
+ * of the (sub)transaction, which also drops the temporary table.
+ */
+void
+EndPGDuckCopyIn(PGDuckCopyIn * copyIn)
+{
+	PGDuckConnection *connection = copyIn->connection;
+
+	if (copyIn->inProgress)
+	{
+		/* we cannot cleanly leave COPY-in mode without finishing */
+		connection->discardOnRelease = true;
+		ReleasePGDuckConnection(connection);
+		return;
+	}
+
+	List	   *commands =
+		list_make1(psprintf("DROP TABLE IF EXISTS %s", copyIn->tableName));
+
+	ExecuteCommandsOnPGDuckConnection(connection, commands);
+	ReleasePGDuckConnection(connection);
+}
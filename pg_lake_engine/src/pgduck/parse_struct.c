@@ -1224,6 +1224,35 @@ QuoteDuckDBFieldName(char *fieldName)
 }
 
 
+/*
+ * QuoteDuckDBLiteral quotes a string to be used as a DuckDB string literal.
+ *
+ * Unlike quote_literal_cstr, this never produces an E'' literal, which DuckDB
+ * does not support. Backslashes have no special meaning in DuckDB string
+ * literals, so only single quotes need to be doubled.
+ */
+char *
+QuoteDuckDBLiteral(const char *value)
+{
+	StringInfoData quoted;
+
+	initStringInfo(&quoted);
+	appendStringInfoChar(&quoted, '\'');
+
+	for (const char *position = value; *position; position++)
+	{
+		if (*position == '\'')
+			appendStringInfoChar(&quoted, '\'');
+
+		appendStringInfoChar(&quoted, *position);
+	}
+
+	appendStringInfoChar(&quoted, '\'');
+
+	return quoted.data;
+}
+
+
 /*
  * Get a CompositeType* object from a PostgreSQL type id.  This is guaranteed to
  * have populated all of the relevant fields in the object, walking the defined
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Functions for converting values in pgduck_server results into datums.
+ *
+ * When results are requested in binary format, pgduck_server sends columns
+ * of common scalar types in the binary format of a PostgreSQL type (the wire
+ * type), and all other columns as text. Binary values whose wire type matches
+ * the target type are passed to the receive function of the target type,
+ * which skips formatting and parsing text altogether.
+ */
+#include "postgres.h"
+
+#include "catalog/pg_type.h"
+#include "lib/stringinfo.h"
+#include "pg_lake/pgduck/client.h"
+#include "pg_lake/pgduck/result_conversion.h"
+#include "utils/lsyscache.h"
+
+static bool IsBinaryCompatibleWireType(Oid wireTypeId, Oid targetTypeId);
+
+
+/*
+ * InitPGDuckResultColumn prepares the conversion of values in the given
+ * result column into the target type. The result formats do not change
+ * between the batches of a query, so the column can be initialized from the
+ * first batch and reused. Function lookups are cached in the current memory
+ * context.
+ */
+void
+InitPGDuckResultColumn(PGDuckResultColumn * resultColumn, PGresult *result,
+					   int columnIndex, Oid targetTypeId)
+{
+	Oid			wireTypeId = PQftype(result, columnIndex);
+
+	memset(resultColumn, 0, sizeof(PGDuckResultColumn));
+
+	/*
+	 * Text values in binary format are identical to the text format, so we
+	 * can use the input function like we do for text columns.
+	 */
+	if (PQfformat(result, columnIndex) != PGDUCK_BINARY_RESULT_FORMAT ||
+		wireTypeId == TEXTOID)
+		return;
+
+	Oid			receiveFunctionId = InvalidOid;
+
+	resultColumn->isBinary = true;
+	resultColumn->receiveAsTarget =
+		IsBinaryCompatibleWireType(wireTypeId, getBaseType(targetTypeId));
+
+	if (resultColumn->receiveAsTarget)
+	{
+		/* use the receive function of the target type, to support domains */
+		getTypeBinaryInputInfo(targetTypeId, &receiveFunctionId,
+							   &resultColumn->receiveIOParam);
+	}
+	else
+	{
+		Oid			outputFunctionId = InvalidOid;
+		bool		isVarlena = false;
+
+		getTypeBinaryInputInfo(wireTypeId, &receiveFunctionId,
+							   &resultColumn->receiveIOParam);
+		getTypeOutputInfo(wireTypeId, &outputFunctionId, &isVarlena);
+		fmgr_info(outputFunctionId, &resultColumn->wireOutputFunction);
+	}
+
+	fmgr_info(receiveFunctionId, &resultColumn->receiveFunction);
+}
+
+
+/*
+ * PGDuckResultValueToDatum converts the value at the given row and column
+ * into a datum of the target type, whose input function is given.
+ */
+Datum
+PGDuckResultValueToDatum(PGDuckResultColumn * resultColumn, PGresult *result,
+						 int rowIndex, int columnIndex,
+						 FmgrInfo *inputFunction, Oid inputIOParam, int32 typmod)
+{
+	bool		isNull = PQgetisnull(result, rowIndex, columnIndex);
+	char	   *value = isNull ? NULL : PQgetvalue(result, rowIndex, columnIndex);
+
+	if (!resultColumn->isBinary)
+	{
+		/* apply the input function even to nulls, to support domains */
+		return InputFunctionCall(inputFunction, value, inputIOParam, typmod);
+	}
+
+	if (isNull)
+	{
+		if (resultColumn->receiveAsTarget)
+			return ReceiveFunctionCall(&resultColumn->receiveFunction, NULL,
+									   resultColumn->receiveIOParam, typmod);
+
+		return InputFunctionCall(inputFunction, NULL, inputIOParam, typmod);
+	}
+
+	/* libpq null-terminates binary values as well */
+	StringInfoData buffer;
+
+	buffer.data = value;
+	buffer.len = PQgetlength(result, rowIndex, columnIndex);
+	buffer.maxlen = buffer.len + 1;
+	buffer.cursor = 0;
+
+	int32		receiveTypmod = resultColumn->receiveAsTarget ? typmod : -1;
+	Datum		datum = ReceiveFunctionCall(&resultColumn->receiveFunction, &buffer,
+											resultColumn->receiveIOParam,
+											receiveTypmod);
+
+	if (buffer.cursor != buffer.len)
+		ereport(ERROR, (errcode(ERRCODE_INVALID_BINARY_REPRESENTATION),
+						errmsg("incorrect binary data format in query engine result")));
+
+	if (resultColumn->receiveAsTarget)
+		return datum;
+
+	/* convert the wire type into the target type via text */
+	char	   *textValue = OutputFunctionCall(&resultColumn->wireOutputFunction, datum);
+
+	return InputFunctionCall(inputFunction, textValue, inputIOParam, typmod);
+}
+
+
+/*
+ * IsBinaryCompatibleWireType returns whether values of the wire type can be
+ * received directly by the receive function of the target type.
+ */
+static bool
+IsBinaryCompatibleWireType(Oid wireTypeId, Oid targetTypeId)
+{
+	if (wireTypeId == targetTypeId)
+		return true;
+
+	/*
+	 * The query engine sends timestamptz in UTC, and converting the text
+	 * format to a timestamp drops the time zone, which gives the same result
+	 * as receiving the UTC value as a timestamp.
+	 */
+	if (wireTypeId == TIMESTAMPTZOID && targetTypeId == TIMESTAMPOID)
+		return true;
+
+	return false;
+}
@@ -30,6 +30,7 @@
 #include "pg_lake/parquet/geoparquet.h"
 #include "pg_lake/parsetree/options.h"
 #include "pg_lake/pgduck/client.h"
+#include "pg_lake/pgduck/copy_in.h"
 #include "pg_lake/pgduck/numeric.h"
 #include "pg_lake/pgduck/read_data.h"
 #include "pg_lake/pgduck/type.h"
@@ -43,6 +44,16 @@
 static char *TupleDescToProjectionListForWrite(TupleDesc tupleDesc,
 											   CopyDataFormat destinationFormat);
 static char *TupleDescToColumnMapForWrite(TupleDesc tupleDesc, CopyDataFormat destinationFormat);
+static char *TupleDescToCastListForWrite(TupleDesc tupleDesc, CopyDataFormat destinationFormat);
+static PendingWrite * StartWriteQueryResult(PGDuckConnection * pgDuckConn,
+											char *query,
+											char *destinationPath,
+											CopyDataFormat destinationFormat,
+											CopyDataCompression destinationCompression,
+											List *formatOptions,
+											bool queryHasRowId,
+											DataFileSchema * schema,
+											TupleDesc queryTupleDesc);
 static DuckDBTypeInfo ChooseDuckDBEngineTypeForWrite(PGType postgresType,
 													 CopyDataFormat destinationFormat);
 static void AppendFieldIdValue(StringInfo map, Field * field, int fieldId);
@@ -70,6 +81,32 @@ ConvertCSVFileTo(char *csvFilePath, TupleDesc csvTupleDesc, int maxLineSize,
 				 CopyDataCompression destinationCompression,
 				 List *formatOptions,
 				 DataFileSchema * schema)
+{
+	PendingWrite *write = StartConvertCSVFileTo(csvFilePath, csvTupleDesc, maxLineSize,
+												destinationPath,
+												destinationFormat,
+												destinationCompression,
+												formatOptions,
+												schema);
+
+	FinishPendingWrite(write);
+}
+
+
+/*
+ * StartConvertCSVFileTo starts converting a CSV file like ConvertCSVFileTo
+ * on a separate connection, without waiting for it to complete.
+ *
+ * The caller should call FinishPendingWrite on the result, and should keep
+ * the CSV file until then.
+ */
+PendingWrite *
+StartConvertCSVFileTo(char *csvFilePath, TupleDesc csvTupleDesc, int maxLineSize,
+					  char *destinationPath,
+					  CopyDataFormat destinationFormat,
+					  CopyDataCompression destinationCompression,
+					  List *formatOptions,
+					  DataFileSchema * schema)
 {
 	StringInfoData command;
 
@@ -132,14 +169,63 @@ ConvertCSVFileTo(char *csvFilePath, TupleDesc csvTupleDesc, int maxLineSize,
 
 	bool		queryHasRowIds = false;
 
-	WriteQueryResultTo(command.data,
-					   destinationPath,
-					   destinationFormat,
-					   destinationCompression,
-					   formatOptions,
-					   queryHasRowIds,
-					   schema,
-					   csvTupleDesc);
+	return StartWriteQueryResult(NULL,
+								 command.data,
+								 destinationPath,
+								 destinationFormat,
+								 destinationCompression,
+								 formatOptions,
+								 queryHasRowIds,
+								 schema,
+								 csvTupleDesc);
+}
+
+
+/*
+ * StartConvertPGDuckCopyInTo starts copying and converting the rows that were
+ * streamed into pgduck_server to the destinationPath, without waiting for it
+ * to complete.
+ *
+ * The rows were sent as CSV generated by csv_writer.c and stored as VARCHAR,
+ * so we apply the same casts as read_csv would in ConvertCSVFileTo. The
+ * conversion runs on the connection of the stream, since the temporary table
+ * is only visible there.
+ *
+ * The caller should call FinishPendingWrite on the result before
+ * EndPGDuckCopyIn.
+ */
+PendingWrite *
+StartConvertPGDuckCopyInTo(PGDuckCopyIn * copyIn, TupleDesc tupleDesc,
+						   char *destinationPath,
+						   CopyDataFormat destinationFormat,
+						   CopyDataCompression destinationCompression,
+						   List *formatOptions,
+						   DataFileSchema * schema)
+{
+	StringInfoData command;
+
+	initStringInfo(&command);
+
+	/* project columns into target format */
+	appendStringInfo(&command, "SELECT %s",
+					 TupleDescToProjectionListForWrite(tupleDesc, destinationFormat));
+
+	/* cast the received text to the engine types */
+	appendStringInfo(&command, " FROM (SELECT %s FROM %s)",
+					 TupleDescToCastListForWrite(tupleDesc, destinationFormat),
+					 copyIn->tableName);
+
+	bool		queryHasRowIds = false;
+
+	return StartWriteQueryResult(copyIn->connection,
+								 command.data,
+								 destinationPath,
+								 destinationFormat,
+								 destinationCompression,
+								 formatOptions,
+								 queryHasRowIds,
+								 schema,
+								 tupleDesc);
 }
 
 
@@ -157,6 +243,62 @@ WriteQueryResultTo(char *query,
 				   bool queryHasRowId,
 				   DataFileSchema * schema,
 				   TupleDesc queryTupleDesc)
+{
+	PendingWrite *write = StartWriteQueryResultTo(query,
+												  destinationPath,
+												  destinationFormat,
+												  destinationCompression,
+												  formatOptions,
+												  queryHasRowId,
+												  schema,
+												  queryTupleDesc);
+
+	return FinishPendingWrite(write);
+}
+
+
+/*
+ * StartWriteQueryResultTo starts writing the result of a query like
+ * WriteQueryResultTo on a separate connection, without waiting for it
+ * to complete. The caller should call FinishPendingWrite on the result.
+ */
+PendingWrite *
+StartWriteQueryResultTo(char *query,
+						char *destinationPath,
+						CopyDataFormat destinationFormat,
+						CopyDataCompression destinationCompression,
+						List *formatOptions,
+						bool queryHasRowId,
+						DataFileSchema * schema,
+						TupleDesc queryTupleDesc)
+{
+	return StartWriteQueryResult(NULL,
+								 query,
+								 destinationPath,
+								 destinationFormat,
+								 destinationCompression,
+								 formatOptions,
+								 queryHasRowId,
+								 schema,
+								 queryTupleDesc);
+}
+
+
+/*
+ * StartWriteQueryResult sends the command for WriteQueryResultTo on the given
+ * connection, or on a connection from the pool if pgDuckConn is NULL, and
+ * returns without waiting for the result.
+ */
+static PendingWrite *
+StartWriteQueryResult(PGDuckConnection * pgDuckConn,
+					  char *query,
+					  char *destinationPath,
+					  CopyDataFormat destinationFormat,
+					  CopyDataCompression destinationCompression,
+					  List *formatOptions,
+					  bool queryHasRowId,
+					  DataFileSchema * schema,
+					  TupleDesc queryTupleDesc)
 {
 	StringInfoData command;
 
@@ -383,9 +525,22 @@ WriteQueryResultTo(char *query,
 			elog(ERROR, "unexpected format: %s", formatName);
 	}
 
+	/*
+	 * DuckDB writes to a temporary file and renames it when the destination
+	 * already exists, unless use_tmp_file is off. Writers that create the
+	 * destination themselves (e.g. a named pipe) turn it off.
+	 */
+	if (!GetBoolOption(formatOptions, "use_tmp_file", true))
+		appendStringInfoString(&command, ", use_tmp_file false");
+
 	/* end WITH options */
 	appendStringInfoString(&command, ")");
 
+	PendingWrite *write = palloc0(sizeof(PendingWrite));
+
+	write->releaseConnection = pgDuckConn == NULL;
+	write->connection = pgDuckConn != NULL ? pgDuckConn : GetPGDuckConnection();
+
 	if (TargetRowGroupSizeMB > 0)
 	{
 		/*
@@ -395,18 +550,83 @@ WriteQueryResultTo(char *query,
 		 * simplicity we use the same setting TargetRowGroupSizeMB for all
 		 * formats.
 		 */
-		List	   *commands = list_make3("SET preserve_insertion_order TO 'false';",
-										  command.data,
-										  "RESET preserve_insertion_order;");
+		List	   *commands = list_make1("SET preserve_insertion_order TO 'false';");
 
-		List	   *rowsAffected = ExecuteCommandsInPGDuck(commands);
+		PG_TRY();
+		{
+			ExecuteCommandsOnPGDuckConnection(write->connection, commands);
+		}
+		PG_CATCH();
+		{
+			/* the connection is already marked to be discarded */
+			if (write->releaseConnection)
+				ReleasePGDuckConnection(write->connection);
+			PG_RE_THROW();
+		}
+		PG_END_TRY();
 
-		return list_nth_int(rowsAffected, 1);
+		write->resetInsertionOrder = true;
 	}
-	else
+
+	SendQueryToPGDuck(write->connection, command.data);
+
+	return write;
+}
+
+
+/*
+ * FinishPendingWrite waits for a write started by one of the Start functions
+ * to complete and returns the number of rows written.
+ *
+ * On error, the connection is marked to be discarded. It is also released
+ * if the write obtained it, whereas a connection passed in by the caller
+ * (e.g. during COPY-in) is left for the caller to release.
+ */
+int64
+FinishPendingWrite(PendingWrite * write)
+{
+	PGDuckConnection *pgDuckConn = write->connection;
+	int64		rowsAffected = -1;
+
+	PG_TRY();
+	{
+		PGresult   *result = WaitForLastResult(pgDuckConn);
+
+		CheckPGDuckResult(pgDuckConn, result);
+
+		char	   *commandTuples = PQcmdTuples(result);
+
+		if (*commandTuples != '\0')
+			rowsAffected = atol(commandTuples);
+
+		PQclear(result);
+
+		if (write->resetInsertionOrder)
+		{
+			List	   *commands = list_make1("RESET preserve_insertion_order;");
+
+			ExecuteCommandsOnPGDuckConnection(pgDuckConn, commands);
+		}
+	}
+	PG_CATCH();
 	{
-		return ExecuteCommandInPGDuck(command.data);
+		/*
+		 * The connection may still have preserve_insertion_order disabled,
+		 * so it should not be reused.
+		 */
+		pgDuckConn->discardOnRelease = true;
+
+		if (write->releaseConnection)
+			ReleasePGDuckConnection(pgDuckConn);
+
+		PG_RE_THROW();
 	}
+	PG_END_TRY();
+
+	if (write->releaseConnection)
+		ReleasePGDuckConnection(pgDuckConn);
+
+	return rowsAffected;
 }
 
 
@@ -514,6 +734,45 @@ TupleDescToColumnMapForWrite(TupleDesc tupleDesc, CopyDataFormat destinationForm
 }
 
 
+/*
+ * TupleDescToCastListForWrite converts a PostgreSQL tuple descriptor to
+ * a list of casts from VARCHAR columns of the same name to the DuckDB
+ * engine types, matching TupleDescToColumnMapForWrite.
+ */
+static char *
+TupleDescToCastListForWrite(TupleDesc tupleDesc, CopyDataFormat destinationFormat)
+{
+	StringInfoData castList;
+
+	initStringInfo(&castList);
+
+	bool		hasColumns = false;
+
+	for (int attnum = 1; attnum <= tupleDesc->natts; attnum++)
+	{
+		Form_pg_attribute column = TupleDescAttr(tupleDesc, attnum - 1);
+
+		if (column->attisdropped)
+			continue;
+
+		const char *columnName = quote_identifier(NameStr(column->attname));
+		DuckDBTypeInfo duckdbType =
+			ChooseDuckDBEngineTypeForWrite(MakePGType(column->atttypid, column->atttypmod),
+										   destinationFormat);
+
+		appendStringInfo(&castList, "%sCAST(%s AS %s) AS %s",
+						 hasColumns ? ", " : "",
+						 columnName,
+						 duckdbType.typeName,
+						 columnName);
+
+		hasColumns = true;
+	}
+
+	return castList.data;
+}
+
+
 /*
  * AppendFields appends comma-separated mappings from
  * a field name to a field ID to a DuckDB map in string form.
@@ -66,6 +66,16 @@ INT16ListToArray(List *stringList)
 }
 
 
+/*
+* Int64ListToArray converts a list of int64 * values to an int8 array.
+*/
+ArrayType *
+Int64ListToArray(List *int64List)
+{
+	return ListToArray(int64List, INT8OID);
+}
+
+
 /*
 * Generic function to convert a list to an array.
 * The 'elementType' should be the type of the elements in the
@@ -90,6 +100,12 @@ ListToArray(List *list, Oid elementType)
 
 			datums[datumIndex] = Int16GetDatum(val);
 		}
+		else if (elementType == INT8OID)
+		{
+			int64	   *val = (int64 *) lfirst(cell);
+
+			datums[datumIndex] = Int64GetDatum(*val);
+		}
 		else if (elementType == TEXTOID)
 		{
 			char	   *val = (char *) lfirst(cell);
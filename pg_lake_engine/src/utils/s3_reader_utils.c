@@ -24,10 +24,23 @@
 #include "pg_lake/util/s3_reader_utils.h"
 #include "utils/builtins.h"
 
+/*
+ * Maximum number of blob files to read in a single query, which bounds the
+ * length of the query and the number of concurrent downloads.
+ */
+#define MAX_BLOB_FILES_PER_QUERY 128
+
+static void GetBlobBatch(List *blobFileUris, List *blobIndexes,
+						 BlobReceiveFunction receiveFn, void *context);
+static bool HasGlobCharacters(const char *uri);
 static char *ReadTextContent(const char *command);
 static char *ReadBlobContent(const char *command, size_t *contentLength);
 static char *ReadTextFileCommand(const char *textFileUri);
 static char *ReadBlobFileCommand(const char *blobFileUri);
+static char *ReadBlobFilesCommand(List *blobFileUris);
+static void ReceiveBlobRow(PGresult *result, int rowIndex, List *blobFileUris,
+						   List *blobIndexes, bool *received,
+						   BlobReceiveFunction receiveFn, void *context);
 
 /*
 * GetTextFromURI reads the content of a text file.
@@ -49,6 +62,186 @@ GetBlobFromURI(const char *blobFileUri, size_t *contentLength)
 	return ReadBlobContent(ReadBlobFileCommand(blobFileUri), contentLength);
 }
 
+/*
+ * GetBlobsFromURIs reads the content of multiple blob files in batches of
+ * up to MAX_BLOB_FILES_PER_QUERY files per query, such that the query engine
+ * downloads them concurrently.
+ *
+ * read_blob() expands glob patterns, and we match the returned rows to the
+ * URIs by file name, so URIs that contain glob characters are read one at a
+ * time instead.
+ *
+ * The receive function is called for each blob as soon as it arrives, in
+ * the order of arrival, with the index of the URI in blobFileUris. The
+ * content is only valid during the call.
+ */
+void
+GetBlobsFromURIs(List *blobFileUris, BlobReceiveFunction receiveFn, void *context)
+{
+	List	   *batchUris = NIL;
+	List	   *batchIndexes = NIL;
+	ListCell   *uriCell = NULL;
+
+	foreach(uriCell, blobFileUris)
+	{
+		char	   *blobFileUri = lfirst(uriCell);
+		int			blobIndex = foreach_current_index(uriCell);
+
+		if (HasGlobCharacters(blobFileUri))
+		{
+			size_t		contentLength = 0;
+			char	   *content = GetBlobFromURI(blobFileUri, &contentLength);
+
+			receiveFn(blobIndex, content, contentLength, context);
+			pfree(content);
+			continue;
+		}
+
+		batchUris = lappend(batchUris, blobFileUri);
+		batchIndexes = lappend_int(batchIndexes, blobIndex);
+
+		if (list_length(batchUris) >= MAX_BLOB_FILES_PER_QUERY)
+		{
+			GetBlobBatch(batchUris, batchIndexes, receiveFn, context);
+
+			list_free(batchUris);
+			list_free(batchIndexes);
+			batchUris = NIL;
+			batchIndexes = NIL;
+		}
+	}
+
+	GetBlobBatch(batchUris, batchIndexes, receiveFn, context);
+
+	list_free(batchUris);
+	list_free(batchIndexes);
+}
+
+
+/*
+ * GetBlobBatch reads the given blob files in a single query and passes them
+ * to the receive function along with their index in blobIndexes.
+ */
+static void
+GetBlobBatch(List *blobFileUris, List *blobIndexes,
+			 BlobReceiveFunction receiveFn, void *context)
+{
+	if (blobFileUris == NIL)
+		return;
+
+	int			blobCount = list_length(blobFileUris);
+	bool	   *received = palloc0(blobCount * sizeof(bool));
+	char	   *command = ReadBlobFilesCommand(blobFileUris);
+
+	PGDuckConnection *pgDuckConn = GetPGDuckConnection();
+
+	PG_TRY();
+	{
+		/* receive one blob at a time, to decode it while others arrive */
+		SendQueryWithResultFormat(pgDuckConn, command, 0, NULL,
+								  PGDUCK_BINARY_RESULT_FORMAT, 1);
+
+		PGresult   *result = NULL;
+
+		while ((result = WaitForResult(pgDuckConn)) != NULL)
+		{
+			/* make sure we PQclear the result */
+			PG_TRY();
+			{
+				ThrowIfPGDuckResultHasError(pgDuckConn, result);
+
+				for (int rowIndex = 0; rowIndex < PQntuples(result); rowIndex++)
+					ReceiveBlobRow(result, rowIndex, blobFileUris, blobIndexes,
+								   received, receiveFn, context);
+			}
+			PG_FINALLY();
+			{
+				PQclear(result);
+			}
+			PG_END_TRY();
+		}
+	}
+	PG_FINALLY();
+	{
+		ReleasePGDuckConnection(pgDuckConn);
+	}
+	PG_END_TRY();
+
+	for (int blobIndex = 0; blobIndex < blobCount; blobIndex++)
+	{
+		if (!received[blobIndex])
+			elog(ERROR, "could not read blob file %s",
+				 (char *) list_nth(blobFileUris, blobIndex));
+	}
+
+	pfree(received);
+	pfree(command);
+}
+
+
+/*
+ * HasGlobCharacters returns whether read_blob() would treat the URI as a
+ * glob pattern.
+ */
+static bool
+HasGlobCharacters(const char *uri)
+{
+	return strpbrk(uri, "*?[") != NULL;
+}
+
+
+/*
+ * ReceiveBlobRow passes the blob in the given row of a read_blob() result to
+ * the receive function, once for each occurrence of its file name in the
+ * list of URIs.
+ */
+static void
+ReceiveBlobRow(PGresult *result, int rowIndex, List *blobFileUris,
+			   List *blobIndexes, bool *received,
+			   BlobReceiveFunction receiveFn, void *context)
+{
+	char	   *fileName = PQgetvalue(result, rowIndex, 0);
+	char	   *blobContent = PQgetvalue(result, rowIndex, 1);
+	size_t		contentLength = PQgetlength(result, rowIndex, 1);
+	char	   *unescapedContent = NULL;
+
+	if (PQfformat(result, 1) != PGDUCK_BINARY_RESULT_FORMAT)
+	{
+		/* the server sent the blob as text after all */
+		unescapedContent = (char *) PQunescapeBytea((unsigned char *) blobContent,
+													&contentLength);
+
+		if (unescapedContent == NULL)
+			elog(ERROR, "Failed to unescape bytea data");
+
+		blobContent = unescapedContent;
+	}
+
+	PG_TRY();
+	{
+		ListCell   *uriCell = NULL;
+
+		foreach(uriCell, blobFileUris)
+		{
+			int			batchIndex = foreach_current_index(uriCell);
+
+			if (received[batchIndex] || strcmp(lfirst(uriCell), fileName) != 0)
+				continue;
+
+			received[batchIndex] = true;
+			receiveFn(list_nth_int(blobIndexes, batchIndex), blobContent,
+					  contentLength, context);
+		}
+	}
+	PG_FINALLY();
+	{
+		if (unescapedContent != NULL)
+			PQfreemem(unescapedContent);
+	}
+	PG_END_TRY();
+}
+
+
 /*
 * ReadTextContent reads the content of a text file from the PGDuck server.
 * The input command should be read_text(), and the
@@ -90,6 +283,9 @@ ReadTextContent(const char *command)
 * The input command should be read_blob(), and the result should be a single
 * row with a single column.
 *
+* We request the result in binary format, such that the blob is sent as raw
+* bytes rather than as hex-escaped text of twice the size.
+*
 * !!NOTE!!: Caller is responsible for freeing the returned content.
 */
 static char *
@@ -97,9 +293,8 @@ ReadBlobContent(const char *command, size_t *contentLength)
 {
 	PGDuckConnection *pgDuckConn = GetPGDuckConnection();
 	PGresult   *result =
-		ExecuteQueryOnPGDuckConnection(pgDuckConn, command);
+		ExecuteBinaryQueryOnPGDuckConnection(pgDuckConn, command);
 
-	char	   *blobContent = NULL;
 	char	   *blobContentCopy = NULL;
 
 	/* make sure we PQclear the result */
@@ -112,18 +307,30 @@ ReadBlobContent(const char *command, size_t *contentLength)
 		if (rowCount != 1)
 			elog(ERROR, "Expected 1 row while reading blob file, got %d", rowCount);
 
-		blobContent = PQgetvalue(result, 0, 0);
-		blobContent = (char *) PQunescapeBytea((unsigned char *) blobContent, contentLength);
+		char	   *blobContent = PQgetvalue(result, 0, 0);
 
-		if (blobContent == NULL)
+		if (PQfformat(result, 0) == PGDUCK_BINARY_RESULT_FORMAT)
 		{
-			elog(ERROR, "Failed to unescape bytea data");
+			*contentLength = PQgetlength(result, 0, 0);
+
+			blobContentCopy = palloc(*contentLength);
+			memcpy(blobContentCopy, blobContent, *contentLength);
 		}
+		else
+		{
+			/* the server sent the blob as text after all */
+			blobContent = (char *) PQunescapeBytea((unsigned char *) blobContent, contentLength);
 
-		blobContentCopy = palloc0(*contentLength);
-		memcpy(blobContentCopy, blobContent, *contentLength);
+			if (blobContent == NULL)
+			{
+				elog(ERROR, "Failed to unescape bytea data");
+			}
 
-		PQfreemem(blobContent);
+			blobContentCopy = palloc0(*contentLength);
+			memcpy(blobContentCopy, blobContent, *contentLength);
+
+			PQfreemem(blobContent);
+		}
 	}
 	PG_FINALLY();
 	{
@@ -169,3 +376,31 @@ ReadBlobFileCommand(const char *blobFileUri)
 
 	return command.data;
 }
+
+/*
+* ReadBlobFilesCommand returns the SQL command to read the file names and
+* contents of a list of blob files.
+*/
+static char *
+ReadBlobFilesCommand(List *blobFileUris)
+{
+	StringInfoData command;
+
+	initStringInfo(&command);
+
+	appendStringInfoString(&command, "SELECT filename, content FROM read_blob([");
+
+	ListCell   *uriCell = NULL;
+
+	foreach(uriCell, blobFileUris)
+	{
+		if (foreach_current_index(uriCell) > 0)
+			appendStringInfoString(&command, ", ");
+
+		appendStringInfoString(&command, quote_literal_cstr(lfirst(uriCell)));
+	}
+
+	appendStringInfoString(&command, "])");
+
+	return command.data;
+}
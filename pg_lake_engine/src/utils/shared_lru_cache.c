@@ -0,0 +1,502 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * shared_lru_cache.c - bounded key-value cache in shared memory
+ *
+ * A shared LRU cache maps byte string keys to byte string values that are
+ * shared by all backends. Entries are stored in a DSA area that lives in the
+ * main shared memory segment and is never extended, which bounds the size
+ * of the cache. When the area is full, the least recently used entries are
+ * evicted.
+ *
+ * The hash only stores a hash of the key. The full key is stored in the DSA
+ * area along with the value to detect hash collisions.
+ *
+ * The owning extension creates the cache in _PG_init when it is loaded via
+ * shared_preload_libraries, and calls SharedLRUCacheShmemSize and
+ * SharedLRUCacheShmemInit from its shared memory hooks.
+ */
+#include "postgres.h"
+#include "miscadmin.h"
+
+#include "common/hashfn.h"
+#include "lib/ilist.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/dsa.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+
+#include "pg_lake/util/shared_lru_cache.h"
+
+/* values that need more than 1/N of the cache are not cached */
+#define SHARED_LRU_CACHE_MAX_ENTRY_FRACTION 4
+
+/* expected size of an entry, used to size the hash table */
+#define SHARED_LRU_CACHE_EXPECTED_ENTRY_SIZE_KB 16
+
+#define SHARED_LRU_CACHE_MIN_ENTRIES 64
+
+
+/*
+ * SharedLRUCacheKey is the key of the cache hash.
+ */
+typedef struct SharedLRUCacheKey
+{
+	uint64		keyHash;
+}			SharedLRUCacheKey;
+
+/*
+ * SharedLRUCacheEntry is an entry in the cache hash.
+ */
+typedef struct SharedLRUCacheEntry
+{
+	SharedLRUCacheKey key;
+
+	/* position in the LRU list, most recently used first */
+	dlist_node	lruNode;
+
+	/* full key followed by the value */
+	dsa_pointer data;
+	size_t		keySize;
+	size_t		dataSize;
+}			SharedLRUCacheEntry;
+
+/*
+ * SharedLRUCacheControlData is the shared memory control data of a cache.
+ * It is followed by the in-place DSA area.
+ */
+typedef struct SharedLRUCacheControlData
+{
+	int			trancheId;
+	char	   *lockTrancheName;
+
+	/* protects the hash, the LRU list and the counters */
+	LWLock		lock;
+
+	dlist_head	lruList;
+	int			entryCount;
+	size_t		usedBytes;
+
+	uint64		hits;
+	uint64		misses;
+	uint64		evictions;
+}			SharedLRUCacheControlData;
+
+/*
+ * SharedLRUCache is the backend-local handle of a cache.
+ */
+struct SharedLRUCache
+{
+	/* name of the shared memory structures and the lock tranche */
+	const char *name;
+
+	/* size of the DSA area */
+	size_t		areaSize;
+
+	/* maximum number of entries in the hash */
+	int			maxEntries;
+
+	SharedLRUCacheControlData *control;
+	HTAB	   *hash;
+
+	/* per-backend attachment of the DSA area */
+	dsa_area   *area;
+};
+
+
+static void *SharedLRUCacheAreaPlace(SharedLRUCache * cache);
+static dsa_area *GetSharedLRUCacheArea(SharedLRUCache * cache);
+static SharedLRUCacheKey SharedLRUCacheKeyForBytes(const char *key, size_t keySize);
+static bool SharedLRUCacheEntryHasKey(dsa_area * area, SharedLRUCacheEntry * entry,
+									  const char *key, size_t keySize);
+static void EvictLeastRecentlyUsedEntry(SharedLRUCache * cache);
+static void RemoveSharedLRUCacheEntry(SharedLRUCache * cache,
+									  SharedLRUCacheEntry * entry);
+
+
+/*
+ * CreateSharedLRUCache creates the handle of a shared LRU cache of the given
+ * size. The shared memory is requested and initialized separately.
+ */
+SharedLRUCache *
+CreateSharedLRUCache(const char *name, int sizeKB)
+{
+	SharedLRUCache *cache = MemoryContextAllocZero(TopMemoryContext,
+												   sizeof(SharedLRUCache));
+
+	cache->name = MemoryContextStrdup(TopMemoryContext, name);
+	cache->areaSize = Max((size_t) sizeKB * 1024, dsa_minimum_size());
+	cache->maxEntries = Max(sizeKB / SHARED_LRU_CACHE_EXPECTED_ENTRY_SIZE_KB,
+							SHARED_LRU_CACHE_MIN_ENTRIES);
+
+	return cache;
+}
+
+
+/*
+ * SharedLRUCacheShmemSize computes how much shared memory the cache requires.
+ */
+size_t
+SharedLRUCacheShmemSize(SharedLRUCache * cache)
+{
+	Size		size = 0;
+
+	size = add_size(size, MAXALIGN(sizeof(SharedLRUCacheControlData)));
+	size = add_size(size, cache->areaSize);
+	size = add_size(size, hash_estimate_size(cache->maxEntries,
+											 sizeof(SharedLRUCacheEntry)));
+
+	return size;
+}
+
+
+/*
+ * SharedLRUCacheShmemInit initializes the control data, the DSA area and
+ * the hash of the cache, or attaches to them if they already exist.
+ */
+void
+SharedLRUCacheShmemInit(SharedLRUCache * cache)
+{
+	bool		alreadyInitialized = false;
+	Size		controlSize = MAXALIGN(sizeof(SharedLRUCacheControlData)) +
+		cache->areaSize;
+
+	LWLockAcquire(AddinShmemInitLock, LW_EXCLUSIVE);
+
+	cache->control =
+		(SharedLRUCacheControlData *) ShmemInitStruct(cache->name,
+													  controlSize,
+													  &alreadyInitialized);
+
+	if (!alreadyInitialized)
+	{
+		SharedLRUCacheControlData *control = cache->control;
+
+		memset(control, 0, sizeof(SharedLRUCacheControlData));
+
+		control->trancheId = LWLockNewTrancheId();
+		control->lockTrancheName = (char *) cache->name;
+
+		LWLockRegisterTranche(control->trancheId, control->lockTrancheName);
+		LWLockInitialize(&control->lock, control->trancheId);
+
+		dlist_init(&control->lruList);
+
+		dsa_area   *area = dsa_create_in_place(SharedLRUCacheAreaPlace(cache),
+											   cache->areaSize,
+											   control->trancheId,
+											   NULL);
+
+		/* keep the area around when no backend is attached */
+		dsa_pin(area);
+
+		/* never create DSM segments, such that the size of the cache is bounded */
+		dsa_set_size_limit(area, cache->areaSize);
+
+		dsa_detach(area);
+	}
+
+	HASHCTL		hashInfo;
+
+	memset(&hashInfo, 0, sizeof(hashInfo));
+	hashInfo.keysize = sizeof(SharedLRUCacheKey);
+	hashInfo.entrysize = sizeof(SharedLRUCacheEntry);
+	hashInfo.hash = tag_hash;
+	int			hashFlags = (HASH_ELEM | HASH_FUNCTION);
+
+	char	   *hashName = psprintf("%s hash", cache->name);
+
+	cache->hash = ShmemInitHash(hashName, cache->maxEntries, cache->maxEntries,
+								&hashInfo, hashFlags);
+
+	LWLockRelease(AddinShmemInitLock);
+}
+
+
+/*
+ * SharedLRUCacheIsReady returns whether the shared memory of the cache is
+ * initialized.
+ */
+bool
+SharedLRUCacheIsReady(SharedLRUCache * cache)
+{
+	return cache != NULL && cache->control != NULL;
+}
+
+
+/*
+ * SharedLRUCacheMaxEntrySize returns the maximum size of a cached value,
+ * including its key.
+ */
+size_t
+SharedLRUCacheMaxEntrySize(SharedLRUCache * cache)
+{
+	return cache->areaSize / SHARED_LRU_CACHE_MAX_ENTRY_FRACTION;
+}
+
+
+/*
+ * SharedLRUCacheAreaPlace returns the address of the in-place DSA area.
+ */
+static void *
+SharedLRUCacheAreaPlace(SharedLRUCache * cache)
+{
+	return (char *) cache->control + MAXALIGN(sizeof(SharedLRUCacheControlData));
+}
+
+
+/*
+ * GetSharedLRUCacheArea attaches to the DSA area of the cache, if the
+ * current backend is not yet attached, and returns it.
+ */
+static dsa_area *
+GetSharedLRUCacheArea(SharedLRUCache * cache)
+{
+	if (cache->area == NULL)
+	{
+		MemoryContext oldContext = MemoryContextSwitchTo(TopMemoryContext);
+
+		cache->area = dsa_attach_in_place(SharedLRUCacheAreaPlace(cache), NULL);
+
+		/* stay attached until the backend exits */
+		dsa_pin_mapping(cache->area);
+
+		MemoryContextSwitchTo(oldContext);
+	}
+
+	return cache->area;
+}
+
+
+/*
+ * SharedLRUCacheLookup looks up the value for the given key. If found, it
+ * sets value to a copy in the current memory context and returns true. The
+ * copy is MAXALIGNed, since it comes from palloc.
+ */
+bool
+SharedLRUCacheLookup(SharedLRUCache * cache, const char *key, size_t keySize,
+					 char **value, size_t *valueSize)
+{
+	SharedLRUCacheControlData *control = cache->control;
+	dsa_area   *area = GetSharedLRUCacheArea(cache);
+	SharedLRUCacheKey hashKey = SharedLRUCacheKeyForBytes(key, keySize);
+	char	   *cachedValue = NULL;
+	size_t		cachedSize = 0;
+
+	/* moving the entry in the LRU list requires an exclusive lock */
+	LWLockAcquire(&control->lock, LW_EXCLUSIVE);
+
+	SharedLRUCacheEntry *entry = hash_search(cache->hash, &hashKey, HASH_FIND, NULL);
+
+	if (entry != NULL && SharedLRUCacheEntryHasKey(area, entry, key, keySize))
+	{
+		char	   *data = dsa_get_address(area, entry->data);
+
+		cachedSize = entry->dataSize - entry->keySize;
+		cachedValue = palloc(Max(cachedSize, 1));
+		memcpy(cachedValue, data + entry->keySize, cachedSize);
+
+		dlist_move_head(&control->lruList, &entry->lruNode);
+		control->hits++;
+	}
+	else
+	{
+		control->misses++;
+	}
+
+	LWLockRelease(&control->lock);
+
+	if (cachedValue == NULL)
+		return false;
+
+	*value = cachedValue;
+	*valueSize = cachedSize;
+
+	return true;
+}
+
+
+/*
+ * SharedLRUCacheInsert adds the value for the given key to the cache,
+ * evicting the least recently used entries if the cache is full.
+ */
+void
+SharedLRUCacheInsert(SharedLRUCache * cache, const char *key, size_t keySize,
+					 const char *value, size_t valueSize)
+{
+	SharedLRUCacheControlData *control = cache->control;
+	size_t		dataSize = keySize + valueSize;
+
+	/* do not wipe the whole cache for a single large value */
+	if (dataSize > SharedLRUCacheMaxEntrySize(cache))
+		return;
+
+	dsa_area   *area = GetSharedLRUCacheArea(cache);
+	SharedLRUCacheKey hashKey = SharedLRUCacheKeyForBytes(key, keySize);
+
+	LWLockAcquire(&control->lock, LW_EXCLUSIVE);
+
+	SharedLRUCacheEntry *entry = hash_search(cache->hash, &hashKey, HASH_FIND, NULL);
+
+	if (entry != NULL && SharedLRUCacheEntryHasKey(area, entry, key, keySize))
+	{
+		/* another backend cached the same key in the meantime */
+		LWLockRelease(&control->lock);
+		return;
+	}
+	else if (entry != NULL)
+	{
+		/* hash collision, replace the other entry */
+		RemoveSharedLRUCacheEntry(cache, entry);
+	}
+
+	while (control->entryCount >= cache->maxEntries)
+		EvictLeastRecentlyUsedEntry(cache);
+
+	dsa_pointer data = dsa_allocate_extended(area, dataSize, DSA_ALLOC_NO_OOM);
+
+	while (!DsaPointerIsValid(data) && !dlist_is_empty(&control->lruList))
+	{
+		EvictLeastRecentlyUsedEntry(cache);
+
+		data = dsa_allocate_extended(area, dataSize, DSA_ALLOC_NO_OOM);
+	}
+
+	bool		found = false;
+
+	if (DsaPointerIsValid(data))
+		entry = hash_search(cache->hash, &hashKey, HASH_ENTER_NULL, &found);
+
+	if (DsaPointerIsValid(data) && entry != NULL)
+	{
+		char	   *entryData = dsa_get_address(area, data);
+
+		memcpy(entryData, key, keySize);
+		memcpy(entryData + keySize, value, valueSize);
+
+		entry->data = data;
+		entry->keySize = keySize;
+		entry->dataSize = dataSize;
+
+		dlist_push_head(&control->lruList, &entry->lruNode);
+		control->entryCount++;
+		control->usedBytes += dataSize;
+	}
+	else if (DsaPointerIsValid(data))
+	{
+		/* out of hash table space */
+		dsa_free(area, data);
+	}
+
+	LWLockRelease(&control->lock);
+}
+
+
+/*
+ * SharedLRUCacheGetStats returns the counters and the size of the cache,
+ * or zeroes if the cache is not initialized.
+ */
+void
+SharedLRUCacheGetStats(SharedLRUCache * cache, SharedLRUCacheStats * stats)
+{
+	memset(stats, 0, sizeof(SharedLRUCacheStats));
+
+	if (!SharedLRUCacheIsReady(cache))
+		return;
+
+	SharedLRUCacheControlData *control = cache->control;
+
+	LWLockAcquire(&control->lock, LW_SHARED);
+
+	stats->hits = control->hits;
+	stats->misses = control->misses;
+	stats->evictions = control->evictions;
+	stats->entryCount = control->entryCount;
+	stats->usedBytes = control->usedBytes;
+	stats->areaSize = cache->areaSize;
+
+	LWLockRelease(&control->lock);
+}
+
+
+/*
+ * SharedLRUCacheKeyForBytes returns the hash key for the given key.
+ */
+static SharedLRUCacheKey
+SharedLRUCacheKeyForBytes(const char *key, size_t keySize)
+{
+	SharedLRUCacheKey hashKey;
+
+	memset(&hashKey, 0, sizeof(hashKey));
+	hashKey.keyHash = hash_bytes_extended((const unsigned char *) key, keySize, 0);
+
+	return hashKey;
+}
+
+
+/*
+ * SharedLRUCacheEntryHasKey returns whether the cache entry belongs to the
+ * given key. Must be called while holding the cache lock.
+ */
+static bool
+SharedLRUCacheEntryHasKey(dsa_area * area, SharedLRUCacheEntry * entry,
+						  const char *key, size_t keySize)
+{
+	if (entry->keySize != keySize)
+		return false;
+
+	char	   *cachedKey = dsa_get_address(area, entry->data);
+
+	return memcmp(cachedKey, key, keySize) == 0;
+}
+
+
+/*
+ * EvictLeastRecentlyUsedEntry removes the least recently used entry from
+ * the cache. Must be called while holding the cache lock exclusively.
+ */
+static void
+EvictLeastRecentlyUsedEntry(SharedLRUCache * cache)
+{
+	SharedLRUCacheEntry *entry = dlist_tail_element(SharedLRUCacheEntry, lruNode,
+													&cache->control->lruList);
+
+	RemoveSharedLRUCacheEntry(cache, entry);
+
+	cache->control->evictions++;
+}
+
+
+/*
+ * RemoveSharedLRUCacheEntry removes an entry from the cache and frees its
+ * data. Must be called while holding the cache lock exclusively.
+ */
+static void
+RemoveSharedLRUCacheEntry(SharedLRUCache * cache, SharedLRUCacheEntry * entry)
+{
+	SharedLRUCacheKey key = entry->key;
+
+	dlist_delete(&entry->lruNode);
+	dsa_free(cache->area, entry->data);
+
+	cache->control->entryCount--;
+	cache->control->usedBytes -= entry->dataSize;
+
+	hash_search(cache->hash, &key, HASH_REMOVE, NULL);
+}
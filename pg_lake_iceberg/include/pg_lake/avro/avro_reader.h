@@ -37,6 +37,9 @@ typedef struct AvroReader
 	/* file we are reading from */
 	FILE	   *avroFile;
 
+	/* whether the file is a stream over a buffer in memory */
+	bool		isInMemory;
+
 	/* reader for Avro records */
 	avro_file_reader_t dataReader;
 	bool		initializedDataReader;
@@ -51,6 +54,7 @@ typedef struct AvroReader
 
 
 AvroReader *AvroReaderCreate(const char *filePath);
+AvroReader *AvroReaderCreateFromBuffer(const char *buffer, size_t length);
 bool		AvroReaderReadRecord(AvroReader * reader, AvroParseFunction parseFn, void *entry, void *context);
 void		AvroReaderClose(AvroReader * reader);
 
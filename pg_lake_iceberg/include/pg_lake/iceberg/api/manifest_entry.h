@@ -38,6 +38,7 @@ extern PGDLLEXPORT bool IsManifestEntryStatusScannable(IcebergManifestEntry * ma
 
 /* read api */
 extern PGDLLEXPORT List *FetchManifestEntriesFromManifest(IcebergManifest * manifest, ManifestEntryPredicateFn manifestEntryPredicateFn);
+extern PGDLLEXPORT List *FetchManifestEntriesFromManifests(List *manifests, ManifestEntryPredicateFn manifestEntryPredicateFn);
 
 /* write api */
 extern PGDLLEXPORT void AppendNewManifestEntriesToSnapshot(const char *metadataLocation, bool mergeAddManifests,
@@ -33,3 +33,5 @@ extern PGDLLEXPORT unsigned char *IcebergSerializeColumnBoundText(char *columnBo
 																  Field * field,
 																  size_t *binaryLen);
 extern PGDLLEXPORT Datum ColumnBoundDatum(char *columnBoundText, PGType pgType);
+extern PGDLLEXPORT List *GetDataFileColumnStatsFromBounds(DataFile * dataFile,
+														  List *leafFields);
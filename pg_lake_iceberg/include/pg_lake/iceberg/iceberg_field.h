@@ -36,3 +36,4 @@ extern PGDLLEXPORT DataFileSchema * CreatePositionDeleteDataFileSchema(void);
 extern PGDLLEXPORT const char *GetIcebergJsonSerializedDefaultExpr(TupleDesc tupdesc, AttrNumber attnum,
 																   FieldStructElement * structElementField);
 extern PGDLLEXPORT List *GetRemoteParquetColumnStats(char *path, List *leafFields);
+extern PGDLLEXPORT List *GetRemoteParquetColumnStatsForFiles(List *paths, List *leafFields);
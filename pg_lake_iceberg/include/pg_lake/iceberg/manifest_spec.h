@@ -234,6 +234,7 @@ typedef struct IcebergManifestEntry
 
 extern List *ReadIcebergManifests(const char *manifestListPath);
 extern PGDLLEXPORT List *ReadManifestEntries(const char *manifestPath);
+extern PGDLLEXPORT List *ReadManifestEntriesForPaths(List *manifestPaths);
 
 extern PGDLLEXPORT void WriteIcebergManifestList(const char *manifestListPath, List *manifests);
 extern PGDLLEXPORT void WriteIcebergManifest(const char *manifestPath, List *manifestEntries);
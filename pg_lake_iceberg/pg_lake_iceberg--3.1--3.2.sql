@@ -0,0 +1,23 @@
+CREATE FUNCTION lake_iceberg.manifest_cache_stats(
+    OUT hits bigint,
+    OUT misses bigint,
+    OUT evictions bigint,
+    OUT cached_manifests bigint,
+    OUT used_bytes bigint,
+    OUT size_bytes bigint)
+ RETURNS record
+ LANGUAGE C
+ STRICT
+AS 'MODULE_PATHNAME', $function$manifest_cache_stats$function$;
+REVOKE ALL ON FUNCTION lake_iceberg.manifest_cache_stats() FROM public;
+GRANT EXECUTE ON FUNCTION lake_iceberg.manifest_cache_stats() TO lake_read;
+
+/*
+ * The manifest_cache view shows the hit and miss counters and the size of
+ * the shared memory cache of decoded manifest files.
+ */
+CREATE VIEW lake_iceberg.manifest_cache AS
+	SELECT hits, misses, evictions, cached_manifests, used_bytes, size_bytes
+	FROM lake_iceberg.manifest_cache_stats();
+REVOKE ALL ON lake_iceberg.manifest_cache FROM public;
+GRANT SELECT ON lake_iceberg.manifest_cache TO lake_read;
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <stdio.h>
+
 #include "avro.h"
 
 #include "postgres.h"
@@ -26,7 +28,9 @@
 #include "utils/palloc.h"
 
 
+static void AvroReaderInitSchema(AvroReader * reader);
 static void AvroFileReaderClose(AvroReader * reader);
+static const char *AvroReadJsonSchemaFromBuffer(const char *buffer, size_t length);
 static bool GetFieldValue(avro_value_t * record, char *fieldName, AvroFieldRequired required,
 						  avro_value_t * fieldValue);
 static bool GetFieldArrayValue(avro_value_t * record, char *fieldName, AvroFieldRequired required,
@@ -79,16 +83,132 @@ AvroReaderCreate(const char *filePath)
 		ereport(ERROR, (errmsg("unable to get json schema: %s", avro_strerror())));
 	}
 
+	AvroReaderInitSchema(reader);
+
+	MemoryContextSwitchTo(oldContext);
+
+	return reader;
+}
+
+
+/*
+ * AvroReaderCreateFromBuffer creates an Avro reader for the Avro file contents
+ * in the given buffer by using writer's schema. The buffer is read in place,
+ * so it needs to outlive the reader.
+ */
+AvroReader *
+AvroReaderCreateFromBuffer(const char *buffer, size_t length)
+{
+	MemoryContext readerMemoryContext =
+		AllocSetContextCreate(CurrentMemoryContext,
+							  "AvroReader",
+							  ALLOCSET_DEFAULT_SIZES);
+	MemoryContext oldContext = MemoryContextSwitchTo(readerMemoryContext);
+
+	AvroReader *reader = palloc0(sizeof(AvroReader));
+
+	reader->memoryContext = readerMemoryContext;
+	reader->isInMemory = true;
+
+	/* parse the header before handing over the buffer to the data reader */
+	reader->jsonSchema = AvroReadJsonSchemaFromBuffer(buffer, length);
+
+	reader->avroFile = fmemopen((void *) buffer, length, "rb");
+	if (reader->avroFile == NULL)
+	{
+		ereport(ERROR, (errmsg("could not open in-memory avro file: %m")));
+	}
+
+	/* the data reader closes the memory stream, also when it fails to open */
+	if (avro_file_reader_fp(reader->avroFile, "in-memory", 1, &reader->dataReader) != 0)
+	{
+		ereport(ERROR, (errmsg("unable to open avro file: %s", avro_strerror())));
+	}
+
+	reader->initializedDataReader = true;
+
+	MemoryContextCallback *cb = MemoryContextAllocZero(CurrentMemoryContext,
+													   sizeof(MemoryContextCallback));
+
+	cb->func = (MemoryContextCallbackFunction) AvroFileReaderClose;
+	cb->arg = reader;
+	MemoryContextRegisterResetCallback(CurrentMemoryContext, cb);
+
+	AvroReaderInitSchema(reader);
+
+	MemoryContextSwitchTo(oldContext);
+
+	return reader;
+}
+
+
+/*
+ * AvroReaderInitSchema parses the JSON schema of the reader and prepares the
+ * interface for reading records.
+ */
+static void
+AvroReaderInitSchema(AvroReader * reader)
+{
 	if (avro_schema_from_json(reader->jsonSchema, 0, &reader->dataSchema, NULL) != 0)
 	{
 		ereport(ERROR, (errmsg("unable to parse json schema: %s", avro_strerror())));
 	}
 
 	reader->dataInterface = avro_generic_class_from_schema(reader->dataSchema);
+}
 
-	MemoryContextSwitchTo(oldContext);
 
-	return reader;
+/*
+ * AvroReadJsonSchemaFromBuffer returns the JSON schema stored in the header
+ * of the Avro file contents in the given buffer. Like
+ * avro_file_reader_json_schema, we take the original text from the header
+ * rather than the parsed schema, since the latter drops the field ids.
+ */
+static const char *
+AvroReadJsonSchemaFromBuffer(const char *buffer, size_t length)
+{
+	avro_reader_t headerReader = avro_reader_memory(buffer, length);
+	char		magic[4] = {0};
+
+	if (avro_read(headerReader, magic, sizeof(magic)) != 0 ||
+		magic[0] != 'O' || magic[1] != 'b' || magic[2] != 'j' || magic[3] != 1)
+	{
+		ereport(ERROR, (errmsg("incorrect avro container file magic number")));
+	}
+
+	/* the metadata is a map of bytes values */
+	avro_schema_t metaSchema = avro_schema_map(avro_schema_bytes());
+	avro_value_iface_t *metaInterface = avro_generic_class_from_schema(metaSchema);
+	avro_value_t meta;
+
+	if (metaInterface == NULL || avro_generic_value_new(metaInterface, &meta) != 0)
+	{
+		ereport(ERROR, (errmsg("unable to create avro metadata value: %s", avro_strerror())));
+	}
+
+	if (avro_value_read(headerReader, &meta) != 0)
+	{
+		ereport(ERROR, (errmsg("unable to read avro file header: %s", avro_strerror())));
+	}
+
+	avro_value_t schemaBytes;
+	const void *schemaText = NULL;
+	size_t		schemaLength = 0;
+
+	if (avro_value_get_by_name(&meta, "avro.schema", &schemaBytes, NULL) != 0 ||
+		avro_value_get_bytes(&schemaBytes, &schemaText, &schemaLength) != 0)
+	{
+		ereport(ERROR, (errmsg("avro file header does not contain a schema")));
+	}
+
+	char	   *jsonSchema = pnstrdup(schemaText, schemaLength);
+
+	avro_value_decref(&meta);
+	avro_value_iface_decref(metaInterface);
+	avro_schema_decref(metaSchema);
+	avro_reader_free(headerReader);
+
+	return jsonSchema;
 }
 
 
@@ -147,7 +267,11 @@ void
 AvroReaderClose(AvroReader * reader)
 {
 	AvroFileReaderClose(reader);
-	FreeFile(reader->avroFile);
+
+	/* in-memory files are closed by the data reader */
+	if (!reader->isInMemory)
+		FreeFile(reader->avroFile);
+
 	MemoryContextDelete(reader->memoryContext);
 }
 
@@ -25,6 +25,8 @@
 #include "pg_lake/iceberg/api/datafile.h"
 #include "pg_lake/iceberg/api/snapshot.h"
 
+static List *DataFilesFromManifestEntries(List *manifestEntries, bool pathOnly,
+										  DataFilePredicateFn dataFilePredicateFn);
 
 /*
  * FetchDataFilesFromManifestEntry fetches data files, which are filtered by predicate,
@@ -58,21 +60,9 @@ List *
 FetchDataFilesFromSnapshot(IcebergSnapshot * snapshot, ManifestPredicateFn manifestPredicateFn, ManifestEntryPredicateFn manifestEntryPredicateFn, DataFilePredicateFn dataFilePredicateFn)
 {
 	List	   *manifests = FetchManifestsFromSnapshot(snapshot, manifestPredicateFn);
+	bool		pathOnly = false;
 
-	List	   *dataFiles = NIL;
-
-	ListCell   *manifestCell = NULL;
-
-	foreach(manifestCell, manifests)
-	{
-		IcebergManifest *manifest = lfirst(manifestCell);
-		bool		pathOnly = false;
-		List	   *manifestDataFiles = FetchDataFilesFromManifest(manifest, pathOnly, manifestEntryPredicateFn, dataFilePredicateFn);
-
-		dataFiles = list_concat(dataFiles, manifestDataFiles);
-	}
-
-	return dataFiles;
+	return FetchDataFilesFromManifests(manifests, pathOnly, manifestEntryPredicateFn, dataFilePredicateFn);
 }
 
 /*
@@ -83,21 +73,9 @@ List *
 FetchDataFilePathsFromSnapshot(IcebergSnapshot * snapshot, ManifestPredicateFn manifestPredicateFn, ManifestEntryPredicateFn manifestEntryPredicateFn, DataFilePredicateFn dataFilePredicateFn)
 {
 	List	   *manifests = FetchManifestsFromSnapshot(snapshot, manifestPredicateFn);
+	bool		pathOnly = true;
 
-	List	   *dataFiles = NIL;
-
-	ListCell   *manifestCell = NULL;
-
-	foreach(manifestCell, manifests)
-	{
-		IcebergManifest *manifest = lfirst(manifestCell);
-		bool		pathOnly = true;
-		List	   *manifestDataFiles = FetchDataFilesFromManifest(manifest, pathOnly, manifestEntryPredicateFn, dataFilePredicateFn);
-
-		dataFiles = list_concat(dataFiles, manifestDataFiles);
-	}
-
-	return dataFiles;
+	return FetchDataFilesFromManifests(manifests, pathOnly, manifestEntryPredicateFn, dataFilePredicateFn);
 }
 
 /*
@@ -115,9 +93,41 @@ FetchAllDataAndDeleteFilesFromCurrentSnapshot(IcebergTableMetadata * metadata, L
 	}
 
 	IcebergSnapshot *snapshot = GetCurrentSnapshot(metadata, true);
+	List	   *manifests = FetchManifestsFromSnapshot(snapshot, NULL);
+
+	FetchDataAndDeleteFilesFromManifests(manifests, dataFiles, deleteFiles);
+}
+
+
+/*
+ * FetchDataAndDeleteFilesFromManifests fetches the scannable data and delete
+ * files from the given data and delete manifests, with a single concurrent
+ * download of all manifests.
+ */
+void
+FetchDataAndDeleteFilesFromManifests(List *manifests, List **dataFiles, List **deleteFiles)
+{
+	List	   *manifestEntryLists =
+		FetchManifestEntriesFromManifests(manifests, IsManifestEntryStatusScannable);
 
-	*dataFiles = FetchDataFilesFromSnapshot(snapshot, IsManifestOfFileContentAdd, IsManifestEntryStatusScannable, NULL);
-	*deleteFiles = FetchDataFilesFromSnapshot(snapshot, IsManifestOfFileContentDeletes, IsManifestEntryStatusScannable, NULL);
+	*dataFiles = NIL;
+	*deleteFiles = NIL;
+
+	ListCell   *manifestCell = NULL;
+	ListCell   *manifestEntriesCell = NULL;
+
+	forboth(manifestCell, manifests, manifestEntriesCell, manifestEntryLists)
+	{
+		IcebergManifest *manifest = lfirst(manifestCell);
+		bool		pathOnly = false;
+		List	   *manifestDataFiles =
+			DataFilesFromManifestEntries(lfirst(manifestEntriesCell), pathOnly, NULL);
+
+		if (IsManifestOfFileContentAdd(manifest))
+			*dataFiles = list_concat(*dataFiles, manifestDataFiles);
+		else if (IsManifestOfFileContentDeletes(manifest))
+			*deleteFiles = list_concat(*deleteFiles, manifestDataFiles);
+	}
 }
 
 /*
@@ -167,6 +177,42 @@ FetchDataFilesFromManifest(IcebergManifest * manifest, bool pathOnly, ManifestEn
 
 	List	   *manifestEntries = FetchManifestEntriesFromManifest(manifest, manifestEntryPredicateFn);
 
+	return DataFilesFromManifestEntries(manifestEntries, pathOnly, dataFilePredicateFn);
+}
+
+
+/*
+ * FetchDataFilesFromManifests fetches data files, which are filtered by predicates,
+ * from the given manifests, which are downloaded concurrently.
+ */
+List *
+FetchDataFilesFromManifests(List *manifests, bool pathOnly, ManifestEntryPredicateFn manifestEntryPredicateFn, DataFilePredicateFn dataFilePredicateFn)
+{
+	List	   *manifestEntryLists = FetchManifestEntriesFromManifests(manifests, manifestEntryPredicateFn);
+
+	List	   *dataFiles = NIL;
+
+	ListCell   *manifestEntriesCell = NULL;
+
+	foreach(manifestEntriesCell, manifestEntryLists)
+	{
+		List	   *manifestDataFiles =
+			DataFilesFromManifestEntries(lfirst(manifestEntriesCell), pathOnly, dataFilePredicateFn);
+
+		dataFiles = list_concat(dataFiles, manifestDataFiles);
+	}
+
+	return dataFiles;
+}
+
+
+/*
+ * DataFilesFromManifestEntries returns the data files, or their paths, of the
+ * given manifest entries, which are filtered by predicate.
+ */
+static List *
+DataFilesFromManifestEntries(List *manifestEntries, bool pathOnly, DataFilePredicateFn dataFilePredicateFn)
+{
 	List	   *dataFiles = NIL;
 
 	ListCell   *manifestEntryCell = NULL;
@@ -16,6 +16,7 @@
  */
 
 #include "postgres.h"
+#include "catalog/pg_type.h"
 #include "fmgr.h"
 #include "funcapi.h"
 #include "libpq-fe.h"
@@ -283,11 +284,12 @@ GetPartitionFieldSummaryFromDataFiles(List *dataFiles, int32_t partitionFieldInd
 	FieldSummary *partitionSummary = palloc0(sizeof(FieldSummary));
 
 	/*
-	 * todo: we do not set contains_nan and contains_null yet but let them set
-	 * true to not skip files by mistake
+	 * todo: we do not track NaN partition values yet, so let contains_nan be
+	 * true for floating point types to not skip files by mistake
 	 */
-	partitionSummary->contains_nan = true;
-	partitionSummary->contains_null = true;
+	partitionSummary->contains_nan = resultPgType.postgresTypeOid == FLOAT4OID ||
+		resultPgType.postgresTypeOid == FLOAT8OID;
+	partitionSummary->contains_null = false;
 
 	/* find min of all partition values for the fields in all data files */
 	Datum		minLowerBoundDatum = {0};
@@ -308,7 +310,10 @@ GetPartitionFieldSummaryFromDataFiles(List *dataFiles, int32_t partitionFieldInd
 		PartitionField *partitionField = &partition->fields[partitionFieldIndex];
 
 		if (partitionField->value == NULL)
+		{
+			partitionSummary->contains_null = true;
 			continue;
+		}
 
 		Datum		partitionFieldDatum = PGIcebergBinaryDeserialize(partitionField->value, partitionField->value_length,
 																	 resultField, resultPgType);
@@ -31,6 +31,9 @@
 #include "pg_lake/util/s3_writer_utils.h"
 #include "pg_lake/util/string_utils.h"
 
+static List *FilterManifestEntries(List *manifestEntries,
+								   ManifestEntryPredicateFn manifestEntryPredicateFn);
+
 /*
  * IsManifestEntryStatusScannable checks if the given manifest entry is scannable.
  */
@@ -61,6 +64,51 @@ FetchManifestEntriesFromManifest(IcebergManifest * manifest, ManifestEntryPredic
 
 	List	   *manifestEntries = ReadManifestEntries(manifest->manifest_path);
 
+	return FilterManifestEntries(manifestEntries, manifestEntryPredicateFn);
+}
+
+
+/*
+ * FetchManifestEntriesFromManifests fetches manifest entries, which are filtered
+ * by predicate, from the given manifests. It returns a list with the list of
+ * manifest entries of each manifest, in the same order as the manifests.
+ *
+ * Unlike calling FetchManifestEntriesFromManifest for each manifest, the
+ * manifest files are downloaded concurrently.
+ */
+List *
+FetchManifestEntriesFromManifests(List *manifests, ManifestEntryPredicateFn manifestEntryPredicateFn)
+{
+	List	   *manifestPaths = NIL;
+	ListCell   *manifestCell = NULL;
+
+	foreach(manifestCell, manifests)
+	{
+		IcebergManifest *manifest = lfirst(manifestCell);
+
+		manifestPaths = lappend(manifestPaths, (char *) manifest->manifest_path);
+	}
+
+	List	   *manifestEntryLists = ReadManifestEntriesForPaths(manifestPaths);
+	ListCell   *manifestEntriesCell = NULL;
+
+	foreach(manifestEntriesCell, manifestEntryLists)
+	{
+		lfirst(manifestEntriesCell) = FilterManifestEntries(lfirst(manifestEntriesCell),
+															manifestEntryPredicateFn);
+	}
+
+	return manifestEntryLists;
+}
+
+
+/*
+ * FilterManifestEntries returns the manifest entries for which the predicate
+ * returns true.
+ */
+static List *
+FilterManifestEntries(List *manifestEntries, ManifestEntryPredicateFn manifestEntryPredicateFn)
+{
 	List	   *filteredManifestEntries = NIL;
 
 	ListCell   *manifestEntryCell = NULL;
@@ -23,6 +23,7 @@
 #include "pg_lake/iceberg/iceberg_type_binary_serde.h"
 #include "pg_lake/parquet/leaf_field.h"
 
+#include "catalog/pg_type.h"
 #include "utils/lsyscache.h"
 
 static void SetColumnBoundsFromDataFileStats(const DataFileStats * dataFileStats,
@@ -31,6 +32,8 @@ static void SetColumnBoundsFromDataFileStats(const DataFileStats * dataFileStats
 											 ColumnBound * *upperBounds,
 											 size_t *nUpperBounds);
 static ColumnBound * CreateColumnBoundForLeafField(LeafField * leafField, char *columnBoundText);
+static ColumnBound * FindColumnBound(ColumnBound * bounds, size_t boundsLength, int fieldId);
+static char *ColumnBoundToText(ColumnBound * bound, LeafField * leafField);
 
 /*
  * SetIcebergDataFileStats sets the record count, file size, lower and upper bounds
@@ -188,3 +191,96 @@ ColumnBoundDatum(char *columnBoundText, PGType pgType)
 
 	return boundDatum;
 }
+
+
+/*
+ * GetDataFileColumnStatsFromBounds returns the column stats for the given leaf
+ * fields from the lower and upper bounds in the manifest entry of the data file,
+ * with the bounds in Postgres text representation. This avoids reading the
+ * Parquet footer of the data file, which is what GetRemoteParquetColumnStats
+ * does.
+ *
+ * Fields that do not have both bounds in the manifest are skipped, so an
+ * empty list means the manifest has no usable bounds for the leaf fields.
+ */
+List *
+GetDataFileColumnStatsFromBounds(DataFile * dataFile, List *leafFields)
+{
+	List	   *columnStatsList = NIL;
+	ListCell   *leafFieldCell = NULL;
+
+	foreach(leafFieldCell, leafFields)
+	{
+		LeafField  *leafField = lfirst(leafFieldCell);
+
+		if (leafField->field->type != FIELD_TYPE_SCALAR)
+			continue;
+
+		/*
+		 * Bounds of types that are stored as strings in Iceberg may be
+		 * truncated, which is only meaningful for the string types.
+		 */
+		Oid			pgTypeOid = leafField->pgType.postgresTypeOid;
+
+		if (PGTypeRequiresConversionToIcebergString(leafField->field, leafField->pgType) &&
+			!(pgTypeOid == VARCHAROID || pgTypeOid == BPCHAROID || pgTypeOid == CHAROID))
+			continue;
+
+		ColumnBound *lowerBound = FindColumnBound(dataFile->lower_bounds,
+												  dataFile->lower_bounds_length,
+												  leafField->fieldId);
+		ColumnBound *upperBound = FindColumnBound(dataFile->upper_bounds,
+												  dataFile->upper_bounds_length,
+												  leafField->fieldId);
+
+		if (lowerBound == NULL || upperBound == NULL)
+			continue;
+
+		DataFileColumnStats *columnStats = palloc0(sizeof(DataFileColumnStats));
+
+		columnStats->leafField = *leafField;
+		columnStats->lowerBoundText = ColumnBoundToText(lowerBound, leafField);
+		columnStats->upperBoundText = ColumnBoundToText(upperBound, leafField);
+
+		columnStatsList = lappend(columnStatsList, columnStats);
+	}
+
+	return columnStatsList;
+}
+
+
+/*
+ * FindColumnBound returns the bound of the given field, or NULL if the field
+ * has no bound.
+ */
+static ColumnBound *
+FindColumnBound(ColumnBound * bounds, size_t boundsLength, int fieldId)
+{
+	for (size_t boundIndex = 0; boundIndex < boundsLength; boundIndex++)
+	{
+		if (bounds[boundIndex].column_id == fieldId)
+			return &bounds[boundIndex];
+	}
+
+	return NULL;
+}
+
+
+/*
+ * ColumnBoundToText converts the Iceberg binary serialized bound of the leaf
+ * field to its Postgres text representation.
+ */
+static char *
+ColumnBoundToText(ColumnBound * bound, LeafField * leafField)
+{
+	PGType		pgType = leafField->pgType;
+	Datum		boundDatum = PGIcebergBinaryDeserialize(bound->value, bound->value_length,
+														leafField->field, pgType);
+
+	Oid			typoutput;
+	bool		typIsVarlena;
+
+	getTypeOutputInfo(pgType.postgresTypeOid, &typoutput, &typIsVarlena);
+
+	return OidOutputFunctionCall(typoutput, boundDatum);
+}
@@ -117,6 +117,12 @@ typedef struct RowGroupStats
 	ArrayType  *minMaxArray;
 }			RowGroupStats;
 
+/*
+ * Maximum number of files whose Parquet footers are read by a single query in
+ * GetRemoteParquetColumnStatsForFiles, to keep the query text bounded.
+ */
+#define REMOTE_PARQUET_STATS_BATCH_SIZE 256
+
 static IcebergToDuckDBType IcebergToDuckDBTypes[] =
 {
 	{
@@ -183,6 +189,12 @@ static char *SerializeTextArrayTypeToPgDuck(ArrayType *array);
 static ArrayType *ReadArrayFromText(char *arrayText);
 static List *GetFieldMinMaxStats(PGDuckConnection * pgDuckConn, List *rowGroupStatsList);
 static bool ShouldSkipStatistics(LeafField * leafField);
+static void FetchRemoteParquetColumnStatsBatch(PGDuckConnection * pgDuckConn,
+											   List *paths, int firstPathIndex,
+											   int pathCount, List *leafFields,
+											   List **columnStatsPerPath);
+static char *PrepareColumnStatsBatchQuery(List *paths, int firstPathIndex,
+										  int pathCount, List *leafFields);
 
 
 /*
@@ -968,6 +980,216 @@ GetRemoteParquetColumnStats(char *path, List *leafFields)
 }
 
 
+/*
+ * GetRemoteParquetColumnStatsForFiles gets the stats for each leaf field in
+ * each of the given remote Parquet files. It is equivalent to calling
+ * GetRemoteParquetColumnStats for each file, but reads the footers of up to
+ * REMOTE_PARQUET_STATS_BATCH_SIZE files in a single query, and computes the
+ * min/max values in the same query.
+ *
+ * Returns a list with the list of column stats for each path, in the same
+ * order as the paths.
+ */
+List *
+GetRemoteParquetColumnStatsForFiles(List *paths, List *leafFields)
+{
+	int			pathCount = list_length(paths);
+	List	  **columnStatsPerPath = palloc0(sizeof(List *) * Max(pathCount, 1));
+	List	   *statsLeafFields = NIL;
+	ListCell   *leafFieldCell = NULL;
+
+	foreach(leafFieldCell, leafFields)
+	{
+		LeafField  *leafField = lfirst(leafFieldCell);
+
+		if (!ShouldSkipStatistics(leafField))
+			statsLeafFields = lappend(statsLeafFields, leafField);
+	}
+
+	if (pathCount > 0 && statsLeafFields != NIL)
+	{
+		PGDuckConnection *pgDuckConn = GetPGDuckConnection();
+
+		for (int firstPathIndex = 0; firstPathIndex < pathCount;
+			 firstPathIndex += REMOTE_PARQUET_STATS_BATCH_SIZE)
+		{
+			int			batchPathCount = Min(REMOTE_PARQUET_STATS_BATCH_SIZE,
+											 pathCount - firstPathIndex);
+
+			FetchRemoteParquetColumnStatsBatch(pgDuckConn, paths, firstPathIndex,
+											   batchPathCount, statsLeafFields,
+											   columnStatsPerPath);
+		}
+
+		ReleasePGDuckConnection(pgDuckConn);
+	}
+
+	List	   *columnStatsList = NIL;
+
+	for (int pathIndex = 0; pathIndex < pathCount; pathIndex++)
+		columnStatsList = lappend(columnStatsList, columnStatsPerPath[pathIndex]);
+
+	return columnStatsList;
+}
+
+
+/*
+ * FetchRemoteParquetColumnStatsBatch runs a single query to get the column
+ * stats for pathCount files starting at firstPathIndex, and stores them in
+ * columnStatsPerPath.
+ *
+ * The result has a row per file that has statistics, with the file index
+ * followed by the min and max value of each leaf field.
+ */
+static void
+FetchRemoteParquetColumnStatsBatch(PGDuckConnection * pgDuckConn, List *paths,
+								   int firstPathIndex, int pathCount,
+								   List *leafFields, List **columnStatsPerPath)
+{
+	char	   *query = PrepareColumnStatsBatchQuery(paths, firstPathIndex,
+													 pathCount, leafFields);
+
+	PGresult   *result = ExecuteQueryOnPGDuckConnection(pgDuckConn, query);
+
+	/* throw error if anything failed  */
+	CheckPGDuckResult(pgDuckConn, result);
+
+	/* make sure we PQclear the result */
+	PG_TRY();
+	{
+		int			rowCount = PQntuples(result);
+
+		Assert(PQnfields(result) == 1 + list_length(leafFields) * 2);
+
+		for (int rowIndex = 0; rowIndex < rowCount; rowIndex++)
+		{
+			int			pathIndex = atoi(PQgetvalue(result, rowIndex, 0));
+			List	   *columnStatsList = NIL;
+
+			Assert(pathIndex >= firstPathIndex && pathIndex < firstPathIndex + pathCount);
+
+			for (int fieldIndex = 0; fieldIndex < list_length(leafFields); fieldIndex++)
+			{
+				int			lowerBoundIndex = 1 + fieldIndex * 2;
+				int			upperBoundIndex = lowerBoundIndex + 1;
+
+				if (PQgetisnull(result, rowIndex, lowerBoundIndex) &&
+					PQgetisnull(result, rowIndex, upperBoundIndex))
+				{
+					/* the data file does not have the field, or no stats */
+					continue;
+				}
+
+				DataFileColumnStats *columnStats = palloc0(sizeof(DataFileColumnStats));
+
+				columnStats->leafField = *(LeafField *) list_nth(leafFields, fieldIndex);
+
+				if (!PQgetisnull(result, rowIndex, lowerBoundIndex))
+					columnStats->lowerBoundText = pstrdup(PQgetvalue(result, rowIndex, lowerBoundIndex));
+
+				if (!PQgetisnull(result, rowIndex, upperBoundIndex))
+					columnStats->upperBoundText = pstrdup(PQgetvalue(result, rowIndex, upperBoundIndex));
+
+				columnStatsList = lappend(columnStatsList, columnStats);
+			}
+
+			columnStatsPerPath[pathIndex] = columnStatsList;
+		}
+	}
+	PG_CATCH();
+	{
+		PQclear(result);
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	PQclear(result);
+}
+
+
+/*
+ * PrepareColumnStatsBatchQuery builds the query that reads the row group
+ * statistics of multiple files, similar to FetchRowGroupStats, and then
+ * aggregates them into min/max values per file like GetFieldMinMaxStats.
+ *
+ * Each file gets its own parquet_schema and parquet_metadata call, such that
+ * the column_id to field_id mapping is derived per file, and DuckDB can read
+ * the footers in parallel. The min/max values are pivoted into a column per
+ * field, which allows casting the values to the type of each field.
+ */
+static char *
+PrepareColumnStatsBatchQuery(List *paths, int firstPathIndex, int pathCount,
+							 List *leafFields)
+{
+	StringInfo	query = makeStringInfo();
+
+	appendStringInfoString(query, "WITH column_id_field_id_mapping AS (");
+
+	for (int pathIndex = firstPathIndex; pathIndex < firstPathIndex + pathCount; pathIndex++)
+	{
+		char	   *quotedPath = quote_literal_cstr(list_nth(paths, pathIndex));
+
+		if (pathIndex > firstPathIndex)
+			appendStringInfoString(query, " UNION ALL ");
+
+		appendStringInfo(query,
+						 "SELECT %d AS file_index, column_id, field_id FROM ( "
+						 "	SELECT row_number() OVER () - 1 AS column_id, field_id "
+						 "	FROM parquet_schema(%s) "
+						 "	WHERE num_children IS NULL and field_id <> "
+						 PG_LAKE_TOSTRING(ICEBERG_ROWID_FIELD_ID)
+						 ")",
+						 pathIndex, quotedPath);
+	}
+
+	appendStringInfoString(query, "), parquet_metadata AS (");
+
+	for (int pathIndex = firstPathIndex; pathIndex < firstPathIndex + pathCount; pathIndex++)
+	{
+		char	   *quotedPath = quote_literal_cstr(list_nth(paths, pathIndex));
+
+		if (pathIndex > firstPathIndex)
+			appendStringInfoString(query, " UNION ALL ");
+
+		appendStringInfo(query,
+						 "SELECT %d AS file_index, column_id, stats_min, stats_min_value, "
+						 "stats_max, stats_max_value FROM parquet_metadata(%s)",
+						 pathIndex, quotedPath);
+	}
+
+	/* see FetchRowGroupStats for the use of coalesce */
+	appendStringInfoString(query,
+						   "), row_group_aggs AS ( "
+						   "SELECT c.file_index, c.field_id, "
+						   "       array_agg(CAST(coalesce(m.stats_min, m.stats_min_value) AS TEXT)) "
+						   "                 FILTER (WHERE m.stats_min IS NOT NULL OR m.stats_min_value IS NOT NULL) || "
+						   "       array_agg(CAST(coalesce(m.stats_max, m.stats_max_value) AS TEXT)) "
+						   "                  FILTER (WHERE m.stats_max IS NOT NULL OR m.stats_max_value IS NOT NULL) AS values "
+						   "FROM column_id_field_id_mapping c "
+						   "JOIN parquet_metadata m USING (file_index, column_id) "
+						   "GROUP BY c.file_index, c.field_id) "
+						   "SELECT file_index");
+
+	ListCell   *leafFieldCell = NULL;
+
+	foreach(leafFieldCell, leafFields)
+	{
+		LeafField  *leafField = lfirst(leafFieldCell);
+		int			fieldId = leafField->fieldId;
+
+		appendStringInfo(query,
+						 ", list_aggregate(CAST(any_value(values) FILTER (WHERE field_id = %d) AS %s[]), 'min') AS field_%d_min"
+						 ", list_aggregate(CAST(any_value(values) FILTER (WHERE field_id = %d) AS %s[]), 'max') AS field_%d_max",
+						 fieldId, leafField->duckTypeName, fieldId,
+						 fieldId, leafField->duckTypeName, fieldId);
+	}
+
+	appendStringInfoString(query, " FROM row_group_aggs GROUP BY file_index ORDER BY file_index");
+
+	return query->data;
+}
+
+
 /*
 * FetchRowGroupStats fetches the statistics for the given leaf fields.
 * The output is in the format of:
@@ -92,13 +92,16 @@ iceberg_files(PG_FUNCTION_ARGS)
 
 	List	   *manifests = FetchManifestsFromSnapshot(snapshot, NULL);
 
+	List	   *manifestEntryLists = FetchManifestEntriesFromManifests(manifests, IsManifestEntryStatusScannable);
+
 	ListCell   *manifestCell = NULL;
+	ListCell   *manifestEntriesCell = NULL;
 
-	foreach(manifestCell, manifests)
+	forboth(manifestCell, manifests, manifestEntriesCell, manifestEntryLists)
 	{
 		IcebergManifest *manifest = (IcebergManifest *) lfirst(manifestCell);
 
-		List	   *manifestEntries = FetchManifestEntriesFromManifest(manifest, IsManifestEntryStatusScannable);
+		List	   *manifestEntries = (List *) lfirst(manifestEntriesCell);
 
 		ListCell   *manifestEntryCell = NULL;
 
@@ -0,0 +1,449 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * manifest_cache.c - shared memory cache of decoded Iceberg manifests
+ *
+ * Manifest files are never modified after they are written, so the decoded
+ * manifest entries can be shared by all backends, keyed by manifest path.
+ * Entries are stored in a compact serialized form in a shared LRU cache,
+ * which bounds the size of the cache and evicts the least recently used
+ * manifests when it is full.
+ *
+ * The cache is only available when pg_lake_iceberg is loaded via
+ * shared_preload_libraries.
+ */
+#include "postgres.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+
+#include "access/htup_details.h"
+#include "lib/stringinfo.h"
+#include "storage/ipc.h"
+
+#include "pg_lake/iceberg/manifest_cache.h"
+#include "pg_lake/iceberg/manifest_spec.h"
+#include "pg_lake/util/shared_lru_cache.h"
+
+/*
+ * ManifestCacheReader keeps track of the position in a serialized list of
+ * manifest entries.
+ */
+typedef struct ManifestCacheReader
+{
+	const char *data;
+	size_t		length;
+	size_t		offset;
+}			ManifestCacheReader;
+
+
+static void ManifestCacheSharedMemoryRequest(void);
+static void ManifestCacheSharedMemoryStartup(void);
+static bool IsManifestCacheEnabled(void);
+static void SerializeManifestEntry(StringInfo buffer, IcebergManifestEntry * entry);
+static IcebergManifestEntry * DeserializeManifestEntry(ManifestCacheReader * reader);
+static void WriteOptionalBytes(StringInfo buffer, const void *value, size_t length);
+static void *ReadOptionalBytes(ManifestCacheReader * reader);
+static void WriteColumnBounds(StringInfo buffer, ColumnBound * bounds, size_t boundCount);
+static ColumnBound * ReadColumnBounds(ManifestCacheReader * reader, size_t boundCount);
+static void ReadCachedBytes(ManifestCacheReader * reader, void *destination, size_t size);
+
+/* managed via pg_lake_iceberg.manifest_cache_size */
+int			ManifestCacheSizeKB = DEFAULT_MANIFEST_CACHE_SIZE_KB;
+
+/* managed via pg_lake_iceberg.enable_manifest_cache */
+bool		EnableManifestCache = true;
+
+static shmem_startup_hook_type PreviousSharedMemoryStartupHook = NULL;
+static shmem_request_hook_type PreviousSharedMemoryRequestHook = NULL;
+
+static SharedLRUCache * ManifestCache = NULL;
+
+PG_FUNCTION_INFO_V1(manifest_cache_stats);
+
+
+/*
+ * InitializeManifestCache sets up the shared memory hooks of the manifest
+ * cache, if pg_lake_iceberg is loaded via shared_preload_libraries.
+ */
+void
+InitializeManifestCache(void)
+{
+	if (!process_shared_preload_libraries_in_progress || ManifestCacheSizeKB == 0)
+		return;
+
+	ManifestCache = CreateSharedLRUCache("pg_lake_iceberg manifest cache",
+										 ManifestCacheSizeKB);
+
+	PreviousSharedMemoryStartupHook = shmem_startup_hook;
+	shmem_startup_hook = ManifestCacheSharedMemoryStartup;
+
+	PreviousSharedMemoryRequestHook = shmem_request_hook;
+	shmem_request_hook = ManifestCacheSharedMemoryRequest;
+}
+
+
+/*
+ * ManifestCacheSharedMemoryRequest requests shared memory for the manifest cache.
+ */
+static void
+ManifestCacheSharedMemoryRequest(void)
+{
+	if (PreviousSharedMemoryRequestHook)
+	{
+		PreviousSharedMemoryRequestHook();
+	}
+
+	RequestAddinShmemSpace(SharedLRUCacheShmemSize(ManifestCache));
+}
+
+
+/*
+ * ManifestCacheSharedMemoryStartup initializes the shared memory of the
+ * manifest cache.
+ */
+static void
+ManifestCacheSharedMemoryStartup(void)
+{
+	SharedLRUCacheShmemInit(ManifestCache);
+
+	if (PreviousSharedMemoryStartupHook != NULL)
+	{
+		PreviousSharedMemoryStartupHook();
+	}
+}
+
+
+/*
+ * IsManifestCacheEnabled returns whether the manifest cache can be used.
+ */
+static bool
+IsManifestCacheEnabled(void)
+{
+	return SharedLRUCacheIsReady(ManifestCache) && EnableManifestCache;
+}
+
+
+/*
+ * ManifestCacheLookup looks up the entries of the manifest with the given
+ * path in the manifest cache. If found, it sets manifestEntries to a fresh
+ * copy of the entries in the current memory context and returns true.
+ */
+bool
+ManifestCacheLookup(const char *manifestPath, List **manifestEntries)
+{
+	if (!IsManifestCacheEnabled())
+		return false;
+
+	char	   *serializedEntries = NULL;
+	size_t		serializedSize = 0;
+
+	/* the key includes the terminating NUL */
+	if (!SharedLRUCacheLookup(ManifestCache, manifestPath, strlen(manifestPath) + 1,
+							  &serializedEntries, &serializedSize))
+		return false;
+
+	ManifestCacheReader reader = {
+		.data = serializedEntries,
+		.length = serializedSize,
+		.offset = 0
+	};
+
+	List	   *entries = NIL;
+
+	while (reader.offset < reader.length)
+		entries = lappend(entries, DeserializeManifestEntry(&reader));
+
+	pfree(serializedEntries);
+
+	*manifestEntries = entries;
+
+	return true;
+}
+
+
+/*
+ * ManifestCacheInsert adds the entries of the manifest with the given path
+ * to the manifest cache, evicting the least recently used manifests if the
+ * cache is full.
+ */
+void
+ManifestCacheInsert(const char *manifestPath, List *manifestEntries)
+{
+	if (!IsManifestCacheEnabled())
+		return;
+
+	StringInfoData buffer;
+
+	initStringInfo(&buffer);
+
+	ListCell   *entryCell = NULL;
+
+	foreach(entryCell, manifestEntries)
+	{
+		SerializeManifestEntry(&buffer, lfirst(entryCell));
+	}
+
+	SharedLRUCacheInsert(ManifestCache, manifestPath, strlen(manifestPath) + 1,
+						 buffer.data, buffer.len);
+
+	pfree(buffer.data);
+}
+
+
+/*
+ * SerializeManifestEntry appends a manifest entry to the buffer. The entry
+ * itself is copied as is, followed by the values of all pointer fields,
+ * which are restored by DeserializeManifestEntry.
+ */
+static void
+SerializeManifestEntry(StringInfo buffer, IcebergManifestEntry * entry)
+{
+	DataFile   *dataFile = &entry->data_file;
+
+	appendBinaryStringInfo(buffer, entry, sizeof(IcebergManifestEntry));
+
+	WriteOptionalBytes(buffer, dataFile->file_path, dataFile->file_path_length);
+	WriteOptionalBytes(buffer, dataFile->file_format, dataFile->file_format_length);
+
+	bool		hasPartitionFields = dataFile->partition.fields != NULL;
+
+	appendBinaryStringInfo(buffer, &hasPartitionFields, sizeof(bool));
+
+	for (size_t fieldIndex = 0; hasPartitionFields &&
+		 fieldIndex < dataFile->partition.fields_length; fieldIndex++)
+	{
+		PartitionField *field = &dataFile->partition.fields[fieldIndex];
+		size_t		fieldNameLength = field->field_name != NULL ? strlen(field->field_name) : 0;
+
+		appendBinaryStringInfo(buffer, field, sizeof(PartitionField));
+		WriteOptionalBytes(buffer, field->field_name, fieldNameLength);
+		WriteOptionalBytes(buffer, field->value, field->value_length);
+	}
+
+	WriteOptionalBytes(buffer, dataFile->column_sizes,
+					   dataFile->column_sizes_length * sizeof(ColumnStat));
+	WriteOptionalBytes(buffer, dataFile->value_counts,
+					   dataFile->value_counts_length * sizeof(ColumnStat));
+	WriteOptionalBytes(buffer, dataFile->null_value_counts,
+					   dataFile->null_value_counts_length * sizeof(ColumnStat));
+	WriteOptionalBytes(buffer, dataFile->nan_value_counts,
+					   dataFile->nan_value_counts_length * sizeof(ColumnStat));
+	WriteColumnBounds(buffer, dataFile->lower_bounds, dataFile->lower_bounds_length);
+	WriteColumnBounds(buffer, dataFile->upper_bounds, dataFile->upper_bounds_length);
+	WriteOptionalBytes(buffer, dataFile->key_metadata, dataFile->key_metadata_length);
+	WriteOptionalBytes(buffer, dataFile->split_offsets,
+					   dataFile->split_offsets_length * sizeof(int64_t));
+	WriteOptionalBytes(buffer, dataFile->equality_ids,
+					   dataFile->equality_ids_length * sizeof(int));
+}
+
+
+/*
+ * DeserializeManifestEntry reads a manifest entry written by
+ * SerializeManifestEntry.
+ */
+static IcebergManifestEntry *
+DeserializeManifestEntry(ManifestCacheReader * reader)
+{
+	IcebergManifestEntry *entry = palloc0(sizeof(IcebergManifestEntry));
+	DataFile   *dataFile = &entry->data_file;
+
+	ReadCachedBytes(reader, entry, sizeof(IcebergManifestEntry));
+
+	dataFile->file_path = ReadOptionalBytes(reader);
+	dataFile->file_format = ReadOptionalBytes(reader);
+
+	bool		hasPartitionFields = false;
+
+	ReadCachedBytes(reader, &hasPartitionFields, sizeof(bool));
+
+	if (hasPartitionFields)
+	{
+		size_t		fieldCount = dataFile->partition.fields_length;
+
+		dataFile->partition.fields = palloc0(Max(fieldCount, 1) * sizeof(PartitionField));
+
+		for (size_t fieldIndex = 0; fieldIndex < fieldCount; fieldIndex++)
+		{
+			PartitionField *field = &dataFile->partition.fields[fieldIndex];
+
+			ReadCachedBytes(reader, field, sizeof(PartitionField));
+			field->field_name = ReadOptionalBytes(reader);
+			field->value = ReadOptionalBytes(reader);
+		}
+	}
+	else
+	{
+		dataFile->partition.fields = NULL;
+	}
+
+	dataFile->column_sizes = ReadOptionalBytes(reader);
+	dataFile->value_counts = ReadOptionalBytes(reader);
+	dataFile->null_value_counts = ReadOptionalBytes(reader);
+	dataFile->nan_value_counts = ReadOptionalBytes(reader);
+	dataFile->lower_bounds = ReadColumnBounds(reader, dataFile->lower_bounds_length);
+	dataFile->upper_bounds = ReadColumnBounds(reader, dataFile->upper_bounds_length);
+	dataFile->key_metadata = ReadOptionalBytes(reader);
+	dataFile->split_offsets = ReadOptionalBytes(reader);
+	dataFile->equality_ids = ReadOptionalBytes(reader);
+
+	return entry;
+}
+
+
+/*
+ * WriteOptionalBytes appends a possibly-NULL value of the given length.
+ */
+static void
+WriteOptionalBytes(StringInfo buffer, const void *value, size_t length)
+{
+	bool		hasValue = value != NULL;
+
+	appendBinaryStringInfo(buffer, &hasValue, sizeof(bool));
+
+	if (!hasValue)
+		return;
+
+	appendBinaryStringInfo(buffer, &length, sizeof(size_t));
+	appendBinaryStringInfo(buffer, value, length);
+}
+
+
+/*
+ * ReadOptionalBytes reads a value written by WriteOptionalBytes into a new
+ * NUL-terminated buffer, or returns NULL if the value was NULL.
+ */
+static void *
+ReadOptionalBytes(ManifestCacheReader * reader)
+{
+	bool		hasValue = false;
+
+	ReadCachedBytes(reader, &hasValue, sizeof(bool));
+
+	if (!hasValue)
+		return NULL;
+
+	size_t		length = 0;
+
+	ReadCachedBytes(reader, &length, sizeof(size_t));
+
+	/* strings are NUL-terminated in decoded manifests */
+	char	   *value = palloc0(length + 1);
+
+	ReadCachedBytes(reader, value, length);
+
+	return value;
+}
+
+
+/*
+ * WriteColumnBounds appends a possibly-NULL array of column bounds.
+ */
+static void
+WriteColumnBounds(StringInfo buffer, ColumnBound * bounds, size_t boundCount)
+{
+	bool		hasBounds = bounds != NULL;
+
+	appendBinaryStringInfo(buffer, &hasBounds, sizeof(bool));
+
+	for (size_t boundIndex = 0; hasBounds && boundIndex < boundCount; boundIndex++)
+	{
+		ColumnBound *bound = &bounds[boundIndex];
+
+		appendBinaryStringInfo(buffer, bound, sizeof(ColumnBound));
+		WriteOptionalBytes(buffer, bound->value, bound->value_length);
+	}
+}
+
+
+/*
+ * ReadColumnBounds reads an array of column bounds written by
+ * WriteColumnBounds.
+ */
+static ColumnBound *
+ReadColumnBounds(ManifestCacheReader * reader, size_t boundCount)
+{
+	bool		hasBounds = false;
+
+	ReadCachedBytes(reader, &hasBounds, sizeof(bool));
+
+	if (!hasBounds)
+		return NULL;
+
+	ColumnBound *bounds = palloc0(Max(boundCount, 1) * sizeof(ColumnBound));
+
+	for (size_t boundIndex = 0; boundIndex < boundCount; boundIndex++)
+	{
+		ColumnBound *bound = &bounds[boundIndex];
+
+		ReadCachedBytes(reader, bound, sizeof(ColumnBound));
+		bound->value = ReadOptionalBytes(reader);
+	}
+
+	return bounds;
+}
+
+
+/*
+ * ReadCachedBytes copies the next size bytes of the serialized data.
+ */
+static void
+ReadCachedBytes(ManifestCacheReader * reader, void *destination, size_t size)
+{
+	if (size > reader->length - reader->offset)
+		elog(ERROR, "unexpected end of cached manifest entries");
+
+	memcpy(destination, reader->data + reader->offset, size);
+	reader->offset += size;
+}
+
+
+/*
+ * manifest_cache_stats returns the counters and the size of the shared
+ * manifest cache.
+ */
+Datum
+manifest_cache_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupleDesc;
+
+	if (get_call_result_type(fcinfo, NULL, &tupleDesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	Datum		values[6];
+	bool		nulls[6];
+
+	memset(values, 0, sizeof(values));
+	memset(nulls, 0, sizeof(nulls));
+
+	SharedLRUCacheStats stats;
+
+	SharedLRUCacheGetStats(ManifestCache, &stats);
+
+	values[0] = Int64GetDatum(stats.hits);
+	values[1] = Int64GetDatum(stats.misses);
+	values[2] = Int64GetDatum(stats.evictions);
+	values[3] = Int64GetDatum(stats.entryCount);
+	values[4] = Int64GetDatum(stats.usedBytes);
+	values[5] = Int64GetDatum(stats.areaSize);
+
+	HeapTuple	tuple = heap_form_tuple(BlessTupleDesc(tupleDesc), values, nulls);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
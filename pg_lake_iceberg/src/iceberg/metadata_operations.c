@@ -965,14 +965,18 @@ FinalizeNewSnapshot(IcebergSnapshotBuilder * builder, Oid relationId, const char
 		List	   *manifestList = list_concat_copy(finalDataManifestList,
 													finalDeleteManifestList);
 
+		/* download all manifests concurrently */
+		List	   *manifestEntryLists =
+			FetchManifestEntriesFromManifests(manifestList, NULL);
+
 		ListCell   *manifestCell = NULL;
+		ListCell   *manifestEntriesCell = NULL;
 
-		foreach(manifestCell, manifestList)
+		forboth(manifestCell, manifestList, manifestEntriesCell, manifestEntryLists)
 		{
 			IcebergManifest *manifest = lfirst(manifestCell);
 			IcebergManifestContentType content = manifest->content;
-			List	   *manifestEntries =
-				ReadManifestEntries(manifest->manifest_path);
+			List	   *manifestEntries = lfirst(manifestEntriesCell);
 
 			List	   *deletedManifestEntries =
 				FindAndAdjustDeletedManifestEntries(manifest, manifestEntries, removedEntries,
@@ -23,8 +23,8 @@
 
 #include "utils/builtins.h"
 #include "utils/snapmgr.h"
-#include "utils/wait_event.h"
 
+#include "pg_lake/iceberg/manifest_cache.h"
 #include "pg_lake/iceberg/manifest_spec.h"
 #include "pg_lake/avro/avro_reader.h"
 #include "pg_lake/util/s3_reader_utils.h"
@@ -53,6 +53,21 @@ typedef struct PartitionFieldIdMapEntry
 }			PartitionFieldIdMapEntry;
 
 
+/*
+ * ManifestFetchContext keeps track of the manifests that are fetched by
+ * ReadManifestEntriesForPaths.
+ */
+typedef struct ManifestFetchContext
+{
+	/* manifest entries of all requested manifests */
+	List	   *manifestEntryLists;
+
+	/* manifests that were not cached, and their index in manifestEntryLists */
+	List	   *fetchPaths;
+	List	   *fetchIndexes;
+}			ManifestFetchContext;
+
+
 /*
  * ManifestReaderContext is used to pass the partition field map to the
  * manifest reader.
@@ -73,6 +88,9 @@ static void ReadIcebergManifestFromAvro(avro_value_t * record, IcebergManifest *
 static void ReadIcebergManifestEntryFromAvro(avro_value_t * record, IcebergManifestEntry * entry,
 											 ManifestReaderContext * context);
 static HTAB *CreateManifestPartitionFieldMap(AvroReader * manifestReader);
+static void ReceiveManifestBlob(int blobIndex, const char *content, size_t contentLength,
+								void *context);
+static List *ReadManifestEntriesFromBuffer(const char *manifestBlob, size_t contentLength);
 static IcebergScalarAvroType IcebergAvroTypeFromString(const char *physicalTypeName, const char *logicalTypeName);
 
 
@@ -85,25 +103,9 @@ ReadIcebergManifests(const char *manifestListPath)
 	size_t		contentLength = 0;
 	char	   *manifestListBlob = GetBlobFromURI(manifestListPath, &contentLength);
 
-	/*
-	 * TODO: replace below hack via avro memory api? tempfile will be closed
-	 * at the end of the transaction.
-	 */
-	File		manifestListLocalFile = OpenTemporaryFile(false);
-	const char *manifestListLocalPath = FilePathName(manifestListLocalFile);
-
-	int			writtenLength = FileWrite(manifestListLocalFile, manifestListBlob, contentLength, 0, WAIT_EVENT_COPY_FILE_WRITE);
-
-	if (writtenLength != contentLength)
-	{
-		ereport(ERROR,
-				(errcode(ERRCODE_INTERNAL_ERROR),
-				 errmsg("Failed to write manifest list to temporary file")));
-	}
-
 	List	   *manifests = NIL;
 	IcebergManifest *manifest = palloc0(sizeof(IcebergManifest));
-	AvroReader *manifestListReader = AvroReaderCreate(manifestListLocalPath);
+	AvroReader *manifestListReader = AvroReaderCreateFromBuffer(manifestListBlob, contentLength);
 
 	void	   *context = NULL;
 
@@ -116,7 +118,7 @@ ReadIcebergManifests(const char *manifestListPath)
 	}
 
 	AvroReaderClose(manifestListReader);
-	FileClose(manifestListLocalFile);
+	pfree(manifestListBlob);
 
 	return manifests;
 }
@@ -128,28 +130,108 @@ ReadIcebergManifests(const char *manifestListPath)
 List *
 ReadManifestEntries(const char *manifestPath)
 {
+	List	   *manifestEntries = NIL;
+
+	if (ManifestCacheLookup(manifestPath, &manifestEntries))
+		return manifestEntries;
+
 	size_t		contentLength = 0;
 	char	   *manifestBlob = GetBlobFromURI(manifestPath, &contentLength);
 
-	/*
-	 * TODO: replace below hack via avro memory api? tempfile will be closed
-	 * at the end of the transaction.
-	 */
-	File		manifestLocalFile = OpenTemporaryFile(false);
-	const char *manifestLocalPath = FilePathName(manifestLocalFile);
+	manifestEntries = ReadManifestEntriesFromBuffer(manifestBlob, contentLength);
+
+	pfree(manifestBlob);
+
+	ManifestCacheInsert(manifestPath, manifestEntries);
+
+	return manifestEntries;
+}
+
 
-	int			writtenLength = FileWrite(manifestLocalFile, manifestBlob, contentLength, 0, WAIT_EVENT_COPY_FILE_WRITE);
+/*
+ * ReadManifestEntriesForPaths reads multiple Iceberg manifest files and
+ * returns a list with the list of manifest entries of each file, in the
+ * order of the given paths.
+ *
+ * Manifests that are not in the manifest cache are downloaded concurrently
+ * by the query engine, and each manifest is decoded as soon as it arrives.
+ */
+List *
+ReadManifestEntriesForPaths(List *manifestPaths)
+{
+	ManifestFetchContext fetchContext = {
+		.manifestEntryLists = NIL,
+		.fetchPaths = NIL,
+		.fetchIndexes = NIL
+	};
 
-	if (writtenLength != contentLength)
+	ListCell   *pathCell = NULL;
+
+	foreach(pathCell, manifestPaths)
+	{
+		char	   *manifestPath = lfirst(pathCell);
+		List	   *manifestEntries = NIL;
+
+		if (!ManifestCacheLookup(manifestPath, &manifestEntries))
+		{
+			fetchContext.fetchPaths = lappend(fetchContext.fetchPaths, manifestPath);
+			fetchContext.fetchIndexes = lappend_int(fetchContext.fetchIndexes,
+													foreach_current_index(pathCell));
+		}
+
+		fetchContext.manifestEntryLists =
+			lappend(fetchContext.manifestEntryLists, manifestEntries);
+	}
+
+	if (list_length(fetchContext.fetchPaths) == 1)
 	{
-		ereport(ERROR,
-				(errcode(ERRCODE_INTERNAL_ERROR),
-				 errmsg("Failed to write manifest list to temporary file")));
+		char	   *manifestPath = linitial(fetchContext.fetchPaths);
+		size_t		contentLength = 0;
+		char	   *manifestBlob = GetBlobFromURI(manifestPath, &contentLength);
+
+		ReceiveManifestBlob(0, manifestBlob, contentLength, &fetchContext);
+
+		pfree(manifestBlob);
 	}
+	else if (fetchContext.fetchPaths != NIL)
+	{
+		GetBlobsFromURIs(fetchContext.fetchPaths, ReceiveManifestBlob, &fetchContext);
+	}
+
+	return fetchContext.manifestEntryLists;
+}
 
+
+/*
+ * ReceiveManifestBlob decodes a manifest file received by GetBlobsFromURIs
+ * into the list of manifest entry lists of the fetch context, and adds it
+ * to the manifest cache.
+ */
+static void
+ReceiveManifestBlob(int blobIndex, const char *content, size_t contentLength, void *context)
+{
+	ManifestFetchContext *fetchContext = (ManifestFetchContext *) context;
+	char	   *manifestPath = list_nth(fetchContext->fetchPaths, blobIndex);
+	int			manifestIndex = list_nth_int(fetchContext->fetchIndexes, blobIndex);
+
+	List	   *manifestEntries = ReadManifestEntriesFromBuffer(content, contentLength);
+
+	ManifestCacheInsert(manifestPath, manifestEntries);
+
+	lfirst(list_nth_cell(fetchContext->manifestEntryLists, manifestIndex)) = manifestEntries;
+}
+
+
+/*
+ * ReadManifestEntriesFromBuffer decodes the contents of an Iceberg manifest
+ * file and returns a list of manifest entries.
+ */
+static List *
+ReadManifestEntriesFromBuffer(const char *manifestBlob, size_t contentLength)
+{
 	List	   *manifestEntries = NIL;
 	IcebergManifestEntry *manifestEntry = palloc0(sizeof(IcebergManifestEntry));
-	AvroReader *manifestReader = AvroReaderCreate(manifestLocalPath);
+	AvroReader *manifestReader = AvroReaderCreateFromBuffer(manifestBlob, contentLength);
 
 	ManifestReaderContext *context = palloc0(sizeof(ManifestReaderContext));
 
@@ -164,7 +246,6 @@ ReadManifestEntries(const char *manifestPath)
 	}
 
 	AvroReaderClose(manifestReader);
-	FileClose(manifestLocalFile);
 
 	return manifestEntries;
 }
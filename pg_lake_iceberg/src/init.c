@@ -30,6 +30,7 @@
 #include "pg_lake/iceberg/api.h"
 #include "pg_lake/iceberg/catalog.h"
 #include "pg_lake/iceberg/iceberg_field.h"
+#include "pg_lake/iceberg/manifest_cache.h"
 #include "pg_lake/iceberg/operations/manifest_merge.h"
 #include "pg_lake/iceberg/operations/vacuum.h"
 #include "pg_lake/object_store_catalog/object_store_catalog.h"
@@ -205,6 +206,28 @@ _PG_init(void)
 							GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
 							NULL, NULL, NULL);
 
+	DefineCustomIntVariable("pg_lake_iceberg.manifest_cache_size",
+							gettext_noop("Size of the shared memory cache of decoded manifest "
+										 "files. Requires pg_lake_iceberg in "
+										 "shared_preload_libraries, 0 disables the cache."),
+							NULL,
+							&ManifestCacheSizeKB,
+							DEFAULT_MANIFEST_CACHE_SIZE_KB,
+							0,
+							INT_MAX / 1024,
+							PGC_POSTMASTER,
+							GUC_UNIT_KB,
+							NULL, NULL, NULL);
+
+	DefineCustomBoolVariable("pg_lake_iceberg.enable_manifest_cache",
+							 gettext_noop("Enables the shared memory cache of decoded manifest files."),
+							 NULL,
+							 &EnableManifestCache,
+							 true,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL, NULL, NULL);
+
 	DefineCustomIntVariable("pg_lake_iceberg.max_snapshot_age",
 							gettext_noop("The default maximum age of snapshots in seconds to retain on "
 										 "the tables and branches when expiring snapshots."),
@@ -265,6 +288,7 @@ _PG_init(void)
 							   NULL, NULL, NULL);
 
 	AvroInit();
+	InitializeManifestCache();
 }
 
 
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+#include "pg_lake/fdw/snapshot.h"
+
+/* 16MB */
+#define DEFAULT_QUERY_TEXT_CACHE_SIZE_KB (16 * 1024)
+
+/* pg_lake_table.query_text_cache_size */
+extern int	QueryTextCacheSizeKB;
+
+extern void InitializeQueryTextCache(void);
+extern uint64 ScanSnapshotFingerprint(PgLakeScanSnapshot * snapshot);
+extern char *LookupQueryTextCache(const char *queryTemplate, int scanFlags,
+								  uint64 fingerprint);
+extern void AddQueryTextToCache(const char *queryTemplate, int scanFlags,
+								uint64 fingerprint, PgLakeScanSnapshot * snapshot,
+								const char *queryText);
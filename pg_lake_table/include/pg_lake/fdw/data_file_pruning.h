@@ -20,6 +20,7 @@
 #include "postgres.h"
 
 #include "nodes/pg_list.h"
+#include "pg_lake/iceberg/metadata_spec.h"
 
 
 /*
@@ -37,5 +38,8 @@ extern bool EnableDataFilePruning;
 extern bool EnablePartitionPruning;
 
 List	   *PruneDataFiles(Oid relationId, List *dataFiles, List *baseRestrictInfoList, PruneType pruneType);
+bool		IsFullMatchDataFile(List *fullMatches, ListCell **fullMatchCell, void *dataFile);
+List	   *PruneManifests(Oid relationId, IcebergTableMetadata * metadata, List *manifests,
+						   List *baseRestrictInfoList);
 Var		   *GetFilenameFilterColumn(Oid relationId, List *baseRestrictInfoList);
 List	   *PruneByFilename(List *paths, Oid relationId, List *baseRestrictInfoList);
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+#include "nodes/pg_list.h"
+#include "nodes/primnodes.h"
+#include "pg_lake/fdw/data_file_pruning.h"
+#include "pg_lake/pgduck/type.h"
+
+/*
+ * RangeFilterColumn describes a column that can be used in a range filter,
+ * with the field id of its statistics in the data files.
+ */
+typedef struct RangeFilterColumn
+{
+	Var		   *column;
+	int			fieldId;
+	PGType		pgType;
+}			RangeFilterColumn;
+
+/*
+ * RangeFilterResult is the outcome of checking a range filter against the
+ * bounds of a single data file.
+ */
+typedef enum RangeFilterResult
+{
+	/* the bounds do not decide, fall back to the predicate prover */
+	RANGE_FILTER_UNKNOWN,
+
+	/* no row in the data file can match the filters */
+	RANGE_FILTER_REFUTED,
+
+	/* all rows in the data file match the filters */
+	RANGE_FILTER_IMPLIED
+}			RangeFilterResult;
+
+typedef struct DataFileRangeFilter DataFileRangeFilter;
+
+/* pg_lake_table.enable_bulk_data_file_pruning setting */
+extern bool EnableBulkDataFilePruning;
+
+extern DataFileRangeFilter * CompileDataFileRangeFilter(List *clauses, List *filterColumns);
+extern bool RangeFilterCoversAllClauses(DataFileRangeFilter * filter);
+extern RangeFilterResult * EvaluateDataFileRangeFilter(DataFileRangeFilter * filter,
+													   List *columnStatsPerFile,
+													   PruneType pruneType);
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+#include "nodes/pg_list.h"
+#include "utils/hsearch.h"
+
+/* 64MB */
+#define DEFAULT_DATA_FILE_CACHE_SIZE_KB (64 * 1024)
+
+/* pg_lake_table.data_file_cache_size */
+extern int	DataFileCacheSizeKB;
+
+extern void InitializeDataFileCache(void);
+extern bool DataFileCacheEnabled(Oid relationId);
+extern bool DataFileCacheContainsRelation(Oid relationId);
+extern List *FillDataFileDetailsFromCache(Oid relationId, HTAB *dataFiles,
+										  bool dataOnly, bool newFilesOnly);
+extern void AddDataFileDetailsToCache(Oid relationId, HTAB *dataFiles);
@@ -31,6 +31,7 @@
 #include "nodes/parsenodes.h"
 
 extern List *ReplacePgLakeTableWithReadTableFunc(Node *node);
+extern List *ReplaceHeapTablesWithReadTableFunc(Node *node);
 extern List *RteListToOidList(List *rteList);
 extern Query *ParseQuery(char *command, List *paramList);
 extern char *PreparePGDuckSQLTemplate(Query *query);
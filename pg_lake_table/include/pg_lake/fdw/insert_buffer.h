@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+#include "executor/tuptable.h"
+#include "fmgr.h"
+#include "nodes/pg_list.h"
+#include "pg_lake/extensions/pg_lake_table.h"
+#include "pg_lake/fdw/snapshot.h"
+#include "utils/relcache.h"
+#include "utils/snapshot.h"
+
+#define INSERT_BUFFER_TABLE_NAME "insert_buffer"
+#define INSERT_BUFFER_TABLE_QUALIFIED \
+	PG_LAKE_TABLE_SCHEMA "." INSERT_BUFFER_TABLE_NAME
+
+/* statements that insert more rows skip the insert buffer */
+#define DEFAULT_INSERT_BUFFER_MAX_STATEMENT_ROWS (1000)
+
+/* flush the insert buffer of a table once it has this many rows */
+#define DEFAULT_INSERT_BUFFER_FLUSH_ROWS (10000)
+
+/* flush the insert buffer of a table once a row is 10 seconds old */
+#define DEFAULT_INSERT_BUFFER_FLUSH_INTERVAL (10)
+
+/*
+ * InsertBuffer holds the rows of an INSERT into a table with the
+ * insert_buffer option until the end of the statement.
+ */
+typedef struct InsertBuffer
+{
+	Relation	rel;
+
+	/* memory context in which we keep the rows */
+	MemoryContext context;
+
+	/* list of MinimalTuple */
+	List	   *rows;
+	int			rowCount;
+
+	/* binary output function of the row type */
+	FmgrInfo	recordSendFunction;
+}			InsertBuffer;
+
+/* pg_lake_table.insert_buffer_max_statement_rows setting */
+extern PGDLLEXPORT int InsertBufferMaxStatementRows;
+
+/* pg_lake_table.insert_buffer_flush_rows setting */
+extern PGDLLEXPORT int InsertBufferFlushRows;
+
+/* pg_lake_table.insert_buffer_flush_interval setting */
+extern PGDLLEXPORT int InsertBufferFlushInterval;
+
+extern PGDLLEXPORT bool IsInsertBufferEnabled(Oid relationId);
+extern PGDLLEXPORT InsertBuffer * CreateInsertBuffer(Relation rel);
+extern PGDLLEXPORT bool AddRowToInsertBuffer(InsertBuffer * buffer, TupleTableSlot *slot);
+extern PGDLLEXPORT void FinishInsertBuffer(InsertBuffer * buffer);
+extern PGDLLEXPORT int64 FlushInsertBuffer(Oid relationId);
+extern PGDLLEXPORT int64 CountInsertBufferRows(Oid relationId);
+extern PGDLLEXPORT void ClearInsertBuffer(Oid relationId);
+extern PGDLLEXPORT PgLakeFileScan * CreateInsertBufferFileScan(Oid relationId, Snapshot snapshot);
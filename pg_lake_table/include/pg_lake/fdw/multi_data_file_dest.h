@@ -28,9 +28,19 @@
 /* pg_lake_table.max_write_temp_file_size_mb setting */
 extern PGDLLEXPORT int MaxWriteTempFileSizeMB;
 
+/* pg_lake_table.enable_streaming_writes setting */
+extern PGDLLEXPORT bool EnableStreamingWrites;
+
+/* by default, convert one write file while the next one fills up */
+#define DEFAULT_MAX_BACKGROUND_WRITE_FLUSHES (1)
+
+/* pg_lake_table.max_background_write_flushes setting */
+extern PGDLLEXPORT int MaxBackgroundWriteFlushes;
+
 extern PGDLLEXPORT DestReceiver *CreateMultiDataFileDestReceiver(Oid relationId,
 																 CopyDataFormat targetFormat,
 																 int MaxWriteTempFileSizeMB,
 																 int32 partitionSpecId,
-																 int64 rowIdStart);
+																 int64 rowIdStart,
+																 bool allowPipelining);
 extern PGDLLEXPORT List *GetMultiDataFileDestReceiverModifications(DestReceiver *dest);
@@ -31,6 +31,8 @@ extern List *CurrentPartitionTransformList(Oid relationId);
 extern IcebergPartitionSpec * GetPartitionSpecIfAlreadyExist(Oid relationId, List *partitionTransforms);
 extern List *AllPartitionTransformList(Oid relationId);
 extern List *GetPartitionTransformsFromSpecFields(Oid relationId, List *specFields);
+extern IcebergPartitionTransform * GetPartitionTransformForColumn(Oid relationId, AttrNumber attnum,
+																  IcebergPartitionSpecField * specField);
 extern void *DeserializePartitionValueFromPGText(IcebergPartitionTransform * transform,
 												 const char *valueText, size_t *valueLength);
 extern const char *SerializePartitionValueToPGText(void *value, size_t valueLength, IcebergPartitionTransform * transform);
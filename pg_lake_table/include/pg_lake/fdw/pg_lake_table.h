@@ -82,6 +82,13 @@ typedef struct PgLakeRelationInfo
 	/* Selectivity of join conditions */
 	Selectivity joinclause_sel;
 
+	/*
+	 * Number of rows and pages that a scan of a base relation reads,
+	 * estimated from file statistics. file_rows is -1 if unknown.
+	 */
+	double		file_rows;
+	double		file_pages;
+
 	/* Estimated size and cost for a scan, join, or grouping/aggregation. */
 	double		rows;
 	int			width;
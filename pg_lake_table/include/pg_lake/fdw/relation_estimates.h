@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+#include "nodes/pg_list.h"
+
+/*
+ * LakeRelationEstimate describes the files of a lake table that a scan with
+ * a given set of filters reads.
+ */
+typedef struct LakeRelationEstimate
+{
+	/* live rows in files in which all rows match the filters */
+	double		fullMatchRows;
+
+	/* live rows in files in which some rows may match the filters */
+	double		partialMatchRows;
+
+	/* total size of the files that are read */
+	double		fileBytes;
+}			LakeRelationEstimate;
+
+/* pg_lake_table.enable_file_statistics_estimates setting */
+extern bool EnableFileStatisticsEstimates;
+
+/* pg_lake_table.enable_external_table_estimates setting */
+extern bool EnableExternalTableEstimates;
+
+extern bool EstimateLakeRelationSize(Oid relationId, List *baseRestrictInfoList,
+									 LakeRelationEstimate * estimate);
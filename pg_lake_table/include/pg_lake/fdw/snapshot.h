@@ -39,6 +39,9 @@ typedef struct PgLakeFileScan
 
 	/* true if we already determined that all rows match our filters */
 	bool		allRowsMatch;
+
+	/* size of the file in bytes (0 for unknown) */
+	int64		fileSize;
 }			PgLakeFileScan;
 
 /*
@@ -71,11 +74,17 @@ typedef struct PgLakeScanSnapshot
 }			PgLakeScanSnapshot;
 
 
+#define DEFAULT_MAX_PREFETCH_FILES_PER_SCAN (16)
+
+/* pg_lake_table.max_prefetch_files_per_scan setting */
+extern int	MaxPrefetchFilesPerScan;
+
 PgLakeScanSnapshot *CreatePgLakeScanSnapshot(List *rteList,
 											 List *relationRestrictionsList,
 											 ParamListInfo externalParams,
 											 bool includeChildren,
 											 Oid resultRelationId);
+void		PrefetchScanSnapshotFiles(PgLakeScanSnapshot * snapshot);
 PgLakeTableScan *GetTableScanByRelationId(PgLakeScanSnapshot * snapshot, Oid relationId);
 List	   *GetFileScanPathList(List *fileScans, uint64 *rowCount, bool skipFullScans);
 void		SnapshotFilesScanned(PgLakeScanSnapshot * scanSnapshot, int *dataFileScans, int *deleteFileScans);
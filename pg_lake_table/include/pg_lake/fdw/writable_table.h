@@ -20,6 +20,8 @@
 #include "nodes/pg_list.h"
 #include "utils/relcache.h"
 #include "pg_lake/data_file/data_files.h"
+#include "pg_lake/pgduck/copy_in.h"
+#include "pg_lake/pgduck/write_data.h"
 
 /* by default, we switch to copy-on-write if 20% or more of a file is deleted */
 #define DEFAULT_COPY_ON_WRITE_THRESHOLD (20)
@@ -78,6 +80,54 @@ typedef struct DataFileModification
 	int64		reservedRowIdStart;
 }			DataFileModification;
 
+/*
+ * PendingInsertion is a conversion of inserted rows to data files that was
+ * started by StartCSVInsertion or StartCopyInInsertion.
+ */
+typedef struct PendingInsertion
+{
+	/* data file path, or prefix if the data may be split into several files */
+	char	   *dataFilePrefix;
+	bool		isPrefix;
+
+	/* whether the deletion of in-progress files is deferred */
+	bool		deferDeletion;
+
+	/* number of inserted rows */
+	int64		rowCount;
+
+	/* if the caller already reserved a row ID range, where does it start? */
+	int64		reservedRowIdStart;
+
+	/* write in pgduck_server that produces the data files */
+	PendingWrite *write;
+}			PendingInsertion;
+
+/*
+ * PendingQueryResultInsertion is a write of the result of a pgduck query
+ * into a table that was started by StartAddQueryResultToTable.
+ */
+typedef struct PendingQueryResultInsertion
+{
+	Oid			relationId;
+
+	/* data file path, or prefix if the data may be split into several files */
+	char	   *dataFilePrefix;
+	bool		isPrefix;
+
+	/* whether the deletion of in-progress files is deferred */
+	bool		deferDeletion;
+
+	/* partition of the new data files */
+	int32		partitionSpecId;
+	Partition  *partition;
+
+	bool		isVerbose;
+
+	/* write in pgduck_server that produces the data files */
+	PendingWrite *write;
+}			PendingQueryResultInsertion;
+
 
 /* pg_lake_table.copy_on_write_threshold */
 extern int	CopyOnWriteThreshold;
@@ -113,6 +163,18 @@ extern PGDLLEXPORT bool TryLockTableForUpdate(Oid relationId);
 extern PGDLLEXPORT List *PrepareCSVInsertion(Oid relationId, char *insertCSV, int64 rowCount,
 											 int64 reservedRowIdStart, int maximumLineSize,
 											 DataFileSchema * schema);
+extern PGDLLEXPORT PendingInsertion * StartCSVInsertion(Oid relationId, char *insertCSV,
+														int64 rowCount, int64 reservedRowIdStart,
+														int maximumLineSize,
+														DataFileSchema * schema);
+extern PGDLLEXPORT PendingInsertion * StartCopyInInsertion(Oid relationId, PGDuckCopyIn * copyIn,
+														   int64 rowCount, int64 reservedRowIdStart,
+														   DataFileSchema * schema);
+extern PGDLLEXPORT List *FinishInsertion(PendingInsertion * insertion);
 
 extern PGDLLEXPORT int64 AddQueryResultToTable(Oid relationId, char *readQuery,
 											   TupleDesc queryTupleDesc);
+extern PGDLLEXPORT PendingQueryResultInsertion * StartAddQueryResultToTable(Oid relationId,
+																		  char *readQuery,
+																		  TupleDesc queryTupleDesc);
+extern PGDLLEXPORT int64 FinishAddQueryResultToTable(PendingQueryResultInsertion * insertion);
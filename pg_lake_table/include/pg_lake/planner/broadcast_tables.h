@@ -0,0 +1,32 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "nodes/parsenodes.h"
+#include "nodes/pg_list.h"
+
+/* default maximum size of a table that is sent to pgduck */
+#define DEFAULT_BROADCAST_TABLE_SIZE_LIMIT_KB (8 * 1024)
+
+/* pg_lake_table.broadcast_table_size_limit setting */
+extern int	BroadcastTableSizeLimitKB;
+
+extern bool IsBroadcastableTable(RangeTblEntry *rte);
+extern bool HasBroadcastTable(Node *node);
+extern List *CreateBroadcastTableScans(List *rteList, bool explainOnly);
+extern char *ReplaceBroadcastTableCalls(char *query, List *broadcastScans,
+										bool explainRequested);
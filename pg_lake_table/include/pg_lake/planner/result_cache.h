@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "postgres.h"
+
+#include "access/htup.h"
+#include "lib/stringinfo.h"
+
+/* 64MB */
+#define DEFAULT_RESULT_CACHE_SIZE_KB (64 * 1024)
+
+/* pg_lake_table.result_cache_size */
+extern int	ResultCacheSizeKB;
+
+/* pg_lake_table.enable_result_cache */
+extern bool EnableResultCache;
+
+extern void InitializeResultCache(void);
+extern bool IsResultCacheEnabled(void);
+extern size_t ResultCacheMaxEntrySize(void);
+extern char *BuildResultCacheKey(const char *queryString, int numParams,
+								 const char **parameterValues, size_t *keySize);
+extern bool ResultCacheLookup(const char *key, size_t keySize,
+							  char **results, size_t *resultsSize);
+extern void ResultCacheInsert(const char *key, size_t keySize,
+							  const char *results, size_t resultsSize);
+extern void AppendResultCacheTuple(StringInfo results, HeapTuple tuple);
+extern bool ReadResultCacheTuple(const char *results, size_t resultsSize,
+								 size_t *offset, HeapTuple tuple);
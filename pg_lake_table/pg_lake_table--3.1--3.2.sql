@@ -0,0 +1,89 @@
+/*
+ * The insert_buffer table holds rows that were inserted into Iceberg tables
+ * with the insert_buffer option and are not yet written to data files. Each
+ * row is stored in the binary representation of the table's row type, which
+ * does not depend on session settings such as DateStyle.
+ *
+ * Scans read the buffered rows in addition to the data files, and the insert
+ * buffer worker periodically moves them into new data files.
+ */
+CREATE TABLE lake_table.insert_buffer (
+    -- OID/name of the table
+    table_name regclass not null,
+
+    -- binary representation of the row (record_send)
+    row_data bytea not null,
+
+    -- time at which the row was inserted
+    inserted_at timestamptz not null default now()
+);
+CREATE INDEX insert_buffer_table_name_idx ON lake_table.insert_buffer (table_name);
+
+CREATE FUNCTION lake_table.flush_insert_buffer(table_name regclass)
+RETURNS bigint
+LANGUAGE C STRICT
+AS 'MODULE_PATHNAME', $function$flush_insert_buffer$function$;
+COMMENT ON FUNCTION lake_table.flush_insert_buffer(regclass) IS 'writes the buffered rows of an Iceberg table to data files and returns the number of rows';
+REVOKE ALL ON FUNCTION lake_table.flush_insert_buffer(regclass) FROM public;
+GRANT EXECUTE ON FUNCTION lake_table.flush_insert_buffer(regclass) TO lake_write;
+
+CREATE FUNCTION lake_table.insert_buffer_worker(internal)
+RETURNS internal
+AS 'MODULE_PATHNAME', 'pg_lake_table_insert_buffer_worker'
+LANGUAGE C STRICT;
+
+SELECT extension_base.register_worker('iceberg insert buffer worker', 'lake_table.insert_buffer_worker');
+
+CREATE FUNCTION lake_table.query_text_cache_stats(
+    OUT cache_hits bigint,
+    OUT cache_misses bigint,
+    OUT cached_queries bigint,
+    OUT cache_size bigint)
+ RETURNS record
+ LANGUAGE C
+ STRICT
+AS 'MODULE_PATHNAME', $function$query_text_cache_stats$function$;
+COMMENT ON FUNCTION lake_table.query_text_cache_stats()
+ IS 'query text cache statistics of the current session';
+REVOKE ALL ON FUNCTION lake_table.query_text_cache_stats() FROM public;
+GRANT EXECUTE ON FUNCTION lake_table.query_text_cache_stats() TO lake_read;
+
+CREATE FUNCTION lake_table.data_file_cache_stats(
+    OUT hits bigint,
+    OUT misses bigint,
+    OUT invalidations bigint,
+    OUT cached_relations bigint,
+    OUT cached_files bigint,
+    OUT used_bytes bigint)
+ RETURNS record
+ LANGUAGE C
+ STRICT
+AS 'MODULE_PATHNAME', $function$data_file_cache_stats$function$;
+COMMENT ON FUNCTION lake_table.data_file_cache_stats()
+ IS 'data file cache statistics of the current session';
+REVOKE ALL ON FUNCTION lake_table.data_file_cache_stats() FROM public;
+GRANT EXECUTE ON FUNCTION lake_table.data_file_cache_stats() TO lake_read;
+
+CREATE FUNCTION lake_table.result_cache_stats(
+    OUT hits bigint,
+    OUT misses bigint,
+    OUT evictions bigint,
+    OUT cached_results bigint,
+    OUT used_bytes bigint,
+    OUT size_bytes bigint)
+ RETURNS record
+ LANGUAGE C
+ STRICT
+AS 'MODULE_PATHNAME', $function$result_cache_stats$function$;
+REVOKE ALL ON FUNCTION lake_table.result_cache_stats() FROM public;
+GRANT EXECUTE ON FUNCTION lake_table.result_cache_stats() TO lake_read;
+
+/*
+ * The result_cache view shows the hit and miss counters and the size of
+ * the shared memory cache of pushed down query results.
+ */
+CREATE VIEW lake_table.result_cache AS
+	SELECT hits, misses, evictions, cached_results, used_bytes, size_bytes
+	FROM lake_table.result_cache_stats();
+REVOKE ALL ON lake_table.result_cache FROM public;
+GRANT SELECT ON lake_table.result_cache TO lake_read;
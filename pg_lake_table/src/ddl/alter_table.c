@@ -47,6 +47,7 @@
 #include "pg_lake/ddl/create_table.h"
 #include "pg_lake/ddl/drop_table.h"
 #include "pg_lake/partitioning/partition_by_parser.h"
+#include "pg_lake/fdw/insert_buffer.h"
 #include "pg_lake/fdw/row_ids.h"
 #include "pg_lake/fdw/schema_operations/field_id_mapping_catalog.h"
 #include "pg_lake/fdw/schema_operations/register_field_ids.h"
@@ -298,6 +299,10 @@ ProcessAlterTable(ProcessUtilityParams * processUtilityParams, void *arg)
 	if (tableType == PG_LAKE_ICEBERG_TABLE_TYPE)
 		HandleIcebergOptionsChanges(relationId, alterStmt);
 
+	/* buffered rows are in the current row format, so write them out first */
+	if (tableType == PG_LAKE_ICEBERG_TABLE_TYPE && IsInsertBufferEnabled(relationId))
+		FlushInsertBuffer(relationId);
+
 	/*
 	 * Do the actual DDL using internal ProcessUtility. We use
 	 * PgLakeCommonParentProcessUtility, which skips other pg_lake_engine
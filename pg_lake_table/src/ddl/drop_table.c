@@ -41,6 +41,7 @@
 #include "pg_lake/cleanup/deletion_queue.h"
 #include "pg_lake/fdw/data_files_catalog.h"
 #include "pg_lake/fdw/data_file_stats_catalog.h"
+#include "pg_lake/fdw/insert_buffer.h"
 #include "pg_lake/fdw/writable_table.h"
 #include "pg_lake/fdw/schema_operations/field_id_mapping_catalog.h"
 #include "pg_lake/fdw/schema_operations/register_field_ids.h"
@@ -262,6 +263,13 @@ DropTableAccessHook(ObjectAccessType access, Oid classId, Oid objectId,
 
 			ErrorIfColumnEverUsedInIcebergPartitionSpec(objectId, subId, errorDetail->data);
 
+			/*
+			 * Buffered rows still have the dropped column, which may happen
+			 * without ALTER TABLE when cascading from DROP TYPE.
+			 */
+			if (IsInsertBufferEnabled(objectId))
+				FlushInsertBuffer(objectId);
+
 			/*
 			 * When a column gets dropped, we should remove it from the
 			 * Iceberg schema.
@@ -293,6 +301,8 @@ DropTableAccessHook(ObjectAccessType access, Oid classId, Oid objectId,
 
 			ApplyDDLChanges(objectId, list_make1(ddlOperation));
 
+			ClearInsertBuffer(objectId);
+
 			TriggerCatalogExportIfObjectStoreTable(objectId);
 
 			IcebergCatalogType catalogType = GetIcebergCatalogType(objectId);
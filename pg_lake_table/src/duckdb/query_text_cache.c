@@ -0,0 +1,464 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Per-backend cache of query texts in which the read_table placeholders are
+ * replaced with calls that read the files of a scan snapshot.
+ *
+ * Prepared statements and other repeated queries send the same query
+ * template on every execution, and most of the time the tables involved
+ * still have the same files. Building the read calls for those files
+ * requires a number of catalog lookups and, for tables with many files, a
+ * lot of string building, which we can skip by reusing the query text of
+ * an earlier execution.
+ *
+ * Entries are keyed by the query template, the scan flags, and a
+ * fingerprint of the files in the scan snapshot. The snapshot itself is
+ * still created on every execution, such that visibility follows the
+ * snapshot of the caller, and any change to the set of files to scan
+ * (including pruning that depends on parameter values) results in a
+ * different fingerprint.
+ *
+ * DDL that changes how files are read (e.g. changing the type of a column
+ * or the options of a table) sends a relcache invalidation, which drops the
+ * entries that involve the relation.
+ */
+#include "postgres.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+
+#include "access/htup_details.h"
+#include "common/hashfn.h"
+#include "lib/ilist.h"
+#include "pg_lake/duckdb/query_text_cache.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+#include "utils/syscache.h"
+
+
+/*
+ * CachedQueryText is a query text in which the read_table placeholders
+ * are replaced.
+ */
+typedef struct CachedQueryText
+{
+	/* hash key, derived from the template, scan flags, and fingerprint */
+	uint64		cacheKey;
+
+	/* query template with read_table placeholders */
+	char	   *queryTemplate;
+
+	/* flags passed to ReplaceReadTableFunctionCalls */
+	int			scanFlags;
+
+	/* fingerprint of the files in the scan snapshot */
+	uint64		fingerprint;
+
+	/* relations involved in the scan, for invalidation */
+	Oid		   *relationIds;
+	int			relationCount;
+
+	/* query text with the read calls */
+	char	   *queryText;
+
+	/* memory allocated for this entry */
+	Size		memoryBytes;
+
+	/* position in the LRU list */
+	dlist_node	lruNode;
+}			CachedQueryText;
+
+
+static void InvalidateQueryTextCacheForRelation(Datum argument, Oid relationId);
+static void InvalidateQueryTextCache(Datum argument, int cacheId, uint32 hashValue);
+static uint64 FingerprintTableScan(PgLakeTableScan * tableScan, uint64 hash);
+static uint64 FingerprintFileScans(List *fileScans, uint64 hash);
+static uint64 QueryTextCacheKey(const char *queryTemplate, int scanFlags,
+								uint64 fingerprint);
+static void CollectRelationIds(List *tableScans, List **relationIds);
+static void RemoveCachedQueryText(CachedQueryText * entry);
+static void EnforceQueryTextCacheSize(void);
+
+PG_FUNCTION_INFO_V1(query_text_cache_stats);
+
+/* pg_lake_table.query_text_cache_size */
+int			QueryTextCacheSizeKB = DEFAULT_QUERY_TEXT_CACHE_SIZE_KB;
+
+/* cache key -> CachedQueryText */
+static HTAB *QueryTextCache = NULL;
+
+/* cached query texts in least-recently used order, most recent first */
+static dlist_head QueryTextCacheLRU = DLIST_STATIC_INIT(QueryTextCacheLRU);
+
+/* total memory allocated by cached query texts */
+static Size TotalQueryTextCacheBytes = 0;
+
+/* memory context of the hash and all cached query texts */
+static MemoryContext QueryTextCacheContext = NULL;
+
+/* number of lookups that found or did not find a cached query text */
+static int64 QueryTextCacheHits = 0;
+static int64 QueryTextCacheMisses = 0;
+
+
+/*
+ * InitializeQueryTextCache registers the invalidation callbacks that drop
+ * cached query texts.
+ */
+void
+InitializeQueryTextCache(void)
+{
+	CacheRegisterRelcacheCallback(InvalidateQueryTextCacheForRelation, (Datum) 0);
+
+	/* read calls include type names, which do not go through the relcache */
+	CacheRegisterSyscacheCallback(TYPEOID, InvalidateQueryTextCache, (Datum) 0);
+}
+
+
+/*
+ * ScanSnapshotFingerprint returns a hash of the files in the scan snapshot,
+ * which changes whenever the read calls for the snapshot would change.
+ */
+uint64
+ScanSnapshotFingerprint(PgLakeScanSnapshot * snapshot)
+{
+	uint64		hash = list_length(snapshot->tableScans);
+
+	foreach_ptr(PgLakeTableScan, tableScan, snapshot->tableScans)
+	{
+		hash = FingerprintTableScan(tableScan, hash);
+	}
+
+	return hash;
+}
+
+
+/*
+ * FingerprintTableScan combines the hash of a table scan and its child
+ * scans with the given hash.
+ */
+static uint64
+FingerprintTableScan(PgLakeTableScan * tableScan, uint64 hash)
+{
+	hash = hash_bytes_uint32_extended(tableScan->relationId, hash);
+	hash = hash_bytes_uint32_extended(tableScan->uniqueRelationIdentifier, hash);
+	hash = hash_bytes_uint32_extended(tableScan->isUpdateDelete, hash);
+
+	hash = FingerprintFileScans(tableScan->fileScans, hash);
+	hash = FingerprintFileScans(tableScan->positionDeleteScans, hash);
+
+	hash = hash_combine64(hash, list_length(tableScan->childScans));
+
+	foreach_ptr(PgLakeTableScan, childScan, tableScan->childScans)
+	{
+		hash = FingerprintTableScan(childScan, hash);
+	}
+
+	return hash;
+}
+
+
+/*
+ * FingerprintFileScans combines the hash of a list of file scans with the
+ * given hash.
+ */
+static uint64
+FingerprintFileScans(List *fileScans, uint64 hash)
+{
+	hash = hash_combine64(hash, list_length(fileScans));
+
+	foreach_ptr(PgLakeFileScan, fileScan, fileScans)
+	{
+		hash = hash_bytes_extended((const unsigned char *) fileScan->path,
+								   strlen(fileScan->path), hash);
+		hash = hash_combine64(hash, (uint64) fileScan->rowCount);
+		hash = hash_combine64(hash, fileScan->deletedRowCount);
+		hash = hash_bytes_uint32_extended(fileScan->allRowsMatch, hash);
+	}
+
+	return hash;
+}
+
+
+/*
+ * QueryTextCacheKey returns the hash key of a cached query text.
+ */
+static uint64
+QueryTextCacheKey(const char *queryTemplate, int scanFlags, uint64 fingerprint)
+{
+	uint64		hash = hash_bytes_extended((const unsigned char *) queryTemplate,
+										   strlen(queryTemplate), fingerprint);
+
+	return hash_bytes_uint32_extended(scanFlags, hash);
+}
+
+
+/*
+ * LookupQueryTextCache returns a copy of the cached query text for the given
+ * template, scan flags, and snapshot fingerprint, or NULL if there is none.
+ */
+char *
+LookupQueryTextCache(const char *queryTemplate, int scanFlags, uint64 fingerprint)
+{
+	if (QueryTextCacheSizeKB == 0)
+		return NULL;
+
+	CachedQueryText *entry = NULL;
+
+	if (QueryTextCache != NULL)
+	{
+		uint64		cacheKey = QueryTextCacheKey(queryTemplate, scanFlags, fingerprint);
+
+		entry = hash_search(QueryTextCache, &cacheKey, HASH_FIND, NULL);
+	}
+
+	/* a different template or snapshot can map to the same key */
+	if (entry == NULL ||
+		entry->scanFlags != scanFlags ||
+		entry->fingerprint != fingerprint ||
+		strcmp(entry->queryTemplate, queryTemplate) != 0)
+	{
+		QueryTextCacheMisses++;
+		return NULL;
+	}
+
+	QueryTextCacheHits++;
+
+	dlist_move_head(&QueryTextCacheLRU, &entry->lruNode);
+
+	return pstrdup(entry->queryText);
+}
+
+
+/*
+ * AddQueryTextToCache adds a query text in which the read_table placeholders
+ * of the given template were replaced using the given snapshot.
+ */
+void
+AddQueryTextToCache(const char *queryTemplate, int scanFlags, uint64 fingerprint,
+					PgLakeScanSnapshot * snapshot, const char *queryText)
+{
+	if (QueryTextCacheSizeKB == 0)
+		return;
+
+	Size		maxCacheBytes = (Size) QueryTextCacheSizeKB * 1024;
+	Size		templateBytes = strlen(queryTemplate) + 1;
+	Size		queryTextBytes = strlen(queryText) + 1;
+	List	   *relationIds = NIL;
+
+	CollectRelationIds(snapshot->tableScans, &relationIds);
+
+	Size		relationIdBytes = list_length(relationIds) * sizeof(Oid);
+	Size		memoryBytes = sizeof(CachedQueryText) + templateBytes +
+		queryTextBytes + relationIdBytes;
+
+	/* do not let a single query text push out everything else */
+	if (memoryBytes > maxCacheBytes)
+		return;
+
+	if (QueryTextCache == NULL)
+	{
+		QueryTextCacheContext = AllocSetContextCreate(TopMemoryContext,
+													  "Query Text Cache",
+													  ALLOCSET_DEFAULT_SIZES);
+
+		HASHCTL		hashCtl;
+
+		memset(&hashCtl, 0, sizeof(hashCtl));
+		hashCtl.keysize = sizeof(uint64);
+		hashCtl.entrysize = sizeof(CachedQueryText);
+		hashCtl.hcxt = QueryTextCacheContext;
+
+		QueryTextCache = hash_create("cached query texts by key",
+									 64, &hashCtl,
+									 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	/* allocate before entering the hash, such that entries are always valid */
+	char	   *templateCopy = MemoryContextStrdup(QueryTextCacheContext, queryTemplate);
+	char	   *queryTextCopy = MemoryContextStrdup(QueryTextCacheContext, queryText);
+	Oid		   *relationIdArray = NULL;
+
+	if (relationIds != NIL)
+	{
+		relationIdArray = MemoryContextAlloc(QueryTextCacheContext, relationIdBytes);
+
+		for (int relationIndex = 0; relationIndex < list_length(relationIds); relationIndex++)
+			relationIdArray[relationIndex] = list_nth_oid(relationIds, relationIndex);
+	}
+
+	uint64		cacheKey = QueryTextCacheKey(queryTemplate, scanFlags, fingerprint);
+	bool		found = false;
+	CachedQueryText *entry =
+		hash_search(QueryTextCache, &cacheKey, HASH_ENTER, &found);
+
+	if (found)
+	{
+		/* replace the entry that maps to the same key */
+		pfree(entry->queryTemplate);
+		pfree(entry->queryText);
+
+		if (entry->relationIds != NULL)
+			pfree(entry->relationIds);
+
+		TotalQueryTextCacheBytes -= entry->memoryBytes;
+		dlist_delete(&entry->lruNode);
+	}
+
+	entry->queryTemplate = templateCopy;
+	entry->scanFlags = scanFlags;
+	entry->fingerprint = fingerprint;
+	entry->queryText = queryTextCopy;
+	entry->relationIds = relationIdArray;
+	entry->relationCount = list_length(relationIds);
+	entry->memoryBytes = memoryBytes;
+	TotalQueryTextCacheBytes += memoryBytes;
+
+	dlist_push_head(&QueryTextCacheLRU, &entry->lruNode);
+
+	EnforceQueryTextCacheSize();
+}
+
+
+/*
+ * CollectRelationIds appends the relation IDs of the given table scans and
+ * their child scans to relationIds.
+ */
+static void
+CollectRelationIds(List *tableScans, List **relationIds)
+{
+	foreach_ptr(PgLakeTableScan, tableScan, tableScans)
+	{
+		*relationIds = list_append_unique_oid(*relationIds, tableScan->relationId);
+
+		CollectRelationIds(tableScan->childScans, relationIds);
+	}
+}
+
+
+/*
+ * RemoveCachedQueryText removes an entry from the cache and frees its memory.
+ */
+static void
+RemoveCachedQueryText(CachedQueryText * entry)
+{
+	uint64		cacheKey = entry->cacheKey;
+
+	pfree(entry->queryTemplate);
+	pfree(entry->queryText);
+
+	if (entry->relationIds != NULL)
+		pfree(entry->relationIds);
+
+	TotalQueryTextCacheBytes -= entry->memoryBytes;
+	dlist_delete(&entry->lruNode);
+
+	hash_search(QueryTextCache, &cacheKey, HASH_REMOVE, NULL);
+}
+
+
+/*
+ * EnforceQueryTextCacheSize removes the least-recently used entries until
+ * the cache fits in pg_lake_table.query_text_cache_size.
+ */
+static void
+EnforceQueryTextCacheSize(void)
+{
+	Size		maxCacheBytes = (Size) QueryTextCacheSizeKB * 1024;
+
+	while (TotalQueryTextCacheBytes > maxCacheBytes &&
+		   !dlist_is_empty(&QueryTextCacheLRU))
+	{
+		CachedQueryText *leastRecentlyUsed =
+			dlist_tail_element(CachedQueryText, lruNode, &QueryTextCacheLRU);
+
+		RemoveCachedQueryText(leastRecentlyUsed);
+	}
+}
+
+
+/*
+ * InvalidateQueryTextCacheForRelation removes the cached query texts that
+ * involve the given relation, or all of them for InvalidOid.
+ */
+static void
+InvalidateQueryTextCacheForRelation(Datum argument, Oid relationId)
+{
+	if (QueryTextCache == NULL)
+		return;
+
+	HASH_SEQ_STATUS status;
+	CachedQueryText *entry = NULL;
+
+	hash_seq_init(&status, QueryTextCache);
+
+	while ((entry = hash_seq_search(&status)) != NULL)
+	{
+		bool		involvesRelation = relationId == InvalidOid;
+
+		for (int relationIndex = 0;
+			 relationIndex < entry->relationCount && !involvesRelation;
+			 relationIndex++)
+		{
+			involvesRelation = entry->relationIds[relationIndex] == relationId;
+		}
+
+		/* removing the current entry during a scan is allowed */
+		if (involvesRelation)
+			RemoveCachedQueryText(entry);
+	}
+}
+
+
+/*
+ * InvalidateQueryTextCache removes all cached query texts.
+ */
+static void
+InvalidateQueryTextCache(Datum argument, int cacheId, uint32 hashValue)
+{
+	InvalidateQueryTextCacheForRelation(argument, InvalidOid);
+}
+
+
+/*
+ * query_text_cache_stats returns the query text cache hit and miss counters
+ * of the current backend.
+ */
+Datum
+query_text_cache_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupleDesc;
+
+	if (get_call_result_type(fcinfo, NULL, &tupleDesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	Datum		values[4];
+	bool		nulls[4];
+
+	memset(nulls, 0, sizeof(nulls));
+
+	values[0] = Int64GetDatum(QueryTextCacheHits);
+	values[1] = Int64GetDatum(QueryTextCacheMisses);
+	values[2] = Int64GetDatum(QueryTextCache != NULL ? hash_get_num_entries(QueryTextCache) : 0);
+	values[3] = Int64GetDatum((int64) TotalQueryTextCacheBytes);
+
+	HeapTuple	tuple = heap_form_tuple(BlessTupleDesc(tupleDesc), values, nulls);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
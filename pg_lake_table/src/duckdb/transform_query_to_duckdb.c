@@ -46,6 +46,7 @@
 #include "utils/relcache.h"
 #include "tcop/tcopprot.h"
 
+#include "pg_lake/duckdb/query_text_cache.h"
 #include "pg_lake/duckdb/transform_query_to_duckdb.h"
 #include "pg_lake/fdw/deparse_ruleutils.h"
 #include "pg_lake/fdw/snapshot.h"
@@ -58,6 +59,8 @@
 #include "pg_lake/util/rel_utils.h"
 #include "pg_lake/util/string_utils.h"
 
+static char *ReplaceTableScans(char *query, PgLakeScanSnapshot * snapshot,
+							   int scanFlags);
 static char *BuildReadDataSourceQueryForTableScan(PgLakeTableScan * tableScan,
 												  bool skipFullMatchFiles,
 												  TupleDesc projection);
@@ -72,11 +75,70 @@ static void EnsureServerType(Oid relationId);
  * the relation name. That's only for the explain output, even for analyze.
  *
  * If SKIP_FULL_MATCH_FILES flag is set, we skip fullyIncluded file scans.
+ *
+ * Otherwise, the result is cached by query text and the files in the
+ * snapshot, such that repeated executions can skip building the read calls.
  */
 char *
 ReplaceReadTableFunctionCalls(char *query,
 							  PgLakeScanSnapshot * snapshot,
 							  int scanFlags)
+{
+	bool		explainRequested = (scanFlags & EXPLAIN_REQUESTED) != 0;
+	bool		useCache = !explainRequested && QueryTextCacheSizeKB > 0;
+	uint64		fingerprint = 0;
+	char	   *cachedQuery = NULL;
+
+	/*
+	 * Repeated executions of the same query usually scan the same files, in
+	 * which case we can reuse the query text of an earlier execution.
+	 */
+	if (useCache)
+	{
+		fingerprint = ScanSnapshotFingerprint(snapshot);
+		cachedQuery = LookupQueryTextCache(query, scanFlags, fingerprint);
+	}
+
+	if (cachedQuery != NULL)
+	{
+		query = cachedQuery;
+	}
+	else
+	{
+		char	   *queryTemplate = query;
+
+		query = ReplaceTableScans(queryTemplate, snapshot, scanFlags);
+
+		if (useCache)
+			AddQueryTextToCache(queryTemplate, scanFlags, fingerprint, snapshot, query);
+	}
+
+	/*
+	 * We have a special provision for now(), which needs to return the same
+	 * value for every call in the same transaction, namely the transaction
+	 * start time, but would return a different value within DuckDB.
+	 *
+	 * It is a relatively rare case, because other stable functions relate
+	 * primarily to server or session configuration.
+	 */
+	Datum		timestampDatum = TimestampTzGetDatum(GetCurrentTransactionStartTimestamp());
+	Datum		timestampStringDatum = DirectFunctionCall1(timestamptz_out, timestampDatum);
+	char	   *timestampString = DatumGetCString(timestampStringDatum);
+	char	   *nowReplacementString = psprintf("%s::timestamptz ",
+												quote_literal_cstr(timestampString));
+
+	query = PgLakeReplaceText(query, PG_LAKE_NOW_TEMPLATE "()", nowReplacementString);
+
+	return query;
+}
+
+
+/*
+ * ReplaceTableScans replaces the read_table function calls for each of the
+ * table scans in the snapshot with calls that read the files of the scan.
+ */
+static char *
+ReplaceTableScans(char *query, PgLakeScanSnapshot * snapshot, int scanFlags)
 {
 	bool		explainRequested = (scanFlags & EXPLAIN_REQUESTED) != 0;
 	bool		skipFullMatchFiles = (scanFlags & SKIP_FULL_MATCH_FILES) != 0;
@@ -128,22 +190,6 @@ ReplaceReadTableFunctionCalls(char *query,
 		query = PgLakeReplaceText(query, functionCallToReplace->data, readFunctionForServer);
 	}
 
-	/*
-	 * We have a special provision for now(), which needs to return the same
-	 * value for every call in the same transaction, namely the transaction
-	 * start time, but would return a different value within DuckDB.
-	 *
-	 * It is a relatively rare case, because other stable functions relate
-	 * primarily to server or session configuration.
-	 */
-	Datum		timestampDatum = TimestampTzGetDatum(GetCurrentTransactionStartTimestamp());
-	Datum		timestampStringDatum = DirectFunctionCall1(timestamptz_out, timestampDatum);
-	char	   *timestampString = DatumGetCString(timestampStringDatum);
-	char	   *nowReplacementString = psprintf("%s::timestamptz ",
-												quote_literal_cstr(timestampString));
-
-	query = PgLakeReplaceText(query, PG_LAKE_NOW_TEMPLATE "()", nowReplacementString);
-
 	return query;
 }
 
@@ -51,8 +51,10 @@
 #include "pg_lake/fdw/schema_operations/field_id_mapping_catalog.h"
 #include "pg_lake/fdw/schema_operations/register_field_ids.h"
 #include "pg_lake/fdw/data_file_pruning.h"
+#include "pg_lake/fdw/data_file_range_filter.h"
 #include "pg_lake/fdw/partition_transform.h"
 #include "pg_lake/fdw/writable_table.h"
+#include "pg_lake/iceberg/api/manifest.h"
 #include "pg_lake/iceberg/api/table_schema.h"
 #include "pg_lake/iceberg/catalog.h"
 #include "pg_lake/iceberg/data_file_stats.h"
@@ -106,6 +108,21 @@ static void AddFieldIdsUsedInQuery(HTAB *fieldIdsToUseInBounds, Oid relationId,
 								   PgLakeTableProperties tableProperties,
 								   List *columnsUsedInFilters);
 static List *GetExternalIcebergFieldsForAttributes(Oid relationId, List *attrNos);
+static List *GetExternalDataFileColumnStats(Oid relationId, List *dataFiles,
+											HTAB *fieldIdsUsedInQuery);
+static List *GetRangeFilterColumns(Oid relationId, HTAB *fieldIdsUsedInQuery);
+static List *GetColumnStatsPerDataFile(Oid relationId, List *dataFiles,
+									   List *externalColumnStats);
+static ColumnToFieldIdMapping * FindFieldIdMappingByFieldId(HTAB *fieldIdsUsedInQuery, int fieldId);
+static IcebergPartitionSpec * FindPartitionSpecById(IcebergTableMetadata * metadata, int32_t specId);
+static List *GetManifestPartitionSummaryConstraints(Oid relationId, IcebergManifest * manifest,
+													IcebergPartitionSpec * spec,
+													HTAB *fieldIdsUsedInQuery);
+static Expr *PartitionFieldSummaryConstraint(FieldSummary * summary,
+											 IcebergPartitionTransform * partitionTransform,
+											 ColumnToFieldIdMapping * entry);
+static PartitionField * PartitionFieldFromSummaryBound(IcebergPartitionTransform * partitionTransform,
+													   unsigned char *bound, size_t boundLength);
 static List *GetColumnBoundConstraints(Oid relationId, HTAB *fieldIdCache, List *columnStats,
 									   List *partitionTransforms, Partition * partition);
 static List *GetColumnBoundConstraintsFromColumnStats(Oid relationId, List *columnStats,
@@ -176,6 +193,9 @@ static Const *TransformConstToTargetType(Const *constantClause, Oid targetTypeId
 * execution and statistics of the data files.
 * baseRestrictInfoList is the list of RestrictInfo nodes that represent the
 * filters in the query execution for the given relationId.
+*
+* The retained data files are in the same order as in dataFiles, which
+* IsFullMatchDataFile relies on.
 */
 List *
 PruneDataFiles(Oid relationId, List *dataFiles, List *baseRestrictInfoList, PruneType pruneType)
@@ -230,6 +250,37 @@ PruneDataFiles(Oid relationId, List *dataFiles, List *baseRestrictInfoList, Prun
 
 	AddFieldIdsUsedInQuery(fieldIdsUsedInQuery, relationId, tableProperties, columnsUsedInFilters);
 
+	/*
+	 * For external tables, get the column stats for all data files upfront,
+	 * such that the files without bounds in the manifest can be handled in a
+	 * single batch.
+	 */
+	List	   *externalColumnStats = NIL;
+
+	if (IsExternalIcebergTable(relationId) && EnableDataFilePruning)
+		externalColumnStats = GetExternalDataFileColumnStats(relationId, dataFiles,
+															 fieldIdsUsedInQuery);
+
+	/*
+	 * Check the simple filters against the bounds of all data files at once,
+	 * such that we only need the predicate prover for the files whose bounds
+	 * do not decide.
+	 */
+	RangeFilterResult *rangeFilterResults = NULL;
+	bool		rangeFilterCoversAllClauses = false;
+
+	if (EnableBulkDataFilePruning && EnableDataFilePruning)
+	{
+		List	   *rangeFilterColumns = GetRangeFilterColumns(relationId, fieldIdsUsedInQuery);
+		DataFileRangeFilter *rangeFilter = CompileDataFileRangeFilter(clauses, rangeFilterColumns);
+		List	   *columnStatsPerFile =
+			GetColumnStatsPerDataFile(relationId, dataFiles, externalColumnStats);
+
+		rangeFilterResults = EvaluateDataFileRangeFilter(rangeFilter, columnStatsPerFile,
+														 pruneType);
+		rangeFilterCoversAllClauses = RangeFilterCoversAllClauses(rangeFilter);
+	}
+
 	int			dataFileCount = list_length(dataFiles);
 
 	for (int dataFileIndex = 0; dataFileIndex < dataFileCount; ++dataFileIndex)
@@ -248,12 +299,8 @@ PruneDataFiles(Oid relationId, List *dataFiles, List *baseRestrictInfoList, Prun
 		}
 		else if (IsExternalIcebergTable(relationId))
 		{
-			DataFile   *dataFile = (DataFile *) list_nth(dataFiles, dataFileIndex);
-
-			List	   *leafFields = GetLeafFieldsForTable(relationId);
-			char	   *dataFilePath = (char *) ((DataFile *) dataFile)->file_path;
-
-			columnStats = GetRemoteParquetColumnStats(dataFilePath, leafFields);
+			if (externalColumnStats != NIL)
+				columnStats = list_nth(externalColumnStats, dataFileIndex);
 		}
 		else
 		{
@@ -263,6 +310,35 @@ PruneDataFiles(Oid relationId, List *dataFiles, List *baseRestrictInfoList, Prun
 					 errmsg("Unsupported table type for data file pruning")));
 		}
 
+		if (rangeFilterResults != NULL)
+		{
+			RangeFilterResult rangeFilterResult = rangeFilterResults[dataFileIndex];
+			bool		hasPartitionConstraints = EnablePartitionPruning && partition != NULL &&
+				partition->fields_length > 0;
+
+			if (rangeFilterResult == RANGE_FILTER_REFUTED)
+				continue;
+
+			if (rangeFilterResult == RANGE_FILTER_IMPLIED)
+			{
+				retainedDataFiles = lappend(retainedDataFiles, list_nth(dataFiles, dataFileIndex));
+				continue;
+			}
+
+			/*
+			 * When all filters are range checks and the only constraints are
+			 * the column bounds, the prover cannot do better than the range
+			 * checks.
+			 */
+			if (rangeFilterCoversAllClauses && !hasPartitionConstraints)
+			{
+				if (pruneType == PARTIAL_MATCH)
+					retainedDataFiles = lappend(retainedDataFiles, list_nth(dataFiles, dataFileIndex));
+
+				continue;
+			}
+		}
+
 		/* calculate bound constraints */
 		columnBoundConstraints =
 			GetColumnBoundConstraints(relationId, fieldIdsUsedInQuery, columnStats,
@@ -295,6 +371,468 @@ PruneDataFiles(Oid relationId, List *dataFiles, List *baseRestrictInfoList, Prun
 }
 
 
+/*
+* IsFullMatchDataFile returns whether the given data file is the next file in
+* the list of FULL_MATCH files from PruneDataFiles, and if so, advances
+* *fullMatchCell to the file after it.
+*
+* Callers walk over the PARTIAL_MATCH files from which the full matches were
+* pruned, starting with *fullMatchCell at list_head(fullMatches). Since
+* PruneDataFiles retains the order of the files, that finds all full matches
+* in a single pass, instead of searching the list for every file.
+*/
+bool
+IsFullMatchDataFile(List *fullMatches, ListCell **fullMatchCell, void *dataFile)
+{
+	if (*fullMatchCell == NULL || lfirst(*fullMatchCell) != dataFile)
+		return false;
+
+	*fullMatchCell = lnext(fullMatches, *fullMatchCell);
+
+	return true;
+}
+
+
+/*
+* PruneManifests prunes the data manifests of an Iceberg table based on the
+* filters in the query and the partition summaries in the manifest list,
+* before any of the manifests are read.
+*
+* The partition summaries contain the lower and upper bound of each partition
+* field across all data files in the manifest. We convert those into
+* constraints on the source columns, and skip the manifest when the
+* constraints are refuted by the filters, in the same way PruneDataFiles
+* uses the partition values of individual data files.
+*/
+List *
+PruneManifests(Oid relationId, IcebergTableMetadata * metadata, List *manifests,
+			   List *baseRestrictInfoList)
+{
+	if (!EnablePartitionPruning || baseRestrictInfoList == NIL)
+		return manifests;
+
+	List	   *columnsUsedInFilters = ColumnsUsedInRestrictions(relationId, baseRestrictInfoList);
+
+	if (columnsUsedInFilters == NIL)
+		return manifests;
+
+	/*
+	 * predicate_refuted_by() expects the baseRestrictInfoList to have no
+	 * implicit coercions, so we strip.
+	 */
+	StripAllImplicitCoercionsInList(baseRestrictInfoList);
+
+	List	   *clauses = ExtractClausesFromBaseRestrictInfos(baseRestrictInfoList);
+
+	HTAB	   *fieldIdsUsedInQuery = CreateFieldIdMappingHash();
+	PgLakeTableProperties tableProperties = GetPgLakeTableProperties(relationId);
+
+	AddFieldIdsUsedInQuery(fieldIdsUsedInQuery, relationId, tableProperties, columnsUsedInFilters);
+
+	if (hash_get_num_entries(fieldIdsUsedInQuery) == 0)
+		return manifests;
+
+	List	   *retainedManifests = NIL;
+	ListCell   *manifestCell = NULL;
+
+	foreach(manifestCell, manifests)
+	{
+		IcebergManifest *manifest = lfirst(manifestCell);
+		IcebergPartitionSpec *spec = FindPartitionSpecById(metadata, manifest->partition_spec_id);
+
+		/*
+		 * We only prune data manifests. Delete manifests are small compared
+		 * to the data they apply to, and always need to be read.
+		 */
+		if (!IsManifestOfFileContentAdd(manifest) || spec == NULL ||
+			spec->fields_length == 0 ||
+			spec->fields_length != manifest->partitions_length)
+		{
+			retainedManifests = lappend(retainedManifests, manifest);
+			continue;
+		}
+
+		List	   *summaryConstraints =
+			GetManifestPartitionSummaryConstraints(relationId, manifest, spec,
+												   fieldIdsUsedInQuery);
+
+		if (summaryConstraints != NIL &&
+			predicate_refuted_by(summaryConstraints, clauses, false))
+		{
+			ereport(DEBUG2,
+					(errmsg("pruned manifest %s of relation %s using partition summaries",
+							manifest->manifest_path, GetQualifiedRelationName(relationId))));
+			continue;
+		}
+
+		retainedManifests = lappend(retainedManifests, manifest);
+	}
+
+	return retainedManifests;
+}
+
+
+/*
+* FindFieldIdMappingByFieldId returns the entry for the given field id in
+* the mapping of columns used in the query, or NULL if the field is not used
+* in the query.
+*/
+static ColumnToFieldIdMapping *
+FindFieldIdMappingByFieldId(HTAB *fieldIdsUsedInQuery, int fieldId)
+{
+	HASH_SEQ_STATUS status;
+	ColumnToFieldIdMapping *entry = NULL;
+
+	hash_seq_init(&status, fieldIdsUsedInQuery);
+	while ((entry = hash_seq_search(&status)) != NULL)
+	{
+		if (entry->fieldId == fieldId)
+		{
+			hash_seq_term(&status);
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+
+/*
+* FindPartitionSpecById returns the partition spec with the given id from the
+* table metadata, or NULL if there is no such spec.
+*/
+static IcebergPartitionSpec *
+FindPartitionSpecById(IcebergTableMetadata * metadata, int32_t specId)
+{
+	for (size_t specIndex = 0; specIndex < metadata->partition_specs_length; specIndex++)
+	{
+		IcebergPartitionSpec *spec = &metadata->partition_specs[specIndex];
+
+		if (spec->spec_id == specId)
+			return spec;
+	}
+
+	return NULL;
+}
+
+
+/*
+* GetManifestPartitionSummaryConstraints returns the constraints on the
+* columns used in the query that hold for all rows in the data files of the
+* manifest, based on its partition summaries.
+*/
+static List *
+GetManifestPartitionSummaryConstraints(Oid relationId, IcebergManifest * manifest,
+									   IcebergPartitionSpec * spec,
+									   HTAB *fieldIdsUsedInQuery)
+{
+	List	   *constraintList = NIL;
+
+	for (size_t fieldIndex = 0; fieldIndex < spec->fields_length; fieldIndex++)
+	{
+		IcebergPartitionSpecField *specField = &spec->fields[fieldIndex];
+
+		ColumnToFieldIdMapping *entry =
+			FindFieldIdMappingByFieldId(fieldIdsUsedInQuery, specField->source_id);
+
+		/* skip if the partition field is not used in the query */
+		if (entry == NULL || entry->columnBoundExclusiveUpper == NULL)
+			continue;
+
+		IcebergPartitionTransform *partitionTransform =
+			GetPartitionTransformForColumn(relationId, entry->attrNo, specField);
+
+		if (partitionTransform == NULL)
+			continue;
+
+		Expr	   *summaryConstraint =
+			PartitionFieldSummaryConstraint(&manifest->partitions[fieldIndex],
+											partitionTransform, entry);
+
+		if (summaryConstraint != NULL)
+			constraintList = lappend(constraintList, summaryConstraint);
+	}
+
+	return constraintList;
+}
+
+
+/*
+* PartitionFieldSummaryConstraint creates a constraint on the source column
+* of the partition field based on its summary in the manifest list. The
+* constraint is created as:
+*   column >= lower(summary) AND column < upper(summary)
+* where the bounds are those of the partition values for the lower and
+* upper bound of the summary, with an additional "OR column IS NULL" when
+* the summary contains nulls, or just:
+*   column IS NULL
+* when the summary only contains nulls.
+*/
+static Expr *
+PartitionFieldSummaryConstraint(FieldSummary * summary,
+								IcebergPartitionTransform * partitionTransform,
+								ColumnToFieldIdMapping * entry)
+{
+	if (partitionTransform->type == PARTITION_TRANSFORM_BUCKET)
+	{
+		/* the range of bucket numbers says nothing about the column */
+		return NULL;
+	}
+
+	Oid			resultTypeId = partitionTransform->resultPgType.postgresTypeOid;
+
+	if (summary->contains_nan &&
+		(resultTypeId == FLOAT4OID || resultTypeId == FLOAT8OID))
+	{
+		/* bounds do not include NaN values */
+		return NULL;
+	}
+
+	if (summary->lower_bound == NULL || summary->upper_bound == NULL)
+	{
+		/* without bounds, all values are null if the summary has nulls */
+		if (summary->contains_null)
+			return (Expr *) copyObject(entry->isNullExpression);
+
+		return NULL;
+	}
+
+	Expr	   *rangeConstraint = NULL;
+
+	if (partitionTransform->type == PARTITION_TRANSFORM_IDENTITY)
+	{
+		bool		isNull = false;
+		PGType		resultPgType = partitionTransform->resultPgType;
+
+		Datum		lowerBoundDatum =
+			PartitionValueToDatum(partitionTransform->type, summary->lower_bound,
+								  summary->lower_bound_length, resultPgType, &isNull);
+		Datum		upperBoundDatum =
+			PartitionValueToDatum(partitionTransform->type, summary->upper_bound,
+								  summary->upper_bound_length, resultPgType, &isNull);
+
+		BoolExpr   *columnBoundInclusiveUpper = copyObject(entry->columnBoundInclusiveUpper);
+
+		rangeConstraint = (Expr *) CreateConstraintWithBounds(columnBoundInclusiveUpper,
+															  entry->constByVal, entry->typLen,
+															  lowerBoundDatum, upperBoundDatum);
+	}
+	else
+	{
+		/*
+		 * The other transforms are monotonic, so the rows in the manifest
+		 * fall between the lower bound of the lowest partition and the upper
+		 * bound of the highest partition.
+		 */
+		PartitionField *lowerField =
+			PartitionFieldFromSummaryBound(partitionTransform, summary->lower_bound,
+										   summary->lower_bound_length);
+		PartitionField *upperField =
+			PartitionFieldFromSummaryBound(partitionTransform, summary->upper_bound,
+										   summary->upper_bound_length);
+
+		Expr	   *lowerConstraint =
+			PartitionFieldBoundConstraint(lowerField, partitionTransform, entry);
+		Expr	   *upperConstraint =
+			PartitionFieldBoundConstraint(upperField, partitionTransform, entry);
+
+		if (lowerConstraint == NULL || upperConstraint == NULL)
+			return NULL;
+
+		/* see BuildConstraintsWithNullConst for the order of the arguments */
+		Node	   *lessThanExpr = linitial(((BoolExpr *) upperConstraint)->args);
+		Node	   *greaterThanEqualExpr = lsecond(((BoolExpr *) lowerConstraint)->args);
+
+		rangeConstraint = (Expr *) make_and_qual(lessThanExpr, greaterThanEqualExpr);
+	}
+
+	if (rangeConstraint == NULL)
+		return NULL;
+
+	if (summary->contains_null)
+	{
+		return make_orclause(list_make2(rangeConstraint,
+										copyObject(entry->isNullExpression)));
+	}
+
+	return rangeConstraint;
+}
+
+
+/*
+* PartitionFieldFromSummaryBound creates a partition field with a bound from
+* a partition summary as its value. Summary bounds are not null-terminated,
+* unlike the string partition values of data files, so we add one.
+*/
+static PartitionField *
+PartitionFieldFromSummaryBound(IcebergPartitionTransform * partitionTransform,
+							   unsigned char *bound, size_t boundLength)
+{
+	PartitionField *partitionField = palloc0(sizeof(PartitionField));
+	char	   *value = palloc0(boundLength + 1);
+
+	memcpy(value, bound, boundLength);
+
+	partitionField->field_id = partitionTransform->partitionFieldId;
+	partitionField->field_name = pstrdup(partitionTransform->partitionFieldName);
+	partitionField->value = value;
+	partitionField->value_length = boundLength;
+
+	return partitionField;
+}
+
+
+/*
+* GetExternalDataFileColumnStats returns a list with the column stats of each
+* of the given data files of an external Iceberg table, for the fields used
+* in the query.
+*
+* The stats are decoded from the lower and upper bounds in the manifest
+* entries. Only when the manifest has no bounds for any of the fields used in
+* the query, we read the Parquet footer of the file, for all such files in a
+* single batch. Returns NIL if there are no fields to get the stats for.
+*/
+static List *
+GetExternalDataFileColumnStats(Oid relationId, List *dataFiles, HTAB *fieldIdsUsedInQuery)
+{
+	if (hash_get_num_entries(fieldIdsUsedInQuery) == 0)
+		return NIL;
+
+	/* find the leaf fields for the columns used in the query */
+	List	   *leafFields = GetLeafFieldsForTable(relationId);
+	List	   *queryLeafFields = NIL;
+	ListCell   *leafFieldCell = NULL;
+
+	foreach(leafFieldCell, leafFields)
+	{
+		LeafField  *leafField = lfirst(leafFieldCell);
+		HASH_SEQ_STATUS status;
+		ColumnToFieldIdMapping *entry = NULL;
+
+		hash_seq_init(&status, fieldIdsUsedInQuery);
+		while ((entry = hash_seq_search(&status)) != NULL)
+		{
+			if (entry->fieldId == leafField->fieldId)
+			{
+				queryLeafFields = lappend(queryLeafFields, leafField);
+				hash_seq_term(&status);
+				break;
+			}
+		}
+	}
+
+	if (queryLeafFields == NIL)
+		return NIL;
+
+	List	   *columnStatsList = NIL;
+	List	   *missingBoundsPaths = NIL;
+	List	   *missingBoundsIndexes = NIL;
+	int			dataFileIndex = 0;
+	ListCell   *dataFileCell = NULL;
+
+	foreach(dataFileCell, dataFiles)
+	{
+		DataFile   *dataFile = lfirst(dataFileCell);
+		List	   *columnStats = GetDataFileColumnStatsFromBounds(dataFile, queryLeafFields);
+
+		if (columnStats == NIL)
+		{
+			missingBoundsPaths = lappend(missingBoundsPaths, (char *) dataFile->file_path);
+			missingBoundsIndexes = lappend_int(missingBoundsIndexes, dataFileIndex);
+		}
+
+		columnStatsList = lappend(columnStatsList, columnStats);
+		dataFileIndex++;
+	}
+
+	if (missingBoundsPaths != NIL)
+	{
+		ereport(DEBUG2,
+				(errmsg("reading Parquet footers of %d data files of relation %s "
+						"without bounds in the manifest",
+						list_length(missingBoundsPaths),
+						GetQualifiedRelationName(relationId))));
+
+		List	   *remoteColumnStats =
+			GetRemoteParquetColumnStatsForFiles(missingBoundsPaths, queryLeafFields);
+		ListCell   *remoteColumnStatsCell = NULL;
+		ListCell   *indexCell = NULL;
+
+		forboth(remoteColumnStatsCell, remoteColumnStats, indexCell, missingBoundsIndexes)
+		{
+			ListCell   *columnStatsCell = list_nth_cell(columnStatsList, lfirst_int(indexCell));
+
+			lfirst(columnStatsCell) = lfirst(remoteColumnStatsCell);
+		}
+	}
+
+	return columnStatsList;
+}
+
+
+/*
+* GetRangeFilterColumns returns the columns used in the query for which we
+* can build bound constraints, as RangeFilterColumns for the range filter.
+*/
+static List *
+GetRangeFilterColumns(Oid relationId, HTAB *fieldIdsUsedInQuery)
+{
+	List	   *filterColumns = NIL;
+	HASH_SEQ_STATUS status;
+	ColumnToFieldIdMapping *entry = NULL;
+
+	hash_seq_init(&status, fieldIdsUsedInQuery);
+	while ((entry = hash_seq_search(&status)) != NULL)
+	{
+		/* same condition as for the bound constraints of the prover */
+		if (entry->columnBoundInclusiveUpper == NULL)
+			continue;
+
+		RangeFilterColumn *filterColumn = palloc0(sizeof(RangeFilterColumn));
+
+		filterColumn->column = entry->column;
+		filterColumn->fieldId = entry->fieldId;
+		filterColumn->pgType = GetAttributePGType(relationId, entry->attrNo);
+
+		filterColumns = lappend(filterColumns, filterColumn);
+	}
+
+	return filterColumns;
+}
+
+
+/*
+* GetColumnStatsPerDataFile returns a list with the column stats of each of
+* the given data files, in the same order.
+*/
+static List *
+GetColumnStatsPerDataFile(Oid relationId, List *dataFiles, List *externalColumnStats)
+{
+	if (IsExternalIcebergTable(relationId) && externalColumnStats != NIL)
+		return externalColumnStats;
+
+	List	   *columnStatsPerFile = NIL;
+	bool		isInternalIcebergTable = IsInternalIcebergTable(relationId);
+	ListCell   *dataFileCell = NULL;
+
+	foreach(dataFileCell, dataFiles)
+	{
+		List	   *columnStats = NIL;
+
+		if (isInternalIcebergTable)
+		{
+			TableDataFile *tableDataFile = lfirst(dataFileCell);
+
+			columnStats = tableDataFile->stats.columnStats;
+		}
+
+		columnStatsPerFile = lappend(columnStatsPerFile, columnStats);
+	}
+
+	return columnStatsPerFile;
+}
+
+
 /*
 * CreateFieldIdMappingHash creates a hash table to store the mapping of
 * fieldIds to the corresponding pgAttNum, pgType, and aims to check if
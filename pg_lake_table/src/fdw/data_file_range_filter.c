@@ -0,0 +1,693 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Bulk pruning of data files using range filters.
+ *
+ * PruneDataFiles builds constraints from the bounds of each data file and
+ * asks the predicate prover whether the filters of the query refute or
+ * imply them. That is flexible, but building the expression trees and
+ * running the prover for every file is slow for tables with many files.
+ *
+ * Most filters are simple comparisons of a column with a constant, IN lists,
+ * or null tests. We compile those once into range checks that use the btree
+ * comparison function of the column type, convert the bounds of all data
+ * files into arrays of datums, and run each check over all files in a
+ * single loop. Files that the range checks cannot decide are left to the
+ * predicate prover.
+ */
+#include "postgres.h"
+
+#include "access/nbtree.h"
+#include "access/stratnum.h"
+#include "catalog/pg_am_d.h"
+#include "commands/defrem.h"
+#include "fmgr.h"
+#include "nodes/nodeFuncs.h"
+#include "parser/parse_coerce.h"
+#include "utils/array.h"
+#include "utils/lsyscache.h"
+
+#include "pg_extension_base/pg_compat.h"
+#include "pg_lake/data_file/data_file_stats.h"
+#include "pg_lake/fdw/data_file_range_filter.h"
+#include "pg_lake/iceberg/data_file_stats.h"
+
+bool		EnableBulkDataFilePruning = true;
+
+/*
+ * RangeCheckType is the kind of filter that a range check represents.
+ */
+typedef enum RangeCheckType
+{
+	/* column <op> constant */
+	RANGE_CHECK_COMPARISON,
+
+	/* column = ANY(constant array) */
+	RANGE_CHECK_IN_LIST,
+
+	/* column IS NULL */
+	RANGE_CHECK_IS_NULL,
+
+	/* column IS NOT NULL */
+	RANGE_CHECK_IS_NOT_NULL
+}			RangeCheckType;
+
+/*
+ * RangeCheck is a single filter of the query in a form that can be checked
+ * against the lower and upper bound of a column.
+ */
+typedef struct RangeCheck
+{
+	RangeCheckType type;
+
+	/* index of the column in the filter columns */
+	int			columnIndex;
+
+	/* btree strategy of the comparison */
+	StrategyNumber strategy;
+
+	/* btree comparison function for the column type and the value type */
+	FmgrInfo	compareFunction;
+	Oid			collation;
+
+	/* constant(s) to compare with, non-null */
+	Datum	   *values;
+	int			valueCount;
+}			RangeCheck;
+
+struct DataFileRangeFilter
+{
+	/* columns that range checks can be on (RangeFilterColumn *) */
+	List	   *filterColumns;
+
+	/* range checks compiled from the filters (RangeCheck *) */
+	List	   *checks;
+
+	/* whether all filters could be compiled into range checks */
+	bool		coversAllClauses;
+};
+
+/*
+ * ColumnBoundArrays holds the lower and upper bound of a column for each
+ * data file.
+ */
+typedef struct ColumnBoundArrays
+{
+	bool	   *hasBounds;
+	Datum	   *lowerBounds;
+	Datum	   *upperBounds;
+}			ColumnBoundArrays;
+
+static RangeCheck * CompileRangeCheck(Expr *clause, List *filterColumns);
+static RangeCheck * CompileComparisonCheck(OpExpr *opExpr, List *filterColumns);
+static RangeCheck * CompileInListCheck(ScalarArrayOpExpr *arrayOpExpr, List *filterColumns);
+static RangeCheck * CompileNullTestCheck(NullTest *nullTest, List *filterColumns);
+static int	FindFilterColumn(List *filterColumns, Node *node);
+static bool InitializeRangeCheckOperator(RangeCheck * check, Oid operatorId, Var *column,
+										 Oid valueTypeId, Oid collation);
+static void BuildColumnBoundArrays(ColumnBoundArrays * bounds, RangeFilterColumn * filterColumn,
+								   List *columnStatsPerFile);
+static void RefuteDataFiles(RangeCheck * check, ColumnBoundArrays * bounds,
+							RangeFilterResult * results, int fileCount);
+static void ImplyDataFiles(RangeCheck * check, ColumnBoundArrays * bounds,
+						   RangeFilterResult * results, int fileCount);
+static bool RangeCheckRefutesBounds(RangeCheck * check, Datum lowerBound, Datum upperBound);
+static bool RangeCheckImpliedByBounds(RangeCheck * check, Datum lowerBound, Datum upperBound);
+static bool ComparisonRefutesBounds(RangeCheck * check, StrategyNumber strategy,
+									Datum lowerBound, Datum upperBound, Datum value);
+static bool ComparisonImpliedByBounds(RangeCheck * check, StrategyNumber strategy,
+									  Datum lowerBound, Datum upperBound, Datum value);
+static int	CompareBoundWithValue(RangeCheck * check, Datum bound, Datum value);
+
+
+/*
+ * CompileDataFileRangeFilter compiles the given filters into range checks on
+ * the given columns (RangeFilterColumn *). Filters that cannot be compiled
+ * are skipped, which RangeFilterCoversAllClauses reports.
+ *
+ * The clauses are expected to be stripped of implicit coercions, as for the
+ * predicate prover.
+ */
+DataFileRangeFilter *
+CompileDataFileRangeFilter(List *clauses, List *filterColumns)
+{
+	DataFileRangeFilter *filter = palloc0(sizeof(DataFileRangeFilter));
+
+	filter->filterColumns = filterColumns;
+	filter->coversAllClauses = true;
+
+	foreach_ptr(Expr, clause, clauses)
+	{
+		RangeCheck *check = CompileRangeCheck(clause, filterColumns);
+
+		if (check == NULL)
+		{
+			filter->coversAllClauses = false;
+			continue;
+		}
+
+		filter->checks = lappend(filter->checks, check);
+	}
+
+	return filter;
+}
+
+
+/*
+ * RangeFilterCoversAllClauses returns whether all filters were compiled into
+ * range checks, in which case the range checks decide for files whose only
+ * constraints come from column bounds.
+ */
+bool
+RangeFilterCoversAllClauses(DataFileRangeFilter * filter)
+{
+	return filter->coversAllClauses;
+}
+
+
+/*
+ * EvaluateDataFileRangeFilter checks the range filter against the column
+ * stats of each data file (a list of DataFileColumnStats lists) and returns
+ * an array with the result for each file.
+ *
+ * For PARTIAL_MATCH a file is refuted when any of the range checks is refuted
+ * by its bounds. For FULL_MATCH a file is implied when all filters were
+ * compiled and all range checks are implied by its bounds.
+ */
+RangeFilterResult *
+EvaluateDataFileRangeFilter(DataFileRangeFilter * filter, List *columnStatsPerFile,
+							PruneType pruneType)
+{
+	int			fileCount = list_length(columnStatsPerFile);
+	RangeFilterResult *results = palloc(sizeof(RangeFilterResult) * Max(fileCount, 1));
+
+	/* a subset of the filters cannot imply the whole set */
+	bool		canImply = pruneType == FULL_MATCH && filter->coversAllClauses;
+	RangeFilterResult initialResult = canImply ? RANGE_FILTER_IMPLIED : RANGE_FILTER_UNKNOWN;
+
+	for (int fileIndex = 0; fileIndex < fileCount; fileIndex++)
+		results[fileIndex] = initialResult;
+
+	if (pruneType == FULL_MATCH && !canImply)
+		return results;
+
+	/* bounds are only converted for columns that have range checks */
+	int			columnCount = list_length(filter->filterColumns);
+	ColumnBoundArrays *columnBounds = palloc0(sizeof(ColumnBoundArrays) * Max(columnCount, 1));
+
+	foreach_ptr(RangeCheck, check, filter->checks)
+	{
+		/* null tests never refute files with bounds, see predtest.c */
+		if (pruneType == PARTIAL_MATCH &&
+			(check->type == RANGE_CHECK_IS_NULL || check->type == RANGE_CHECK_IS_NOT_NULL))
+			continue;
+
+		ColumnBoundArrays *bounds = &columnBounds[check->columnIndex];
+
+		if (bounds->hasBounds == NULL)
+		{
+			RangeFilterColumn *filterColumn = list_nth(filter->filterColumns,
+													   check->columnIndex);
+
+			BuildColumnBoundArrays(bounds, filterColumn, columnStatsPerFile);
+		}
+
+		if (pruneType == PARTIAL_MATCH)
+			RefuteDataFiles(check, bounds, results, fileCount);
+		else
+			ImplyDataFiles(check, bounds, results, fileCount);
+	}
+
+	return results;
+}
+
+
+/*
+ * CompileRangeCheck compiles a single filter into a range check, or returns
+ * NULL if the filter is not a simple filter on one of the filter columns.
+ */
+static RangeCheck *
+CompileRangeCheck(Expr *clause, List *filterColumns)
+{
+	if (IsA(clause, OpExpr))
+		return CompileComparisonCheck((OpExpr *) clause, filterColumns);
+	else if (IsA(clause, ScalarArrayOpExpr))
+		return CompileInListCheck((ScalarArrayOpExpr *) clause, filterColumns);
+	else if (IsA(clause, NullTest))
+		return CompileNullTestCheck((NullTest *) clause, filterColumns);
+
+	return NULL;
+}
+
+
+/*
+ * CompileComparisonCheck compiles a "column <op> constant" or
+ * "constant <op> column" filter, where op is a btree operator of the column
+ * type, into a range check.
+ */
+static RangeCheck *
+CompileComparisonCheck(OpExpr *opExpr, List *filterColumns)
+{
+	if (list_length(opExpr->args) != 2)
+		return NULL;
+
+	Node	   *leftOperand = linitial(opExpr->args);
+	Node	   *rightOperand = lsecond(opExpr->args);
+	Oid			operatorId = opExpr->opno;
+
+	if (IsA(leftOperand, Const) && IsA(rightOperand, Var))
+	{
+		/* rewrite "constant <op> column" as "column <commutator> constant" */
+		Node	   *tmp = leftOperand;
+
+		leftOperand = rightOperand;
+		rightOperand = tmp;
+		operatorId = get_commutator(operatorId);
+
+		if (!OidIsValid(operatorId))
+			return NULL;
+	}
+
+	if (!IsA(rightOperand, Const) || ((Const *) rightOperand)->constisnull)
+		return NULL;
+
+	int			columnIndex = FindFilterColumn(filterColumns, leftOperand);
+
+	if (columnIndex < 0)
+		return NULL;
+
+	Const	   *constant = (Const *) rightOperand;
+	RangeCheck *check = palloc0(sizeof(RangeCheck));
+
+	if (!InitializeRangeCheckOperator(check, operatorId, (Var *) leftOperand,
+									  constant->consttype, opExpr->inputcollid))
+		return NULL;
+
+	check->type = RANGE_CHECK_COMPARISON;
+	check->columnIndex = columnIndex;
+	check->values = palloc(sizeof(Datum));
+	check->values[0] = constant->constvalue;
+	check->valueCount = 1;
+
+	return check;
+}
+
+
+/*
+ * CompileInListCheck compiles a "column = ANY(constant array)" filter into a
+ * range check. Null elements of the array can never match, so we skip them.
+ */
+static RangeCheck *
+CompileInListCheck(ScalarArrayOpExpr *arrayOpExpr, List *filterColumns)
+{
+	if (!arrayOpExpr->useOr || list_length(arrayOpExpr->args) != 2)
+		return NULL;
+
+	Node	   *leftOperand = linitial(arrayOpExpr->args);
+	Node	   *rightOperand = lsecond(arrayOpExpr->args);
+
+	if (!IsA(rightOperand, Const) || ((Const *) rightOperand)->constisnull)
+		return NULL;
+
+	int			columnIndex = FindFilterColumn(filterColumns, leftOperand);
+
+	if (columnIndex < 0)
+		return NULL;
+
+	ArrayType  *array = DatumGetArrayTypeP(((Const *) rightOperand)->constvalue);
+	Oid			elementTypeId = ARR_ELEMTYPE(array);
+	RangeCheck *check = palloc0(sizeof(RangeCheck));
+
+	if (!InitializeRangeCheckOperator(check, arrayOpExpr->opno, (Var *) leftOperand,
+									  elementTypeId, arrayOpExpr->inputcollid) ||
+		check->strategy != BTEqualStrategyNumber)
+		return NULL;
+
+	int16		elementLength;
+	bool		elementByValue;
+	char		elementAlign;
+	Datum	   *elements = NULL;
+	bool	   *elementNulls = NULL;
+	int			elementCount = 0;
+
+	get_typlenbyvalalign(elementTypeId, &elementLength, &elementByValue, &elementAlign);
+	deconstruct_array(array, elementTypeId, elementLength, elementByValue, elementAlign,
+					  &elements, &elementNulls, &elementCount);
+
+	check->type = RANGE_CHECK_IN_LIST;
+	check->columnIndex = columnIndex;
+	check->values = palloc(sizeof(Datum) * Max(elementCount, 1));
+	check->valueCount = 0;
+
+	for (int elementIndex = 0; elementIndex < elementCount; elementIndex++)
+	{
+		if (elementNulls[elementIndex])
+			continue;
+
+		check->values[check->valueCount++] = elements[elementIndex];
+	}
+
+	return check;
+}
+
+
+/*
+ * CompileNullTestCheck compiles a "column IS [NOT] NULL" filter into a range
+ * check.
+ */
+static RangeCheck *
+CompileNullTestCheck(NullTest *nullTest, List *filterColumns)
+{
+	if (nullTest->argisrow)
+		return NULL;
+
+	int			columnIndex = FindFilterColumn(filterColumns, (Node *) nullTest->arg);
+
+	if (columnIndex < 0)
+		return NULL;
+
+	RangeCheck *check = palloc0(sizeof(RangeCheck));
+
+	check->type = nullTest->nulltesttype == IS_NULL ?
+		RANGE_CHECK_IS_NULL : RANGE_CHECK_IS_NOT_NULL;
+	check->columnIndex = columnIndex;
+
+	return check;
+}
+
+
+/*
+ * FindFilterColumn returns the index of the filter column that the given
+ * node refers to, or -1 if the node is not a Var of one of the columns.
+ */
+static int
+FindFilterColumn(List *filterColumns, Node *node)
+{
+	if (node == NULL || !IsA(node, Var))
+		return -1;
+
+	Var		   *var = (Var *) node;
+
+	if (var->varlevelsup != 0)
+		return -1;
+
+	int			columnIndex = 0;
+
+	foreach_ptr(RangeFilterColumn, filterColumn, filterColumns)
+	{
+		if (filterColumn->column->varattno == var->varattno &&
+			filterColumn->column->vartype == var->vartype)
+			return columnIndex;
+
+		columnIndex++;
+	}
+
+	return -1;
+}
+
+
+/*
+ * InitializeRangeCheckOperator finds the btree strategy and comparison
+ * function of the given operator in the default btree operator family of the
+ * column type. Returns false if the operator is not in that family, or the
+ * column or value cannot be passed to the comparison function as is.
+ */
+static bool
+InitializeRangeCheckOperator(RangeCheck * check, Oid operatorId, Var *column,
+							 Oid valueTypeId, Oid collation)
+{
+	Oid			operatorClassId = GetDefaultOpClass(column->vartype, BTREE_AM_OID);
+
+	if (!OidIsValid(operatorClassId))
+		return false;
+
+	Oid			operatorFamilyId = get_opclass_family(operatorClassId);
+
+	if (!op_in_opfamily(operatorId, operatorFamilyId))
+		return false;
+
+	int			strategy;
+	Oid			leftTypeId;
+	Oid			rightTypeId;
+
+	get_op_opfamily_properties(operatorId, operatorFamilyId, false, &strategy,
+							   &leftTypeId, &rightTypeId);
+
+	if (!IsBinaryCoercible(column->vartype, leftTypeId) ||
+		!IsBinaryCoercible(valueTypeId, rightTypeId))
+		return false;
+
+	Oid			compareFunctionId = get_opfamily_proc(operatorFamilyId, leftTypeId,
+													  rightTypeId, BTORDER_PROC);
+
+	if (!OidIsValid(compareFunctionId))
+		return false;
+
+	fmgr_info(compareFunctionId, &check->compareFunction);
+	check->strategy = strategy;
+	check->collation = collation;
+
+	return true;
+}
+
+
+/*
+ * BuildColumnBoundArrays converts the lower and upper bounds of the given
+ * column in each data file into datums.
+ */
+static void
+BuildColumnBoundArrays(ColumnBoundArrays * bounds, RangeFilterColumn * filterColumn,
+					   List *columnStatsPerFile)
+{
+	int			fileCount = list_length(columnStatsPerFile);
+	int			fileIndex = 0;
+	ListCell   *columnStatsCell = NULL;
+
+	bounds->hasBounds = palloc0(sizeof(bool) * Max(fileCount, 1));
+	bounds->lowerBounds = palloc0(sizeof(Datum) * Max(fileCount, 1));
+	bounds->upperBounds = palloc0(sizeof(Datum) * Max(fileCount, 1));
+
+	foreach(columnStatsCell, columnStatsPerFile)
+	{
+		List	   *columnStats = lfirst(columnStatsCell);
+
+		foreach_ptr(DataFileColumnStats, columnStat, columnStats)
+		{
+			if (columnStat->leafField.fieldId != filterColumn->fieldId)
+				continue;
+
+			/* without both bounds, the file cannot be pruned on this column */
+			if (columnStat->lowerBoundText == NULL || columnStat->upperBoundText == NULL)
+				break;
+
+			Datum		lowerBound = ColumnBoundDatum(columnStat->lowerBoundText,
+													  filterColumn->pgType);
+			Datum		upperBound = lowerBound;
+
+			if (strcmp(columnStat->lowerBoundText, columnStat->upperBoundText) != 0)
+				upperBound = ColumnBoundDatum(columnStat->upperBoundText,
+											  filterColumn->pgType);
+
+			bounds->hasBounds[fileIndex] = true;
+			bounds->lowerBounds[fileIndex] = lowerBound;
+			bounds->upperBounds[fileIndex] = upperBound;
+			break;
+		}
+
+		fileIndex++;
+	}
+}
+
+
+/*
+ * RefuteDataFiles marks the files whose bounds refute the range check as
+ * refuted.
+ */
+static void
+RefuteDataFiles(RangeCheck * check, ColumnBoundArrays * bounds,
+				RangeFilterResult * results, int fileCount)
+{
+	for (int fileIndex = 0; fileIndex < fileCount; fileIndex++)
+	{
+		if (results[fileIndex] == RANGE_FILTER_REFUTED || !bounds->hasBounds[fileIndex])
+			continue;
+
+		if (RangeCheckRefutesBounds(check, bounds->lowerBounds[fileIndex],
+									bounds->upperBounds[fileIndex]))
+			results[fileIndex] = RANGE_FILTER_REFUTED;
+	}
+}
+
+
+/*
+ * ImplyDataFiles marks the files whose bounds do not imply the range check
+ * as unknown.
+ */
+static void
+ImplyDataFiles(RangeCheck * check, ColumnBoundArrays * bounds,
+			   RangeFilterResult * results, int fileCount)
+{
+	for (int fileIndex = 0; fileIndex < fileCount; fileIndex++)
+	{
+		if (results[fileIndex] != RANGE_FILTER_IMPLIED)
+			continue;
+
+		if (!bounds->hasBounds[fileIndex] ||
+			!RangeCheckImpliedByBounds(check, bounds->lowerBounds[fileIndex],
+									   bounds->upperBounds[fileIndex]))
+			results[fileIndex] = RANGE_FILTER_UNKNOWN;
+	}
+}
+
+
+/*
+ * RangeCheckRefutesBounds returns whether no value between the given bounds
+ * can pass the range check.
+ */
+static bool
+RangeCheckRefutesBounds(RangeCheck * check, Datum lowerBound, Datum upperBound)
+{
+	switch (check->type)
+	{
+		case RANGE_CHECK_COMPARISON:
+			return ComparisonRefutesBounds(check, check->strategy, lowerBound,
+										   upperBound, check->values[0]);
+
+		case RANGE_CHECK_IN_LIST:
+			for (int valueIndex = 0; valueIndex < check->valueCount; valueIndex++)
+			{
+				if (!ComparisonRefutesBounds(check, BTEqualStrategyNumber, lowerBound,
+											 upperBound, check->values[valueIndex]))
+					return false;
+			}
+
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+/*
+ * RangeCheckImpliedByBounds returns whether all values between the given
+ * bounds pass the range check.
+ */
+static bool
+RangeCheckImpliedByBounds(RangeCheck * check, Datum lowerBound, Datum upperBound)
+{
+	switch (check->type)
+	{
+		case RANGE_CHECK_COMPARISON:
+			return ComparisonImpliedByBounds(check, check->strategy, lowerBound,
+											 upperBound, check->values[0]);
+
+		case RANGE_CHECK_IN_LIST:
+			for (int valueIndex = 0; valueIndex < check->valueCount; valueIndex++)
+			{
+				if (ComparisonImpliedByBounds(check, BTEqualStrategyNumber, lowerBound,
+											  upperBound, check->values[valueIndex]))
+					return true;
+			}
+
+			return false;
+
+		case RANGE_CHECK_IS_NOT_NULL:
+			/* bounds only exist when the file has non-null values */
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+/*
+ * ComparisonRefutesBounds returns whether "column <strategy> value" is false
+ * for all values between the given bounds.
+ */
+static bool
+ComparisonRefutesBounds(RangeCheck * check, StrategyNumber strategy,
+						Datum lowerBound, Datum upperBound, Datum value)
+{
+	switch (strategy)
+	{
+		case BTLessStrategyNumber:
+			return CompareBoundWithValue(check, lowerBound, value) >= 0;
+
+		case BTLessEqualStrategyNumber:
+			return CompareBoundWithValue(check, lowerBound, value) > 0;
+
+		case BTEqualStrategyNumber:
+			return CompareBoundWithValue(check, lowerBound, value) > 0 ||
+				CompareBoundWithValue(check, upperBound, value) < 0;
+
+		case BTGreaterEqualStrategyNumber:
+			return CompareBoundWithValue(check, upperBound, value) < 0;
+
+		case BTGreaterStrategyNumber:
+			return CompareBoundWithValue(check, upperBound, value) <= 0;
+
+		default:
+			return false;
+	}
+}
+
+
+/*
+ * ComparisonImpliedByBounds returns whether "column <strategy> value" is true
+ * for all values between the given bounds.
+ */
+static bool
+ComparisonImpliedByBounds(RangeCheck * check, StrategyNumber strategy,
+						  Datum lowerBound, Datum upperBound, Datum value)
+{
+	switch (strategy)
+	{
+		case BTLessStrategyNumber:
+			return CompareBoundWithValue(check, upperBound, value) < 0;
+
+		case BTLessEqualStrategyNumber:
+			return CompareBoundWithValue(check, upperBound, value) <= 0;
+
+		case BTEqualStrategyNumber:
+			return CompareBoundWithValue(check, lowerBound, value) == 0 &&
+				CompareBoundWithValue(check, upperBound, value) == 0;
+
+		case BTGreaterEqualStrategyNumber:
+			return CompareBoundWithValue(check, lowerBound, value) >= 0;
+
+		case BTGreaterStrategyNumber:
+			return CompareBoundWithValue(check, lowerBound, value) > 0;
+
+		default:
+			return false;
+	}
+}
+
+
+/*
+ * CompareBoundWithValue compares a column bound with a value of the range
+ * check using the btree comparison function.
+ */
+static int
+CompareBoundWithValue(RangeCheck * check, Datum bound, Datum value)
+{
+	return DatumGetInt32(FunctionCall2Coll(&check->compareFunction, check->collation,
+										   bound, value));
+}
@@ -0,0 +1,597 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Per-backend cache of the column stats and partition values of data files.
+ *
+ * Reading the data files of a table joins the files catalog with the column
+ * stats and partition values catalogs, which returns a row per column stat
+ * and partition value of each file. For tables with many files and columns,
+ * decoding that join dominates planning time.
+ *
+ * The column stats and partition values of a data file are written once,
+ * together with the file, and never change afterwards, while file ids are
+ * never reused. Hence, we can cache them by file id. The files themselves
+ * are still read from the catalog on every call, such that visibility and
+ * row locks follow the snapshot of the caller, and only the details of files
+ * that are not yet in the cache are read using the join.
+ *
+ * DDL that changes how stats are interpreted (e.g. changing the type of a
+ * column) sends a relcache invalidation, which drops the cache of the
+ * relation. Invalidated caches are only freed at the end of the transaction,
+ * since a lookup may be in progress when the invalidation arrives.
+ */
+#include "postgres.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+
+#include "access/htup_details.h"
+#include "access/xact.h"
+#include "lib/ilist.h"
+#include "pg_lake/data_file/data_file_stats.h"
+#include "pg_lake/data_file/data_files.h"
+#include "pg_lake/fdw/data_files_cache.h"
+#include "pg_lake/iceberg/partitioning/partition.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+
+
+/*
+ * CachedDataFileDetails is the cached part of a TableDataFile.
+ */
+typedef struct CachedDataFileDetails
+{
+	/* hash key */
+	int64		fileId;
+
+	/* whether this is a data file or a position delete file */
+	DataFileContent content;
+
+	/* column stats and partition values in the relation cache context */
+	List	   *columnStats;
+	Partition  *partition;
+	int32		partitionSpecId;
+}			CachedDataFileDetails;
+
+/*
+ * RelationDataFileCache holds the cached data file details of a relation.
+ */
+typedef struct RelationDataFileCache
+{
+	/* hash key */
+	Oid			relationId;
+
+	/*
+	 * Memory context that holds the cached details, or NULL if the details
+	 * of the relation do not fit into the cache.
+	 */
+	MemoryContext context;
+
+	/* file id -> CachedDataFileDetails */
+	HTAB	   *dataFiles;
+
+	/* number of files that got removed, whose memory is not yet reclaimed */
+	int64		removedFileCount;
+
+	/* memory allocated in context */
+	Size		memoryBytes;
+
+	/* position in the LRU list of relation caches */
+	dlist_node	lruNode;
+}			RelationDataFileCache;
+
+
+static void InvalidateDataFileCache(Datum argument, Oid relationId);
+static void DataFileCacheXactCallback(XactEvent event, void *arg);
+static RelationDataFileCache * GetRelationDataFileCache(Oid relationId, bool createIfMissing);
+static void RetireRelationDataFileCache(RelationDataFileCache * relationCache, bool keepEntry);
+static void EnforceDataFileCacheSize(RelationDataFileCache * relationCache);
+static List *CopyColumnStatsList(List *columnStats);
+static DataFileColumnStats * CopyDataFileColumnStats(DataFileColumnStats * columnStats);
+
+PG_FUNCTION_INFO_V1(data_file_cache_stats);
+
+/* pg_lake_table.data_file_cache_size */
+int			DataFileCacheSizeKB = DEFAULT_DATA_FILE_CACHE_SIZE_KB;
+
+/* relation ID -> RelationDataFileCache */
+static HTAB *RelationDataFileCaches = NULL;
+
+/* relation caches in least-recently used order, most recent first */
+static dlist_head RelationDataFileCacheLRU = DLIST_STATIC_INIT(RelationDataFileCacheLRU);
+
+/* total memory allocated by relation caches */
+static Size TotalDataFileCacheBytes = 0;
+
+/* parent context of the hash and all relation caches */
+static MemoryContext DataFileCacheContext = NULL;
+
+/* parent context of invalidated relation caches, reset at transaction end */
+static MemoryContext RetiredDataFileCacheContext = NULL;
+
+/* number of files served from and added to the cache, and dropped caches */
+static int64 DataFileCacheHits = 0;
+static int64 DataFileCacheMisses = 0;
+static int64 DataFileCacheInvalidations = 0;
+
+
+/*
+ * InitializeDataFileCache registers the invalidation callback that drops the
+ * cache of a relation when its relcache entry is invalidated.
+ */
+void
+InitializeDataFileCache(void)
+{
+	CacheRegisterRelcacheCallback(InvalidateDataFileCache, (Datum) 0);
+	RegisterXactCallback(DataFileCacheXactCallback, NULL);
+}
+
+
+/*
+ * DataFileCacheEnabled returns whether the data file details of the given
+ * relation can be served from the cache.
+ */
+bool
+DataFileCacheEnabled(Oid relationId)
+{
+	if (DataFileCacheSizeKB == 0)
+		return false;
+
+	RelationDataFileCache *relationCache =
+		GetRelationDataFileCache(relationId, false);
+
+	/* the details of the relation did not fit into the cache */
+	if (relationCache != NULL && relationCache->context == NULL)
+		return false;
+
+	return true;
+}
+
+
+/*
+ * DataFileCacheContainsRelation returns whether the cache has any data file
+ * details of the given relation.
+ */
+bool
+DataFileCacheContainsRelation(Oid relationId)
+{
+	RelationDataFileCache *relationCache =
+		GetRelationDataFileCache(relationId, false);
+
+	return relationCache != NULL && relationCache->context != NULL;
+}
+
+
+/*
+ * FillDataFileDetailsFromCache sets the column stats, partition, and partition
+ * spec ID of the data files in the given file id => TableDataFile hash from
+ * the cache, and returns the list of TableDataFile pointers that are not in
+ * the cache.
+ *
+ * When the hash contains all files of the relation (or all data files when
+ * dataOnly is set), cached files that are no longer in it are removed from
+ * the cache.
+ */
+List *
+FillDataFileDetailsFromCache(Oid relationId, HTAB *dataFiles, bool dataOnly,
+							 bool newFilesOnly)
+{
+	List	   *uncachedFiles = NIL;
+
+	RelationDataFileCache *relationCache =
+		GetRelationDataFileCache(relationId, false);
+
+	HASH_SEQ_STATUS status;
+	TableDataFile *dataFile = NULL;
+
+	hash_seq_init(&status, dataFiles);
+
+	while ((dataFile = hash_seq_search(&status)) != NULL)
+	{
+		CachedDataFileDetails *details = NULL;
+
+		if (relationCache != NULL && relationCache->context != NULL)
+			details = hash_search(relationCache->dataFiles, &dataFile->fileId,
+								  HASH_FIND, NULL);
+
+		if (details == NULL)
+		{
+			uncachedFiles = lappend(uncachedFiles, dataFile);
+			continue;
+		}
+
+		DataFileCacheHits++;
+
+		/* copy into the caller's context, cache memory is transient */
+		dataFile->stats.columnStats = CopyColumnStatsList(details->columnStats);
+		dataFile->partition = CopyPartition(details->partition);
+		dataFile->partitionSpecId = details->partitionSpecId;
+	}
+
+	if (relationCache == NULL || relationCache->context == NULL)
+		return uncachedFiles;
+
+	dlist_move_head(&RelationDataFileCacheLRU, &relationCache->lruNode);
+
+	if (newFilesOnly)
+		return uncachedFiles;
+
+	/* remove files that were removed from the relation */
+	CachedDataFileDetails *details = NULL;
+
+	hash_seq_init(&status, relationCache->dataFiles);
+
+	while ((details = hash_seq_search(&status)) != NULL)
+	{
+		if (dataOnly && details->content != CONTENT_DATA)
+			continue;
+
+		if (hash_search(dataFiles, &details->fileId, HASH_FIND, NULL) != NULL)
+			continue;
+
+		hash_search(relationCache->dataFiles, &details->fileId, HASH_REMOVE, NULL);
+		relationCache->removedFileCount++;
+	}
+
+	/*
+	 * The memory of removed files is only reclaimed by rebuilding the cache
+	 * of the relation, which we do once they outnumber the cached files.
+	 */
+	if (relationCache->removedFileCount > hash_get_num_entries(relationCache->dataFiles))
+		RetireRelationDataFileCache(relationCache, false);
+
+	return uncachedFiles;
+}
+
+
+/*
+ * AddDataFileDetailsToCache adds the column stats, partition, and partition
+ * spec ID of the data files in the given file id => TableDataFile hash to
+ * the cache of the relation.
+ */
+void
+AddDataFileDetailsToCache(Oid relationId, HTAB *dataFiles)
+{
+	if (!DataFileCacheEnabled(relationId))
+		return;
+
+	RelationDataFileCache *relationCache =
+		GetRelationDataFileCache(relationId, true);
+
+	MemoryContext oldContext = MemoryContextSwitchTo(relationCache->context);
+
+	HASH_SEQ_STATUS status;
+	TableDataFile *dataFile = NULL;
+
+	hash_seq_init(&status, dataFiles);
+
+	while ((dataFile = hash_seq_search(&status)) != NULL)
+	{
+		bool		found = false;
+		CachedDataFileDetails *details =
+			hash_search(relationCache->dataFiles, &dataFile->fileId, HASH_ENTER, &found);
+
+		if (found)
+			continue;
+
+		DataFileCacheMisses++;
+
+		details->content = dataFile->content;
+		details->columnStats = CopyColumnStatsList(dataFile->stats.columnStats);
+		details->partition = CopyPartition(dataFile->partition);
+		details->partitionSpecId = dataFile->partitionSpecId;
+	}
+
+	MemoryContextSwitchTo(oldContext);
+
+	Size		memoryBytes = MemoryContextMemAllocated(relationCache->context, true);
+
+	TotalDataFileCacheBytes += memoryBytes - relationCache->memoryBytes;
+	relationCache->memoryBytes = memoryBytes;
+
+	EnforceDataFileCacheSize(relationCache);
+}
+
+
+/*
+ * EnforceDataFileCacheSize evicts least-recently used relation caches until
+ * the total size is below pg_lake_table.data_file_cache_size. If the given
+ * relation cache does not fit by itself, the relation is no longer cached.
+ */
+static void
+EnforceDataFileCacheSize(RelationDataFileCache * relationCache)
+{
+	Size		maxCacheBytes = (Size) DataFileCacheSizeKB * 1024;
+
+	if (relationCache->memoryBytes > maxCacheBytes)
+	{
+		bool		keepEntry = true;
+
+		RetireRelationDataFileCache(relationCache, keepEntry);
+		return;
+	}
+
+	while (TotalDataFileCacheBytes > maxCacheBytes)
+	{
+		RelationDataFileCache *leastRecentlyUsed =
+			dlist_tail_element(RelationDataFileCache, lruNode, &RelationDataFileCacheLRU);
+
+		if (leastRecentlyUsed == relationCache)
+			break;
+
+		RetireRelationDataFileCache(leastRecentlyUsed, false);
+	}
+}
+
+
+/*
+ * GetRelationDataFileCache returns the cache of the given relation, optionally
+ * creating an empty one if it does not exist yet.
+ */
+static RelationDataFileCache *
+GetRelationDataFileCache(Oid relationId, bool createIfMissing)
+{
+	if (RelationDataFileCaches == NULL)
+	{
+		if (!createIfMissing)
+			return NULL;
+
+		DataFileCacheContext = AllocSetContextCreate(TopMemoryContext,
+													 "Data File Cache",
+													 ALLOCSET_DEFAULT_SIZES);
+		RetiredDataFileCacheContext = AllocSetContextCreate(TopMemoryContext,
+															"Retired Data File Caches",
+															ALLOCSET_SMALL_SIZES);
+
+		HASHCTL		hashCtl;
+
+		memset(&hashCtl, 0, sizeof(hashCtl));
+		hashCtl.keysize = sizeof(Oid);
+		hashCtl.entrysize = sizeof(RelationDataFileCache);
+		hashCtl.hcxt = DataFileCacheContext;
+
+		RelationDataFileCaches = hash_create("data file caches by relation id",
+											 32, &hashCtl,
+											 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	bool		found = false;
+	RelationDataFileCache *relationCache =
+		hash_search(RelationDataFileCaches, &relationId,
+					createIfMissing ? HASH_ENTER : HASH_FIND, &found);
+
+	if (!createIfMissing || found)
+		return relationCache;
+
+	relationCache->context = AllocSetContextCreate(DataFileCacheContext,
+												   "Relation Data File Cache",
+												   ALLOCSET_DEFAULT_SIZES);
+
+	HASHCTL		hashCtl;
+
+	memset(&hashCtl, 0, sizeof(hashCtl));
+	hashCtl.keysize = sizeof(int64);
+	hashCtl.entrysize = sizeof(CachedDataFileDetails);
+	hashCtl.hcxt = relationCache->context;
+
+	relationCache->dataFiles = hash_create("cached data files by file id",
+										   1024, &hashCtl,
+										   HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	relationCache->removedFileCount = 0;
+	relationCache->memoryBytes = 0;
+
+	dlist_push_head(&RelationDataFileCacheLRU, &relationCache->lruNode);
+
+	return relationCache;
+}
+
+
+/*
+ * RetireRelationDataFileCache removes the cached details of a relation. The
+ * memory is freed at the end of the transaction. If keepEntry is true, the
+ * entry of the relation remains to signal that the relation is not cached.
+ */
+static void
+RetireRelationDataFileCache(RelationDataFileCache * relationCache, bool keepEntry)
+{
+	if (relationCache->context != NULL)
+	{
+		MemoryContextSetParent(relationCache->context, RetiredDataFileCacheContext);
+
+		TotalDataFileCacheBytes -= relationCache->memoryBytes;
+		dlist_delete(&relationCache->lruNode);
+
+		relationCache->context = NULL;
+		relationCache->dataFiles = NULL;
+		relationCache->memoryBytes = 0;
+		relationCache->removedFileCount = 0;
+	}
+
+	if (!keepEntry)
+		hash_search(RelationDataFileCaches, &relationCache->relationId, HASH_REMOVE, NULL);
+}
+
+
+/*
+ * InvalidateDataFileCache drops the cache of a relation when its relcache
+ * entry is invalidated, or all caches when all relcache entries are.
+ */
+static void
+InvalidateDataFileCache(Datum argument, Oid relationId)
+{
+	if (RelationDataFileCaches == NULL)
+		return;
+
+	if (relationId == InvalidOid)
+	{
+		HASH_SEQ_STATUS status;
+		RelationDataFileCache *relationCache = NULL;
+
+		hash_seq_init(&status, RelationDataFileCaches);
+
+		while ((relationCache = hash_seq_search(&status)) != NULL)
+		{
+			if (relationCache->context != NULL)
+				DataFileCacheInvalidations++;
+
+			RetireRelationDataFileCache(relationCache, false);
+		}
+
+		return;
+	}
+
+	RelationDataFileCache *relationCache =
+		hash_search(RelationDataFileCaches, &relationId, HASH_FIND, NULL);
+
+	if (relationCache == NULL)
+		return;
+
+	if (relationCache->context != NULL)
+		DataFileCacheInvalidations++;
+
+	RetireRelationDataFileCache(relationCache, false);
+}
+
+
+/*
+ * DataFileCacheXactCallback frees invalidated relation caches at the end of
+ * the transaction.
+ */
+static void
+DataFileCacheXactCallback(XactEvent event, void *arg)
+{
+	switch (event)
+	{
+		case XACT_EVENT_COMMIT:
+		case XACT_EVENT_PARALLEL_COMMIT:
+		case XACT_EVENT_ABORT:
+		case XACT_EVENT_PARALLEL_ABORT:
+		case XACT_EVENT_PREPARE:
+			{
+				if (RetiredDataFileCacheContext != NULL)
+					MemoryContextDeleteChildren(RetiredDataFileCacheContext);
+				break;
+			}
+
+		default:
+			break;
+	}
+}
+
+
+/*
+ * CopyColumnStatsList returns a deep copy of a list of DataFileColumnStats
+ * in the current memory context.
+ */
+static List *
+CopyColumnStatsList(List *columnStats)
+{
+	List	   *copy = NIL;
+	ListCell   *cell = NULL;
+
+	foreach(cell, columnStats)
+	{
+		DataFileColumnStats *columnStat = (DataFileColumnStats *) lfirst(cell);
+
+		copy = lappend(copy, CopyDataFileColumnStats(columnStat));
+	}
+
+	return copy;
+}
+
+
+/*
+ * CopyDataFileColumnStats returns a deep copy of column stats read from
+ * the catalog, which always have a scalar leaf field.
+ */
+static DataFileColumnStats *
+CopyDataFileColumnStats(DataFileColumnStats * columnStats)
+{
+	DataFileColumnStats *copy = palloc(sizeof(DataFileColumnStats));
+
+	*copy = *columnStats;
+
+	Assert(columnStats->leafField.field->type == FIELD_TYPE_SCALAR);
+
+	Field	   *field = palloc(sizeof(Field));
+
+	*field = *columnStats->leafField.field;
+	field->field.scalar.typeName = pstrdup(field->field.scalar.typeName);
+
+	copy->leafField.field = field;
+	copy->leafField.duckTypeName = pstrdup(columnStats->leafField.duckTypeName);
+
+	if (columnStats->lowerBoundText != NULL)
+		copy->lowerBoundText = pstrdup(columnStats->lowerBoundText);
+
+	if (columnStats->upperBoundText != NULL)
+		copy->upperBoundText = pstrdup(columnStats->upperBoundText);
+
+	return copy;
+}
+
+
+/*
+ * data_file_cache_stats returns the data file cache hit and miss counters
+ * and the size of the data file cache of the current backend.
+ */
+Datum
+data_file_cache_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupleDesc;
+
+	if (get_call_result_type(fcinfo, NULL, &tupleDesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	int64		cachedRelations = 0;
+	int64		cachedFiles = 0;
+
+	if (RelationDataFileCaches != NULL)
+	{
+		HASH_SEQ_STATUS status;
+		RelationDataFileCache *relationCache = NULL;
+
+		hash_seq_init(&status, RelationDataFileCaches);
+
+		while ((relationCache = hash_seq_search(&status)) != NULL)
+		{
+			if (relationCache->context == NULL)
+				continue;
+
+			cachedRelations++;
+			cachedFiles += hash_get_num_entries(relationCache->dataFiles);
+		}
+	}
+
+	Datum		values[6];
+	bool		nulls[6];
+
+	memset(nulls, 0, sizeof(nulls));
+
+	values[0] = Int64GetDatum(DataFileCacheHits);
+	values[1] = Int64GetDatum(DataFileCacheMisses);
+	values[2] = Int64GetDatum(DataFileCacheInvalidations);
+	values[3] = Int64GetDatum(cachedRelations);
+	values[4] = Int64GetDatum(cachedFiles);
+	values[5] = Int64GetDatum((int64) TotalDataFileCacheBytes);
+
+	HeapTuple	tuple = heap_form_tuple(BlessTupleDesc(tupleDesc), values, nulls);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
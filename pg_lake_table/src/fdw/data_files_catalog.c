@@ -33,6 +33,7 @@
 #include "pg_lake/extensions/pg_lake_engine.h"
 #include "pg_lake/fdw/catalog/row_id_mappings.h"
 #include "pg_lake/fdw/data_file_stats.h"
+#include "pg_lake/fdw/data_files_cache.h"
 #include "pg_lake/fdw/data_files_catalog.h"
 #include "pg_lake/fdw/data_file_stats.h"
 #include "pg_lake/fdw/data_file_stats_catalog.h"
@@ -89,6 +90,10 @@ static int64 GetFileIdForPath(Oid relatoinId, const char *path);
 static void UpdateDeletedRowCount(Oid relationId, const char *path, int64 deletedRowCount);
 static void RemoveDataFileFromTable(Oid relationId, const char *path);
 static void RemoveAllDataFilesFromCatalog(Oid relationId);
+static HTAB *ReadTableDataFilesFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnly,
+											bool forUpdate, char *orderBy, Snapshot snapshot,
+											List *partitionTransforms, bool includeDetails,
+											List *fileIds);
 static HTAB *CreateDataFilesHash(void);
 static HTAB *CreateDataFilesByPathHash(void);
 static List *TableDataFileHashToList(HTAB *dataFiles);
@@ -135,6 +140,97 @@ HTAB *
 GetTableDataFilesHashFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnly,
 								 bool forUpdate, char *orderBy, Snapshot snapshot,
 								 List *partitionTransforms)
+{
+	bool		includeDetails = true;
+
+	if (!DataFileCacheEnabled(relationId))
+		return ReadTableDataFilesFromCatalog(relationId, dataOnly, newFilesOnly,
+											 forUpdate, orderBy, snapshot,
+											 partitionTransforms, includeDetails,
+											 NIL);
+
+	/* first read of the relation, fill the cache with the result */
+	if (!DataFileCacheContainsRelation(relationId))
+	{
+		HTAB	   *dataFilesHash =
+			ReadTableDataFilesFromCatalog(relationId, dataOnly, newFilesOnly,
+										  forUpdate, orderBy, snapshot,
+										  partitionTransforms, includeDetails,
+										  NIL);
+
+		AddDataFileDetailsToCache(relationId, dataFilesHash);
+
+		return dataFilesHash;
+	}
+
+	/*
+	 * Read only the files themselves, such that visibility and locking
+	 * follow the snapshot, and get the column stats and partition values
+	 * from the cache.
+	 */
+	HTAB	   *dataFilesHash =
+		ReadTableDataFilesFromCatalog(relationId, dataOnly, newFilesOnly,
+									  forUpdate, orderBy, snapshot,
+									  partitionTransforms, !includeDetails,
+									  NIL);
+
+	List	   *uncachedFiles = FillDataFileDetailsFromCache(relationId, dataFilesHash,
+															 dataOnly, newFilesOnly);
+
+	if (uncachedFiles == NIL)
+		return dataFilesHash;
+
+	/* read the column stats and partition values of new files */
+	List	   *uncachedFileIds = NIL;
+	ListCell   *fileCell = NULL;
+
+	foreach(fileCell, uncachedFiles)
+	{
+		TableDataFile *dataFile = lfirst(fileCell);
+
+		uncachedFileIds = lappend(uncachedFileIds, &dataFile->fileId);
+	}
+
+	HTAB	   *uncachedFilesHash =
+		ReadTableDataFilesFromCatalog(relationId, false, false, false, NULL,
+									  snapshot, partitionTransforms,
+									  includeDetails, uncachedFileIds);
+
+	AddDataFileDetailsToCache(relationId, uncachedFilesHash);
+
+	foreach(fileCell, uncachedFiles)
+	{
+		TableDataFile *dataFile = lfirst(fileCell);
+		TableDataFile *dataFileWithDetails =
+			hash_search(uncachedFilesHash, &dataFile->fileId, HASH_FIND, NULL);
+
+		if (dataFileWithDetails == NULL)
+			continue;
+
+		dataFile->stats.columnStats = dataFileWithDetails->stats.columnStats;
+		dataFile->partition = dataFileWithDetails->partition;
+		dataFile->partitionSpecId = dataFileWithDetails->partitionSpecId;
+	}
+
+	return dataFilesHash;
+}
+
+
+/*
+ * ReadTableDataFilesFromCatalog reads the data files of the given table from
+ * the catalog into a file id => TableDataFile hash, with the same options as
+ * GetTableDataFilesHashFromCatalog.
+ *
+ * If includeDetails is false, the column stats and partition values are not
+ * read and left empty.
+ * If fileIds is not NIL, only files with an id in the list of int64 pointers
+ * are returned.
+ */
+static HTAB *
+ReadTableDataFilesFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnly,
+							  bool forUpdate, char *orderBy, Snapshot snapshot,
+							  List *partitionTransforms, bool includeDetails,
+							  List *fileIds)
 {
 	MemoryContext callerContext = CurrentMemoryContext;
 
@@ -153,17 +249,22 @@ GetTableDataFilesHashFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnl
 						    /* 5 */ "f.file_size, "
 						    /* 6 */ "f.deleted_row_count, "
 						    /* 7 */ "f.updated_time, "
-						    /* 8 */ "f.first_row_id, "
-						    /* 9 */ "sma.field_id, "
-						    /* 10 */ "sma.field_pg_type, "
-						    /* 11 */ "sma.field_pg_typemod, "
-						    /* 12 */ "sma.lower_bound, "
-						    /* 13 */ "sma.upper_bound, "
-						    /* 14 */ "p.partition_field_id, "
-						    /* 15 */ "p.partition_field_name, "
-						    /* 16 */ "p.value, "
-						    /* 17 */ "p.spec_id "
-						   "from (");
+						    /* 8 */ "f.first_row_id");
+
+	if (includeDetails)
+		appendStringInfoString(&metadataQuery,
+							   ", "
+							    /* 9 */ "sma.field_id, "
+							    /* 10 */ "sma.field_pg_type, "
+							    /* 11 */ "sma.field_pg_typemod, "
+							    /* 12 */ "sma.lower_bound, "
+							    /* 13 */ "sma.upper_bound, "
+							    /* 14 */ "p.partition_field_id, "
+							    /* 15 */ "p.partition_field_name, "
+							    /* 16 */ "p.value, "
+							    /* 17 */ "p.spec_id");
+
+	appendStringInfoString(&metadataQuery, " from (");
 
 	appendStringInfoString(&metadataQuery,
 						   "select * from " DATA_FILES_TABLE_QUALIFIED " "
@@ -175,28 +276,34 @@ GetTableDataFilesHashFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnl
 	if (newFilesOnly)
 		appendStringInfoString(&metadataQuery, " and id IN (select id from " TX_DATA_FILES_QUALIFIED_TABLE_NAME ")");
 
+	if (fileIds != NIL)
+		appendStringInfoString(&metadataQuery, " and id OPERATOR(pg_catalog.=) ANY($2)");
+
 	if (forUpdate)
 		appendStringInfoString(&metadataQuery, " for update");
 
+	appendStringInfoString(&metadataQuery, ") f");
+
 	/*
 	 * not all tables (or all columns) have the stats. For example, iceberg
 	 * tables created before we added this catalog or data types that do not
 	 * have min/max or pg_lake tables.
 	 */
-	appendStringInfoString(&metadataQuery,
-						   ") f "
-						   "LEFT JOIN (" DATA_FILE_PARTITION_VALUES_TABLE_QUALIFIED
-						   " JOIN " PARTITION_FIELDS_TABLE_QUALIFIED
-						   " USING (table_name, partition_field_id) "
-						   ") p USING (table_name, id) "
-						   "LEFT JOIN ("
-						   DATA_FILE_COLUMN_STATS_TABLE_QUALIFIED " s "
-						   "JOIN " MAPPING_TABLE_NAME
-						   " m USING (table_name, field_id) "
-						   "JOIN pg_attribute a ON (a.attrelid OPERATOR(pg_catalog.=) m.table_name "
-						   "                       AND a.attnum   OPERATOR(pg_catalog.=) m.pg_attnum "
-						   "                       AND NOT a.attisdropped)"
-						   ") sma USING (table_name, path)");
+	if (includeDetails)
+		appendStringInfoString(&metadataQuery,
+							   " "
+							   "LEFT JOIN (" DATA_FILE_PARTITION_VALUES_TABLE_QUALIFIED
+							   " JOIN " PARTITION_FIELDS_TABLE_QUALIFIED
+							   " USING (table_name, partition_field_id) "
+							   ") p USING (table_name, id) "
+							   "LEFT JOIN ("
+							   DATA_FILE_COLUMN_STATS_TABLE_QUALIFIED " s "
+							   "JOIN " MAPPING_TABLE_NAME
+							   " m USING (table_name, field_id) "
+							   "JOIN pg_attribute a ON (a.attrelid OPERATOR(pg_catalog.=) m.table_name "
+							   "                       AND a.attnum   OPERATOR(pg_catalog.=) m.pg_attnum "
+							   "                       AND NOT a.attisdropped)"
+							   ") sma USING (table_name, path)");
 
 
 	if (orderBy != NULL)
@@ -217,8 +324,9 @@ GetTableDataFilesHashFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnl
 
 	SPI_START_EXTENSION_OWNER(PgLakeTable);
 
-	DECLARE_SPI_ARGS(1);
+	DECLARE_SPI_ARGS(2);
 	SPI_ARG_VALUE(1, OIDOID, relationId, false);
+	SPI_ARG_VALUE(2, INT8ARRAYOID, Int64ListToArray(fileIds), fileIds == NIL);
 
 	if (!snapshot)
 	{
@@ -308,6 +416,12 @@ GetTableDataFilesHashFromCatalog(Oid relationId, bool dataOnly, bool newFilesOnl
 			dataFile->partitionSpecId = DEFAULT_SPEC_ID;
 		}
 
+		if (!includeDetails)
+		{
+			MemoryContextSwitchTo(spiContext);
+			continue;
+		}
+
 		bool		isFieldIdNull = false;
 		Datum		fieldIdDatum = GET_SPI_DATUM(rowIndex, 9, &isFieldIdNull);
 
@@ -591,6 +705,10 @@ TableDataFileHashToList(HTAB *dataFiles)
  *
  * includeUnbound specifies whether to include position delete files that are not
  * bound to a specific data file.
+ *
+ * The source paths are joined with the mapping as a set, rather than compared
+ * as an array with every mapping row, since the generic plan of the cached
+ * query cannot hash an array parameter and scans can have many data files.
  */
 List *
 GetPossiblePositionDeleteFilesFromCatalog(Oid relationId, List *sourcePathList, Snapshot snapshot)
@@ -612,7 +730,7 @@ GetPossiblePositionDeleteFilesFromCatalog(Oid relationId, List *sourcePathList,
 		 /* 1 */ "path "
 		"from " DELETION_FILE_MAP_TABLE " "
 		"where table_name OPERATOR(pg_catalog.=) $1 "
-		"and deleted_from OPERATOR(pg_catalog.=) ANY($2)";
+		"and deleted_from OPERATOR(pg_catalog.=) ANY (select pg_catalog.unnest($2))";
 
 	SPI_START();
 
@@ -57,6 +57,9 @@ typedef struct ReplacePgLakeTableContext
 	/* relation rtes to find */
 	List	   *relationRteList;
 
+	/* whether to replace regular tables instead of pg_lake tables */
+	bool		replaceHeapTables;
+
 	/* whether a ctid Var is present */
 	bool		hasCtidVar;
 }			ReplacePgLakeTableContext;
@@ -88,6 +91,7 @@ ReplacePgLakeTableWithReadTableFunc(Node *node)
 	ReplacePgLakeTableContext context = {
 		.readTableFunctionId = readTableFunctionId,
 		.relationRteList = NIL,
+		.replaceHeapTables = false,
 		.hasCtidVar = false
 	};
 
@@ -112,6 +116,27 @@ ReplacePgLakeTableWithReadTableFunc(Node *node)
 }
 
 
+/*
+ * ReplaceHeapTablesWithReadTableFunc replaces all occurrences of regular
+ * tables with read_table(..) function calls, such that they can be replaced
+ * by reads of a copy of the table in the same way as pg_lake tables.
+ */
+List *
+ReplaceHeapTablesWithReadTableFunc(Node *node)
+{
+	ReplacePgLakeTableContext context = {
+		.readTableFunctionId = ReadTableFunctionId(),
+		.relationRteList = NIL,
+		.replaceHeapTables = true,
+		.hasCtidVar = false
+	};
+
+	ReplacePgLakeTableWalker(node, &context);
+
+	return context.relationRteList;
+}
+
+
 /*
 * RteListToOidList converts a list of RangeTblEntry to a list of Oids.
 */
@@ -169,8 +194,11 @@ ReplacePgLakeTableWalker(Node *node, ReplacePgLakeTableContext * context)
 	}
 
 	RangeTblEntry *rte = (RangeTblEntry *) node;
+	bool		replaceTable = context->replaceHeapTables ?
+		rte->rtekind == RTE_RELATION && !IsAnyLakeForeignTable(rte) :
+		IsAnyLakeForeignTable(rte);
 
-	if (IsAnyLakeForeignTable(rte))
+	if (replaceTable)
 	{
 		char	   *qualifiedRelationName = GetQualifiedRelationName(rte->relid);
 
@@ -0,0 +1,660 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Insert buffer for Iceberg tables.
+ *
+ * Every INSERT into an Iceberg table normally writes at least one data file
+ * and one snapshot, which is costly for workloads that do many small inserts.
+ * Tables with the insert_buffer option instead keep the rows of small INSERT
+ * statements in the lake_table.insert_buffer heap table, in the binary
+ * representation of the table's row type. The binary representation does
+ * not depend on settings such as DateStyle of the inserting session, so
+ * the rows can be read by any session. Since the buffer and the files
+ * catalog are both regular tables, inserts are transactional and a single
+ * snapshot gives a consistent view of both.
+ *
+ * Scans write the buffered rows that are visible to their snapshot to a
+ * temporary data file and read it along with the data files of the table.
+ * The insert buffer worker moves the buffered rows into data files once a
+ * table has insert_buffer_flush_rows rows in the buffer or once the oldest
+ * row is insert_buffer_flush_interval seconds old. Deleting the rows and
+ * adding the data files happens in one transaction, and concurrent flushes
+ * only see the rows they deleted themselves.
+ *
+ * UPDATE/DELETE and ALTER TABLE first flush the buffer, such that they only
+ * need to deal with data files, and TRUNCATE/DROP TABLE discard it.
+ */
+#include "postgres.h"
+#include "miscadmin.h"
+
+#include "access/htup_details.h"
+#include "access/table.h"
+#include "access/xact.h"
+#include "catalog/namespace.h"
+#include "catalog/pg_type.h"
+#include "executor/spi.h"
+#include "foreign/foreign.h"
+#include "lib/stringinfo.h"
+#include "pg_extension_base/base_workers.h"
+#include "pg_lake/copy/copy_format.h"
+#include "pg_lake/csv/csv_options.h"
+#include "pg_lake/csv/csv_writer.h"
+#include "pg_lake/fdw/insert_buffer.h"
+#include "pg_lake/fdw/multi_data_file_dest.h"
+#include "pg_lake/fdw/schema_operations/register_field_ids.h"
+#include "pg_lake/fdw/writable_table.h"
+#include "pg_lake/iceberg/catalog.h"
+#include "pg_lake/parsetree/options.h"
+#include "pg_lake/partitioning/partition_by_parser.h"
+#include "pg_lake/partitioning/partition_spec_catalog.h"
+#include "pg_lake/partitioning/partitioned_dest_receiver.h"
+#include "pg_lake/pgduck/write_data.h"
+#include "pg_lake/storage/local_storage.h"
+#include "pg_lake/util/rel_utils.h"
+#include "pg_lake/util/spi_helpers.h"
+#include "pg_lake/util/table_type.h"
+#include "utils/acl.h"
+#include "utils/array.h"
+#include "utils/backend_status.h"
+#include "utils/builtins.h"
+#include "utils/fmgroids.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/ps_status.h"
+#include "utils/rel.h"
+#include "utils/snapmgr.h"
+#include "utils/syscache.h"
+
+/* number of buffered rows to fetch at a time */
+#define INSERT_BUFFER_FETCH_SIZE (1000)
+
+int			InsertBufferMaxStatementRows = DEFAULT_INSERT_BUFFER_MAX_STATEMENT_ROWS;
+int			InsertBufferFlushRows = DEFAULT_INSERT_BUFFER_FLUSH_ROWS;
+int			InsertBufferFlushInterval = DEFAULT_INSERT_BUFFER_FLUSH_INTERVAL;
+
+static bool InsertBufferCatalogExists(void);
+static int64 ReadInsertBuffer(Relation rel, bool deleteRows, DestReceiver *dest);
+static List *GetInsertBuffersToFlush(void);
+static void FlushInsertBufferInWorker(Oid relationId);
+
+PG_FUNCTION_INFO_V1(flush_insert_buffer);
+PG_FUNCTION_INFO_V1(pg_lake_table_insert_buffer_worker);
+
+
+/*
+ * flush_insert_buffer writes the buffered rows of a table to data files
+ * and returns the number of rows.
+ */
+Datum
+flush_insert_buffer(PG_FUNCTION_ARGS)
+{
+	Oid			relationId = PG_GETARG_OID(0);
+
+	if (!IsInternalIcebergTable(relationId))
+		ereport(ERROR, (errcode(ERRCODE_WRONG_OBJECT_TYPE),
+						errmsg("\"%s\" is not an Iceberg table",
+							   get_rel_name(relationId))));
+
+	AclResult	aclResult = pg_class_aclcheck(relationId, GetUserId(), ACL_INSERT);
+
+	if (aclResult != ACLCHECK_OK)
+		aclcheck_error(aclResult, OBJECT_FOREIGN_TABLE, get_rel_name(relationId));
+
+	PG_RETURN_INT64(FlushInsertBuffer(relationId));
+}
+
+
+/*
+ * pg_lake_table_insert_buffer_worker is the main function of the base worker
+ * that flushes the insert buffers of all tables in the database once they
+ * exceed the size or age thresholds.
+ */
+Datum
+pg_lake_table_insert_buffer_worker(PG_FUNCTION_ARGS)
+{
+	/* report application_name in pg_stat_activity */
+	pgstat_report_appname("pg_lake insert buffer");
+
+	/* report process name in ps (follows "pg_extension_base worker") */
+	set_ps_display(psprintf("(pg_lake insert buffer for database %d)", MyDatabaseId));
+
+	/* list of tables to flush, reset on each loop iteration */
+	MemoryContext outOfTransactionMemoryContext =
+		AllocSetContextCreate(CacheMemoryContext, "pg_lake insert buffer",
+							  ALLOCSET_DEFAULT_SIZES);
+
+	while (true)
+	{
+		List	   *relationIdList = NIL;
+
+		START_TRANSACTION();
+		{
+			MemoryContext oldContext =
+				MemoryContextSwitchTo(outOfTransactionMemoryContext);
+
+			relationIdList = GetInsertBuffersToFlush();
+
+			MemoryContextSwitchTo(oldContext);
+		}
+		END_TRANSACTION_NO_THROW(WARNING);
+
+		/*
+		 * Flush each table in a separate transaction, such that a failing
+		 * table does not hold up the others and new snapshots are committed
+		 * as soon as possible.
+		 */
+		foreach_oid(relationId, relationIdList)
+		{
+			START_TRANSACTION();
+			{
+				FlushInsertBufferInWorker(relationId);
+			}
+			END_TRANSACTION_NO_THROW(WARNING);
+
+			CHECK_FOR_INTERRUPTS();
+		}
+
+		MemoryContextReset(outOfTransactionMemoryContext);
+
+		LightSleep(1000);
+	}
+
+	PG_RETURN_VOID();
+}
+
+
+/*
+ * GetInsertBuffersToFlush returns the tables whose insert buffer has at least
+ * InsertBufferFlushRows rows or rows older than InsertBufferFlushInterval,
+ * with the oldest buffers first.
+ */
+static List *
+GetInsertBuffersToFlush(void)
+{
+	List	   *relationIdList = NIL;
+
+	if (!InsertBufferCatalogExists())
+		return NIL;
+
+	char	   *query =
+		"select table_name "
+		"from " INSERT_BUFFER_TABLE_QUALIFIED " "
+		"group by table_name "
+		"having pg_catalog.count(*) operator(pg_catalog.>=) $1 "
+		"or pg_catalog.min(inserted_at) operator(pg_catalog.<=) "
+		"pg_catalog.now() operator(pg_catalog.-) pg_catalog.make_interval(secs => $2) "
+		"order by pg_catalog.min(inserted_at)";
+
+	DECLARE_SPI_ARGS(2);
+	SPI_ARG_VALUE(1, INT8OID, InsertBufferFlushRows, false);
+	SPI_ARG_VALUE(2, FLOAT8OID, InsertBufferFlushInterval, false);
+
+	MemoryContext callerContext = CurrentMemoryContext;
+
+	SPI_START_EXTENSION_OWNER(PgLakeTable);
+
+	bool		readOnly = true;
+
+	SPI_EXECUTE(query, readOnly);
+
+	for (uint64 rowIndex = 0; rowIndex < SPI_processed; rowIndex++)
+	{
+		bool		isNull = false;
+		Oid			relationId = GET_SPI_VALUE(OIDOID, rowIndex, 1, &isNull);
+
+		MemoryContext spiContext = MemoryContextSwitchTo(callerContext);
+
+		relationIdList = lappend_oid(relationIdList, relationId);
+
+		MemoryContextSwitchTo(spiContext);
+	}
+
+	SPI_END();
+
+	return relationIdList;
+}
+
+
+/*
+ * FlushInsertBufferInWorker flushes the insert buffer of a table from the
+ * insert buffer worker, unless the table is gone or read-only.
+ */
+static void
+FlushInsertBufferInWorker(Oid relationId)
+{
+	if (!SearchSysCacheExists1(RELOID, ObjectIdGetDatum(relationId)))
+	{
+		/* table dropped, DROP TABLE removes the buffered rows */
+		return;
+	}
+
+	if (IsReadOnlyIcebergTable(relationId))
+		return;
+
+	FlushInsertBuffer(relationId);
+}
+
+
+/*
+ * IsInsertBufferEnabled returns whether inserts into the given table go
+ * into the insert buffer.
+ */
+bool
+IsInsertBufferEnabled(Oid relationId)
+{
+	ForeignTable *foreignTable = GetForeignTable(relationId);
+
+	if (!GetBoolOption(foreignTable->options, "insert_buffer", false))
+		return false;
+
+	/* ignore the option until the extension is updated */
+	return InsertBufferCatalogExists();
+}
+
+
+/*
+ * InsertBufferCatalogExists returns whether the lake_table.insert_buffer
+ * table exists.
+ */
+static bool
+InsertBufferCatalogExists(void)
+{
+	bool		missingOk = true;
+
+	Oid			namespaceId = get_namespace_oid(PG_LAKE_TABLE_SCHEMA, missingOk);
+
+	if (namespaceId == InvalidOid)
+		return false;
+
+	return get_relname_relid(INSERT_BUFFER_TABLE_NAME, namespaceId) != InvalidOid;
+}
+
+
+/*
+ * CreateInsertBuffer creates an InsertBuffer for the rows of an INSERT
+ * statement into the given relation.
+ */
+InsertBuffer *
+CreateInsertBuffer(Relation rel)
+{
+	InsertBuffer *buffer = palloc0(sizeof(InsertBuffer));
+
+	buffer->rel = rel;
+	buffer->context = AllocSetContextCreate(CurrentMemoryContext,
+											"pg_lake insert buffer",
+											ALLOCSET_DEFAULT_SIZES);
+	fmgr_info(F_RECORD_SEND, &buffer->recordSendFunction);
+
+	return buffer;
+}
+
+
+/*
+ * AddRowToInsertBuffer adds the row in the given slot to the insert buffer,
+ * or returns false if the statement inserts too many rows for the buffer,
+ * in which case the caller should write the buffered rows and the remaining
+ * rows to data files.
+ */
+bool
+AddRowToInsertBuffer(InsertBuffer * buffer, TupleTableSlot *slot)
+{
+	if (buffer->rowCount >= InsertBufferMaxStatementRows)
+		return false;
+
+	MemoryContext oldContext = MemoryContextSwitchTo(buffer->context);
+
+	buffer->rows = lappend(buffer->rows, ExecCopySlotMinimalTuple(slot));
+	buffer->rowCount++;
+
+	MemoryContextSwitchTo(oldContext);
+
+	return true;
+}
+
+
+/*
+ * FinishInsertBuffer writes the rows of the statement to the
+ * lake_table.insert_buffer table.
+ */
+void
+FinishInsertBuffer(InsertBuffer * buffer)
+{
+	if (buffer->rowCount == 0)
+		return;
+
+	Oid			relationId = RelationGetRelid(buffer->rel);
+	TupleDesc	tupleDesc = RelationGetDescr(buffer->rel);
+	TupleTableSlot *slot = MakeSingleTupleTableSlot(tupleDesc, &TTSOpsMinimalTuple);
+	Datum	   *rowValues = palloc(sizeof(Datum) * buffer->rowCount);
+	int			rowIndex = 0;
+
+	foreach_ptr(MinimalTupleData, row, buffer->rows)
+	{
+		ExecStoreMinimalTuple(row, slot, false);
+
+		/* the datum has the row type of the table */
+		Datum		rowDatum = ExecFetchSlotHeapTupleDatum(slot);
+		bytea	   *rowBytes = SendFunctionCall(&buffer->recordSendFunction, rowDatum);
+
+		rowValues[rowIndex++] = PointerGetDatum(rowBytes);
+	}
+
+	ExecDropSingleTupleTableSlot(slot);
+
+	ArrayType  *rowArray = construct_array(rowValues, rowIndex, BYTEAOID, -1, false,
+										   TYPALIGN_INT);
+
+	char	   *query =
+		"insert into " INSERT_BUFFER_TABLE_QUALIFIED " (table_name, row_data) "
+		"select $1, pg_catalog.unnest($2)";
+
+	DECLARE_SPI_ARGS(2);
+	SPI_ARG_VALUE(1, OIDOID, relationId, false);
+	SPI_ARG_VALUE(2, BYTEAARRAYOID, rowArray, false);
+
+	SPI_START_EXTENSION_OWNER(PgLakeTable);
+
+	bool		readOnly = false;
+
+	SPI_EXECUTE(query, readOnly);
+
+	SPI_END();
+
+	MemoryContextReset(buffer->context);
+	buffer->rows = NIL;
+	buffer->rowCount = 0;
+}
+
+
+/*
+ * FlushInsertBuffer moves the buffered rows of a table that are visible to
+ * a new snapshot into new data files and returns the number of rows.
+ */
+int64
+FlushInsertBuffer(Oid relationId)
+{
+	ErrorIfReadOnlyIcebergTable(relationId);
+
+	Relation	rel = table_open(relationId, RowExclusiveLock);
+	CopyDataFormat format = GetForeignTableFormat(relationId);
+	int			specId = GetCurrentSpecId(relationId);
+	bool		partitionedTable = GetIcebergTablePartitionByOption(relationId) != NULL;
+	DestReceiver *insertDest = NULL;
+
+	/* write the rows in the same way as an INSERT */
+	if (partitionedTable)
+	{
+		insertDest = CreatePartitionedDestReceiver(relationId, format, specId);
+	}
+	else
+	{
+		bool		allowPipelining = true;
+
+		insertDest = CreateMultiDataFileDestReceiver(relationId,
+													 format,
+													 MaxWriteTempFileSizeMB,
+													 specId,
+													 0,
+													 allowPipelining);
+	}
+
+	bool		deleteRows = true;
+	int64		rowCount = ReadInsertBuffer(rel, deleteRows, insertDest);
+
+	if (rowCount > 0)
+	{
+		insertDest->rShutdown(insertDest);
+
+		List	   *modifications =
+			partitionedTable ? GetPartitionedDestReceiverModifications(insertDest) :
+			GetMultiDataFileDestReceiverModifications(insertDest);
+
+		ApplyDataFileModifications(rel, modifications);
+	}
+
+	table_close(rel, NoLock);
+
+	return rowCount;
+}
+
+
+/*
+ * CountInsertBufferRows returns the number of buffered rows of a table that
+ * are visible to the active snapshot.
+ */
+int64
+CountInsertBufferRows(Oid relationId)
+{
+	if (!IsInsertBufferEnabled(relationId))
+		return 0;
+
+	char	   *query =
+		"select pg_catalog.coalesce(pg_catalog.sum(pg_catalog.cardinality(row_data)), 0) "
+		"from " INSERT_BUFFER_TABLE_QUALIFIED " "
+		"where table_name operator(pg_catalog.=) $1";
+
+	DECLARE_SPI_ARGS(1);
+	SPI_ARG_VALUE(1, OIDOID, relationId, false);
+
+	SPI_START_EXTENSION_OWNER(PgLakeTable);
+
+	bool		readOnly = true;
+
+	SPI_EXECUTE(query, readOnly);
+
+	bool		isNull = false;
+	int64		rowCount = GET_SPI_VALUE(INT8OID, 0, 1, &isNull);
+
+	SPI_END();
+
+	return rowCount;
+}
+
+
+/*
+ * ClearInsertBuffer removes the buffered rows of a table.
+ */
+void
+ClearInsertBuffer(Oid relationId)
+{
+	if (!InsertBufferCatalogExists())
+		return;
+
+	char	   *query =
+		"delete from " INSERT_BUFFER_TABLE_QUALIFIED " "
+		"where table_name operator(pg_catalog.=) $1";
+
+	DECLARE_SPI_ARGS(1);
+	SPI_ARG_VALUE(1, OIDOID, relationId, false);
+
+	SPI_START_EXTENSION_OWNER(PgLakeTable);
+
+	bool		readOnly = false;
+
+	SPI_EXECUTE(query, readOnly);
+
+	SPI_END();
+}
+
+
+/*
+ * CreateInsertBufferFileScan writes the buffered rows of a table that are
+ * visible to the given snapshot to a temporary data file, and returns a
+ * file scan for it, or NULL if there are no such rows.
+ *
+ * The data file is written in the same way as the data files of the table,
+ * such that it can be read in the same way.
+ */
+PgLakeFileScan *
+CreateInsertBufferFileScan(Oid relationId, Snapshot snapshot)
+{
+	Relation	rel = table_open(relationId, AccessShareLock);
+	ForeignTable *foreignTable = GetForeignTable(relationId);
+	List	   *options = foreignTable->options;
+	PgLakeTableType tableType = GetPgLakeTableType(relationId);
+	CopyDataFormat format;
+	CopyDataCompression compression;
+
+	FindDataFormatAndCompression(tableType, NULL, options, &format, &compression);
+
+	bool		includeHeader = true;
+	List	   *copyOptions = InternalCSVOptions(includeHeader);
+	char	   *csvPath = GenerateTempFileName("lake_table_insert_buffer", true);
+	DestReceiver *csvDest = CreateCSVDestReceiver(csvPath, copyOptions, format);
+
+	PushActiveSnapshot(snapshot);
+
+	bool		deleteRows = false;
+	int64		rowCount = ReadInsertBuffer(rel, deleteRows, csvDest);
+
+	PopActiveSnapshot();
+
+	if (rowCount == 0)
+	{
+		table_close(rel, NoLock);
+		return NULL;
+	}
+
+	csvDest->rShutdown(csvDest);
+
+	int			maxLineSize = GetCSVDestReceiverMaxLineSize(csvDest);
+	char	   *dataFilePath = GenerateTempFileName("lake_table_insert_buffer", true);
+
+	ConvertCSVFileTo(csvPath,
+					 RelationGetDescr(rel),
+					 maxLineSize,
+					 dataFilePath,
+					 format,
+					 compression,
+					 options,
+					 GetDataFileSchemaForTable(relationId));
+
+	PgLakeFileScan *fileScan = palloc0(sizeof(PgLakeFileScan));
+
+	fileScan->path = dataFilePath;
+	fileScan->rowCount = rowCount;
+
+	table_close(rel, NoLock);
+
+	return fileScan;
+}
+
+
+/*
+ * ReadInsertBuffer sends the buffered rows of a table to the given
+ * DestReceiver and returns the number of rows. The DestReceiver is only
+ * started if there are rows.
+ *
+ * If deleteRows is true, the rows are deleted from the buffer and read
+ * using a new snapshot. Otherwise, the rows are read using the active
+ * snapshot.
+ */
+static int64
+ReadInsertBuffer(Relation rel, bool deleteRows, DestReceiver *dest)
+{
+	Oid			relationId = RelationGetRelid(rel);
+	TupleDesc	tupleDesc = RelationGetDescr(rel);
+	Oid			rowTypeId = rel->rd_rel->reltype;
+	int64		rowCount = 0;
+
+	char	   *query = deleteRows ?
+		"delete from " INSERT_BUFFER_TABLE_QUALIFIED " "
+		"where table_name operator(pg_catalog.=) $1 "
+		"returning row_data" :
+		"select row_data "
+		"from " INSERT_BUFFER_TABLE_QUALIFIED " "
+		"where table_name operator(pg_catalog.=) $1";
+
+	FmgrInfo	recordRecvFunction;
+
+	fmgr_info(F_RECORD_RECV, &recordRecvFunction);
+
+	TupleTableSlot *slot = MakeSingleTupleTableSlot(tupleDesc, &TTSOpsHeapTuple);
+	MemoryContext callerContext = CurrentMemoryContext;
+	MemoryContext rowContext = AllocSetContextCreate(CurrentMemoryContext,
+													 "pg_lake insert buffer row",
+													 ALLOCSET_DEFAULT_SIZES);
+
+	DECLARE_SPI_ARGS(1);
+	SPI_ARG_VALUE(1, OIDOID, relationId, false);
+
+	SPI_START_EXTENSION_OWNER(PgLakeTable);
+
+	bool		readOnly = !deleteRows;
+	Portal		cursor = SPI_cursor_open_with_args(NULL, query, spiArgCount,
+												   spiArgTypes, spiArgValues,
+												   spiArgNulls, readOnly, 0);
+
+	while (true)
+	{
+		SPI_cursor_fetch(cursor, true, INSERT_BUFFER_FETCH_SIZE);
+
+		if (SPI_processed == 0)
+			break;
+
+		for (uint64 rowIndex = 0; rowIndex < SPI_processed; rowIndex++)
+		{
+			MemoryContext spiContext = MemoryContextSwitchTo(rowContext);
+
+			bool		isNull = false;
+			bytea	   *rowBytes = GET_SPI_VALUE(BYTEAOID, rowIndex, 1, &isNull);
+			StringInfoData rowBuffer;
+
+			initStringInfo(&rowBuffer);
+			appendBinaryStringInfo(&rowBuffer, VARDATA(rowBytes),
+								   VARSIZE(rowBytes) - VARHDRSZ);
+
+			/* parse the row into a tuple of the table's row type */
+			Datum		rowDatum = ReceiveFunctionCall(&recordRecvFunction, &rowBuffer,
+													   rowTypeId, -1);
+			HeapTupleHeader rowHeader = DatumGetHeapTupleHeader(rowDatum);
+			HeapTupleData tuple;
+
+			tuple.t_len = HeapTupleHeaderGetDatumLength(rowHeader);
+			ItemPointerSetInvalid(&tuple.t_self);
+			tuple.t_tableOid = InvalidOid;
+			tuple.t_data = rowHeader;
+
+			ExecStoreHeapTuple(&tuple, slot, false);
+
+			/* the DestReceiver may allocate memory that outlives the row */
+			MemoryContextSwitchTo(callerContext);
+
+			if (rowCount == 0)
+				dest->rStartup(dest, CMD_INSERT, tupleDesc);
+
+			dest->receiveSlot(slot, dest);
+			rowCount++;
+
+			ExecClearTuple(slot);
+			MemoryContextReset(rowContext);
+			MemoryContextSwitchTo(spiContext);
+		}
+
+		SPI_freetuptable(SPI_tuptable);
+	}
+
+	SPI_cursor_close(cursor);
+
+	SPI_END();
+
+	ExecDropSingleTupleTableSlot(slot);
+	MemoryContextDelete(rowContext);
+
+	return rowCount;
+}
@@ -28,6 +28,7 @@
 #include "pg_lake/fdw/multi_data_file_dest.h"
 #include "pg_lake/fdw/writable_table.h"
 #include "pg_lake/fdw/schema_operations/register_field_ids.h"
+#include "pg_lake/pgduck/copy_in.h"
 #include "pg_lake/pgduck/remote_storage.h"
 #include "pg_lake/pgduck/write_data.h"
 #include "pg_lake/storage/local_storage.h"
@@ -41,6 +42,29 @@
 /* pg_lake_table.max_write_temp_file_size_mb setting */
 int			MaxWriteTempFileSizeMB = DEFAULT_MAX_WRITE_TEMP_FILE_SIZE_MB;
 
+/* pg_lake_table.enable_streaming_writes setting */
+bool		EnableStreamingWrites = true;
+
+/* pg_lake_table.max_background_write_flushes setting */
+int			MaxBackgroundWriteFlushes = DEFAULT_MAX_BACKGROUND_WRITE_FLUSHES;
+
+
+/*
+ * PendingFlush is a file (or stream) whose conversion to data files was
+ * started, but not yet completed.
+ */
+typedef struct PendingFlush
+{
+	/* memory context that holds the temp file and stream */
+	MemoryContext context;
+
+	/* conversion that is in progress */
+	PendingInsertion *insertion;
+
+	/* stream of rows to release after the conversion, or NULL */
+	PGDuckCopyIn *copyIn;
+}			PendingFlush;
+
 
 /*
  * MultiDataFileUploadDestReceiver is a DestReceiver that writes the tuples
@@ -50,6 +74,14 @@ int			MaxWriteTempFileSizeMB = DEFAULT_MAX_WRITE_TEMP_FILE_SIZE_MB;
  * is converted to a data file and a new one is started. Data files are
  * stored in S3 and can therefore be removed from the local machine once
  * written.
+ *
+ * When streaming is enabled, the internal DestReceiver sends the CSV rows
+ * directly to pgduck_server instead of writing a local file, and the size
+ * threshold applies to the amount of data sent.
+ *
+ * The conversion of a full file happens in the background, such that the
+ * next file fills up while pgduck_server converts and uploads the previous
+ * one. At most maxPendingFlushes conversions are in progress at a time.
  */
 typedef struct MultiDataFileUploadDestReceiver
 {
@@ -59,9 +91,15 @@ typedef struct MultiDataFileUploadDestReceiver
 	/* function pointers for the active CSV DestReceiver */
 	DestReceiver *currentDest;
 
-	/* current CSV file */
+	/* current CSV file, or NULL when streaming */
 	char	   *currentFilePath;
 
+	/* current stream of rows to pgduck_server, or NULL when using a file */
+	PGDuckCopyIn *currentCopyIn;
+
+	/* whether to stream rows to pgduck_server instead of using a file */
+	bool		useStreaming;
+
 	/* current number of rows in the CSV file */
 	int64		currentRowCount;
 
@@ -75,9 +113,18 @@ typedef struct MultiDataFileUploadDestReceiver
 	/* memory context for the DestReceiver */
 	MemoryContext parentContext;
 
-	/* memory context for the child DestReceiver */
+	/* memory context for the child DestReceivers */
 	MemoryContext childContext;
 
+	/* memory context for the current child DestReceiver */
+	MemoryContext currentContext;
+
+	/* flushes whose conversion is in progress, oldest first */
+	List	   *pendingFlushes;
+
+	/* maximum length of pendingFlushes */
+	int			maxPendingFlushes;
+
 	/* target format of the DestReceiver */
 	CopyDataFormat targetFormat;
 
@@ -105,7 +152,9 @@ typedef struct MultiDataFileUploadDestReceiver
 
 
 static void CreateChildDestReceiver(MultiDataFileUploadDestReceiver * self);
+static bool HasNonDroppedColumns(TupleDesc tupleDesc);
 static void FlushChildDestReceiver(MultiDataFileUploadDestReceiver * self);
+static void FinishOldestPendingFlush(MultiDataFileUploadDestReceiver * self);
 static void StartDestReceiver(DestReceiver *self, int operation, TupleDesc typeinfo);
 static bool ReceiveSlot(TupleTableSlot *slot, DestReceiver *self);
 static void ShutdownDestReceiver(DestReceiver *self);
@@ -117,7 +166,7 @@ static void DestroyDestReceiver(DestReceiver *self);
  * size limit. In other words, the splitting is based on the file size.
  *
  * When rowIdStart is 0, rowId assignment is automatically handled by the
- * DestReceiver (specifically PrepareCSVInsertion()).  This is the common case
+ * DestReceiver (specifically FinishInsertion()).  This is the common case
  * for inserts or imports of data files into a table.  This will ensure that
  * the rowmap records are properly sync'd with the file ids that are generated
  * at the time, and will be handled automatically.
@@ -138,13 +187,21 @@ static void DestroyDestReceiver(DestReceiver *self);
  *
  * StartReservingRowIdRange() and FinishReservingRowIdRange() should likely be
  * used for any future callers as well.
+ *
+ * When allowPipelining is true, rows may be streamed to pgduck_server rather
+ * than staged in a local file (pg_lake_table.enable_streaming_writes), and
+ * full files are converted in the background while the next one fills up
+ * (pg_lake_table.max_background_write_flushes). Both hold pgduck_server
+ * connections across calls, so callers that create many DestReceivers at
+ * once (e.g. one per partition) should not allow it.
  */
 DestReceiver *
 CreateMultiDataFileDestReceiver(Oid relationId,
 								CopyDataFormat targetFormat,
 								int MaxWriteTempFileSizeMB,
 								int32 partitionSpecId,
-								int64 rowIdStart)
+								int64 rowIdStart,
+								bool allowPipelining)
 {
 	MultiDataFileUploadDestReceiver *self =
 		(MultiDataFileUploadDestReceiver *) palloc0(sizeof(MultiDataFileUploadDestReceiver));
@@ -165,6 +222,8 @@ CreateMultiDataFileDestReceiver(Oid relationId,
 											   ALLOCSET_DEFAULT_INITSIZE,
 											   ALLOCSET_DEFAULT_MAXSIZE);
 	self->currentRowIdStart = rowIdStart;
+	self->useStreaming = allowPipelining && EnableStreamingWrites;
+	self->maxPendingFlushes = allowPipelining ? MaxBackgroundWriteFlushes : 0;
 
 	/* cache the schema field */
 	self->schema = GetDataFileSchemaForTable(relationId);
@@ -180,18 +239,43 @@ CreateMultiDataFileDestReceiver(Oid relationId,
 static void
 CreateChildDestReceiver(MultiDataFileUploadDestReceiver * self)
 {
-	/* use the same memory context that was used to create the DestReceiver */
-	MemoryContext oldContext = MemoryContextSwitchTo(self->childContext);
+	/*
+	 * Use a separate memory context for each file, since the file may be
+	 * converted in the background after we start the next one.
+	 */
+	self->currentContext = AllocSetContextCreate(self->childContext,
+												 "MultiDataFileUploadDestReceiver file",
+												 ALLOCSET_DEFAULT_SIZES);
 
-	/* we currently use CSV as a universal intermediate format */
-	bool		includeHeader = true;
-	List	   *copyOptions = InternalCSVOptions(includeHeader);
-	char	   *tempFilePath = GenerateTempFileName("lake_table_insert", true);
+	MemoryContext oldContext = MemoryContextSwitchTo(self->currentContext);
 
 	self->currentRowCount = 0;
-	self->currentFilePath = tempFilePath;
-	self->currentDest = CreateCSVDestReceiver(tempFilePath, copyOptions,
-											  self->targetFormat);
+
+	/* we currently use CSV as a universal intermediate format */
+	if (self->useStreaming)
+	{
+		/* pgduck_server does not expect a header when receiving rows */
+		bool		includeHeader = false;
+		List	   *copyOptions = InternalCSVOptions(includeHeader);
+
+		self->currentFilePath = NULL;
+		self->currentCopyIn = StartPGDuckCopyIn(self->tupleDesc);
+		self->currentDest = CreateCSVDestReceiverForCallback(SendPGDuckCopyInData,
+															 self->currentCopyIn,
+															 copyOptions,
+															 self->targetFormat);
+	}
+	else
+	{
+		bool		includeHeader = true;
+		List	   *copyOptions = InternalCSVOptions(includeHeader);
+		char	   *tempFilePath = GenerateTempFileName("lake_table_insert", true);
+
+		self->currentFilePath = tempFilePath;
+		self->currentCopyIn = NULL;
+		self->currentDest = CreateCSVDestReceiver(tempFilePath, copyOptions,
+												  self->targetFormat);
+	}
 
 	self->currentDest->rStartup(self->currentDest, self->operation, self->tupleDesc);
 
@@ -200,24 +284,98 @@ CreateChildDestReceiver(MultiDataFileUploadDestReceiver * self)
 
 
 /*
- * FlushChildDestReceiver finalizes the write file and converts it to
- * one or more data files.
+ * FlushChildDestReceiver finalizes the write file and starts converting it to
+ * one or more data files. If we are not allowed to have pending flushes, it
+ * waits for the conversion to complete.
  */
 static void
 FlushChildDestReceiver(MultiDataFileUploadDestReceiver * self)
 {
 	self->currentDest->rShutdown(self->currentDest);
 
+	/* make room for the new pending flush */
+	while (self->pendingFlushes != NIL &&
+		   list_length(self->pendingFlushes) >= self->maxPendingFlushes)
+		FinishOldestPendingFlush(self);
+
+	/* start conversion in the memory context of the file */
+	MemoryContext oldContext = MemoryContextSwitchTo(self->currentContext);
+
+	PendingFlush *flush = palloc0(sizeof(PendingFlush));
+
+	flush->context = self->currentContext;
+	flush->copyIn = self->currentCopyIn;
+
+	if (self->currentCopyIn != NULL)
+	{
+		int64		receivedRowCount = FinishPGDuckCopyIn(self->currentCopyIn);
+
+		if (receivedRowCount != self->currentRowCount)
+			ereport(ERROR, (errmsg("query engine received " INT64_FORMAT " rows, "
+								   "expected " INT64_FORMAT,
+								   receivedRowCount, self->currentRowCount)));
+
+		flush->insertion =
+			StartCopyInInsertion(self->relationId,
+								 self->currentCopyIn,
+								 self->currentRowCount,
+								 self->currentRowIdStart,
+								 self->schema);
+	}
+	else
+	{
+		flush->insertion =
+			StartCSVInsertion(self->relationId,
+							  self->currentFilePath,
+							  self->currentRowCount,
+							  self->currentRowIdStart,
+							  GetCSVDestReceiverMaxLineSize(self->currentDest),
+							  self->schema);
+	}
+
+	/*
+	 * If caller of dest receiver is assigning rowids itself,
+	 * currentRowIdStart will be > 0, otherwise 0 if totally managed.
+	 *
+	 * When initially assigned by the caller, we need to increase the value
+	 * ourselves here to match the underlying row counts for the files
+	 * generated by the conversion. Files are not split in that case.
+	 */
+	if (self->currentRowIdStart > 0)
+		self->currentRowIdStart += self->currentRowCount;
+
+	self->currentDest->rDestroy(self->currentDest);
+	self->currentDest = NULL;
+	self->currentCopyIn = NULL;
+	self->currentContext = NULL;
+
+	MemoryContextSwitchTo(self->parentContext);
+	self->pendingFlushes = lappend(self->pendingFlushes, flush);
+	MemoryContextSwitchTo(oldContext);
+
+	if (self->maxPendingFlushes == 0)
+		FinishOldestPendingFlush(self);
+}
+
+
+/*
+ * FinishOldestPendingFlush waits for the conversion of the oldest pending
+ * flush to complete and adds the new data files to the modifications.
+ */
+static void
+FinishOldestPendingFlush(MultiDataFileUploadDestReceiver * self)
+{
+	PendingFlush *flush = linitial(self->pendingFlushes);
+
+	self->pendingFlushes = list_delete_first(self->pendingFlushes);
+
 	/* do conversion in a memory context that is about to be destroyed */
-	MemoryContext oldContext = MemoryContextSwitchTo(self->childContext);
+	MemoryContext oldContext = MemoryContextSwitchTo(flush->context);
 
-	List	   *insertModifications =
-		PrepareCSVInsertion(self->relationId,
-							self->currentFilePath,
-							self->currentRowCount,
-							self->currentRowIdStart,
-							GetCSVDestReceiverMaxLineSize(self->currentDest),
-							self->schema);
+	List	   *insertModifications = FinishInsertion(flush->insertion);
+
+	if (flush->copyIn != NULL)
+		EndPGDuckCopyIn(flush->copyIn);
 
 	/* make sure we preserve the list of data file modifications */
 	MemoryContextSwitchTo(self->parentContext);
@@ -234,22 +392,7 @@ FlushChildDestReceiver(MultiDataFileUploadDestReceiver * self)
 
 		copyModification->partitionSpecId = self->currentPartitionSpecId;
 		copyModification->partition = modification->partition;
-
-		/*
-		 * If caller of dest receiver is assigning rowids itself,
-		 * currentRowIdStart will be > 0, otherwise 0 if totally managed.
-		 *
-		 * When initially assigned by the caller, we need to increase the
-		 * value ourselves here to match the underlying row counts for the
-		 * files generated by PrepareCSVInsertion().
-		 */
-		if (self->currentRowIdStart > 0)
-		{
-			copyModification->reservedRowIdStart = self->currentRowIdStart;
-
-			/* increment currentRowIdStart by number of rows */
-			self->currentRowIdStart += modification->insertedRowCount;
-		}
+		copyModification->reservedRowIdStart = modification->reservedRowIdStart;
 
 		/* add a data mapping for each file  */
 		self->modifications = lappend(self->modifications, copyModification);
@@ -257,11 +400,8 @@ FlushChildDestReceiver(MultiDataFileUploadDestReceiver * self)
 
 	MemoryContextSwitchTo(oldContext);
 
-	self->currentDest->rDestroy(self->currentDest);
-	self->currentDest = NULL;
-
-	/* release all memory allocated for child DestReceiver, and the temp file */
-	MemoryContextReset(self->childContext);
+	/* release all memory allocated for the child DestReceiver, and the temp file */
+	MemoryContextDelete(flush->context);
 }
 
 
@@ -276,10 +416,31 @@ StartDestReceiver(DestReceiver *dest, int operation, TupleDesc tupleDesc)
 	self->operation = operation;
 	self->tupleDesc = tupleDesc;
 
+	/* without columns, we rely on read_csv to infer the rows from the file */
+	if (!HasNonDroppedColumns(tupleDesc))
+		self->useStreaming = false;
+
 	CreateChildDestReceiver(self);
 }
 
 
+/*
+ * HasNonDroppedColumns returns whether the tuple descriptor has at least one
+ * column that is not dropped.
+ */
+static bool
+HasNonDroppedColumns(TupleDesc tupleDesc)
+{
+	for (int attnum = 1; attnum <= tupleDesc->natts; attnum++)
+	{
+		if (!TupleDescAttr(tupleDesc, attnum - 1)->attisdropped)
+			return true;
+	}
+
+	return false;
+}
+
+
 /*
  * ReceiveSlot is called when a slot is received. We pass it on to the child
  * DestReceiver, and rotate to a new file if the file size exceeds the threshold.
@@ -305,7 +466,8 @@ ReceiveSlot(TupleTableSlot *slot, DestReceiver *dest)
 
 /*
  * ShutdownDestReceiver is called at the end of a write. We finalize the last
- * write file and convert it to one or more data files.
+ * write file, convert it to one or more data files, and wait for all pending
+ * conversions.
  */
 static void
 ShutdownDestReceiver(DestReceiver *dest)
@@ -314,6 +476,9 @@ ShutdownDestReceiver(DestReceiver *dest)
 
 	if (self->currentDest != NULL)
 		FlushChildDestReceiver(self);
+
+	while (self->pendingFlushes != NIL)
+		FinishOldestPendingFlush(self);
 }
 
 
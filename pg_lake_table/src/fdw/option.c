@@ -536,6 +536,7 @@ InitPgLakeIcebergOptions(void)
 		{"location", ForeignTableRelationId},
 
 		{"autovacuum_enabled", ForeignTableRelationId},
+		{"insert_buffer", ForeignTableRelationId},
 		{"column_stats_mode", ForeignTableRelationId},
 		{"row_ids", ForeignTableRelationId},
 		{"partition_by", ForeignTableRelationId},
@@ -713,6 +714,11 @@ pg_lake_iceberg_validator(PG_FUNCTION_ARGS)
 			/* only accept boolean */
 			(void) defGetBoolean(def);
 		}
+		else if (catalog == ForeignTableRelationId && strcmp(def->defname, "insert_buffer") == 0)
+		{
+			/* only accept boolean */
+			(void) defGetBoolean(def);
+		}
 		else if (catalog == ForeignTableRelationId && strcmp(def->defname, "catalog") == 0)
 		{
 			char	   *icebergCatalogName = defGetString(def);
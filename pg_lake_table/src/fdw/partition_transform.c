@@ -58,6 +58,8 @@ static void *ApplyHourTransformToColumn(IcebergPartitionTransform * transform,
 										size_t *valueSize);
 static IcebergPartitionTransform * GetPartitionTransformFromSpecField(Oid relationId,
 																	  IcebergPartitionSpecField * specField);
+static bool TryParseTransformName(const char *name, IcebergPartitionTransformType * type,
+								  size_t *bucketCount, size_t *truncateLen);
 static void ParseTransformName(const char *name, IcebergPartitionTransformType * type,
 							   size_t *bucketCount, size_t *truncateLen);
 static bool ParseBracketUintSize(const char *name, const char *prefix, size_t *outVal);
@@ -278,6 +280,47 @@ GetPartitionTransformFromSpecField(Oid relationId, IcebergPartitionSpecField * s
 }
 
 
+/*
+* GetPartitionTransformForColumn returns the partition transform for the given
+* spec field, applied to the given column of the relation.
+*
+* Unlike GetPartitionTransformFromSpecField, it does not require the field of
+* the column to be registered in the catalog, such that it can be used for
+* external Iceberg tables. The source field is therefore not set. Returns
+* NULL for unknown and void transforms.
+*/
+IcebergPartitionTransform *
+GetPartitionTransformForColumn(Oid relationId, AttrNumber attnum,
+							   IcebergPartitionSpecField * specField)
+{
+	IcebergPartitionTransform *transform = palloc0(sizeof(IcebergPartitionTransform));
+
+	if (!TryParseTransformName(specField->transform,
+							   &transform->type,
+							   &transform->bucketCount,
+							   &transform->truncateLen) ||
+		transform->type == PARTITION_TRANSFORM_VOID)
+	{
+		pfree(transform);
+		return NULL;
+	}
+
+	transform->partitionFieldId = specField->field_id;
+	transform->partitionFieldName = pstrdup(specField->name);
+	transform->transformName = pstrdup(specField->transform);
+
+	transform->attnum = attnum;
+	transform->columnName = get_attname(relationId, attnum, false);
+	transform->pgType = GetAttributePGType(relationId, attnum);
+	transform->sourceField = NULL;
+
+	/* set transform's postgres type */
+	transform->resultPgType = GetTransformResultPGType(transform);
+
+	return transform;
+}
+
+
 /*
  * ParseTransformName
  *    Reverse of GenerateTransformName().
@@ -293,12 +336,6 @@ ParseTransformName(const char *name,
 				   size_t *bucketCount,
 				   size_t *truncateLen)
 {
-	/* Defensive – clear outputs first */
-	if (bucketCount)
-		*bucketCount = 0;
-	if (truncateLen)
-		*truncateLen = 0;
-
 	/* Check for empty name */
 	if (name == NULL || *name == '\0')
 	{
@@ -306,52 +343,56 @@ ParseTransformName(const char *name,
 				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
 				 errmsg("empty partition transform name")));
 	}
-	else if (pg_strncasecmp(name, "identity", strlen("identity")) == 0)
+
+	if (!TryParseTransformName(name, type, bucketCount, truncateLen))
 	{
-		*type = PARTITION_TRANSFORM_IDENTITY;
-		return;
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("unknown partition transform \"%s\"", name)));
 	}
+}
+
+
+/*
+ * TryParseTransformName is like ParseTransformName, but returns false
+ * instead of throwing an error when the name is not a known transform.
+ */
+static bool
+TryParseTransformName(const char *name,
+					  IcebergPartitionTransformType * type,
+					  size_t *bucketCount,
+					  size_t *truncateLen)
+{
+	/* Defensive – clear outputs first */
+	if (bucketCount)
+		*bucketCount = 0;
+	if (truncateLen)
+		*truncateLen = 0;
+
+	if (name == NULL || *name == '\0')
+		return false;
+	else if (pg_strncasecmp(name, "identity", strlen("identity")) == 0)
+		*type = PARTITION_TRANSFORM_IDENTITY;
 	else if (pg_strncasecmp(name, "year", strlen("year")) == 0)
-	{
 		*type = PARTITION_TRANSFORM_YEAR;
-		return;
-	}
 	else if (pg_strncasecmp(name, "month", strlen("month")) == 0)
-	{
 		*type = PARTITION_TRANSFORM_MONTH;
-		return;
-	}
 	else if (pg_strncasecmp(name, "day", strlen("day")) == 0)
-	{
 		*type = PARTITION_TRANSFORM_DAY;
-		return;
-	}
 	else if (pg_strncasecmp(name, "hour", strlen("hour")) == 0)
-	{
 		*type = PARTITION_TRANSFORM_HOUR;
-		return;
-	}
 	else if (pg_strncasecmp(name, "void", strlen("void")) == 0)
-	{
 		*type = PARTITION_TRANSFORM_VOID;
-		return;
-	}
 	else if (pg_strncasecmp(name, "bucket[", strlen("bucket[")) == 0 &&
 			 ParseBracketUintSize(name, "bucket[", bucketCount))
-	{
 		*type = PARTITION_TRANSFORM_BUCKET;
-		return;
-	}
 	else if (pg_strncasecmp(name, "truncate[", strlen("truncate[")) == 0 &&
 			 ParseBracketUintSize(name, "truncate[", truncateLen))
-	{
 		*type = PARTITION_TRANSFORM_TRUNCATE;
-		return;
-	}
+	else
+		return false;
 
-	ereport(ERROR,
-			(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-			 errmsg("unknown partition transform \"%s\"", name)));
+	return true;
 }
 
 
@@ -266,12 +266,21 @@ PartitionedDestReceiveSlot(TupleTableSlot *slot, DestReceiver *self)
 				list_concat(myState->alreadyFlushedPartitionModifications, modifications);
 		}
 
+		/*
+		 * We do not stream rows or flush files in the background for
+		 * partitioned writes, since each of the (up to
+		 * MaxOpenFilesForPartitionedWrite) subreceivers would hold a
+		 * connection to pgduck_server.
+		 */
+		bool		allowPipelining = false;
+
 		DestReceiver *partitionReceiver =
 			CreateMultiDataFileDestReceiver(myState->relationId,
 											myState->targetFormat,
 											MaxWriteTempFileSizeMB,
 											myState->currentPartitionSpecId,
-											0);
+											0,
+											allowPipelining);
 
 		entryPtr->multiDataFileDestReceiver = partitionReceiver;
 		partitionReceiver->rStartup((DestReceiver *) entryPtr->multiDataFileDestReceiver, myState->operation, myState->tupleDesc);
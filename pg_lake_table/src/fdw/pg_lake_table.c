@@ -28,6 +28,7 @@
 #include "funcapi.h"
 
 #include <limits.h>
+#include <math.h>
 
 #include "access/htup_details.h"
 #include "access/sysattr.h"
@@ -76,7 +77,9 @@
 #include "pg_lake/csv/csv_writer.h"
 #include "pg_lake/duckdb/transform_query_to_duckdb.h"
 #include "pg_lake/fdw/deparse_ruleutils.h"
+#include "pg_lake/fdw/insert_buffer.h"
 #include "pg_lake/fdw/pg_lake_table.h"
+#include "pg_lake/fdw/relation_estimates.h"
 #include "pg_lake/fdw/shippable.h"
 #include "pg_lake/fdw/snapshot.h"
 #include "pg_lake/fdw/update_tracking.h"
@@ -93,6 +96,7 @@
 #include "pg_lake/pgduck/array_conversion.h"
 #include "pg_lake/pgduck/client.h"
 #include "pg_lake/pgduck/explain.h"
+#include "pg_lake/pgduck/result_conversion.h"
 #include "pg_lake/pgduck/rewrite_query.h"
 #include "pg_lake/pgduck/serialize.h"
 #include "pg_lake/pgduck/write_data.h"
@@ -161,6 +165,9 @@ typedef struct PgLakeScanState
 	List	   *param_exprs;	/* executable expressions for param values */
 	const char **param_values;	/* textual values of query parameters */
 
+	/* conversion state for each result column, set up on the first batch */
+	PGDuckResultColumn *resultColumns;
+
 	/* for storing result tuples */
 	HeapTuple  *tuples;			/* array of currently-retrieved tuples */
 	int			num_tuples;		/* # of tuples in array */
@@ -237,6 +244,9 @@ typedef struct PgLakeModifyState
 	DestReceiver *insertDest;
 	uint64		insertedRowCount;
 
+	/* rows of a small INSERT, if the table has an insert buffer */
+	InsertBuffer *insertBuffer;
+
 	/* slot used for position deletes */
 	TupleTableSlot *deleteSlot;
 
@@ -430,6 +440,10 @@ static void postgresGetForeignUpperPaths(PlannerInfo *root,
 /*
  * Helper functions
  */
+static void estimate_base_rel_size_from_files(PlannerInfo *root,
+											  RelOptInfo *baserel,
+											  Oid foreigntableid,
+											  PgLakeRelationInfo * fpinfo);
 static void estimate_path_cost_size(PlannerInfo *root,
 									RelOptInfo *foreignrel,
 									List *param_join_conds,
@@ -465,8 +479,11 @@ static HeapTuple make_tuple_from_result_row(PGresult *res,
 											Relation rel,
 											AttInMetadata *attinmeta,
 											List *retrieved_attrs,
+											PGDuckResultColumn * resultColumns,
 											ForeignScanState *fsstate,
 											MemoryContext temp_context);
+static PGDuckResultColumn * init_result_columns(PGresult *res, TupleDesc tupdesc,
+												List *retrieved_attrs);
 static void conversion_error_callback(void *arg);
 static bool foreign_join_ok(PlannerInfo *root, RelOptInfo *joinrel,
 							JoinType jointype, RelOptInfo *outerrel, RelOptInfo *innerrel,
@@ -497,6 +514,7 @@ static void merge_fdw_options(PgLakeRelationInfo * fpinfo,
 							  const PgLakeRelationInfo * fpinfo_i);
 
 static void WriteInsertRecord(PgLakeModifyState * modifyState, TupleTableSlot *slot);
+static void WriteInsertBufferRecords(PgLakeModifyState * modifyState);
 static void PrepareDeletionSlot(PgLakeFileModifyState * fileModifyState,
 								uint64 fileRowNumber,
 								TupleTableSlot *deleteSlot);
@@ -699,6 +717,9 @@ postgresGetForeignRelSize(PlannerInfo *root,
 
 	cost_qual_eval(&fpinfo->local_conds_cost, fpinfo->local_conds, root);
 
+	/* use the statistics of the data files, if we have them */
+	estimate_base_rel_size_from_files(root, baserel, foreigntableid, fpinfo);
+
 	/*
 	 * Set # of retrieved rows and cached relation costs to some negative
 	 * value, so that we can detect when they are set to some sensible values,
@@ -1685,6 +1706,17 @@ postgresBeginForeignScan(ForeignScanState *node, int eflags)
 	if (isUpdateDelete)
 		LockTableForUpdate(fsstate->resultRelationId);
 
+	/*
+	 * Rows in the insert buffer cannot be updated or deleted in place, so we
+	 * first move them into data files that are part of the snapshot.
+	 */
+	if (isUpdateDelete && !(eflags & EXEC_FLAG_EXPLAIN_ONLY) &&
+		IsInsertBufferEnabled(fsstate->resultRelationId))
+	{
+		FlushInsertBuffer(fsstate->resultRelationId);
+		CommandCounterIncrement();
+	}
+
 	List	   *restrictionList =
 		list_nth(fsplan->fdw_private, FdwScanPrivateRestrictions);
 
@@ -1698,6 +1730,10 @@ postgresBeginForeignScan(ForeignScanState *node, int eflags)
 		CreatePgLakeScanSnapshot(rteList, restrictionList, paramListInfo,
 								 includeChildren, fsstate->resultRelationId);
 
+	/* start downloading the files into the cache while the scan runs */
+	if (!(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+		PrefetchScanSnapshotFiles(fsstate->scanSnapshot);
+
 	/*
 	 * We do some extra bookkeeping for scans that are part of an
 	 * update/delete to interpret the row identifier (filename,
@@ -2223,6 +2259,15 @@ postgresExecForeignInsert(EState *estate,
 	if (resultRelationDesc->rd_att->constr)
 		ExecConstraints(resultRelInfo, slot, estate);
 
+	if (fmstate->insertBuffer != NULL)
+	{
+		if (AddRowToInsertBuffer(fmstate->insertBuffer, slot))
+			return slot;
+
+		/* too many rows for the insert buffer, write data files instead */
+		WriteInsertBufferRecords(fmstate);
+	}
+
 	WriteInsertRecord(fmstate, slot);
 
 	return slot;
@@ -2591,6 +2636,31 @@ WriteInsertRecord(PgLakeModifyState * modifyState, TupleTableSlot *slot)
 }
 
 
+/*
+ * WriteInsertBufferRecords writes the rows that were added to the insert
+ * buffer so far to the insert destination and stops using the insert buffer.
+ */
+static void
+WriteInsertBufferRecords(PgLakeModifyState * modifyState)
+{
+	InsertBuffer *insertBuffer = modifyState->insertBuffer;
+	TupleTableSlot *slot = MakeSingleTupleTableSlot(RelationGetDescr(modifyState->rel),
+													&TTSOpsMinimalTuple);
+
+	foreach_ptr(MinimalTupleData, row, insertBuffer->rows)
+	{
+		ExecStoreMinimalTuple(row, slot, false);
+		WriteInsertRecord(modifyState, slot);
+		ExecClearTuple(slot);
+	}
+
+	ExecDropSingleTupleTableSlot(slot);
+	MemoryContextDelete(insertBuffer->context);
+
+	modifyState->insertBuffer = NULL;
+}
+
+
 /*
  * PrepareDeletionSlot puts a deletion record for the given CTID in the
  * deleteSlot.
@@ -2766,6 +2836,10 @@ FinishForeignModify(PgLakeModifyState * fmstate)
 	ListCell   *fileModifyCell = NULL;
 	List	   *modifications = NIL;
 
+	/* rows of a small INSERT go into the insert buffer */
+	if (fmstate->insertBuffer != NULL)
+		FinishInsertBuffer(fmstate->insertBuffer);
+
 	foreach(fileModifyCell, fmstate->fileModifyStates)
 	{
 		PgLakeFileModifyState *fileModifyState = lfirst(fileModifyCell);
@@ -2996,6 +3070,57 @@ postgresExplainForeignScan(ForeignScanState *node, ExplainState *es)
 }
 
 
+/*
+ * estimate_base_rel_size_from_files sets the number of rows and pages that a
+ * scan of the base relation reads based on the statistics of its data files,
+ * or sets file_rows to -1 if the table has no file statistics.
+ */
+static void
+estimate_base_rel_size_from_files(PlannerInfo *root,
+								  RelOptInfo *baserel,
+								  Oid foreigntableid,
+								  PgLakeRelationInfo * fpinfo)
+{
+	LakeRelationEstimate estimate;
+
+	fpinfo->file_rows = -1;
+	fpinfo->file_pages = 0;
+
+	if (!EstimateLakeRelationSize(foreigntableid, baserel->baserestrictinfo,
+								  &estimate))
+		return;
+
+	/*
+	 * Files outside of the bounds of the filters are already pruned, and all
+	 * rows match in files that are fully within the bounds. Only the rows in
+	 * the remaining files are subject to the selectivity of the filters.
+	 */
+	Selectivity remote_sel = clauselist_selectivity(root,
+													fpinfo->remote_conds,
+													baserel->relid,
+													JOIN_INNER,
+													NULL);
+
+	fpinfo->file_rows = clamp_row_est(estimate.fullMatchRows +
+									  estimate.partialMatchRows * remote_sel);
+
+	/*
+	 * Data files are columnar, so we only read the columns we need. Without
+	 * per-column sizes, assume that all columns are equally large.
+	 */
+	int			total_columns = Max(baserel->max_attr, 1);
+	int			used_columns = Max(bms_num_members(fpinfo->attrs_used), 1);
+	double		column_fraction = Min((double) used_columns / total_columns, 1.0);
+
+	fpinfo->file_pages = ceil(estimate.fileBytes * column_fraction / BLCKSZ);
+
+	/* let selectivity estimation of other clauses know the table size */
+	baserel->tuples = estimate.fullMatchRows + estimate.partialMatchRows;
+	baserel->pages = (BlockNumber) Min(ceil(estimate.fileBytes / BLCKSZ),
+									   (double) MaxBlockNumber);
+}
+
+
 /*
  * estimate_path_cost_size
  *		Get cost and size estimates for a foreign scan on given foreign relation
@@ -3025,8 +3150,18 @@ estimate_path_cost_size(PlannerInfo *root,
 	/*
 	 * We hard code the expected row count from the top-level foreign scan
 	 * node. See comments on ESTIMATED_ROW_COUNT for the reasoning.
+	 *
+	 * For scans of tables with file statistics, we know how many rows the
+	 * files contain, and joins of such scans are estimated by the planner
+	 * based on the scan estimates.
 	 */
 	double		rows = ESTIMATED_ROW_COUNT;
+
+	if (IS_SIMPLE_REL(foreignrel) && fpinfo->file_rows >= 0)
+		rows = fpinfo->file_rows;
+	else if (IS_JOIN_REL(foreignrel) && foreignrel->rows > 0)
+		rows = foreignrel->rows;
+
 	double		retrieved_rows = rows;
 	int			width = fpinfo->width;
 	int			disabled_nodes = 0;
@@ -3079,6 +3214,10 @@ estimate_path_cost_size(PlannerInfo *root,
 
 		rows = clamp_row_est(rows * local_sel);
 
+		/* Add in the cost of reading the columns we need from the files */
+		if (IS_SIMPLE_REL(foreignrel))
+			total_cost += seq_page_cost * fpinfo->file_pages;
+
 		/* Add in the eval cost of the locally-checked quals */
 		startup_cost += fpinfo->local_conds_cost.startup;
 		total_cost += fpinfo->local_conds_cost.per_tuple * retrieved_rows;
@@ -3222,9 +3361,10 @@ ec_member_matches_foreign(PlannerInfo *root, RelOptInfo *rel,
  * Sends a prepared statement to the foreign server for execution.
  *
  * This function constructs an array of query parameter values in text format and sends
- * the prepared statement to the foreign server using PQsendQueryParams. It also sets
- * the single row mode for the connection and initializes the state variables for the
- * foreign scan.
+ * the prepared statement to the foreign server using PQsendQueryParams. It requests
+ * binary results where possible and sets the chunked rows mode for the connection,
+ * such that each fetch_more_data call retrieves a batch of rows, and initializes
+ * the state variables for the foreign scan.
  */
 static void
 send_prepared_statement(ForeignScanState *node)
@@ -3268,7 +3408,7 @@ send_prepared_statement(ForeignScanState *node)
 	}
 
 	/* if sending fails, throws error */
-	SendQueryWithParams(fsstate->conn, query, numParams, values);
+	SendScanQueryWithParams(fsstate->conn, query, numParams, values);
 
 	/* Mark the cursor as created, and show no tuples have been retrieved */
 	fsstate->prepared_statement_sent = true;
@@ -3312,10 +3452,13 @@ fetch_more_data(ForeignScanState *node)
 		{
 			numrows = PQntuples(res);
 
-			/* one way of SingleRowMode to indicate we are at the end */
+			/*
+			 * in single-row and chunked mode, an empty PGRES_TUPLES_OK
+			 * result indicates we are at the end
+			 */
 			if (PQresultStatus(res) == PGRES_TUPLES_OK && numrows == 0)
 				fsstate->eof_reached = true;
-			else if (PQresultStatus(res) != PGRES_SINGLE_TUPLE)
+			else if (!IsPGDuckRowBatchResult(res))
 			{
 				ThrowIfPGDuckResultHasError(fsstate->conn, res);
 			}
@@ -3325,6 +3468,21 @@ fetch_more_data(ForeignScanState *node)
 		fsstate->num_tuples = numrows;
 		fsstate->next_tuple = 0;
 
+		/*
+		 * The result formats are the same for all batches (and rescans), so
+		 * we set up the conversion once in the scan's memory context.
+		 */
+		if (numrows > 0 && fsstate->resultColumns == NULL)
+		{
+			MemoryContext scanContext = GetMemoryChunkContext(fsstate);
+			MemoryContext batchContext = MemoryContextSwitchTo(scanContext);
+
+			fsstate->resultColumns = init_result_columns(res, fsstate->tupdesc,
+														 fsstate->retrieved_attrs);
+
+			MemoryContextSwitchTo(batchContext);
+		}
+
 		for (i = 0; i < numrows; i++)
 		{
 			Assert(IsA(node->ss.ps.plan, ForeignScan));
@@ -3334,6 +3492,7 @@ fetch_more_data(ForeignScanState *node)
 										   fsstate->rel,
 										   fsstate->attinmeta,
 										   fsstate->retrieved_attrs,
+										   fsstate->resultColumns,
 										   node,
 										   fsstate->temp_cxt);
 		}
@@ -3399,13 +3558,20 @@ create_foreign_modify(Relation rel,
 		}
 		else
 		{
+			bool		allowPipelining = true;
+
 			fmstate->insertDest =
 				CreateMultiDataFileDestReceiver(relationId,
 												foreignTableFormat,
 												MaxWriteTempFileSizeMB,
 												specId,
-												0);
+												0,
+												allowPipelining);
 		}
+
+		/* small inserts go into the insert buffer, if enabled */
+		if (operation == CMD_INSERT && IsInsertBufferEnabled(relationId))
+			fmstate->insertBuffer = CreateInsertBuffer(rel);
 	}
 
 	if (operation == CMD_UPDATE || operation == CMD_DELETE)
@@ -4419,6 +4585,7 @@ postgresExecForeignTruncate(List *relations,
 			PgLakeModifyValidityCheckHook(relationId);
 
 		RemoveAllDataFilesFromTable(relationId);
+		ClearInsertBuffer(relationId);
 	}
 }
 
@@ -5348,12 +5515,45 @@ add_foreign_final_paths(PlannerInfo *root, RelOptInfo *input_rel,
 }
 
 
+/*
+ * init_result_columns sets up the conversion of the ordinary columns in the
+ * PGresult into the types of the corresponding attributes in tupdesc.
+ */
+static PGDuckResultColumn *
+init_result_columns(PGresult *res, TupleDesc tupdesc, List *retrieved_attrs)
+{
+	PGDuckResultColumn *resultColumns =
+		palloc0(list_length(retrieved_attrs) * sizeof(PGDuckResultColumn));
+	ListCell   *lc;
+	int			j = 0;
+
+	foreach(lc, retrieved_attrs)
+	{
+		int			i = lfirst_int(lc);
+
+		/* system columns are always read as text */
+		if (i > 0)
+		{
+			Form_pg_attribute attr = TupleDescAttr(tupdesc, i - 1);
+
+			InitPGDuckResultColumn(&resultColumns[j], res, j, attr->atttypid);
+		}
+
+		j++;
+	}
+
+	return resultColumns;
+}
+
+
 /*
  * Create a tuple from the specified row of the PGresult.
  *
  * rel is the local representation of the foreign table, attinmeta is
  * conversion data for the rel's tupdesc, and retrieved_attrs is an
  * integer list of the table column numbers present in the PGresult.
+ * resultColumns holds the conversion state for binary columns, or is NULL
+ * if all columns are in text format.
  * fsstate is the ForeignScan plan node's execution state.
  * temp_context is a working context that can be reset after each tuple.
  *
@@ -5367,6 +5567,7 @@ make_tuple_from_result_row(PGresult *res,
 						   Relation rel,
 						   AttInMetadata *attinmeta,
 						   List *retrieved_attrs,
+						   PGDuckResultColumn * resultColumns,
 						   ForeignScanState *fsstate,
 						   MemoryContext temp_context)
 {
@@ -5444,11 +5645,23 @@ make_tuple_from_result_row(PGresult *res,
 			/* ordinary column */
 			Assert(i <= tupdesc->natts);
 			nulls[i - 1] = (valstr == NULL);
-			/* Apply the input function even to nulls, to support domains */
-			values[i - 1] = InputFunctionCall(&attinmeta->attinfuncs[i - 1],
-											  valstr,
-											  attinmeta->attioparams[i - 1],
-											  attinmeta->atttypmods[i - 1]);
+
+			if (resultColumns != NULL)
+			{
+				/* handles both binary and text columns */
+				values[i - 1] = PGDuckResultValueToDatum(&resultColumns[j], res, row, j,
+														 &attinmeta->attinfuncs[i - 1],
+														 attinmeta->attioparams[i - 1],
+														 attinmeta->atttypmods[i - 1]);
+			}
+			else
+			{
+				/* Apply the input function even to nulls, to support domains */
+				values[i - 1] = InputFunctionCall(&attinmeta->attinfuncs[i - 1],
+												  valstr,
+												  attinmeta->attioparams[i - 1],
+												  attinmeta->atttypmods[i - 1]);
+			}
 		}
 		else if (i == SelfItemPointerAttributeNumber)
 		{
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Size estimates of lake tables based on file statistics.
+ *
+ * The files catalog of Iceberg tables stores the exact row count, deleted
+ * row count, and size of each data file, and the column bounds of each file
+ * tell us which files can match the filters of a query. That gives the
+ * planner a far better estimate of the number of rows that a scan returns
+ * than a fixed guess, which matters most when joining lake tables with
+ * regular tables.
+ *
+ * For external Iceberg tables, we can use the record counts and file sizes
+ * in the manifests of the current snapshot. Reading those during planning
+ * costs remote requests that the scan repeats, so that is opt-in.
+ */
+#include "postgres.h"
+#include "miscadmin.h"
+
+#include "pg_lake/data_file/data_files.h"
+#include "pg_lake/fdw/data_file_pruning.h"
+#include "pg_lake/fdw/data_files_catalog.h"
+#include "pg_lake/fdw/insert_buffer.h"
+#include "pg_lake/fdw/relation_estimates.h"
+#include "pg_lake/iceberg/api/datafile.h"
+#include "pg_lake/iceberg/api/manifest.h"
+#include "pg_lake/iceberg/api/snapshot.h"
+#include "pg_lake/iceberg/catalog.h"
+#include "pg_lake/iceberg/manifest_spec.h"
+#include "pg_lake/iceberg/metadata_spec.h"
+#include "pg_lake/util/table_type.h"
+#include "pg_extension_base/pg_compat.h"
+#include "utils/snapmgr.h"
+
+
+static bool EstimateInternalTableSize(Oid relationId, List *baseRestrictInfoList,
+									  LakeRelationEstimate * estimate);
+static bool EstimateExternalIcebergTableSize(Oid relationId, List *baseRestrictInfoList,
+											 LakeRelationEstimate * estimate);
+
+/* pg_lake_table.enable_file_statistics_estimates setting */
+bool		EnableFileStatisticsEstimates = true;
+
+/* pg_lake_table.enable_external_table_estimates setting */
+bool		EnableExternalTableEstimates = false;
+
+
+/*
+ * EstimateLakeRelationSize estimates the number of rows and bytes that a scan
+ * of the given relation with the given filters reads, based on the
+ * statistics of the data files. It returns false if the relation does not
+ * have file statistics.
+ */
+bool
+EstimateLakeRelationSize(Oid relationId, List *baseRestrictInfoList,
+						 LakeRelationEstimate * estimate)
+{
+	memset(estimate, 0, sizeof(LakeRelationEstimate));
+
+	if (!EnableFileStatisticsEstimates)
+		return false;
+
+	/* pruning strips implicit coercions from the clauses */
+	List	   *restrictInfoCopy = copyObject(baseRestrictInfoList);
+
+	if (IsWritablePgLakeTable(relationId) || IsInternalIcebergTable(relationId))
+		return EstimateInternalTableSize(relationId, restrictInfoCopy, estimate);
+	else if (IsExternalIcebergTable(relationId) && EnableExternalTableEstimates)
+		return EstimateExternalIcebergTableSize(relationId, restrictInfoCopy, estimate);
+
+	return false;
+}
+
+
+/*
+ * EstimateInternalTableSize estimates the size of a scan on a table whose
+ * data files are tracked in the files catalog, including rows that are in
+ * the insert buffer.
+ */
+static bool
+EstimateInternalTableSize(Oid relationId, List *baseRestrictInfoList,
+						  LakeRelationEstimate * estimate)
+{
+	bool		dataOnly = true;
+	bool		newFilesOnly = false;
+	bool		forUpdate = false;
+	List	   *dataFiles =
+		GetTableDataFilesFromCatalog(relationId, dataOnly, newFilesOnly,
+									 forUpdate, NULL, GetTransactionSnapshot());
+
+	List	   *prunedDataFiles = dataFiles;
+	List	   *fullMatches = dataFiles;
+
+	/* without filters, all rows of all files match */
+	if (baseRestrictInfoList != NIL)
+	{
+		prunedDataFiles = PruneDataFiles(relationId, dataFiles,
+										 baseRestrictInfoList, PARTIAL_MATCH);
+		fullMatches = PruneDataFiles(relationId, prunedDataFiles,
+									 baseRestrictInfoList, FULL_MATCH);
+	}
+
+	ListCell   *fullMatchCell = list_head(fullMatches);
+
+	foreach_ptr(TableDataFile, dataFile, prunedDataFiles)
+	{
+		/* files written before we tracked row counts */
+		if (dataFile->stats.rowCount < 0)
+			return false;
+
+		double		liveRows = dataFile->stats.rowCount - dataFile->stats.deletedRowCount;
+
+		if (IsFullMatchDataFile(fullMatches, &fullMatchCell, dataFile))
+			estimate->fullMatchRows += liveRows;
+		else
+			estimate->partialMatchRows += liveRows;
+
+		estimate->fileBytes += dataFile->stats.fileSize;
+	}
+
+	/* buffered rows have no statistics, so they may or may not match */
+	estimate->partialMatchRows += CountInsertBufferRows(relationId);
+
+	return true;
+}
+
+
+/*
+ * EstimateExternalIcebergTableSize estimates the size of a scan on an
+ * external Iceberg table using the manifests of the current snapshot.
+ */
+static bool
+EstimateExternalIcebergTableSize(Oid relationId, List *baseRestrictInfoList,
+								 LakeRelationEstimate * estimate)
+{
+	char	   *metadataPath = GetIcebergMetadataLocation(relationId, false);
+	IcebergTableMetadata *metadata = ReadIcebergTableMetadata(metadataPath);
+	IcebergSnapshot *snapshot = GetCurrentSnapshot(metadata, true);
+	List	   *manifests = FetchManifestsFromSnapshot(snapshot, NULL);
+	List	   *retainedManifests = PruneManifests(relationId, metadata, manifests,
+												   baseRestrictInfoList);
+	List	   *dataFiles = NIL;
+	List	   *deleteFiles = NIL;
+
+	FetchDataAndDeleteFilesFromManifests(retainedManifests, &dataFiles, &deleteFiles);
+
+	List	   *prunedDataFiles = PruneDataFiles(relationId, dataFiles,
+												 baseRestrictInfoList, PARTIAL_MATCH);
+	List	   *fullMatches = PruneDataFiles(relationId, prunedDataFiles,
+											 baseRestrictInfoList, FULL_MATCH);
+
+	ListCell   *fullMatchCell = list_head(fullMatches);
+
+	foreach_ptr(DataFile, dataFile, prunedDataFiles)
+	{
+		if (IsFullMatchDataFile(fullMatches, &fullMatchCell, dataFile))
+			estimate->fullMatchRows += dataFile->record_count;
+		else
+			estimate->partialMatchRows += dataFile->record_count;
+
+		estimate->fileBytes += dataFile->file_size_in_bytes;
+	}
+
+	/*
+	 * Manifests do not tell us which data files the position deletes apply
+	 * to, so we take them off the rows that may match.
+	 */
+	double		deletedRows = 0;
+
+	foreach_ptr(DataFile, deleteFile, deleteFiles)
+	{
+		deletedRows += deleteFile->record_count;
+	}
+
+	estimate->partialMatchRows = Max(estimate->partialMatchRows - deletedRows, 0);
+
+	return true;
+}
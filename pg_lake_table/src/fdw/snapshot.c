@@ -27,15 +27,21 @@
 #include "pg_lake/data_file/data_files.h"
 #include "pg_lake/extensions/pg_lake_engine.h"
 #include "pg_lake/iceberg/api/datafile.h"
+#include "pg_lake/iceberg/api/manifest.h"
+#include "pg_lake/iceberg/api/snapshot.h"
 #include "pg_lake/iceberg/catalog.h"
 #include "pg_lake/iceberg/api/table_schema.h"
 #include "pg_lake/fdw/data_files_catalog.h"
+#include "pg_lake/fdw/insert_buffer.h"
 #include "pg_lake/fdw/snapshot.h"
 #include "pg_lake/fdw/writable_table.h"
+#include "pg_lake/pgduck/cache_worker.h"
+#include "pg_lake/pgduck/client.h"
 #include "pg_lake/pgduck/map.h"
 #include "pg_lake/parsetree/options.h"
 #include "pg_extension_base/pg_compat.h"
 #include "pg_lake/pgduck/remote_storage.h"
+#include "pg_lake/pgduck/type.h"
 #include "pg_lake/planner/restriction_collector.h"
 #include "pg_lake/object_store_catalog/object_store_catalog.h"
 #include "pg_lake/rest_catalog/rest_catalog.h"
@@ -46,6 +52,7 @@
 #include "foreign/foreign.h"
 #include "nodes/execnodes.h"
 #include "nodes/pg_list.h"
+#include "utils/builtins.h"
 #include "utils/snapmgr.h"
 #include "utils/timestamp.h"
 #include "utils/lsyscache.h"
@@ -65,9 +72,13 @@ static void ConvertIcebergDataFilesToFileScan(List *dataFiles, List *deleteFiles
 											  List **fileScans,
 											  List **positionDeleteFileScans);
 static void ErrorIfSchemasDoNotMatch(Oid relationId, IcebergTableMetadata * metadata);
+static void AppendPrefetchFileScans(PgLakeTableScan * tableScan, List **fileScans);
 static int	NullSafeStrcmp(const char *a, const char *b);
 static bool TypesAreCompatible(PGType pgType, PGType icebergType);
 
+/* pg_lake_table.max_prefetch_files_per_scan setting */
+int			MaxPrefetchFilesPerScan = DEFAULT_MAX_PREFETCH_FILES_PER_SCAN;
+
 /*
  * CreatePgLakeScanSnapshot generates a current snapshot for a list
  * of pg_lake relation rtes, where a snapshot is a list
@@ -223,6 +234,8 @@ CreateTableScanForRelation(Oid relationId, Snapshot snapshot, int uniqueRelation
 		if (isResultRelation)
 			fullMatches = PruneDataFiles(relationId, prunedDataFiles, baseRestrictInfoList, FULL_MATCH);
 
+		ListCell   *fullMatchCell = list_head(fullMatches);
+
 		foreach_ptr(TableDataFile, dataFile, prunedDataFiles)
 		{
 			PgLakeFileScan *fileScan = palloc0(sizeof(PgLakeFileScan));
@@ -230,7 +243,8 @@ CreateTableScanForRelation(Oid relationId, Snapshot snapshot, int uniqueRelation
 			fileScan->path = dataFile->path;
 			fileScan->rowCount = dataFile->stats.rowCount;
 			fileScan->deletedRowCount = dataFile->stats.deletedRowCount;
-			fileScan->allRowsMatch = list_member_ptr(fullMatches, dataFile);
+			fileScan->allRowsMatch = IsFullMatchDataFile(fullMatches, &fullMatchCell, dataFile);
+			fileScan->fileSize = dataFile->stats.fileSize;
 
 			fileScans = lappend(fileScans, fileScan);
 		}
@@ -241,9 +255,23 @@ CreateTableScanForRelation(Oid relationId, Snapshot snapshot, int uniqueRelation
 
 			positionDeleteScan->path = deletionFile->path;
 			positionDeleteScan->rowCount = deletionFile->stats.rowCount;
+			positionDeleteScan->fileSize = deletionFile->stats.fileSize;
 
 			positionDeleteScans = lappend(positionDeleteScans, positionDeleteScan);
 		}
+
+		/*
+		 * Rows in the insert buffer are read as an additional data file.
+		 * UPDATE/DELETE flush the buffer before taking the snapshot.
+		 */
+		if (!isResultRelation && IsInsertBufferEnabled(relationId))
+		{
+			PgLakeFileScan *insertBufferScan =
+				CreateInsertBufferFileScan(relationId, snapshot);
+
+			if (insertBufferScan != NULL)
+				fileScans = lappend(fileScans, insertBufferScan);
+		}
 	}
 	else if (IsExternalIcebergTable(relationId))
 	{
@@ -347,6 +375,78 @@ CreateTableScanForRelation(Oid relationId, Snapshot snapshot, int uniqueRelation
 	return tableScan;
 }
 
+/*
+ * PrefetchScanSnapshotFiles asks pgduck_server to download the files of the
+ * scan snapshot into the cache in the background, such that later files are
+ * already cached by the time the scan reaches them. pgduck_server only
+ * downloads files that fit in the headroom of the cache, with a bounded
+ * number of concurrent downloads, and returns without waiting for them.
+ */
+void
+PrefetchScanSnapshotFiles(PgLakeScanSnapshot * snapshot)
+{
+	/* without the cache manager, prefetched files would never be evicted */
+	if (MaxPrefetchFilesPerScan <= 0 || !EnableCacheManager || MaxCacheSizeMB <= 0)
+		return;
+
+	List	   *fileScans = NIL;
+
+	foreach_ptr(PgLakeTableScan, tableScan, snapshot->tableScans)
+		AppendPrefetchFileScans(tableScan, &fileScans);
+
+	StringInfoData urls;
+	StringInfoData fileSizes;
+	int			fileCount = 0;
+
+	initStringInfo(&urls);
+	initStringInfo(&fileSizes);
+
+	foreach_ptr(PgLakeFileScan, fileScan, fileScans)
+	{
+		/* only files from the catalog or Iceberg metadata have known sizes */
+		if (fileScan->fileSize <= 0)
+			continue;
+
+		if (fileCount > 0)
+		{
+			appendStringInfoString(&urls, ",");
+			appendStringInfoString(&fileSizes, ",");
+		}
+
+		appendStringInfoString(&urls, QuoteDuckDBLiteral(fileScan->path));
+		appendStringInfo(&fileSizes, INT64_FORMAT, fileScan->fileSize);
+
+		if (++fileCount >= MaxPrefetchFilesPerScan)
+			break;
+	}
+
+	if (fileCount == 0)
+		return;
+
+	int64		maxCacheSizeBytes = ((int64) MaxCacheSizeMB) * 1024 * 1024;
+	char	   *command = psprintf("CALL pg_lake_prefetch_files([%s], [%s], " INT64_FORMAT ")",
+								   urls.data, fileSizes.data, maxCacheSizeBytes);
+
+	ExecuteOptionalCommandInPGDuck(command);
+}
+
+
+/*
+ * AppendPrefetchFileScans appends the file scans of a table scan and its
+ * children to fileScans, in the order in which they are likely to be read.
+ * Position delete files are read before the data files they apply to.
+ */
+static void
+AppendPrefetchFileScans(PgLakeTableScan * tableScan, List **fileScans)
+{
+	*fileScans = list_concat(*fileScans, tableScan->positionDeleteScans);
+	*fileScans = list_concat(*fileScans, tableScan->fileScans);
+
+	foreach_ptr(PgLakeTableScan, childScan, tableScan->childScans)
+		AppendPrefetchFileScans(childScan, fileScans);
+}
+
+
 /*
 * NullSafeStrcmp is a helper function that compares two strings for equality,
 * treating NULL as equal to NULL.
@@ -543,7 +643,17 @@ CreateTableScanForIcebergMetadata(Oid relationId, IcebergTableMetadata * metadat
 	List	   *dataFiles = NIL;
 	List	   *deleteFiles = NIL;
 
-	FetchAllDataAndDeleteFilesFromCurrentSnapshot(metadata, &dataFiles, &deleteFiles);
+	IcebergSnapshot *snapshot = GetCurrentSnapshot(metadata, true);
+	List	   *manifests = FetchManifestsFromSnapshot(snapshot, NULL);
+
+	/*
+	 * Skip the data manifests whose partition summaries show that none of
+	 * their files can match the filters, before reading the manifests.
+	 */
+	List	   *retainedManifests = PruneManifests(relationId, metadata, manifests,
+												   baseRestrictInfoList);
+
+	FetchDataAndDeleteFilesFromManifests(retainedManifests, &dataFiles, &deleteFiles);
 
 	List	   *retainedFiles = PruneDataFiles(relationId, dataFiles, baseRestrictInfoList, PARTIAL_MATCH);
 
@@ -570,6 +680,7 @@ ConvertIcebergDataFilesToFileScan(List *dataFiles, List *deleteFiles,
 		fileScan->path = (char *) dataFile->file_path;
 		fileScan->rowCount = dataFile->record_count;
 		fileScan->deletedRowCount = 0;
+		fileScan->fileSize = dataFile->file_size_in_bytes;
 
 		*fileScans = lappend(*fileScans, fileScan);
 	}
@@ -584,6 +695,7 @@ ConvertIcebergDataFilesToFileScan(List *dataFiles, List *deleteFiles,
 		fileScan->path = (char *) dataFile->file_path;
 		fileScan->rowCount = dataFile->record_count;
 		fileScan->deletedRowCount = 0;
+		fileScan->fileSize = dataFile->file_size_in_bytes;
 
 		*positionDeleteFileScans = lappend(*positionDeleteFileScans, fileScan);
 	}
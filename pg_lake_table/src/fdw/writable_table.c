@@ -94,6 +94,10 @@ typedef struct CompactionDataFileHashEntry
 }			CompactionDataFileHashEntry;
 
 
+static PendingInsertion * StartInsertion(Oid relationId, char *insertCSV,
+										 int maximumLineSize, PGDuckCopyIn * copyIn,
+										 int64 rowCount, int64 reservedRowIdStart,
+										 DataFileSchema * schema);
 static List *ApplyInsertFile(Relation rel, char *insertFile, int64 rowCount,
 							 int64 reservedRowIdStart, int32 partitionSpecId,
 							 Partition * partition);
@@ -123,6 +127,15 @@ static List *PrepareToAddQueryResultToTable(Oid relationId,
 											bool queryHasRowId,
 											bool allowSplit,
 											bool isVerbose);
+static PendingQueryResultInsertion * StartQueryResultInsertion(Oid relationId,
+															   char *readQuery,
+															   TupleDesc queryTupleDesc,
+															   int32 partitionSpecId,
+															   Partition * partition,
+															   bool queryHasRowId,
+															   bool allowSplit,
+															   bool isVerbose);
+static List *FinishQueryResultInsertion(PendingQueryResultInsertion * insertion);
 static List *GetPossiblePositionDeleteFiles(Oid relationId, List *sourcePathList,
 											Snapshot snapshot);
 static void ApplyMetadataChanges(Oid relationId, List *metadataOperations);
@@ -213,6 +226,53 @@ List *
 PrepareCSVInsertion(Oid relationId, char *insertCSV, int64 rowCount,
 					int64 reservedRowIdStart, int maximumLineSize,
 					DataFileSchema * schema)
+{
+	PendingInsertion *insertion =
+		StartCSVInsertion(relationId, insertCSV, rowCount, reservedRowIdStart,
+						  maximumLineSize, schema);
+
+	return FinishInsertion(insertion);
+}
+
+
+/*
+ * StartCSVInsertion starts converting a given CSV file like PrepareCSVInsertion,
+ * without waiting for the conversion to complete. The caller should keep the
+ * CSV file until FinishInsertion returns.
+ */
+PendingInsertion *
+StartCSVInsertion(Oid relationId, char *insertCSV, int64 rowCount,
+				  int64 reservedRowIdStart, int maximumLineSize,
+				  DataFileSchema * schema)
+{
+	return StartInsertion(relationId, insertCSV, maximumLineSize, NULL,
+						  rowCount, reservedRowIdStart, schema);
+}
+
+
+/*
+ * StartCopyInInsertion starts converting rows that were streamed into
+ * pgduck_server like StartCSVInsertion. The stream should already be finished
+ * via FinishPGDuckCopyIn, and the caller should call EndPGDuckCopyIn after
+ * FinishInsertion.
+ */
+PendingInsertion *
+StartCopyInInsertion(Oid relationId, PGDuckCopyIn * copyIn, int64 rowCount,
+					 int64 reservedRowIdStart, DataFileSchema * schema)
+{
+	return StartInsertion(relationId, NULL, 0, copyIn,
+						  rowCount, reservedRowIdStart, schema);
+}
+
+
+/*
+ * StartInsertion implements StartCSVInsertion and StartCopyInInsertion.
+ * The rows come from insertCSV if it is not NULL, and from copyIn otherwise.
+ */
+static PendingInsertion *
+StartInsertion(Oid relationId, char *insertCSV, int maximumLineSize,
+			   PGDuckCopyIn * copyIn, int64 rowCount,
+			   int64 reservedRowIdStart, DataFileSchema * schema)
 {
 	Relation	relation = table_open(relationId, RowExclusiveLock);
 	ForeignTable *foreignTable = GetForeignTable(relationId);
@@ -258,20 +318,57 @@ PrepareCSVInsertion(Oid relationId, char *insertCSV, int64 rowCount,
 
 	InsertInProgressFileRecordExtended(dataFilePrefix, isPrefix, deferDeletion);
 
-	/* convert insert file to a new file in table format */
-	ConvertCSVFileTo(insertCSV,
-					 tupleDescriptor,
-					 maximumLineSize,
-					 dataFilePrefix,
-					 format,
-					 compression,
-					 options,
-					 schema);
+	PendingInsertion *insertion = palloc0(sizeof(PendingInsertion));
+
+	insertion->dataFilePrefix = dataFilePrefix;
+	insertion->isPrefix = isPrefix;
+	insertion->deferDeletion = deferDeletion;
+	insertion->rowCount = rowCount;
+	insertion->reservedRowIdStart = reservedRowIdStart;
+
+	/* convert inserted rows to a new file in table format */
+	if (insertCSV != NULL)
+		insertion->write = StartConvertCSVFileTo(insertCSV,
+												 tupleDescriptor,
+												 maximumLineSize,
+												 dataFilePrefix,
+												 format,
+												 compression,
+												 options,
+												 schema);
+	else
+		insertion->write = StartConvertPGDuckCopyInTo(copyIn,
+													  tupleDescriptor,
+													  dataFilePrefix,
+													  format,
+													  compression,
+													  options,
+													  schema);
+
+	table_close(relation, NoLock);
+
+	return insertion;
+}
+
+
+/*
+ * FinishInsertion waits for the conversion started by StartCSVInsertion or
+ * StartCopyInInsertion to complete.
+ *
+ * It returns a list of DataFileModifications to apply to the table metadata.
+ */
+List *
+FinishInsertion(PendingInsertion * insertion)
+{
+	char	   *dataFilePrefix = insertion->dataFilePrefix;
+	int64		rowCount = insertion->rowCount;
+
+	FinishPendingWrite(insertion->write);
 
 	/* find which files were generated by DuckDB COPY */
 	List	   *dataFiles = NIL;
 
-	if (splitFilesBySize)
+	if (insertion->isPrefix)
 	{
 		dataFiles = ListRemoteFileNames(psprintf("%s/*", dataFilePrefix));
 	}
@@ -285,7 +382,7 @@ PrepareCSVInsertion(Oid relationId, char *insertCSV, int64 rowCount,
 	 * prefix paths with full paths. At precommit hook, we delete persisted
 	 * files from in-progress
 	 */
-	if (isPrefix && deferDeletion)
+	if (insertion->isPrefix && insertion->deferDeletion)
 		ReplaceInProgressPrefixPathWithFullPaths(dataFilePrefix, dataFiles);
 
 	/* build a DataFileModification for each new data file */
@@ -309,13 +406,11 @@ PrepareCSVInsertion(Oid relationId, char *insertCSV, int64 rowCount,
 		modification->type = ADD_DATA_FILE;
 		modification->insertFile = dataFilePath;
 		modification->insertedRowCount = rowCount;
-		modification->reservedRowIdStart = reservedRowIdStart;
+		modification->reservedRowIdStart = insertion->reservedRowIdStart;
 
 		modifications = lappend(modifications, modification);
 	}
 
-	table_close(relation, NoLock);
-
 	return modifications;
 }
 
@@ -947,6 +1042,24 @@ static List *
 PrepareToAddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryTupleDesc,
 							   int32 partitionSpecId, Partition * partition,
 							   bool queryHasRowId, bool allowSplit, bool isVerbose)
+{
+	PendingQueryResultInsertion *insertion =
+		StartQueryResultInsertion(relationId, readQuery, queryTupleDesc,
+								  partitionSpecId, partition,
+								  queryHasRowId, allowSplit, isVerbose);
+
+	return FinishQueryResultInsertion(insertion);
+}
+
+
+/*
+ * StartQueryResultInsertion starts executing a query in pgduck that writes
+ * new data files for the table, without waiting for it to complete.
+ */
+static PendingQueryResultInsertion *
+StartQueryResultInsertion(Oid relationId, char *readQuery, TupleDesc queryTupleDesc,
+						  int32 partitionSpecId, Partition * partition,
+						  bool queryHasRowId, bool allowSplit, bool isVerbose)
 {
 	PgLakeTableProperties properties = GetPgLakeTableProperties(relationId);
 	List	   *options = properties.options;
@@ -982,16 +1095,44 @@ PrepareToAddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryT
 
 	InsertInProgressFileRecordExtended(newDataFilePath, isPrefix, deferDeletion);
 
+	PendingQueryResultInsertion *insertion = palloc0(sizeof(PendingQueryResultInsertion));
+
+	insertion->relationId = relationId;
+	insertion->dataFilePrefix = newDataFilePath;
+	insertion->isPrefix = isPrefix;
+	insertion->deferDeletion = deferDeletion;
+	insertion->partitionSpecId = partitionSpecId;
+	insertion->partition = partition;
+	insertion->isVerbose = isVerbose;
+
 	/* perform compaction */
-	int64		rowCount =
-		WriteQueryResultTo(readQuery,
-						   newDataFilePath,
-						   properties.format,
-						   properties.compression,
-						   options,
-						   queryHasRowId,
-						   schema,
-						   queryTupleDesc);
+	insertion->write =
+		StartWriteQueryResultTo(readQuery,
+								newDataFilePath,
+								properties.format,
+								properties.compression,
+								options,
+								queryHasRowId,
+								schema,
+								queryTupleDesc);
+
+	return insertion;
+}
+
+
+/*
+ * FinishQueryResultInsertion waits for the query started by
+ * StartQueryResultInsertion, analyzes the newly generated files, and
+ * prepares the metadata operations.
+ */
+static List *
+FinishQueryResultInsertion(PendingQueryResultInsertion * insertion)
+{
+	Oid			relationId = insertion->relationId;
+	char	   *newDataFilePath = insertion->dataFilePrefix;
+	bool		isPrefix = insertion->isPrefix;
+
+	int64		rowCount = FinishPendingWrite(insertion->write);
 
 	if (rowCount == 0)
 	{
@@ -1007,16 +1148,17 @@ PrepareToAddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryT
 	/* find which files were generated */
 	List	   *newFiles = NIL;
 	List	   *newFileOps = FindGeneratedDataFiles(relationId, newDataFilePath,
-													partitionSpecId, partition,
-													splitFilesBySize, rowCount,
-													isVerbose, &newFiles);
+													insertion->partitionSpecId,
+													insertion->partition,
+													isPrefix, rowCount,
+													insertion->isVerbose, &newFiles);
 
 	/*
 	 * when we defer deletion of in-progress files, we need to replace the
 	 * prefix paths with full paths. At precommit hook, we delete persisted
 	 * files from in-progress
 	 */
-	if (isPrefix && deferDeletion)
+	if (isPrefix && insertion->deferDeletion)
 		ReplaceInProgressPrefixPathWithFullPaths(newDataFilePath, newFiles);
 
 	return newFileOps;
@@ -1029,11 +1171,22 @@ PrepareToAddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryT
 int64
 AddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryTupleDesc)
 {
-	int64		rowsProcessed = 0;
-	ForeignTable *foreignTable = GetForeignTable(relationId);
-	List	   *options = foreignTable->options;
-	bool		hasRowIds = GetBoolOption(options, "row_ids", false);
+	PendingQueryResultInsertion *insertion =
+		StartAddQueryResultToTable(relationId, readQuery, queryTupleDesc);
 
+	return FinishAddQueryResultToTable(insertion);
+}
+
+
+/*
+ * StartAddQueryResultToTable starts adding the result of a pgduck query to
+ * the table like AddQueryResultToTable, without waiting for the query to
+ * complete. This allows the caller to feed the query (e.g. via a named pipe)
+ * before calling FinishAddQueryResultToTable.
+ */
+PendingQueryResultInsertion *
+StartAddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryTupleDesc)
+{
 	/* verbose option is only used during vacuum */
 	bool		isVerbose = false;
 
@@ -1043,8 +1196,6 @@ AddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryTupleDesc)
 	/* query result can potentially be multi-TB, always allow split */
 	bool		allowSplit = true;
 
-	List	   *metadataOperations = NIL;
-
 	/*
 	 * COPY/INSERT .. SELECT pushdown code-path is never exercised for
 	 * partitioned tables, so partition is NULL.
@@ -1061,10 +1212,28 @@ AddQueryResultToTable(Oid relationId, char *readQuery, TupleDesc queryTupleDesc)
 
 	Assert(partitionSpecId == DEFAULT_SPEC_ID);
 
-	List	   *newFileOps =
-		PrepareToAddQueryResultToTable(relationId, readQuery, queryTupleDesc,
-									   partitionSpecId, partition,
-									   queryHasRowId, allowSplit, isVerbose);
+	return StartQueryResultInsertion(relationId, readQuery, queryTupleDesc,
+									 partitionSpecId, partition,
+									 queryHasRowId, allowSplit, isVerbose);
+}
+
+
+/*
+ * FinishAddQueryResultToTable waits for the query started by
+ * StartAddQueryResultToTable and adds the new data files to the table.
+ */
+int64
+FinishAddQueryResultToTable(PendingQueryResultInsertion * insertion)
+{
+	Oid			relationId = insertion->relationId;
+	int64		rowsProcessed = 0;
+	ForeignTable *foreignTable = GetForeignTable(relationId);
+	List	   *options = foreignTable->options;
+	bool		hasRowIds = GetBoolOption(options, "row_ids", false);
+
+	List	   *metadataOperations = NIL;
+
+	List	   *newFileOps = FinishQueryResultInsertion(insertion);
 
 	metadataOperations = list_concat(metadataOperations, newFileOps);
 
@@ -1444,8 +1613,6 @@ FilterCompactionCandidates(List *dataFiles, TimestampTz compactionStartTime,
  *
  * The optional snapshot parameter can be used to get the position deletes
  * as of a specific snapshot.
- *
- * This operation could perhaps be optimized into a single SQL query.
  */
 List *
 GetPositionDeleteFilesForDataFiles(Oid relationId, List *dataFiles, Snapshot snapshot,
@@ -28,19 +28,27 @@
 #include "pg_lake/ddl/drop_table.h"
 #include "pg_lake/ddl/utility_hook.h"
 #include "pg_lake/ddl/vacuum.h"
+#include "pg_lake/duckdb/query_text_cache.h"
 #include "pg_lake/extensions/pg_lake_table.h"
 #include "pg_lake/extensions/extension_ids.h"
 #include "pg_lake/fdw/pg_lake_table.h"
 #include "pg_lake/fdw/data_file_pruning.h"
+#include "pg_lake/fdw/data_file_range_filter.h"
+#include "pg_lake/fdw/data_files_cache.h"
+#include "pg_lake/fdw/insert_buffer.h"
 #include "pg_lake/fdw/shippable.h"
+#include "pg_lake/fdw/snapshot.h"
 #include "pg_lake/fdw/writable_table.h"
 #include "pg_lake/fdw/multi_data_file_dest.h"
+#include "pg_lake/fdw/relation_estimates.h"
 #include "pg_lake/pgduck/numeric.h"
 #include "pg_lake/partitioning/partitioned_dest_receiver.h"
 #include "pg_lake/pgduck/write_data.h"
+#include "pg_lake/planner/broadcast_tables.h"
 #include "pg_lake/planner/extensible_nodes.h"
 #include "pg_lake/planner/insert_select.h"
 #include "pg_lake/planner/query_pushdown.h"
+#include "pg_lake/planner/result_cache.h"
 #include "pg_lake/util/s3_file_utils.h"
 #include "pg_lake/test/hide_lake_objects.h"
 #include "pg_lake/transaction/transaction_hooks.h"
@@ -141,6 +149,58 @@ _PG_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("pg_lake_table.enable_bulk_data_file_pruning",
+							 "Checks simple filters against the bounds of all data "
+							 "files at once during data file pruning.",
+							 NULL,
+							 &EnableBulkDataFilePruning,
+							 true,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomIntVariable("pg_lake_table.max_prefetch_files_per_scan",
+							"Maximum number of data files that a scan asks pgduck_server "
+							"to download into the cache in the background. A value of 0 "
+							"disables prefetching.",
+							NULL,
+							&MaxPrefetchFilesPerScan,
+							DEFAULT_MAX_PREFETCH_FILES_PER_SCAN,
+							0,
+							INT_MAX,
+							PGC_USERSET,
+							GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomBoolVariable("pg_lake_table.enable_file_statistics_estimates",
+							 "Enables row count and cost estimates based on the "
+							 "statistics of the data files of Iceberg tables.",
+							 NULL,
+							 &EnableFileStatisticsEstimates,
+							 true,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomBoolVariable("pg_lake_table.enable_external_table_estimates",
+							 "Enables row count and cost estimates based on the "
+							 "manifests of external Iceberg tables.",
+							 "Reading the metadata and manifests during planning "
+							 "adds remote requests to every query.",
+							 &EnableExternalTableEstimates,
+							 false,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomBoolVariable("pg_lake_table.enable_partition_pruning",
 							 "Enables partition pruning based on the partition values "
 							 "for iceberg tables.",
@@ -241,6 +301,150 @@ _PG_init(void)
 							NULL,
 							NULL);
 
+	DefineCustomBoolVariable("pg_lake_table.enable_streaming_writes",
+							 "Enables streaming inserted rows to the query engine "
+							 "instead of writing them to a temporary file first.",
+							 NULL,
+							 &EnableStreamingWrites,
+							 true,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomIntVariable("pg_lake_table.max_background_write_flushes",
+							"Determines the maximum number of write files that are "
+							"converted to data files in the background while the "
+							"next file fills up. 0 converts files synchronously.",
+							NULL,
+							&MaxBackgroundWriteFlushes,
+							DEFAULT_MAX_BACKGROUND_WRITE_FLUSHES,
+							0,
+							64,
+							PGC_USERSET,
+							GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("pg_lake_table.data_file_cache_size",
+							"Determines the maximum amount of memory per backend "
+							"used to cache the column stats and partition values "
+							"of data files. 0 disables the cache.",
+							NULL,
+							&DataFileCacheSizeKB,
+							DEFAULT_DATA_FILE_CACHE_SIZE_KB,
+							0,
+							INT_MAX / 1024,
+							PGC_USERSET,
+							GUC_UNIT_KB | GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("pg_lake_table.query_text_cache_size",
+							"Determines the maximum amount of memory per backend "
+							"used to cache query texts that read the files of "
+							"the tables in a query. 0 disables the cache.",
+							NULL,
+							&QueryTextCacheSizeKB,
+							DEFAULT_QUERY_TEXT_CACHE_SIZE_KB,
+							0,
+							INT_MAX / 1024,
+							PGC_USERSET,
+							GUC_UNIT_KB | GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("pg_lake_table.result_cache_size",
+							"Size of the shared memory cache of pushed down query "
+							"results. Requires pg_lake_table in "
+							"shared_preload_libraries, 0 disables the cache.",
+							NULL,
+							&ResultCacheSizeKB,
+							DEFAULT_RESULT_CACHE_SIZE_KB,
+							0,
+							INT_MAX / 1024,
+							PGC_POSTMASTER,
+							GUC_UNIT_KB,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomBoolVariable("pg_lake_table.enable_result_cache",
+							 "Enables serving the results of repeated pushed down "
+							 "queries on Iceberg tables from the shared result cache.",
+							 NULL,
+							 &EnableResultCache,
+							 false,
+							 PGC_USERSET,
+							 GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							 NULL,
+							 NULL,
+							 NULL);
+
+	DefineCustomIntVariable("pg_lake_table.broadcast_table_size_limit",
+							"Determines the maximum size of a regular table "
+							"that is copied to pgduck to push down a query that "
+							"joins it with pg_lake tables. 0 disables copying.",
+							NULL,
+							&BroadcastTableSizeLimitKB,
+							DEFAULT_BROADCAST_TABLE_SIZE_LIMIT_KB,
+							0,
+							INT_MAX / 1024,
+							PGC_USERSET,
+							GUC_UNIT_KB | GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("pg_lake_table.insert_buffer_max_statement_rows",
+							"Determines the maximum number of rows an INSERT "
+							"statement can add to the insert buffer of a table. "
+							"Larger inserts write data files directly.",
+							NULL,
+							&InsertBufferMaxStatementRows,
+							DEFAULT_INSERT_BUFFER_MAX_STATEMENT_ROWS,
+							0,
+							INT_MAX,
+							PGC_USERSET,
+							GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("pg_lake_table.insert_buffer_flush_rows",
+							"Determines the number of buffered rows at which "
+							"the insert buffer worker writes the rows of a table "
+							"to data files.",
+							NULL,
+							&InsertBufferFlushRows,
+							DEFAULT_INSERT_BUFFER_FLUSH_ROWS,
+							1,
+							INT_MAX,
+							PGC_SIGHUP,
+							GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
+	DefineCustomIntVariable("pg_lake_table.insert_buffer_flush_interval",
+							"Determines the age of the oldest buffered row at "
+							"which the insert buffer worker writes the rows of "
+							"a table to data files.",
+							NULL,
+							&InsertBufferFlushInterval,
+							DEFAULT_INSERT_BUFFER_FLUSH_INTERVAL,
+							0,
+							INT_MAX,
+							PGC_SIGHUP,
+							GUC_UNIT_S | GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE,
+							NULL,
+							NULL,
+							NULL);
+
 	DefineCustomIntVariable("pg_lake_table.max_open_files_for_partitioned_write",
 							"Determines the maximum number of open files for "
 							"partitioned writes. If this limit is reached, currently the "
@@ -371,6 +575,9 @@ _PG_init(void)
 
 	InitializeDropTableHandler();
 	InitializeFullQueryPushdown();
+	InitializeDataFileCache();
+	InitializeQueryTextCache();
+	InitializeResultCache();
 
 	RegisterPgLakeCustomNodes();
 
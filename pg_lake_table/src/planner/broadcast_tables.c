@@ -0,0 +1,371 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Broadcasting of small heap tables into pushed down queries.
+ *
+ * Queries that join pg_lake tables with regular PostgreSQL tables can
+ * normally not be pushed down to pgduck, which means all the (filtered)
+ * rows of the pg_lake tables are pulled into PostgreSQL for the join.
+ *
+ * If the regular tables are small, we instead write their contents to a
+ * temporary Parquet file at the start of execution and replace the table
+ * in the pushed down query with a read of the file. The whole query then
+ * runs in DuckDB and only the final result comes back.
+ */
+#include "postgres.h"
+#include "miscadmin.h"
+
+#include "access/table.h"
+#include "access/tableam.h"
+#include "catalog/catalog.h"
+#include "catalog/pg_class.h"
+#include "catalog/pg_inherits.h"
+#include "catalog/pg_type.h"
+#include "nodes/nodeFuncs.h"
+#include "pg_lake/copy/copy_format.h"
+#include "pg_lake/csv/csv_options.h"
+#include "pg_lake/csv/csv_writer.h"
+#include "pg_lake/extensions/pg_lake_engine.h"
+#include "pg_lake/fdw/shippable.h"
+#include "pg_lake/pgduck/read_data.h"
+#include "pg_lake/pgduck/type.h"
+#include "pg_lake/pgduck/write_data.h"
+#include "pg_lake/planner/broadcast_tables.h"
+#include "pg_lake/planner/insert_select.h"
+#include "pg_lake/planner/restriction_collector.h"
+#include "pg_lake/storage/local_storage.h"
+#include "pg_lake/util/rel_utils.h"
+#include "pg_lake/util/string_utils.h"
+#include "storage/bufmgr.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+#include "utils/snapmgr.h"
+
+/*
+ * BroadcastTableScan represents a copy of a regular table that is read
+ * by a pushed down query.
+ */
+typedef struct BroadcastTableScan
+{
+	Oid			relationId;
+	int			uniqueRelationIdentifier;
+
+	/* read call for the copy of the table */
+	char	   *readCall;
+}			BroadcastTableScan;
+
+int			BroadcastTableSizeLimitKB = DEFAULT_BROADCAST_TABLE_SIZE_LIMIT_KB;
+
+static bool HasBroadcastTableWalker(Node *node, void *context);
+static bool RelationSuitableForBroadcast(Relation rel);
+static char *WriteBroadcastTable(Oid relationId);
+static char *EmptyBroadcastTableRead(Oid relationId);
+
+
+/*
+ * IsBroadcastableTable returns whether the given range table entry is a
+ * regular table that is small enough to be sent to pgduck as part of a
+ * pushed down query.
+ */
+bool
+IsBroadcastableTable(RangeTblEntry *rte)
+{
+	if (BroadcastTableSizeLimitKB <= 0)
+		return false;
+
+	if (rte->rtekind != RTE_RELATION || rte->tablesample != NULL)
+		return false;
+
+	if (rte->relkind != RELKIND_RELATION && rte->relkind != RELKIND_MATVIEW)
+		return false;
+
+	/* catalogs are not accessed consistently via snapshots */
+	if (IsCatalogRelationOid(rte->relid))
+		return false;
+
+	if (rte->inh && has_subclass(rte->relid))
+		return false;
+
+	Relation	rel = table_open(rte->relid, NoLock);
+	bool		suitable = RelationSuitableForBroadcast(rel);
+
+	table_close(rel, NoLock);
+
+	return suitable;
+}
+
+
+/*
+ * RelationSuitableForBroadcast returns whether all the rows and columns of
+ * the given relation can be written to a Parquet file without losing
+ * information, and whether the relation is below the size limit.
+ */
+static bool
+RelationSuitableForBroadcast(Relation rel)
+{
+	/* row level security policies depend on the user */
+	if (rel->rd_rel->relrowsecurity)
+		return false;
+
+	if (rel->rd_rel->relkind == RELKIND_MATVIEW && !RelationIsPopulated(rel))
+		return false;
+
+	if (!RelationColumnsSuitableForPushdown(rel, DATA_FORMAT_PARQUET))
+		return false;
+
+	TupleDesc	tupleDesc = RelationGetDescr(rel);
+
+	for (int columnIndex = 0; columnIndex < tupleDesc->natts; columnIndex++)
+	{
+		Form_pg_attribute column = TupleDescAttr(tupleDesc, columnIndex);
+
+		if (column->attisdropped)
+			continue;
+
+#if PG_VERSION_NUM >= 180000
+		/* virtual generated columns are not stored */
+		if (column->attgenerated == ATTRIBUTE_GENERATED_VIRTUAL)
+			return false;
+#endif
+
+		if (!is_shippable(column->atttypid, TypeRelationId, NULL))
+			return false;
+
+		/* unbounded numerics would be rounded to the default scale */
+		if (column->atttypid == NUMERICOID && column->atttypmod == -1)
+			return false;
+	}
+
+	/* large values are stored out of line, so include the TOAST table */
+	uint64		blockCount = RelationGetNumberOfBlocks(rel);
+
+	if (OidIsValid(rel->rd_rel->reltoastrelid))
+	{
+		Relation	toastRel = table_open(rel->rd_rel->reltoastrelid, AccessShareLock);
+
+		blockCount += RelationGetNumberOfBlocks(toastRel);
+
+		table_close(toastRel, AccessShareLock);
+	}
+
+	uint64		relationSize = blockCount * BLCKSZ;
+
+	return relationSize <= (uint64) BroadcastTableSizeLimitKB * 1024;
+}
+
+
+/*
+ * HasBroadcastTable returns whether the given query tree contains a regular
+ * table, which can only be pushed down by broadcasting it.
+ */
+bool
+HasBroadcastTable(Node *node)
+{
+	return HasBroadcastTableWalker(node, NULL);
+}
+
+
+/*
+ * HasBroadcastTableWalker is the walker for HasBroadcastTable.
+ */
+static bool
+HasBroadcastTableWalker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Query))
+	{
+		return query_tree_walker((Query *) node,
+								 HasBroadcastTableWalker,
+								 context,
+								 QTW_EXAMINE_RTES_BEFORE);
+	}
+	else if (IsA(node, RangeTblEntry))
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) node;
+
+		if (rte->rtekind == RTE_RELATION && !IsAnyLakeForeignTable(rte))
+			return true;
+
+		/* query_tree_walker descends into RTEs */
+		return false;
+	}
+
+	return expression_tree_walker(node, HasBroadcastTableWalker, context);
+}
+
+
+/*
+ * CreateBroadcastTableScans writes the contents of the regular tables in
+ * the given list of range table entries to temporary files and returns a
+ * list of BroadcastTableScan. If explainOnly is set, we skip writing the
+ * files and read an empty relation with the same columns instead, which is
+ * enough for pgduck to plan the query.
+ */
+List *
+CreateBroadcastTableScans(List *rteList, bool explainOnly)
+{
+	List	   *broadcastScans = NIL;
+
+	foreach_ptr(RangeTblEntry, rte, rteList)
+	{
+		BroadcastTableScan *broadcastScan = palloc0(sizeof(BroadcastTableScan));
+
+		broadcastScan->relationId = rte->relid;
+		broadcastScan->uniqueRelationIdentifier = GetUniqueRelationIdentifier(rte);
+		if (explainOnly)
+			broadcastScan->readCall = EmptyBroadcastTableRead(rte->relid);
+		else
+			broadcastScan->readCall = WriteBroadcastTable(rte->relid);
+
+		broadcastScans = lappend(broadcastScans, broadcastScan);
+	}
+
+	return broadcastScans;
+}
+
+
+/*
+ * WriteBroadcastTable writes the rows of the given table that are visible
+ * to the active snapshot to a temporary Parquet file and returns a query
+ * fragment that reads the file.
+ */
+static char *
+WriteBroadcastTable(Oid relationId)
+{
+	Relation	rel = table_open(relationId, AccessShareLock);
+	TupleDesc	tupleDesc = RelationGetDescr(rel);
+
+	bool		includeHeader = true;
+	List	   *copyOptions = InternalCSVOptions(includeHeader);
+	char	   *csvPath = GenerateTempFileName("lake_table_broadcast", true);
+	DestReceiver *csvDest = CreateCSVDestReceiver(csvPath, copyOptions, DATA_FORMAT_PARQUET);
+
+	csvDest->rStartup(csvDest, CMD_SELECT, tupleDesc);
+
+	TupleTableSlot *slot = table_slot_create(rel, NULL);
+	TableScanDesc scanDesc = table_beginscan(rel, GetActiveSnapshot(), 0, NULL);
+	ReadDataStats stats = {0, 0};
+
+	while (table_scan_getnextslot(scanDesc, ForwardScanDirection, slot))
+	{
+		csvDest->receiveSlot(slot, csvDest);
+		stats.sourceRowCount++;
+
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	table_endscan(scanDesc);
+	ExecDropSingleTupleTableSlot(slot);
+
+	csvDest->rShutdown(csvDest);
+
+	char	   *parquetPath = GenerateTempFileName("lake_table_broadcast", true);
+
+	ConvertCSVFileTo(csvPath,
+					 tupleDesc,
+					 GetCSVDestReceiverMaxLineSize(csvDest),
+					 parquetPath,
+					 DATA_FORMAT_PARQUET,
+					 DATA_COMPRESSION_NONE,
+					 NIL,
+					 NULL);
+
+	char	   *readCall =
+		ReadDataSourceQuery(list_make1(parquetPath), NIL,
+							DATA_FORMAT_PARQUET, DATA_COMPRESSION_NONE,
+							tupleDesc, NIL, NULL, &stats, 0);
+
+	table_close(rel, NoLock);
+
+	return psprintf("(%s)", readCall);
+}
+
+
+/*
+ * EmptyBroadcastTableRead returns a query fragment that returns no rows, but
+ * has the same columns as the given table.
+ */
+static char *
+EmptyBroadcastTableRead(Oid relationId)
+{
+	Relation	rel = table_open(relationId, AccessShareLock);
+	TupleDesc	tupleDesc = RelationGetDescr(rel);
+	StringInfoData readCall;
+	bool		addComma = false;
+
+	initStringInfo(&readCall);
+	appendStringInfoString(&readCall, "(SELECT ");
+
+	for (int columnIndex = 0; columnIndex < tupleDesc->natts; columnIndex++)
+	{
+		Form_pg_attribute column = TupleDescAttr(tupleDesc, columnIndex);
+
+		if (column->attisdropped)
+			continue;
+
+		PGType		columnType = MakePGType(column->atttypid, column->atttypmod);
+
+		appendStringInfo(&readCall, "%sNULL::%s AS %s",
+						 addComma ? ", " : "",
+						 GetFullDuckDBTypeNameForPGType(columnType),
+						 quote_identifier(NameStr(column->attname)));
+		addComma = true;
+	}
+
+	if (!addComma)
+		appendStringInfoString(&readCall, "NULL");
+
+	appendStringInfoString(&readCall, " LIMIT 0)");
+
+	table_close(rel, NoLock);
+
+	return readCall.data;
+}
+
+
+/*
+ * ReplaceBroadcastTableCalls replaces the read_table function calls for
+ * broadcast tables with reads of their copies, or with the table name if
+ * explainRequested is set.
+ */
+char *
+ReplaceBroadcastTableCalls(char *query, List *broadcastScans,
+						   bool explainRequested)
+{
+	foreach_ptr(BroadcastTableScan, broadcastScan, broadcastScans)
+	{
+		char	   *qualifiedRelationName =
+			GetQualifiedRelationName(broadcastScan->relationId);
+
+		char	   *functionCallToReplace =
+			psprintf("%s(%s::text, %d)",
+					 PG_LAKE_READ_TABLE,
+					 quote_literal_cstr(qualifiedRelationName),
+					 broadcastScan->uniqueRelationIdentifier);
+
+		char	   *replacement = explainRequested ?
+			qualifiedRelationName : broadcastScan->readCall;
+
+		query = PgLakeReplaceText(query, functionCallToReplace, replacement);
+	}
+
+	return query;
+}
@@ -19,6 +19,7 @@
 #include "funcapi.h"
 #include "miscadmin.h"
 
+#include "access/htup_details.h"
 #include "catalog/catalog.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_operator.h"
@@ -33,6 +34,7 @@
 #include "pg_lake/fdw/deparse_ruleutils.h"
 #include "pg_lake/fdw/shippable.h"
 #include "pg_lake/iceberg/catalog.h"
+#include "pg_lake/planner/broadcast_tables.h"
 #include "pg_lake/planner/dbt.h"
 #include "pg_lake/planner/explain.h"
 #include "pg_lake/planner/pushdown_utils.h"
@@ -40,15 +42,18 @@
 #include "pg_lake/planner/insert_select.h"
 #include "pg_lake/planner/query_pushdown.h"
 #include "pg_lake/planner/restriction_collector.h"
+#include "pg_lake/planner/result_cache.h"
 #include "pg_extension_base/pg_compat.h"
 #include "pg_lake/pgduck/array_conversion.h"
 #include "pg_lake/pgduck/client.h"
 #include "pg_lake/pgduck/explain.h"
 #include "pg_lake/pgduck/map.h"
+#include "pg_lake/pgduck/result_conversion.h"
 #include "pg_lake/pgduck/rewrite_query.h"
 #include "pg_lake/pgduck/serialize.h"
 #include "pg_lake/test/hide_lake_objects.h"
 #include "pg_lake/util/rel_utils.h"
+#include "pg_lake/util/table_type.h"
 #if PG_VERSION_NUM >= 180000
 #include "commands/explain_format.h"
 #include "commands/explain_state.h"
@@ -170,13 +175,44 @@ typedef struct QueryPushdownScanState
 
 	/* connection properties */
 	PGDuckConnection *connection;
-	char	  **receivedValues;
+	Datum	   *receivedValues;
+	bool	   *receivedNulls;
+
+	/* conversion state for each result column, set up on the first batch */
+	PGDuckResultColumn *resultColumns;
+
+	/* current batch of rows received from pgduck */
+	MemoryContext batchContext;
+	HeapTuple  *batchTuples;
+	int			batchTupleCount;
+	int			nextBatchTuple;
+	bool		endOfResults;
 
 	ParamListInfo paramListInfo;
 	int			numParams;
 	const char **parameterValues;
+
+	/* key of the query in the result cache, if the result can be cached */
+	char	   *resultCacheKey;
+	size_t		resultCacheKeySize;
+
+	/* results served from the result cache */
+	char	   *cachedResults;
+	size_t		cachedResultsSize;
+	size_t		cachedResultsOffset;
+	HeapTupleData cachedTuple;
+
+	/* results received from pgduck that will be added to the result cache */
+	StringInfo	resultsToCache;
 }			QueryPushdownScanState;
 
+static bool QueryResultIsCacheable(Query *scanQuery, PgLakeScanSnapshot * snapshot);
+static bool TableScansAreIcebergTables(List *tableScans);
+static void FetchNextResultBatch(QueryPushdownScanState * scanState);
+static void AddResultBatchToCache(QueryPushdownScanState * scanState);
+static void FinishResultCaching(QueryPushdownScanState * scanState);
+static void InitResultColumns(QueryPushdownScanState * scanState, PGresult *result);
+
 
 /*
  * InitializeFullQueryPushdown sets up the global planner hook.
@@ -498,6 +534,12 @@ FullQueryIsPushdownable(Query *parse)
 		return false;
 	}
 
+	if (HasBroadcastTable((Node *) parse) && !HasLakeRTE((Node *) parse, NULL))
+	{
+		/* only broadcast tables when joining with pg_lake tables */
+		return false;
+	}
+
 	return true;
 }
 
@@ -703,8 +745,9 @@ ProcessNotShippableExpressionWalker(Node *node, IsShippableContext * context)
 			RecordNotShippableObject(context, InvalidOid, InvalidOid, NOT_SHIPPABLE_SQL_JOIN_MERGED_COLUMNS_ALIAS);
 		}
 
-		/* we only support pg_lake relations for the moment */
-		if (rte->rtekind == RTE_RELATION && !IsAnyLakeForeignTable(rte))
+		/* besides pg_lake relations, we only support small tables */
+		if (rte->rtekind == RTE_RELATION && !IsAnyLakeForeignTable(rte) &&
+			!IsBroadcastableTable(rte))
 		{
 			if (context->stopAtFirstNotShippable)
 				return true;
@@ -1391,6 +1434,10 @@ QueryPushdownBeginScan(CustomScanState *node, EState *estate, int eflags)
 	List	   *rteList =
 		ReplacePgLakeTableWithReadTableFunc((Node *) scanQuery);
 
+	/* small regular tables are written to files and read in the same way */
+	List	   *broadcastRteList =
+		ReplaceHeapTablesWithReadTableFunc((Node *) scanQuery);
+
 	/* if there are child tables, include them in the snapshot */
 	bool		includeChildren = true;
 
@@ -1398,13 +1445,21 @@ QueryPushdownBeginScan(CustomScanState *node, EState *estate, int eflags)
 		CreatePgLakeScanSnapshot(rteList, relationRestrictionsList, paramListInfo,
 								 includeChildren, InvalidOid);
 
+	bool		explainRequested = eflags & EXEC_FLAG_EXPLAIN_ONLY;
+
+	List	   *broadcastScans =
+		CreateBroadcastTableScans(broadcastRteList, explainRequested);
+
 	/*
 	 * Deparse the query and replace read_table('table_name') with the
 	 * appropriate file scan functions.
 	 */
 	char	   *pgDuckSQLTemplate = PreparePGDuckSQLTemplate(scanQuery);
 
-	bool		explainRequested = eflags & EXEC_FLAG_EXPLAIN_ONLY;
+	pgDuckSQLTemplate = ReplaceBroadcastTableCalls(pgDuckSQLTemplate,
+												   broadcastScans,
+												   explainRequested);
+
 	char	   *queryString = ReplaceReadTableFunctionCalls(pgDuckSQLTemplate,
 															snapshot,
 															explainRequested);
@@ -1412,11 +1467,14 @@ QueryPushdownBeginScan(CustomScanState *node, EState *estate, int eflags)
 	TupleDesc	tupleDesc = node->ss.ss_ScanTupleSlot->tts_tupleDescriptor;
 
 	scanState->queryString = queryString;
-	scanState->connection = GetPGDuckConnection();
 	scanState->tupleDesc = tupleDesc;
 	scanState->attributeInputMetadata = TupleDescGetAttInMetadata(tupleDesc);
 	scanState->estate = estate;
-	scanState->receivedValues = (char **) palloc0(tupleDesc->natts * sizeof(char *));
+	scanState->receivedValues = (Datum *) palloc0(tupleDesc->natts * sizeof(Datum));
+	scanState->receivedNulls = (bool *) palloc0(tupleDesc->natts * sizeof(bool));
+	scanState->batchContext = AllocSetContextCreate(estate->es_query_cxt,
+													"pushdown result batch",
+													ALLOCSET_DEFAULT_SIZES);
 	scanState->paramListInfo = paramListInfo;
 	scanState->numParams = 0;
 	scanState->parameterValues = 0;
@@ -1448,14 +1506,87 @@ QueryPushdownBeginScan(CustomScanState *node, EState *estate, int eflags)
 		}
 	}
 
+	/*
+	 * Repeated queries on tables that did not change can be answered from the
+	 * result cache without involving pgduck.
+	 */
+	if (!(eflags & EXEC_FLAG_EXPLAIN_ONLY) && scanState->insertIntoRelid == InvalidOid &&
+		broadcastScans == NIL && QueryResultIsCacheable(scanQuery, snapshot))
+	{
+		scanState->resultCacheKey = BuildResultCacheKey(scanState->queryString,
+														scanState->numParams,
+														scanState->parameterValues,
+														&scanState->resultCacheKeySize);
+
+		/* a key that leaves no room for results is never in the cache */
+		if (scanState->resultCacheKeySize < ResultCacheMaxEntrySize())
+		{
+			if (ResultCacheLookup(scanState->resultCacheKey,
+								  scanState->resultCacheKeySize,
+								  &scanState->cachedResults,
+								  &scanState->cachedResultsSize))
+				return;
+
+			scanState->resultsToCache = makeStringInfo();
+		}
+	}
+
+	/* start downloading the files into the cache while the query runs */
+	if (!explainRequested)
+		PrefetchScanSnapshotFiles(snapshot);
+
+	scanState->connection = GetPGDuckConnection();
+
 	if (!(eflags & EXEC_FLAG_EXPLAIN_ONLY) && scanState->insertIntoRelid == InvalidOid)
 	{
 		/* if sending fails, throws error */
-		SendQueryWithParams(scanState->connection,
-							scanState->queryString,
-							scanState->numParams,
-							scanState->parameterValues);
+		SendScanQueryWithParams(scanState->connection,
+								scanState->queryString,
+								scanState->numParams,
+								scanState->parameterValues);
+	}
+}
+
+
+/*
+ * QueryResultIsCacheable returns whether the result of the query is fully
+ * determined by the query text and parameters, such that it can be served
+ * from the result cache.
+ *
+ * That is only the case for Iceberg tables managed by pg_lake, whose query
+ * text lists data files that never change. Other lake tables can point to
+ * a path or a wildcard whose contents change over time.
+ */
+static bool
+QueryResultIsCacheable(Query *scanQuery, PgLakeScanSnapshot * snapshot)
+{
+	if (!IsResultCacheEnabled())
+		return false;
+
+	if (contain_volatile_functions((Node *) scanQuery))
+		return false;
+
+	return TableScansAreIcebergTables(snapshot->tableScans);
+}
+
+
+/*
+ * TableScansAreIcebergTables returns whether all the given table scans and
+ * their child scans are on Iceberg tables.
+ */
+static bool
+TableScansAreIcebergTables(List *tableScans)
+{
+	foreach_ptr(PgLakeTableScan, tableScan, tableScans)
+	{
+		if (GetPgLakeTableType(tableScan->relationId) != PG_LAKE_ICEBERG_TABLE_TYPE)
+			return false;
+
+		if (!TableScansAreIcebergTables(tableScan->childScans))
+			return false;
 	}
+
+	return true;
 }
 
 
@@ -1492,10 +1623,11 @@ QueryPushdownScanNext(CustomScanState *node)
 	TupleTableSlot *slot;
 
 	/*
-	 * We use this context while converting each row fetched from remote node
+	 * We use this context while returning each row fetched from remote node
 	 * into tuple/slot. We do this because the context is reset on every row
 	 * by Postgres so we don't need to care about the allocations in
-	 * QueryPushdownScanNextInternal().
+	 * QueryPushdownScanNextInternal(). Rows themselves are converted a batch
+	 * at a time in the batch context.
 	 */
 	ExprContext *econtext = node->ss.ps.ps_ExprContext;
 	MemoryContext oldContext =
@@ -1517,7 +1649,6 @@ QueryPushdownScanNextInternal(CustomScanState *node)
 	QueryPushdownScanState *scanState = (QueryPushdownScanState *) node;
 	TupleTableSlot *slot = node->ss.ss_ScanTupleSlot;
 	TupleDesc	tupleDesc = scanState->tupleDesc;
-	AttInMetadata *attributeInputMetadata = scanState->attributeInputMetadata;
 
 	if (scanState->insertIntoRelid != InvalidOid)
 	{
@@ -1531,78 +1662,209 @@ QueryPushdownScanNextInternal(CustomScanState *node)
 		return NULL;
 	}
 
+	if (scanState->cachedResults != NULL)
+	{
+		/* the tuple points into the cached results, which we keep */
+		if (!ReadResultCacheTuple(scanState->cachedResults,
+								  scanState->cachedResultsSize,
+								  &scanState->cachedResultsOffset,
+								  &scanState->cachedTuple))
+			return NULL;
+
+		ExecStoreHeapTuple(&scanState->cachedTuple, slot, false);
+
+		return slot;
+	}
+
+	if (scanState->nextBatchTuple >= scanState->batchTupleCount)
+	{
+		if (scanState->endOfResults)
+			return NULL;
+
+		FetchNextResultBatch(scanState);
+
+		if (scanState->nextBatchTuple >= scanState->batchTupleCount)
+			return NULL;
+	}
+
+	/*
+	 * Store the tuple in the tuple table slot. We pass shouldFree=false
+	 * because it is allocated in the batch context, which is reset when the
+	 * next batch is fetched.
+	 */
+	HeapTuple	heapTuple = scanState->batchTuples[scanState->nextBatchTuple++];
+
+	ExecStoreHeapTuple(heapTuple, slot, false);
+
+	return slot;
+}
+
+
+/*
+ * FetchNextResultBatch waits for the next batch of rows from pgduck and
+ * converts them into heap tuples in the batch context.
+ */
+static void
+FetchNextResultBatch(QueryPushdownScanState * scanState)
+{
+	TupleDesc	tupleDesc = scanState->tupleDesc;
+	AttInMetadata *attributeInputMetadata = scanState->attributeInputMetadata;
+
+	/* flush the previous batch */
+	MemoryContextReset(scanState->batchContext);
+	scanState->batchTuples = NULL;
+	scanState->batchTupleCount = 0;
+	scanState->nextBatchTuple = 0;
+
 	PGresult   *result = WaitForResult(scanState->connection);
 
 	if (result == NULL)
 	{
-		return NULL;
+		scanState->endOfResults = true;
+		FinishResultCaching(scanState);
+		return;
 	}
 
-	/* one way of SingleRowMode to indicate we are at the end */
+	/*
+	 * in single-row and chunked mode, an empty PGRES_TUPLES_OK result
+	 * indicates we are at the end
+	 */
 	if (PQresultStatus(result) == PGRES_TUPLES_OK && PQntuples(result) == 0)
 	{
 		PQclear(result);
-		return NULL;
+		scanState->endOfResults = true;
+		FinishResultCaching(scanState);
+		return;
 	}
-	else if (PQresultStatus(result) != PGRES_SINGLE_TUPLE)
+	else if (!IsPGDuckRowBatchResult(result))
 	{
 		CheckPGDuckResult(scanState->connection, result);
 	}
 
+	MemoryContext oldContext = MemoryContextSwitchTo(scanState->batchContext);
+
 	PG_TRY();
 	{
-		/* we should be in single-row mode */
-		Assert(PQntuples(result) <= 1);
-
-		int			rowIndex = 0;
+		int			rowCount = PQntuples(result);
 		int			columnCount = PQnfields(result);
 		int			expectedColumnCount = tupleDesc->natts;
-		char	  **receivedValues = scanState->receivedValues;
+		Datum	   *receivedValues = scanState->receivedValues;
+		bool	   *receivedNulls = scanState->receivedNulls;
 
 		if (columnCount != expectedColumnCount)
 		{
 			ereport(ERROR, (errmsg("unexpected number of columns returned")));
 		}
 
-		for (int columnIndex = 0; columnIndex < columnCount; columnIndex++)
+		/* result formats are the same for all batches */
+		if (scanState->resultColumns == NULL)
+			InitResultColumns(scanState, result);
+
+		PGDuckResultColumn *resultColumns = scanState->resultColumns;
+
+		scanState->batchTuples = palloc(rowCount * sizeof(HeapTuple));
+
+		for (int rowIndex = 0; rowIndex < rowCount; rowIndex++)
 		{
-			if (PQgetisnull(result, rowIndex, columnIndex))
+			for (int columnIndex = 0; columnIndex < columnCount; columnIndex++)
 			{
-				receivedValues[columnIndex] = NULL;
+				receivedNulls[columnIndex] = PQgetisnull(result, rowIndex, columnIndex);
+				receivedValues[columnIndex] =
+					PGDuckResultValueToDatum(&resultColumns[columnIndex], result,
+											 rowIndex, columnIndex,
+											 &attributeInputMetadata->attinfuncs[columnIndex],
+											 attributeInputMetadata->attioparams[columnIndex],
+											 attributeInputMetadata->atttypmods[columnIndex]);
 			}
-			else
-			{
-				char	   *value = PQgetvalue(result, rowIndex, columnIndex);
 
-				if (PQfformat(result, columnIndex) == 1)
-				{
-					ereport(ERROR, (errmsg("unexpected binary result")));
-				}
-				receivedValues[columnIndex] = value;
-			}
+			/* construct the tuple from the converted values */
+			scanState->batchTuples[rowIndex] =
+				heap_form_tuple(tupleDesc, receivedValues, receivedNulls);
 		}
 
-		/* construct the tuple from the input strings */
-		HeapTuple	heapTuple = BuildTupleFromCStrings(attributeInputMetadata,
-													   receivedValues);
-
-		/*
-		 * Store the tuple in the tuple table slot. We pass shouldFree=false
-		 * because it is allocated in per-row context (ecxt_per_tuple_memory)
-		 * and will be freed when the context is reset by Postgres.
-		 */
-		ExecStoreHeapTuple(heapTuple, slot, false);
-
-		PQclear(result);
+		scanState->batchTupleCount = rowCount;
 	}
-	PG_CATCH();
+	PG_FINALLY();
 	{
 		PQclear(result);
-		PG_RE_THROW();
 	}
 	PG_END_TRY();
 
-	return slot;
+	MemoryContextSwitchTo(oldContext);
+
+	if (scanState->resultsToCache != NULL)
+		AddResultBatchToCache(scanState);
+}
+
+
+/*
+ * AddResultBatchToCache appends the current batch of rows to the results
+ * that will be added to the result cache, or stops caching if the results
+ * become too large.
+ */
+static void
+AddResultBatchToCache(QueryPushdownScanState * scanState)
+{
+	StringInfo	results = scanState->resultsToCache;
+	size_t		maxResultsSize = ResultCacheMaxEntrySize() - scanState->resultCacheKeySize;
+
+	for (int tupleIndex = 0; tupleIndex < scanState->batchTupleCount; tupleIndex++)
+	{
+		AppendResultCacheTuple(results, scanState->batchTuples[tupleIndex]);
+
+		if ((size_t) results->len > maxResultsSize)
+		{
+			pfree(results->data);
+			pfree(results);
+			scanState->resultsToCache = NULL;
+			return;
+		}
+	}
+}
+
+
+/*
+ * FinishResultCaching adds the results to the result cache once all rows
+ * have been received.
+ */
+static void
+FinishResultCaching(QueryPushdownScanState * scanState)
+{
+	StringInfo	results = scanState->resultsToCache;
+
+	if (results == NULL)
+		return;
+
+	ResultCacheInsert(scanState->resultCacheKey, scanState->resultCacheKeySize,
+					  results->data, results->len);
+
+	pfree(results->data);
+	pfree(results);
+	scanState->resultsToCache = NULL;
+}
+
+
+/*
+ * InitResultColumns sets up the conversion of the result columns into the
+ * types of the scan tuple.
+ */
+static void
+InitResultColumns(QueryPushdownScanState * scanState, PGresult *result)
+{
+	TupleDesc	tupleDesc = scanState->tupleDesc;
+	MemoryContext oldContext = MemoryContextSwitchTo(scanState->estate->es_query_cxt);
+
+	scanState->resultColumns = palloc0(tupleDesc->natts * sizeof(PGDuckResultColumn));
+
+	for (int columnIndex = 0; columnIndex < tupleDesc->natts; columnIndex++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupleDesc, columnIndex);
+
+		InitPGDuckResultColumn(&scanState->resultColumns[columnIndex], result,
+							   columnIndex, attr->atttypid);
+	}
+
+	MemoryContextSwitchTo(oldContext);
 }
 
 
@@ -1629,7 +1891,10 @@ QueryPushdownEndScan(CustomScanState *node)
 {
 	QueryPushdownScanState *scanState = (QueryPushdownScanState *) node;
 
-	ReleasePGDuckConnection(scanState->connection);
+	/* no connection is used when serving results from the cache */
+	if (scanState->connection != NULL)
+		ReleasePGDuckConnection(scanState->connection);
+
 	scanState->connection = NULL;
 }
 
@@ -1657,6 +1922,8 @@ QueryPushdownExplainScan(CustomScanState *node, List *ancestors,
 	 */
 	List	   *rteList =
 		ReplacePgLakeTableWithReadTableFunc((Node *) scanQuery);
+	List	   *broadcastRteList =
+		ReplaceHeapTablesWithReadTableFunc((Node *) scanQuery);
 
 	/* if there are child tables, include them in the snapshot */
 	bool		includeChildren = true;
@@ -1665,6 +1932,13 @@ QueryPushdownExplainScan(CustomScanState *node, List *ancestors,
 		CreatePgLakeScanSnapshot(rteList, relationRestrictionsList, paramListInfo,
 								 includeChildren, InvalidOid);
 
+	/*
+	 * We run EXPLAIN in pgduck, which only needs the copies of the tables
+	 * when the query is also executed.
+	 */
+	bool		explainOnly = !es->analyze;
+	List	   *broadcastScans = CreateBroadcastTableScans(broadcastRteList, explainOnly);
+
 	/*
 	 * Deparse the query and replace read_table('table_name') with the
 	 * appropriate file scan functions.
@@ -1672,7 +1946,10 @@ QueryPushdownExplainScan(CustomScanState *node, List *ancestors,
 	char	   *pgDuckSQLTemplate = PreparePGDuckSQLTemplate(scanQuery);
 
 	bool		explainRequested = true;
-	char	   *queryString = ReplaceReadTableFunctionCalls(pgDuckSQLTemplate,
+	char	   *explainTemplate = ReplaceBroadcastTableCalls(pgDuckSQLTemplate,
+															 broadcastScans,
+															 explainRequested);
+	char	   *queryString = ReplaceReadTableFunctionCalls(explainTemplate,
 															snapshot,
 															explainRequested);
 
@@ -1693,7 +1970,9 @@ QueryPushdownExplainScan(CustomScanState *node, List *ancestors,
 
 		ExplainPropertyText("Vectorized SQL", queryString, es);
 	}
-	char	   *realQuery = ReplaceReadTableFunctionCalls(pgDuckSQLTemplate,
+	char	   *realTemplate = ReplaceBroadcastTableCalls(pgDuckSQLTemplate,
+														  broadcastScans, false);
+	char	   *realQuery = ReplaceReadTableFunctionCalls(realTemplate,
 														  snapshot, false);
 
 	if (scanState->insertIntoRelid != InvalidOid)
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * result_cache.c - shared memory cache of pushed down query results
+ *
+ * Dashboards tend to run the same queries many times while the underlying
+ * Iceberg tables change only occasionally. The text of a pushed down query
+ * contains the full list of data and deletion files of each table, and
+ * those files are never modified after they are written, so the result of
+ * a query is fully determined by its text and parameter values. Hence, we
+ * can share results between backends, keyed by query text and parameters,
+ * and serve repeated queries without sending them to pgduck_server.
+ *
+ * When a table is modified, its file list changes and the next query gets
+ * a different key, such that committed changes are never hidden by the
+ * cache. Results of older snapshots are evicted in least recently used
+ * order when the cache is full.
+ *
+ * Like the manifest cache, results are stored in a shared LRU cache of
+ * bounded size. The cache is only
+ * available when pg_lake_table is loaded via shared_preload_libraries, and
+ * only used when pg_lake_table.enable_result_cache is on.
+ */
+#include "postgres.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+
+#include "access/htup_details.h"
+#include "storage/ipc.h"
+
+#include "pg_lake/planner/result_cache.h"
+#include "pg_lake/util/shared_lru_cache.h"
+
+static void ResultCacheSharedMemoryRequest(void);
+static void ResultCacheSharedMemoryStartup(void);
+static void AppendAlignedBytes(StringInfo buffer, const void *data, size_t size);
+
+/* managed via pg_lake_table.result_cache_size */
+int			ResultCacheSizeKB = DEFAULT_RESULT_CACHE_SIZE_KB;
+
+/* managed via pg_lake_table.enable_result_cache */
+bool		EnableResultCache = false;
+
+static shmem_startup_hook_type PreviousSharedMemoryStartupHook = NULL;
+static shmem_request_hook_type PreviousSharedMemoryRequestHook = NULL;
+
+static SharedLRUCache * ResultCache = NULL;
+
+PG_FUNCTION_INFO_V1(result_cache_stats);
+
+
+/*
+ * InitializeResultCache sets up the shared memory hooks of the result
+ * cache, if pg_lake_table is loaded via shared_preload_libraries.
+ */
+void
+InitializeResultCache(void)
+{
+	if (!process_shared_preload_libraries_in_progress || ResultCacheSizeKB == 0)
+		return;
+
+	ResultCache = CreateSharedLRUCache("pg_lake_table result cache",
+									   ResultCacheSizeKB);
+
+	PreviousSharedMemoryStartupHook = shmem_startup_hook;
+	shmem_startup_hook = ResultCacheSharedMemoryStartup;
+
+	PreviousSharedMemoryRequestHook = shmem_request_hook;
+	shmem_request_hook = ResultCacheSharedMemoryRequest;
+}
+
+
+/*
+ * ResultCacheMaxEntrySize returns the maximum size of a cached result,
+ * including its key.
+ */
+size_t
+ResultCacheMaxEntrySize(void)
+{
+	return SharedLRUCacheMaxEntrySize(ResultCache);
+}
+
+
+/*
+ * ResultCacheSharedMemoryRequest requests shared memory for the result cache.
+ */
+static void
+ResultCacheSharedMemoryRequest(void)
+{
+	if (PreviousSharedMemoryRequestHook)
+	{
+		PreviousSharedMemoryRequestHook();
+	}
+
+	RequestAddinShmemSpace(SharedLRUCacheShmemSize(ResultCache));
+}
+
+
+/*
+ * ResultCacheSharedMemoryStartup initializes the shared memory of the result
+ * cache.
+ */
+static void
+ResultCacheSharedMemoryStartup(void)
+{
+	SharedLRUCacheShmemInit(ResultCache);
+
+	if (PreviousSharedMemoryStartupHook != NULL)
+	{
+		PreviousSharedMemoryStartupHook();
+	}
+}
+
+
+/*
+ * IsResultCacheEnabled returns whether the result cache can be used.
+ */
+bool
+IsResultCacheEnabled(void)
+{
+	return SharedLRUCacheIsReady(ResultCache) && EnableResultCache;
+}
+
+
+/*
+ * BuildResultCacheKey serializes the query string and the parameter values
+ * into a key for the result cache.
+ */
+char *
+BuildResultCacheKey(const char *queryString, int numParams,
+					const char **parameterValues, size_t *keySize)
+{
+	StringInfoData key;
+
+	initStringInfo(&key);
+	appendBinaryStringInfo(&key, queryString, strlen(queryString) + 1);
+	appendBinaryStringInfo(&key, &numParams, sizeof(int));
+
+	for (int paramIndex = 0; paramIndex < numParams; paramIndex++)
+	{
+		const char *value = parameterValues[paramIndex];
+		bool		isNull = value == NULL;
+
+		appendBinaryStringInfo(&key, &isNull, sizeof(bool));
+
+		if (!isNull)
+			appendBinaryStringInfo(&key, value, strlen(value) + 1);
+	}
+
+	*keySize = key.len;
+
+	return key.data;
+}
+
+
+/*
+ * ResultCacheLookup looks up the results of the query with the given key in
+ * the result cache. If found, it sets results to a copy of the serialized
+ * tuples in the current memory context and returns true.
+ */
+bool
+ResultCacheLookup(const char *key, size_t keySize,
+				  char **results, size_t *resultsSize)
+{
+	if (!IsResultCacheEnabled())
+		return false;
+
+	/* palloc returns MAXALIGNed memory, which the tuples rely on */
+	return SharedLRUCacheLookup(ResultCache, key, keySize, results, resultsSize);
+}
+
+
+/*
+ * ResultCacheInsert adds the serialized result tuples of the query with the
+ * given key to the result cache, evicting the least recently used results
+ * if the cache is full.
+ */
+void
+ResultCacheInsert(const char *key, size_t keySize,
+				  const char *results, size_t resultsSize)
+{
+	if (!IsResultCacheEnabled())
+		return;
+
+	SharedLRUCacheInsert(ResultCache, key, keySize, results, resultsSize);
+}
+
+
+/*
+ * AppendResultCacheTuple appends a tuple to a buffer of serialized results.
+ * The length and the tuple data are MAXALIGNed, such that tuples can be
+ * read in place by ReadResultCacheTuple.
+ */
+void
+AppendResultCacheTuple(StringInfo results, HeapTuple tuple)
+{
+	uint32		tupleLength = tuple->t_len;
+
+	AppendAlignedBytes(results, &tupleLength, sizeof(uint32));
+	AppendAlignedBytes(results, tuple->t_data, tupleLength);
+}
+
+
+/*
+ * ReadResultCacheTuple points tuple at the next tuple in a MAXALIGNed buffer
+ * of serialized results, or returns false if there are no more tuples.
+ */
+bool
+ReadResultCacheTuple(const char *results, size_t resultsSize, size_t *offset,
+					 HeapTuple tuple)
+{
+	if (*offset >= resultsSize)
+		return false;
+
+	uint32		tupleLength = 0;
+	size_t		dataOffset = *offset + MAXALIGN(sizeof(uint32));
+
+	memcpy(&tupleLength, results + *offset, sizeof(uint32));
+
+	if (dataOffset + tupleLength > resultsSize)
+		elog(ERROR, "unexpected end of cached query results");
+
+	tuple->t_len = tupleLength;
+	tuple->t_data = (HeapTupleHeader) (results + dataOffset);
+	tuple->t_tableOid = InvalidOid;
+	ItemPointerSetInvalid(&tuple->t_self);
+
+	*offset = dataOffset + MAXALIGN(tupleLength);
+
+	return true;
+}
+
+
+/*
+ * AppendAlignedBytes appends data to the buffer, followed by zero padding up
+ * to the next MAXALIGN boundary.
+ */
+static void
+AppendAlignedBytes(StringInfo buffer, const void *data, size_t size)
+{
+	appendBinaryStringInfo(buffer, data, size);
+
+	int			padding = MAXALIGN(buffer->len) - buffer->len;
+
+	if (padding > 0)
+	{
+		enlargeStringInfo(buffer, padding);
+		memset(buffer->data + buffer->len, 0, padding);
+		buffer->len += padding;
+		buffer->data[buffer->len] = '\0';
+	}
+}
+
+
+/*
+ * result_cache_stats returns the counters and the size of the shared
+ * result cache.
+ */
+Datum
+result_cache_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupleDesc;
+
+	if (get_call_result_type(fcinfo, NULL, &tupleDesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	Datum		values[6];
+	bool		nulls[6];
+
+	memset(values, 0, sizeof(values));
+	memset(nulls, 0, sizeof(nulls));
+
+	SharedLRUCacheStats stats;
+
+	SharedLRUCacheGetStats(ResultCache, &stats);
+
+	values[0] = Int64GetDatum(stats.hits);
+	values[1] = Int64GetDatum(stats.misses);
+	values[2] = Int64GetDatum(stats.evictions);
+	values[3] = Int64GetDatum(stats.entryCount);
+	values[4] = Int64GetDatum(stats.usedBytes);
+	values[5] = Int64GetDatum(stats.areaSize);
+
+	HeapTuple	tuple = heap_form_tuple(BlessTupleDesc(tupleDesc), values, nulls);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
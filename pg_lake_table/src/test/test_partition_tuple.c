@@ -124,7 +124,8 @@ get_partition_tuple(PG_FUNCTION_ARGS)
  * get_partition_summary
  *
  * This function takes a table name and returns the partition summary
- * for all current manifests of the table.
+ * for all current manifests of the table, including whether the partition
+ * fields contain nulls.
  */
 Datum
 get_partition_summary(PG_FUNCTION_ARGS)
@@ -164,8 +165,8 @@ get_partition_summary(PG_FUNCTION_ARGS)
 	InitMaterializedSRF(fcinfo, MAT_SRF_USE_EXPECTED_DESC);
 
 	/* fill result tuplestore */
-	Datum	   *values = palloc0(sizeof(Datum) * 4);
-	bool	   *nulls = palloc0(sizeof(bool) * 4);
+	Datum	   *values = palloc0(sizeof(Datum) * 5);
+	bool	   *nulls = palloc0(sizeof(bool) * 5);
 
 	ListCell   *manifestCell = NULL;
 
@@ -221,6 +222,8 @@ get_partition_summary(PG_FUNCTION_ARGS)
 				nulls[3] = true;
 			}
 
+			values[4] = BoolGetDatum(partitionSummary->contains_null);
+
 			tuplestore_putvalues(rsinfo->setResult, rsinfo->setDesc, values, nulls);
 		}
 	}
@@ -0,0 +1,74 @@
+import pytest
+from utils_pytest import *
+
+
+@pytest.mark.parametrize("full_query_pushdown", [True, False])
+def test_binary_results_match_text(
+    pg_conn, extension, s3, with_default_location, full_query_pushdown
+):
+    run_command(
+        f"""
+        CREATE TABLE test_binary_results (
+            id int,
+            b bool,
+            i2 smallint,
+            i8 bigint,
+            f4 real,
+            f8 double precision,
+            n numeric(12,3),
+            t text,
+            v varchar(20),
+            ba bytea,
+            u uuid,
+            d date,
+            ts timestamp,
+            tstz timestamptz,
+            arr int[]
+        ) USING iceberg;
+
+        INSERT INTO test_binary_results
+        SELECT s,
+               s % 2 = 0,
+               (s - 50)::smallint,
+               s * 1000000007,
+               s / 3.0,
+               s / 7.0,
+               (s - 50) * 1.125,
+               'text-' || s,
+               'varchar-' || s,
+               decode(lpad(to_hex(s), 8, '0'), 'hex'),
+               md5(s::text)::uuid,
+               '1999-12-25'::date + (s - 50),
+               '1969-07-20 20:17:40.123456'::timestamp + s * interval '1 day',
+               '2024-02-29 12:00:00+00'::timestamptz + s * interval '1 hour',
+               ARRAY[s, s + 1]
+        FROM generate_series(1,100) s;
+
+        INSERT INTO test_binary_results (id, d, ts, tstz)
+        VALUES (101, 'infinity', '-infinity', 'infinity'),
+               (102, '-infinity', 'infinity', '-infinity');
+
+        INSERT INTO test_binary_results (id) VALUES (103);
+
+        SET LOCAL pg_lake_table.enable_full_query_pushdown TO {full_query_pushdown};
+        SET LOCAL TimeZone TO 'America/New_York';
+    """,
+        pg_conn,
+    )
+
+    queries = [
+        "SELECT * FROM test_binary_results ORDER BY id",
+        "SELECT id, tstz::timestamp, d + 1, n * 2, f8 + f4 FROM test_binary_results ORDER BY id",
+        "SELECT count(*), sum(i8), avg(n), min(tstz), max(d) FROM test_binary_results",
+    ]
+
+    for query in queries:
+        run_command("SET LOCAL pg_lake_engine.enable_binary_results TO off", pg_conn)
+        text_result = run_query(query, pg_conn)
+
+        run_command("SET LOCAL pg_lake_engine.enable_binary_results TO on", pg_conn)
+        binary_result = run_query(query, pg_conn)
+
+        assert binary_result == text_result
+
+    pg_conn.rollback()
@@ -0,0 +1,96 @@
+import pytest
+from utils_pytest import *
+
+
+def is_pushed_down(query, pg_conn):
+    result = run_query(f"EXPLAIN (verbose) {query}", pg_conn)
+    return "Custom Scan (Query Pushdown)" in str(result)
+
+
+def test_broadcast_tables(s3, pg_conn, extension, with_default_location):
+    run_command(
+        """
+        CREATE SCHEMA test_broadcast_tables;
+        SET search_path TO test_broadcast_tables;
+        CREATE TABLE sales (product_id int, amount int) USING iceberg;
+        INSERT INTO sales SELECT s % 10, s FROM generate_series(1, 1000) s;
+        CREATE TABLE products (id int, name text, price numeric(10,2));
+        INSERT INTO products SELECT s, 'product-' || s, s * 1.5 FROM generate_series(0, 4) s;
+    """,
+        pg_conn,
+    )
+
+    query = """
+        SELECT name, price, count(*), sum(amount)
+        FROM sales JOIN products ON (product_id = id)
+        GROUP BY name, price ORDER BY name
+    """
+
+    # the join with a small heap table runs in DuckDB
+    assert is_pushed_down(query, pg_conn)
+    expected = [
+        [
+            f"product-{i}",
+            Decimal(i * 1.5).quantize(Decimal("0.01")),
+            100,
+            sum(s for s in range(1, 1001) if s % 10 == i),
+        ]
+        for i in range(5)
+    ]
+    assert run_query(query, pg_conn) == expected
+
+    # uncommitted changes to the heap table are visible
+    run_command("DELETE FROM products WHERE id = 0", pg_conn)
+    assert run_query(query, pg_conn) == expected[1:]
+
+    # results are the same without broadcasting
+    run_command("SET LOCAL pg_lake_table.broadcast_table_size_limit TO 0", pg_conn)
+    assert not is_pushed_down(query, pg_conn)
+    assert run_query(query, pg_conn) == expected[1:]
+    run_command("RESET pg_lake_table.broadcast_table_size_limit", pg_conn)
+
+    # tables over the size limit are not broadcast
+    run_command(
+        """
+        SET LOCAL pg_lake_table.broadcast_table_size_limit TO '8kB';
+        INSERT INTO products SELECT s, 'product-' || s, 0 FROM generate_series(100, 1000) s;
+    """,
+        pg_conn,
+    )
+    assert not is_pushed_down(query, pg_conn)
+    run_command("RESET pg_lake_table.broadcast_table_size_limit", pg_conn)
+
+    # empty tables are broadcast as well
+    run_command("TRUNCATE products", pg_conn)
+    assert is_pushed_down(query, pg_conn)
+    assert run_query(query, pg_conn) == []
+
+    # large values in the TOAST table count towards the size limit
+    run_command(
+        """
+        SET LOCAL pg_lake_table.broadcast_table_size_limit TO '64kB';
+        INSERT INTO products (id, name)
+        SELECT 1, string_agg(md5(s::text), '') FROM generate_series(1, 10000) s;
+    """,
+        pg_conn,
+    )
+    assert not is_pushed_down(query, pg_conn)
+    run_command("RESET pg_lake_table.broadcast_table_size_limit", pg_conn)
+    run_command("TRUNCATE products", pg_conn)
+
+    # unbounded numerics cannot be broadcast without losing precision
+    run_command(
+        """
+        CREATE TABLE discounts (product_id int, discount numeric);
+        INSERT INTO discounts VALUES (1, 0.123456789012345);
+    """,
+        pg_conn,
+    )
+    assert not is_pushed_down(
+        "SELECT * FROM sales JOIN discounts USING (product_id)", pg_conn
+    )
+
+    # queries without pg_lake tables are not affected
+    assert not is_pushed_down("SELECT count(*) FROM products", pg_conn)
+
+    pg_conn.rollback()
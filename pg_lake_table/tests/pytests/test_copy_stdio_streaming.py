@@ -0,0 +1,107 @@
+import gzip
+import io
+import json
+import pytest
+import psycopg2
+import duckdb
+from utils_pytest import *
+
+
+def copy_from_bytes(copy_command, data, conn):
+    cursor = conn.cursor()
+    try:
+        cursor.copy_expert(copy_command, io.BytesIO(data))
+    finally:
+        cursor.close()
+
+
+def copy_to_bytes(copy_command, conn):
+    output = io.BytesIO()
+    cursor = conn.cursor()
+    try:
+        cursor.copy_expert(copy_command, output)
+    finally:
+        cursor.close()
+    return output.getvalue()
+
+
+@pytest.mark.parametrize("streaming", ["on", "off"])
+def test_copy_stdio_streaming(
+    s3, pg_conn, extension, with_default_location, tmp_path, streaming
+):
+    run_command(
+        f"""
+        SET pg_lake_copy.enable_stdio_streaming TO {streaming};
+        CREATE SCHEMA test_stdio_streaming;
+        CREATE TABLE test_stdio_streaming.ice (id int, txt text) USING iceberg;
+        CREATE TABLE test_stdio_streaming.heap (id int, txt text);
+    """,
+        pg_conn,
+    )
+
+    # larger than a pipe buffer, with quoting
+    csv_data = "".join(f'{i},"row, {i}"\n' for i in range(100000)).encode()
+
+    # pushed down into the Iceberg table
+    copy_from_bytes(
+        "COPY test_stdio_streaming.ice FROM STDIN WITH (format 'csv')",
+        csv_data,
+        pg_conn,
+    )
+
+    result = run_query(
+        "SELECT count(*), sum(id), max(txt), pg_lake_last_copy_pushed_down_test() "
+        "FROM test_stdio_streaming.ice",
+        pg_conn,
+    )
+    assert result == [[100000, 4999950000, "row, 99999", True]]
+
+    # transmitted into the heap table, with compression
+    copy_from_bytes(
+        "COPY test_stdio_streaming.heap FROM STDIN "
+        "WITH (format 'csv', compression 'gzip')",
+        gzip.compress(csv_data),
+        pg_conn,
+    )
+
+    result = run_query(
+        "SELECT count(*), sum(id), max(txt) FROM test_stdio_streaming.heap", pg_conn
+    )
+    assert result == [[100000, 4999950000, "row, 99999"]]
+
+    # write Parquet to the client and read it back
+    parquet_path = tmp_path / "stdio.parquet"
+    parquet_path.write_bytes(
+        copy_to_bytes(
+            "COPY test_stdio_streaming.ice TO STDOUT WITH (format 'parquet')",
+            pg_conn,
+        )
+    )
+
+    duckdb_conn = duckdb.connect()
+    result = duckdb_conn.execute(
+        "SELECT count(*), sum(id), max(txt) FROM read_parquet($1)",
+        [str(parquet_path)],
+    ).fetchall()
+    assert result == [(100000, 4999950000, "row, 99999")]
+
+    # write compressed JSON to the client
+    json_data = copy_to_bytes(
+        "COPY (SELECT * FROM test_stdio_streaming.heap WHERE id < 5) "
+        "TO STDOUT WITH (format 'json', compression 'gzip')",
+        pg_conn,
+    )
+    rows = [json.loads(line) for line in gzip.decompress(json_data).splitlines()]
+    assert sorted(rows, key=lambda row: row["id"]) == [
+        {"id": i, "txt": f"row, {i}"} for i in range(5)
+    ]
+
+    # errors in the middle of the input are reported
+    with pytest.raises(psycopg2.DatabaseError):
+        copy_from_bytes(
+            "COPY test_stdio_streaming.ice FROM STDIN WITH (format 'csv')",
+            csv_data + b"x,y\n" + csv_data,
+            pg_conn,
+        )
+
+    pg_conn.rollback()
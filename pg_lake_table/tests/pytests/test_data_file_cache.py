@@ -0,0 +1,110 @@
+import pytest
+from utils_pytest import *
+
+explain_prefix = "EXPLAIN (analyze, verbose, format json) "
+
+
+def files_used(filter, pg_conn):
+    results = run_query(
+        f"{explain_prefix} SELECT * FROM test_data_file_cache.tbl WHERE {filter}",
+        pg_conn,
+    )
+    return int(fetch_data_files_used(results))
+
+
+def cache_stats(pg_conn):
+    results = run_query(
+        "SELECT hits, misses, invalidations FROM lake_table.data_file_cache_stats()",
+        pg_conn,
+    )
+    return results[0]
+
+
+def cache_stats_delta(before, pg_conn):
+    after = cache_stats(pg_conn)
+    return {
+        "hits": after[0] - before[0],
+        "misses": after[1] - before[1],
+        "invalidations": after[2] - before[2],
+    }
+
+
+def test_data_file_cache(s3, pg_conn, extension, with_default_location):
+    run_command(
+        """
+        CREATE SCHEMA test_data_file_cache;
+        CREATE TABLE test_data_file_cache.tbl (a int, b text, c int)
+        USING iceberg WITH (autovacuum_enabled='False');
+        INSERT INTO test_data_file_cache.tbl VALUES (1, 'one', 10);
+        INSERT INTO test_data_file_cache.tbl VALUES (2, 'two', 20);
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    # the first scan fills the cache
+    before = cache_stats(pg_conn)
+    assert files_used("a = 1", pg_conn) == 1
+    assert files_used("a > 0", pg_conn) == 2
+    assert cache_stats_delta(before, pg_conn)["misses"] > 0
+
+    # the second one uses it
+    before = cache_stats(pg_conn)
+    assert files_used("a = 1", pg_conn) == 1
+    assert files_used("a > 0", pg_conn) == 2
+    delta = cache_stats_delta(before, pg_conn)
+    assert delta["hits"] > 0
+    assert delta["misses"] == 0
+
+    # stats of new files are added to the cache
+    run_command(
+        "INSERT INTO test_data_file_cache.tbl VALUES (3, 'three', 30)", pg_conn
+    )
+    before = cache_stats(pg_conn)
+    assert files_used("a = 3", pg_conn) == 1
+    assert cache_stats_delta(before, pg_conn)["misses"] > 0
+
+    before = cache_stats(pg_conn)
+    assert files_used("a > 0", pg_conn) == 3
+    delta = cache_stats_delta(before, pg_conn)
+    assert delta["hits"] > 0
+    assert delta["misses"] == 0
+
+    # the new file is gone after rollback
+    pg_conn.rollback()
+    assert files_used("a > 0", pg_conn) == 2
+
+    # removed files are no longer used
+    run_command("DELETE FROM test_data_file_cache.tbl WHERE a = 2", pg_conn)
+    pg_conn.commit()
+    assert files_used("a > 0", pg_conn) == 1
+
+    # schema changes invalidate the cache
+    before = cache_stats(pg_conn)
+    run_command(
+        """
+        ALTER TABLE test_data_file_cache.tbl DROP COLUMN c;
+        ALTER TABLE test_data_file_cache.tbl ADD COLUMN c text;
+        INSERT INTO test_data_file_cache.tbl VALUES (4, 'four', 'x');
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+    assert cache_stats_delta(before, pg_conn)["invalidations"] > 0
+
+    before = cache_stats(pg_conn)
+    assert files_used("c = 'x'", pg_conn) == 1
+    assert cache_stats_delta(before, pg_conn)["misses"] > 0
+
+    assert run_query(
+        "SELECT a, b, c FROM test_data_file_cache.tbl ORDER BY a", pg_conn
+    ) == [[1, "one", None], [4, "four", "x"]]
+
+    # pruning is the same without the cache
+    run_command("SET LOCAL pg_lake_table.data_file_cache_size TO 0", pg_conn)
+    assert files_used("c = 'x'", pg_conn) == 1
+    assert files_used("a = 1", pg_conn) == 1
+    pg_conn.rollback()
+
+    run_command("DROP SCHEMA test_data_file_cache CASCADE", pg_conn)
+    pg_conn.commit()
@@ -1618,6 +1618,56 @@ def test_pruning_with_none_stats_mode(s3, pg_conn, extension, with_default_locat
     pg_conn.rollback()
 
 
+def test_external_pruning_without_manifest_bounds(
+    s3, pg_conn, extension, with_default_location
+):
+    explain_prefix = "EXPLAIN (verbose, format json) "
+
+    # the manifest has no bounds with column_stats_mode='none'
+    create_table_sql = f"""
+        CREATE SCHEMA test_external_pruning_without_manifest_bounds;
+        SET search_path TO test_external_pruning_without_manifest_bounds;
+
+        CREATE TABLE tbl (
+            a int,
+            b text
+        ) USING iceberg WITH (autovacuum_enabled='False', column_stats_mode='none');
+
+        INSERT INTO tbl VALUES (1, 'aaa');
+        INSERT INTO tbl VALUES (2, 'bbb');
+        INSERT INTO tbl VALUES (3, 'ccc');
+    """
+    run_command(create_table_sql, pg_conn)
+    pg_conn.commit()
+
+    create_external_iceberg_table_cmd = f"SELECT public.create_external_iceberg_table('tbl', 'tbl_external', 'test_external_pruning_without_manifest_bounds', 'test_external_pruning_without_manifest_bounds')"
+    run_command(create_external_iceberg_table_cmd, pg_conn)
+
+    # no stats for the internal table
+    results = run_query(f"{explain_prefix} SELECT * FROM tbl WHERE a = 2", pg_conn)
+    assert int(fetch_data_files_used(results)) == 3
+
+    # external table falls back to the Parquet footers
+    results = run_query(
+        f"{explain_prefix} SELECT * FROM tbl_external WHERE a = 2", pg_conn
+    )
+    assert int(fetch_data_files_used(results)) == 1
+
+    results = run_query(
+        f"{explain_prefix} SELECT * FROM tbl_external WHERE a > 1 AND b < 'ccc'",
+        pg_conn,
+    )
+    assert int(fetch_data_files_used(results)) == 1
+
+    result = run_query("SELECT b FROM tbl_external WHERE a = 2", pg_conn)
+    assert result == [["bbb"]]
+
+    run_command(
+        "DROP SCHEMA test_external_pruning_without_manifest_bounds CASCADE", pg_conn
+    )
+    pg_conn.commit()
+
+
 def test_pruning_for_inlined_functions(
     s3, pg_conn, extension, with_default_location, create_helper_functions
 ):
@@ -1703,6 +1753,91 @@ def test_pruning_for_inlined_functions(
     pg_conn.commit()
 
 
+def test_bulk_pruning(s3, pg_conn, extension, with_default_location):
+    explain_prefix = "EXPLAIN (verbose, format json) "
+
+    run_command(
+        """
+        CREATE SCHEMA test_bulk_pruning;
+        CREATE TABLE test_bulk_pruning.tbl (a int, b text)
+        USING iceberg WITH (autovacuum_enabled='False');
+    """,
+        pg_conn,
+    )
+
+    # files with ranges [0,9], [10,19], ..., [90,99] and a file with only 200
+    for i in range(10):
+        run_command(
+            f"INSERT INTO test_bulk_pruning.tbl SELECT s, s::text FROM generate_series({i * 10}, {i * 10 + 9}) s",
+            pg_conn,
+        )
+        pg_conn.commit()
+
+    run_command(
+        "INSERT INTO test_bulk_pruning.tbl SELECT 200, 'x' FROM generate_series(1, 5)",
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    run_command(
+        "SELECT create_external_iceberg_table('tbl', 'tbl_external', 'test_bulk_pruning', 'test_bulk_pruning')",
+        pg_conn,
+    )
+
+    params = [
+        ("a < 25", 3),
+        ("25 > a", 3),
+        ("a >= 95", 2),
+        ("a = 200", 1),
+        ("a = 15::bigint", 1),
+        ("a BETWEEN 20 AND 39", 2),
+        ("a IN (5, 55, 300)", 2),
+        ("a IN (1000, 2000)", 0),
+        ("b = 'x'", 1),
+        # clauses that are not range checks fall back to the prover
+        ("a > 10 OR a < 0", 10),
+        ("a < 25 AND a + 1 > 0", 3),
+        ("a IS NULL", 11),
+        ("a IS NOT NULL", 11),
+    ]
+
+    for bulk_pruning in ["on", "off"]:
+        run_command(
+            f"SET LOCAL pg_lake_table.enable_bulk_data_file_pruning TO {bulk_pruning}",
+            pg_conn,
+        )
+
+        for tbl_name in ["tbl", "tbl_external"]:
+            for filter, expected_files in params:
+                results = run_query(
+                    f"{explain_prefix} SELECT * FROM test_bulk_pruning.{tbl_name} WHERE {filter}",
+                    pg_conn,
+                )
+                assert int(fetch_data_files_used(results)) == expected_files, filter
+
+        # files in which all rows match are skipped by deletes
+        delete_params = [
+            ("a < 30", 0, 3),
+            ("a = 200", 0, 1),
+            ("a IN (200, 300)", 0, 1),
+            ("a IS NOT NULL AND a >= 90", 0, 2),
+            ("a >= 20 AND a < 25", 1, 0),
+        ]
+
+        for filter, expected_used, expected_skipped in delete_params:
+            results = run_query(
+                f"{explain_prefix} DELETE FROM test_bulk_pruning.tbl WHERE {filter}",
+                pg_conn,
+            )
+            assert int(fetch_data_files_used(results)) == expected_used, filter
+            assert int(fetch_data_files_skipped(results)) == expected_skipped, filter
+
+    pg_conn.rollback()
+
+    run_command("DROP SCHEMA test_bulk_pruning CASCADE", pg_conn)
+    pg_conn.commit()
+
+
 @pytest.fixture(scope="module")
 def create_helper_functions(superuser_conn):
 
@@ -322,6 +322,9 @@ def test_explain_not_vectorized_messages(s3, pg_conn, extension, with_default_lo
     run_command("create table test2(a text);", pg_conn)
     run_command("create table test(a text) using iceberg;", pg_conn)
 
+    # do not copy the regular table into the pushed down query
+    run_command("set local pg_lake_table.broadcast_table_size_limit to 0;", pg_conn)
+
     # not shippable table and function
     result = run_query(
         """
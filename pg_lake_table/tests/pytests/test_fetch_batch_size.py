@@ -0,0 +1,43 @@
+import pytest
+from utils_pytest import *
+
+
+@pytest.mark.parametrize("batch_size", [1, 7, 1000, 100000])
+@pytest.mark.parametrize("full_query_pushdown", [True, False])
+def test_fetch_batch_size(
+    pg_conn, extension, s3, with_default_location, batch_size, full_query_pushdown
+):
+    run_command(
+        f"""
+        CREATE TABLE test_fetch_batch (id int, val text, ts timestamptz) USING iceberg;
+        INSERT INTO test_fetch_batch
+        SELECT s, 'value-' || s, '2024-01-01'::timestamptz + s * interval '1 minute'
+        FROM generate_series(1,2500) s;
+
+        SET LOCAL pg_lake_engine.fetch_batch_size TO {batch_size};
+        SET LOCAL pg_lake_table.enable_full_query_pushdown TO {full_query_pushdown};
+    """,
+        pg_conn,
+    )
+
+    result = run_query(
+        "SELECT count(*), count(DISTINCT val), min(ts), max(id) FROM (SELECT * FROM test_fetch_batch) t",
+        pg_conn,
+    )
+    assert result[0][0] == 2500
+    assert result[0][1] == 2500
+    assert result[0][3] == 2500
+
+    # row-returning scan that crosses several batch boundaries
+    result = run_query(
+        "SELECT id, val FROM test_fetch_batch WHERE id % 3 = 0 ORDER BY id", pg_conn
+    )
+    assert len(result) == 833
+    assert result[0] == [3, "value-3"]
+    assert result[-1] == [2499, "value-2499"]
+
+    # stopping early leaves unread batches behind
+    result = run_query("SELECT id FROM test_fetch_batch LIMIT 5", pg_conn)
+    assert len(result) == 5
+
+    pg_conn.rollback()
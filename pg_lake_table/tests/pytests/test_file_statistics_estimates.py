@@ -0,0 +1,94 @@
+import pytest
+from utils_pytest import *
+
+
+def estimated_rows(pg_conn, query):
+    result = run_query(f"EXPLAIN (format json) {query}", pg_conn)
+    return find_key_in_json(result[0][0], "Plan Rows")
+
+
+def test_file_statistics_estimates(s3, pg_conn, extension, with_default_location):
+    run_command(
+        """
+        CREATE SCHEMA test_file_estimates;
+        CREATE TABLE test_file_estimates.tbl (id int, val text)
+        USING iceberg WITH (autovacuum_enabled='False');
+        INSERT INTO test_file_estimates.tbl SELECT s, 'v' || s FROM generate_series(1, 1000) s;
+        INSERT INTO test_file_estimates.tbl SELECT s, 'v' || s FROM generate_series(1001, 3000) s;
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    run_command(
+        "SET pg_lake_table.enable_full_query_pushdown TO off",
+        pg_conn,
+    )
+
+    # row counts come from the files catalog
+    assert estimated_rows(pg_conn, "SELECT * FROM test_file_estimates.tbl") == 3000
+
+    # files outside the bounds are pruned, files within the bounds fully count
+    assert (
+        estimated_rows(pg_conn, "SELECT * FROM test_file_estimates.tbl WHERE id > 1000")
+        == 2000
+    )
+    assert (
+        estimated_rows(pg_conn, "SELECT * FROM test_file_estimates.tbl WHERE id <= 1000")
+        == 1000
+    )
+
+    # only rows in partially matching files are subject to selectivity
+    rows = estimated_rows(
+        pg_conn, "SELECT * FROM test_file_estimates.tbl WHERE id > 2000"
+    )
+    assert 0 < rows < 2000
+
+    # deleted rows are not counted
+    run_command("DELETE FROM test_file_estimates.tbl WHERE id % 10 = 0", pg_conn)
+    pg_conn.commit()
+
+    run_command(
+        "SET pg_lake_table.enable_full_query_pushdown TO off",
+        pg_conn,
+    )
+    assert estimated_rows(pg_conn, "SELECT * FROM test_file_estimates.tbl") == 2700
+
+    # can be disabled
+    run_command(
+        "SET pg_lake_table.enable_file_statistics_estimates TO off",
+        pg_conn,
+    )
+    assert estimated_rows(pg_conn, "SELECT * FROM test_file_estimates.tbl") == 1000
+
+    pg_conn.rollback()
+
+    run_command("DROP SCHEMA test_file_estimates CASCADE", pg_conn)
+    pg_conn.commit()
+
+
+def test_insert_buffer_estimates(s3, pg_conn, extension, with_default_location):
+    run_command(
+        """
+        CREATE SCHEMA test_buffer_estimates;
+        CREATE TABLE test_buffer_estimates.tbl (id int, val text)
+        USING iceberg WITH (insert_buffer='true', autovacuum_enabled='False');
+        INSERT INTO test_buffer_estimates.tbl SELECT s, 'v' || s FROM generate_series(1, 500) s;
+        INSERT INTO test_buffer_estimates.tbl SELECT s, 'v' || s FROM generate_series(501, 700) s;
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    run_command(
+        "SET pg_lake_table.enable_full_query_pushdown TO off",
+        pg_conn,
+    )
+
+    # buffered rows count towards the estimate, whether flushed or not
+    assert estimated_rows(pg_conn, "SELECT * FROM test_buffer_estimates.tbl") == 700
+
+    pg_conn.rollback()
+
+    run_command("DROP SCHEMA test_buffer_estimates CASCADE", pg_conn)
+    pg_conn.commit()
@@ -0,0 +1,248 @@
+import time
+import pytest
+from utils_pytest import *
+
+
+@pytest.fixture
+def insert_buffer_flush_interval(request):
+    run_command_outside_tx(
+        [
+            f"ALTER SYSTEM SET pg_lake_table.insert_buffer_flush_interval TO '{request.param}'",
+            "SELECT pg_reload_conf()",
+        ]
+    )
+
+    yield
+
+    run_command_outside_tx(
+        [
+            "ALTER SYSTEM RESET pg_lake_table.insert_buffer_flush_interval",
+            "SELECT pg_reload_conf()",
+        ]
+    )
+
+
+def data_file_count(pg_conn):
+    result = run_query(
+        "SELECT count(*) FROM lake_table.files "
+        "WHERE table_name = 'test_insert_buffer.tbl'::regclass",
+        pg_conn,
+    )
+    return result[0][0]
+
+
+def buffered_row_count(superuser_conn):
+    result = run_query(
+        "SELECT count(*) FROM lake_table.insert_buffer "
+        "WHERE table_name = 'test_insert_buffer.tbl'::regclass",
+        superuser_conn,
+    )
+    return result[0][0]
+
+
+# keep the insert buffer worker from flushing during the test
+@pytest.mark.parametrize("insert_buffer_flush_interval", ["1h"], indirect=True)
+def test_insert_buffer(
+    s3,
+    pg_conn,
+    superuser_conn,
+    extension,
+    with_default_location,
+    insert_buffer_flush_interval,
+):
+    run_command(
+        """
+        CREATE SCHEMA test_insert_buffer;
+        CREATE TABLE test_insert_buffer.tbl (id int, txt text, arr int[])
+        USING iceberg WITH (insert_buffer='true', autovacuum_enabled='False');
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    # small inserts do not add data files, but are visible to scans
+    run_command(
+        """
+        INSERT INTO test_insert_buffer.tbl VALUES (1, 'one', '{1}');
+        INSERT INTO test_insert_buffer.tbl VALUES (2, 'comma, "quote"', NULL), (3, NULL, '{}');
+    """,
+        pg_conn,
+    )
+    assert data_file_count(pg_conn) == 0
+    assert run_query(
+        "SELECT id, txt, arr::text FROM test_insert_buffer.tbl ORDER BY id", pg_conn
+    ) == [[1, "one", "{1}"], [2, 'comma, "quote"', None], [3, None, "{}"]]
+
+    # buffered rows are gone after rollback
+    pg_conn.rollback()
+    assert run_query("SELECT count(*) FROM test_insert_buffer.tbl", pg_conn) == [[0]]
+
+    run_command(
+        "INSERT INTO test_insert_buffer.tbl SELECT s, 'row-' || s FROM generate_series(1, 10) s",
+        pg_conn,
+    )
+    pg_conn.commit()
+    assert buffered_row_count(superuser_conn) == 10
+
+    # buffered rows combine with rows in data files
+    run_command(
+        """
+        SET LOCAL pg_lake_table.insert_buffer_max_statement_rows TO 5;
+        INSERT INTO test_insert_buffer.tbl SELECT s, 'row-' || s FROM generate_series(11, 20) s;
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+    assert data_file_count(pg_conn) == 1
+    assert run_query(
+        "SELECT count(*), count(DISTINCT id) FROM test_insert_buffer.tbl", pg_conn
+    ) == [[20, 20]]
+
+    # flushing moves the buffered rows into a data file
+    assert run_query(
+        "SELECT lake_table.flush_insert_buffer('test_insert_buffer.tbl')", pg_conn
+    ) == [[10]]
+    pg_conn.commit()
+    assert data_file_count(pg_conn) == 2
+    assert buffered_row_count(superuser_conn) == 0
+    assert run_query("SELECT count(*) FROM test_insert_buffer.tbl", pg_conn) == [[20]]
+
+    # UPDATE and DELETE flush the buffer first
+    run_command(
+        """
+        INSERT INTO test_insert_buffer.tbl VALUES (21, 'new');
+        UPDATE test_insert_buffer.tbl SET txt = 'updated' WHERE id IN (1, 21);
+        DELETE FROM test_insert_buffer.tbl WHERE id = 2;
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+    assert buffered_row_count(superuser_conn) == 0
+    assert run_query(
+        "SELECT id, txt FROM test_insert_buffer.tbl WHERE id IN (1, 2, 21) ORDER BY id",
+        pg_conn,
+    ) == [[1, "updated"], [21, "updated"]]
+
+    # ALTER TABLE flushes rows in the old row format
+    run_command(
+        """
+        INSERT INTO test_insert_buffer.tbl VALUES (22, 'before alter');
+        ALTER TABLE test_insert_buffer.tbl ADD COLUMN extra int;
+        INSERT INTO test_insert_buffer.tbl VALUES (23, 'after alter', NULL, 5);
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+    assert run_query(
+        "SELECT id, txt, extra FROM test_insert_buffer.tbl WHERE id > 21 ORDER BY id",
+        pg_conn,
+    ) == [[22, "before alter", None], [23, "after alter", 5]]
+
+    # TRUNCATE removes buffered rows
+    run_command("TRUNCATE test_insert_buffer.tbl", pg_conn)
+    pg_conn.commit()
+    assert buffered_row_count(superuser_conn) == 0
+    assert run_query("SELECT count(*) FROM test_insert_buffer.tbl", pg_conn) == [[0]]
+
+    run_command("DROP SCHEMA test_insert_buffer CASCADE", pg_conn)
+    pg_conn.commit()
+
+
+@pytest.mark.parametrize("insert_buffer_flush_interval", ["1s"], indirect=True)
+def test_insert_buffer_worker(
+    s3,
+    pg_conn,
+    superuser_conn,
+    extension,
+    with_default_location,
+    insert_buffer_flush_interval,
+):
+    run_command(
+        """
+        CREATE SCHEMA test_insert_buffer;
+        CREATE TABLE test_insert_buffer.tbl (id int, txt text)
+        USING iceberg WITH (insert_buffer='true', autovacuum_enabled='False');
+        INSERT INTO test_insert_buffer.tbl VALUES (1, 'one');
+        INSERT INTO test_insert_buffer.tbl VALUES (2, 'two');
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    # the worker writes the buffered rows to a data file
+    for _ in range(30):
+        if buffered_row_count(superuser_conn) == 0:
+            break
+        time.sleep(1)
+
+    assert buffered_row_count(superuser_conn) == 0
+    assert data_file_count(pg_conn) == 1
+    assert run_query(
+        "SELECT id, txt FROM test_insert_buffer.tbl ORDER BY id", pg_conn
+    ) == [[1, "one"], [2, "two"]]
+
+    run_command("DROP SCHEMA test_insert_buffer CASCADE", pg_conn)
+    pg_conn.commit()
+
+
+# keep the insert buffer worker from flushing during the test
+@pytest.mark.parametrize("insert_buffer_flush_interval", ["1h"], indirect=True)
+def test_insert_buffer_session_settings(
+    s3,
+    pg_conn,
+    superuser_conn,
+    extension,
+    with_default_location,
+    insert_buffer_flush_interval,
+):
+    run_command(
+        """
+        CREATE SCHEMA test_insert_buffer;
+        CREATE TABLE test_insert_buffer.tbl (id int, d date, ts timestamp, f float8)
+        USING iceberg WITH (insert_buffer='true', autovacuum_enabled='False');
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    # buffer rows under non-default output settings
+    run_command(
+        """
+        SET DateStyle TO 'SQL, DMY';
+        SET extra_float_digits TO -15;
+        INSERT INTO test_insert_buffer.tbl
+        VALUES (1, '2024-02-03', '2024-02-03 04:05:06.789', 0.1 + 0.2);
+        RESET DateStyle;
+        RESET extra_float_digits;
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+    assert buffered_row_count(superuser_conn) == 1
+
+    expected = [[1, "2024-02-03", "2024-02-03 04:05:06.789", True]]
+    query = """
+        SELECT id, d::text, ts::text, f = 0.1::float8 + 0.2::float8
+        FROM test_insert_buffer.tbl
+    """
+
+    # scans in another session see the same values
+    assert run_query(query, superuser_conn) == expected
+    superuser_conn.commit()
+
+    # flushing in a session with different settings keeps the values intact
+    run_command("SET DateStyle TO 'German, MDY'", superuser_conn)
+    assert run_query(
+        "SELECT lake_table.flush_insert_buffer('test_insert_buffer.tbl')",
+        superuser_conn,
+    ) == [[1]]
+    superuser_conn.commit()
+    run_command("RESET DateStyle", superuser_conn)
+    superuser_conn.commit()
+
+    assert buffered_row_count(superuser_conn) == 0
+    assert data_file_count(pg_conn) == 1
+    assert run_query(query, pg_conn) == expected
+
+    run_command("DROP SCHEMA test_insert_buffer CASCADE", pg_conn)
+    pg_conn.commit()
@@ -0,0 +1,68 @@
+import pytest
+from utils_pytest import *
+
+
+def get_cache_stats(conn):
+    return run_query(
+        "SELECT hits, misses, cached_manifests FROM lake_iceberg.manifest_cache",
+        conn,
+    )[0]
+
+
+def test_manifest_cache(s3, pg_conn, extension, with_default_location):
+    # each insert adds a manifest
+    run_command(
+        """
+        CREATE SCHEMA test_manifest_cache;
+        CREATE TABLE test_manifest_cache.tbl (a int, b text)
+        USING iceberg WITH (autovacuum_enabled='False');
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    for i in range(3):
+        run_command(
+            f"INSERT INTO test_manifest_cache.tbl VALUES ({i}, 'value-{i}')", pg_conn
+        )
+        pg_conn.commit()
+
+    metadata_location = run_query(
+        "SELECT metadata_location FROM iceberg_tables "
+        "WHERE table_name = 'tbl' AND table_namespace = 'test_manifest_cache'",
+        pg_conn,
+    )[0][0]
+    run_command(
+        f"CREATE FOREIGN TABLE test_manifest_cache.tbl_external () SERVER pg_lake OPTIONS (path '{metadata_location}')",
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    query = "SELECT a, b FROM test_manifest_cache.tbl_external ORDER BY a"
+    expected = [[0, "value-0"], [1, "value-1"], [2, "value-2"]]
+
+    # the first scan fills the cache
+    assert run_query(query, pg_conn) == expected
+    hits, misses, cached_manifests = get_cache_stats(pg_conn)
+    assert cached_manifests >= 3
+
+    # repeated scans do not read manifests anymore
+    for _ in range(3):
+        assert run_query(query, pg_conn) == expected
+
+    new_hits, new_misses, _ = get_cache_stats(pg_conn)
+    assert new_hits >= hits + 9
+    assert new_misses == misses
+
+    # the cache can be bypassed
+    run_command("SET LOCAL pg_lake_iceberg.enable_manifest_cache TO off", pg_conn)
+    assert run_query(query, pg_conn) == expected
+
+    hits, misses, _ = get_cache_stats(pg_conn)
+    assert hits == new_hits
+    assert misses == new_misses
+
+    pg_conn.rollback()
+
+    run_command("DROP SCHEMA test_manifest_cache CASCADE", pg_conn)
+    pg_conn.commit()
@@ -1700,6 +1700,75 @@ def test_pruning_for_coercions_temporal(
     pg_conn.rollback()
 
 
+def test_external_manifest_pruning(
+    s3,
+    disable_data_file_pruning,
+    pg_conn,
+    extension,
+    with_default_location,
+):
+    explain_prefix = "EXPLAIN (verbose, format json) "
+
+    # each insert adds a manifest, whose partition summaries cover its files
+    run_command(
+        """
+        CREATE SCHEMA test_external_manifest_pruning;
+        SET search_path TO test_external_manifest_pruning;
+
+        CREATE TABLE tbl (
+            a int,
+            d date,
+            b text
+        ) USING iceberg WITH (autovacuum_enabled='False', partition_by='a, month(d)');
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    for insert in [
+        "INSERT INTO tbl VALUES (1, '2024-01-05', 'x'), (2, '2024-01-20', 'y')",
+        "INSERT INTO tbl VALUES (10, '2024-06-01', 'z'), (11, '2024-07-15', 'w')",
+        "INSERT INTO tbl VALUES (NULL, '2025-01-01', 'v')",
+    ]:
+        run_command(insert, pg_conn)
+        pg_conn.commit()
+
+    metadata_location = run_query(
+        "SELECT metadata_location FROM iceberg_tables "
+        "WHERE table_name = 'tbl' AND table_namespace = 'test_external_manifest_pruning'",
+        pg_conn,
+    )[0][0]
+    run_command(
+        f"CREATE FOREIGN TABLE tbl_external () SERVER pg_lake OPTIONS (path '{metadata_location}')",
+        pg_conn,
+    )
+
+    # data file pruning is disabled, so only manifests are pruned
+    queries = [
+        ("SELECT * FROM tbl_external", 5),
+        ("SELECT * FROM tbl_external WHERE a = 2", 2),
+        ("SELECT * FROM tbl_external WHERE a > 5", 2),
+        ("SELECT * FROM tbl_external WHERE a BETWEEN 3 AND 9", 0),
+        ("SELECT * FROM tbl_external WHERE a IS NULL", 1),
+        ("SELECT * FROM tbl_external WHERE d >= '2024-06-01'", 3),
+        ("SELECT * FROM tbl_external WHERE d < '2024-02-01'", 2),
+        ("SELECT * FROM tbl_external WHERE a = 1 OR b = 'v'", 5),
+    ]
+
+    for query, expected_files in queries:
+        results = run_query(f"{explain_prefix} {query}", pg_conn)
+        assert int(fetch_data_files_used(results)) == expected_files
+
+        external_result = run_query(f"{query} ORDER BY b", pg_conn)
+        internal_result = run_query(
+            f"{query.replace('tbl_external', 'tbl')} ORDER BY b", pg_conn
+        )
+        assert external_result == internal_result
+
+    run_command("DROP SCHEMA test_external_manifest_pruning CASCADE", pg_conn)
+    pg_conn.commit()
+
+
 # this test file aims to ensure partition pruning works
 @pytest.fixture(scope="module")
 def disable_data_file_pruning(superuser_conn):
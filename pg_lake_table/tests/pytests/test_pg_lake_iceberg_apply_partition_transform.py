@@ -72,12 +72,12 @@ def test_manifest_partition_summary_via_spark(
 
     insert_random_rows(spark_session, pg_conn, 10)
 
-    # we do not set contains_null or contains_nan properly yet, we do not verify them
-    spark_query = f"""select lower_bound, upper_bound from ( select inline(partition_summaries) from public.test_apply_partition_transform.all_manifests ) manifest_summaries
-                      order by lower_bound desc nulls first, upper_bound desc nulls first;"""
+    # we do not set contains_nan properly yet, so we only verify contains_null
+    spark_query = f"""select lower_bound, upper_bound, contains_null from ( select inline(partition_summaries) from public.test_apply_partition_transform.all_manifests ) manifest_summaries
+                      order by lower_bound desc nulls first, upper_bound desc nulls first, contains_null;"""
 
-    pg_query = f"""select lower_bound, upper_bound from lake_table.partition_summary('test_apply_partition_transform'::regclass)
-                     order by lower_bound COLLATE "C" desc nulls first, upper_bound COLLATE "C" desc nulls first;"""
+    pg_query = f"""select lower_bound, upper_bound, contains_null from lake_table.partition_summary('test_apply_partition_transform'::regclass)
+                     order by lower_bound COLLATE "C" desc nulls first, upper_bound COLLATE "C" desc nulls first, contains_null;"""
 
     result = assert_query_result_on_spark_and_pg(
         installcheck, spark_session, pg_conn, spark_query, pg_query
@@ -85,6 +85,9 @@ def test_manifest_partition_summary_via_spark(
 
     assert len(result) > 0
 
+    # the inserted rows include a row with all nulls, which pruning relies on
+    assert any(row[2] for row in result)
+
     spark_session.sql("truncate table public.test_apply_partition_transform")
     pg_conn.rollback()
 
@@ -155,7 +158,8 @@ def test_manifest_partition_summary(
     )
     pg_conn.commit()
 
-    pg_query = f"""select * from lake_table.partition_summary('test_manifest_partition_summary'::regclass)
+    pg_query = f"""select sequence_number, partition_field_id, lower_bound, upper_bound
+                     from lake_table.partition_summary('test_manifest_partition_summary'::regclass)
                      order by sequence_number, partition_field_id, lower_bound COLLATE "C" desc nulls first, upper_bound COLLATE "C" desc nulls first;"""
 
     result = run_query(pg_query, pg_conn)
@@ -864,7 +868,8 @@ def create_helper_functions(superuser_conn, s3, extension):
             sequence_number int,
             partition_field_id int,
             lower_bound text,
-            upper_bound text
+            upper_bound text,
+            contains_null bool
         )
         LANGUAGE C STRICT
         AS 'pg_lake_table', $$get_partition_summary$$;
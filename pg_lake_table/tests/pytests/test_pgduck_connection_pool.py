@@ -0,0 +1,53 @@
+import pytest
+from utils_pytest import *
+
+
+def get_pool_stats(conn):
+    return run_query(
+        "SELECT pool_hits, pool_misses, idle_connections FROM lake_engine.pgduck_connection_pool_stats()",
+        conn,
+    )[0]
+
+
+def test_connection_reused_across_transactions(s3, extension, superuser_conn):
+    url = f"s3://{TEST_BUCKET}/test_connection_pool/data.parquet"
+
+    run_command(
+        f"""
+        COPY (SELECT s FROM generate_series(1,10) s) TO '{url}';
+        CREATE FOREIGN TABLE test_connection_pool () SERVER pg_lake OPTIONS (path '{url}');
+    """,
+        superuser_conn,
+    )
+    superuser_conn.commit()
+
+    conn = open_pg_conn()
+    conn.autocommit = True
+
+    # first query has to open a new connection
+    run_query("SELECT count(*) FROM test_connection_pool", conn)
+    hits, misses, idle = get_pool_stats(conn)
+    assert misses >= 1
+    assert idle >= 1
+
+    # subsequent transactions reuse the idle connection
+    for _ in range(5):
+        result = run_query("SELECT count(*) FROM test_connection_pool", conn)
+        assert result[0][0] == 10
+
+    new_hits, new_misses, idle = get_pool_stats(conn)
+    assert new_hits >= hits + 5
+    assert new_misses == misses
+    assert idle >= 1
+
+    # disabling the pool closes connections on release
+    run_command("SET pg_lake_engine.connection_pool_size TO 0", conn)
+    run_query("SELECT count(*) FROM test_connection_pool", conn)
+
+    _, _, idle = get_pool_stats(conn)
+    assert idle == 0
+
+    conn.close()
+
+    run_command("DROP FOREIGN TABLE test_connection_pool", superuser_conn)
+    superuser_conn.commit()
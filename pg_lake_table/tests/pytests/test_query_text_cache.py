@@ -0,0 +1,70 @@
+import pytest
+from utils_pytest import *
+
+
+def get_cache_stats(conn):
+    return run_query(
+        "SELECT cache_hits, cache_misses, cached_queries FROM lake_table.query_text_cache_stats()",
+        conn,
+    )[0]
+
+
+def test_prepared_statement_reuses_query_text(
+    s3, pg_conn, extension, with_default_location
+):
+    run_command(
+        """
+        CREATE SCHEMA test_query_text_cache;
+        CREATE TABLE test_query_text_cache.tbl (id int, val text) USING iceberg;
+        INSERT INTO test_query_text_cache.tbl SELECT s, 'v' || s FROM generate_series(1, 100) s;
+        PREPARE q(int) AS SELECT count(*) FROM test_query_text_cache.tbl WHERE id <= $1;
+        PREPARE p(int) AS SELECT val FROM test_query_text_cache.tbl WHERE id = $1 OFFSET 0;
+    """,
+        pg_conn,
+    )
+
+    # the first execution builds the query text
+    assert run_query("EXECUTE q(10)", pg_conn)[0][0] == 10
+    hits, misses, cached = get_cache_stats(pg_conn)
+    assert cached >= 1
+
+    # executions on the same files reuse it, including generic plans
+    for _ in range(8):
+        assert run_query("EXECUTE q(10)", pg_conn)[0][0] == 10
+
+    new_hits, new_misses, _ = get_cache_stats(pg_conn)
+    assert new_hits >= hits + 8
+    assert new_misses == misses
+
+    for _ in range(8):
+        assert run_query("EXECUTE p(5)", pg_conn) == [["v5"]]
+
+    # new files result in a new query text
+    run_command(
+        "INSERT INTO test_query_text_cache.tbl VALUES (5, 'new')",
+        pg_conn,
+    )
+    hits, misses, _ = get_cache_stats(pg_conn)
+
+    assert run_query("EXECUTE q(10)", pg_conn)[0][0] == 11
+    assert sorted(run_query("EXECUTE p(5)", pg_conn)) == [["new"], ["v5"]]
+
+    new_hits, new_misses, _ = get_cache_stats(pg_conn)
+    assert new_misses >= misses + 2
+
+    # changing the schema drops the cached query texts of the table
+    run_command(
+        "ALTER TABLE test_query_text_cache.tbl ADD COLUMN extra int",
+        pg_conn,
+    )
+    assert run_query("EXECUTE q(10)", pg_conn)[0][0] == 11
+
+    # disabling the cache still returns correct results
+    run_command("SET LOCAL pg_lake_table.query_text_cache_size TO 0", pg_conn)
+    hits, misses, _ = get_cache_stats(pg_conn)
+
+    assert run_query("EXECUTE q(100)", pg_conn)[0][0] == 101
+
+    assert get_cache_stats(pg_conn)[:2] == [hits, misses]
+
+    pg_conn.rollback()
@@ -0,0 +1,81 @@
+import pytest
+from utils_pytest import *
+
+
+def get_cache_stats(conn):
+    return run_query(
+        "SELECT hits, misses, cached_results FROM lake_table.result_cache",
+        conn,
+    )[0]
+
+
+def test_result_cache(s3, pg_conn, extension, with_default_location):
+    run_command(
+        """
+        CREATE SCHEMA test_result_cache;
+        CREATE TABLE test_result_cache.tbl (id int, val text) USING iceberg;
+        INSERT INTO test_result_cache.tbl SELECT s, 'v' || (s % 3) FROM generate_series(1, 100) s;
+    """,
+        pg_conn,
+    )
+    pg_conn.commit()
+
+    query = "SELECT val, count(*), sum(id) FROM test_result_cache.tbl GROUP BY val ORDER BY val"
+    expected = [["v0", 33, 1683], ["v1", 34, 1717], ["v2", 33, 1650]]
+
+    # the cache is opt-in
+    hits, misses, _ = get_cache_stats(pg_conn)
+    assert run_query(query, pg_conn) == expected
+    assert get_cache_stats(pg_conn)[:2] == [hits, misses]
+
+    run_command("SET pg_lake_table.enable_result_cache TO on", pg_conn)
+    pg_conn.commit()
+
+    # the first execution fills the cache, the next ones are served from it
+    assert run_query(query, pg_conn) == expected
+    hits, misses, cached = get_cache_stats(pg_conn)
+    assert cached >= 1
+
+    for _ in range(3):
+        assert run_query(query, pg_conn) == expected
+
+    new_hits, _, _ = get_cache_stats(pg_conn)
+    assert new_hits >= hits + 3
+
+    # parameters are part of the key
+    run_command(
+        "PREPARE q(int) AS SELECT count(*) FROM test_result_cache.tbl WHERE id <= $1",
+        pg_conn,
+    )
+    for _ in range(7):
+        assert run_query("EXECUTE q(10)", pg_conn) == [[10]]
+        assert run_query("EXECUTE q(20)", pg_conn) == [[20]]
+
+    # changes to the table are visible immediately, also before commit
+    run_command("INSERT INTO test_result_cache.tbl VALUES (1000, 'v0')", pg_conn)
+    assert run_query(query, pg_conn)[0] == ["v0", 34, 2683]
+    assert run_query("EXECUTE q(2000)", pg_conn) == [[101]]
+
+    pg_conn.rollback()
+    assert run_query(query, pg_conn) == expected
+
+    run_command("DELETE FROM test_result_cache.tbl WHERE id <= 10", pg_conn)
+    pg_conn.commit()
+    assert run_query("EXECUTE q(20)", pg_conn) == [[10]]
+
+    # other sessions get the results, but only when they enable the cache
+    other_conn = open_pg_conn()
+    hits, _, _ = get_cache_stats(other_conn)
+    run_command("SET pg_lake_table.enable_result_cache TO on", other_conn)
+    assert run_query(
+        "SELECT count(*) FROM test_result_cache.tbl WHERE id <= 20", other_conn
+    ) == [[10]]
+    assert run_query(
+        "SELECT count(*) FROM test_result_cache.tbl WHERE id <= 20", other_conn
+    ) == [[10]]
+    assert get_cache_stats(other_conn)[0] >= hits + 1
+    other_conn.close()
+
+    run_command("RESET pg_lake_table.enable_result_cache", pg_conn)
+    run_command("DROP SCHEMA test_result_cache CASCADE", pg_conn)
+    pg_conn.commit()
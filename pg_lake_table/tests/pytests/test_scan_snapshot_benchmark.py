@@ -0,0 +1,82 @@
+import time
+import pytest
+from utils_pytest import *
+
+
+def create_table_with_files(conn, table_name, file_count):
+    """
+    Create an Iceberg table with file_count data files in the catalog, and a
+    position delete file for every 10th data file. The files do not exist,
+    which is fine as long as we only plan queries.
+    """
+    location = f"s3://{TEST_BUCKET}/test_scan_snapshot_benchmark/{table_name}"
+
+    run_command(
+        f"""
+        CREATE TABLE test_scan_snapshot_benchmark.{table_name} (id int)
+        USING iceberg WITH (autovacuum_enabled='False');
+
+        INSERT INTO lake_table.files (table_name, path, file_size, row_count, deleted_row_count)
+        SELECT 'test_scan_snapshot_benchmark.{table_name}'::regclass,
+               '{location}/data_' || s || '.parquet', 1000, 10, 0
+        FROM generate_series(1, {file_count}) s;
+
+        INSERT INTO lake_table.files (table_name, path, file_size, row_count, content)
+        SELECT 'test_scan_snapshot_benchmark.{table_name}'::regclass,
+               '{location}/delete_' || s || '.parquet', 1000, 1, 1
+        FROM generate_series(10, {file_count}, 10) s;
+
+        INSERT INTO lake_table.deletion_file_map (table_name, path, deleted_from)
+        SELECT 'test_scan_snapshot_benchmark.{table_name}'::regclass,
+               '{location}/delete_' || s || '.parquet',
+               '{location}/data_' || s || '.parquet'
+        FROM generate_series(10, {file_count}, 10) s;
+    """,
+        conn,
+    )
+
+
+def time_delete_planning(conn, table_name):
+    start = time.time()
+    results = run_query(
+        f"EXPLAIN (verbose, format json) DELETE FROM test_scan_snapshot_benchmark.{table_name}",
+        conn,
+    )
+    return time.time() - start, results
+
+
+def test_scan_snapshot_benchmark(s3, superuser_conn, extension, with_default_location):
+    run_command("CREATE SCHEMA test_scan_snapshot_benchmark", superuser_conn)
+
+    create_table_with_files(superuser_conn, "small", 25000)
+    create_table_with_files(superuser_conn, "large", 100000)
+    run_command("ANALYZE lake_table.files, lake_table.deletion_file_map", superuser_conn)
+
+    # warm up the caches
+    time_delete_planning(superuser_conn, "small")
+
+    small_time, results = time_delete_planning(superuser_conn, "small")
+    assert int(fetch_data_files_skipped(results)) == 25000
+
+    large_time, results = time_delete_planning(superuser_conn, "large")
+    assert int(fetch_data_files_used(results)) == 0
+    assert int(fetch_data_files_skipped(results)) == 100000
+
+    # all position delete files are found for a scan of all files
+    results = run_query(
+        "EXPLAIN (verbose, format json) SELECT * FROM test_scan_snapshot_benchmark.large",
+        superuser_conn,
+    )
+    assert int(fetch_data_files_used(results)) == 100000
+    assert int(fetch_delete_files_used(results)) == 10000
+
+    print(
+        f"scan snapshot for 25000 files: {small_time:.3f}s, "
+        f"for 100000 files: {large_time:.3f}s"
+    )
+
+    # 4x the files should take about 4x the time, quadratic steps take 16x;
+    # the bound is generous to tolerate noisy timings on small machines
+    assert large_time < max(small_time, 0.5) * 12
+
+    superuser_conn.rollback()
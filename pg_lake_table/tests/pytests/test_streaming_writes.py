@@ -0,0 +1,116 @@
+import pytest
+from utils_pytest import *
+
+
+@pytest.mark.parametrize("streaming", ["on", "off"])
+def test_streaming_writes(s3, pg_conn, extension, with_default_location, streaming):
+    run_command(
+        f"""
+        SET pg_lake_table.enable_streaming_writes TO {streaming};
+        SET TimeZone TO 'UTC';
+        CREATE SCHEMA test_streaming_writes;
+        CREATE TABLE test_streaming_writes.tbl (
+            id int,
+            txt text,
+            num numeric(10,2),
+            ts timestamptz,
+            arr int[],
+            bin bytea
+        )
+        USING iceberg;
+    """,
+        pg_conn,
+    )
+
+    # values that require quoting or escaping in CSV
+    run_command(
+        """
+        INSERT INTO test_streaming_writes.tbl VALUES
+            (1, 'plain', 1.5, '2024-01-01 10:00:00+00', '{1,2}', '\\x00ff'),
+            (2, 'comma, "quote"', -2.25, NULL, '{}', NULL),
+            (3, E'new\\nline', NULL, '2024-02-29 23:59:59+00', NULL, '\\x'),
+            (4, '\\N', 0, NULL, '{NULL,3}', NULL),
+            (5, '', NULL, NULL, NULL, NULL),
+            (6, NULL, NULL, NULL, NULL, NULL);
+    """,
+        pg_conn,
+    )
+
+    result = run_query(
+        "SELECT id, txt, num::text, ts::text, arr::text, bin::text "
+        "FROM test_streaming_writes.tbl ORDER BY id",
+        pg_conn,
+    )
+    assert result == [
+        [1, "plain", "1.50", "2024-01-01 10:00:00+00", "{1,2}", "\\x00ff"],
+        [2, 'comma, "quote"', "-2.25", None, "{}", None],
+        [3, "new\nline", None, "2024-02-29 23:59:59+00", None, "\\x"],
+        [4, "\\N", "0.00", None, "{NULL,3}", None],
+        [5, "", None, None, None, None],
+        [6, None, None, None, None, None],
+    ]
+
+    # larger inserts are split into multiple data files in the same way
+    run_command(
+        """
+        SET LOCAL pg_lake_table.max_write_temp_file_size_mb TO 1;
+        INSERT INTO test_streaming_writes.tbl (id, txt)
+        SELECT s, repeat('x', 100) FROM generate_series(1, 20000) s;
+    """,
+        pg_conn,
+    )
+
+    result = run_query(
+        "SELECT count(*), sum(length(txt)) FROM test_streaming_writes.tbl WHERE id > 0",
+        pg_conn,
+    )
+    assert result == [[20006, 2000000 + 5 + 14 + 8 + 2 + 0]]
+
+    pg_conn.rollback()
+
+
+@pytest.mark.parametrize("streaming", ["on", "off"])
+@pytest.mark.parametrize("background_flushes", [0, 1, 3])
+def test_background_write_flushes(
+    s3, pg_conn, extension, with_default_location, streaming, background_flushes
+):
+    run_command(
+        f"""
+        SET pg_lake_table.enable_streaming_writes TO {streaming};
+        SET pg_lake_table.max_background_write_flushes TO {background_flushes};
+        SET pg_lake_table.max_write_temp_file_size_mb TO 1;
+        CREATE SCHEMA test_background_flushes;
+        CREATE TABLE test_background_flushes.tbl (id int, txt text)
+        USING iceberg;
+        INSERT INTO test_background_flushes.tbl
+        SELECT s, repeat('x', 100) FROM generate_series(1, 50000) s;
+    """,
+        pg_conn,
+    )
+
+    # each write file becomes its own data file
+    result = run_query(
+        "SELECT count(*) FROM lake_table.files "
+        "WHERE table_name = 'test_background_flushes.tbl'::regclass",
+        pg_conn,
+    )
+    assert result[0][0] > 1
+
+    result = run_query(
+        "SELECT count(*), count(DISTINCT id), sum(length(txt)) "
+        "FROM test_background_flushes.tbl",
+        pg_conn,
+    )
+    assert result == [[50000, 50000, 5000000]]
+
+    # a failing insert does not leave pending conversions behind
+    with pytest.raises(Exception, match="division by zero"):
+        run_command(
+            """
+            INSERT INTO test_background_flushes.tbl
+            SELECT s, CASE WHEN s < 40000 THEN repeat('x', 100) ELSE (1/(s - s))::text END
+            FROM generate_series(1, 50000) s;
+        """,
+            pg_conn,
+        )
+    pg_conn.rollback()
@@ -20,6 +20,7 @@
 
 #include <duckdb.h>
 #include "catalog/pg_type_d.h"
+#include "lib/stringinfo.h"
 #include "duckdb/duckdb.h"
 
 /*
@@ -46,6 +47,17 @@ typedef struct TextOutputBuffer
 	bool		needsFree;
 }			TextOutputBuffer;
 
+/*
+ * EncodedColumn holds the values of a column vector in PG wire format. The
+ * value of row i, including its length word (or its CSV representation for
+ * transmit), is stored in data between offsets[i] and offsets[i + 1].
+ */
+typedef struct EncodedColumn
+{
+	StringInfoData data;
+	int		   *offsets;
+}			EncodedColumn;
+
 typedef struct DuckDBTypeInfo
 {
 	duckdb_type duckType;
@@ -55,8 +67,28 @@ typedef struct DuckDBTypeInfo
 	 * for DuckDB types.
 	 */
 				DuckDBStatus(*to_text) (duckdb_vector vector, duckdb_logical_type logicalType, int row, TextOutputBuffer * buffer);
+
+	/*
+	 * PostgreSQL type whose binary format is produced by to_binary, or
+	 * InvalidOid if the type can only be sent as text.
+	 */
+	Oid			binaryTypeId;
+
+	/*
+	 * Function pointer for conversion, it is like SEND function in Postgres
+	 * for DuckDB types. It appends the length-prefixed value in binary
+	 * format of binaryTypeId to the output.
+	 */
+				DuckDBStatus(*to_binary) (duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output);
+
+	/*
+	 * Function pointer for converting a whole vector to binary format at
+	 * once, used instead of to_binary for fixed-size types.
+	 */
+				DuckDBStatus(*to_binary_column) (duckdb_vector vector, idx_t rowCount, uint64_t *validity, EncodedColumn * column);
 }			DuckDBTypeInfo;
 
 extern DuckDBTypeInfo * find_duck_type_info(duckdb_type duckType);
+extern Oid	find_binary_type_id(DuckDBTypeInfo * typeInfo, duckdb_logical_type logicalType);
 
 #endif
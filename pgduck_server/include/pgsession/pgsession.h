@@ -98,9 +98,6 @@ typedef enum PreparedStatementState
 
 /*
  * ResponseFormat describes the expected format of the response.
- *
- * If add parameters to the response format (e.g. binary vs. text), this
- * would be the place to put it.
  */
 typedef struct ResponseFormat
 {
@@ -109,14 +106,26 @@ typedef struct ResponseFormat
 	 * data to clients.
 	 */
 	bool		isTransmit;
+
+	/*
+	 * Result format codes from the Bind message. Following the protocol, no
+	 * codes means all columns are sent as text, a single code applies to all
+	 * columns, and otherwise there is one code per result column.
+	 *
+	 * Binary format is only used for columns whose type has a binary
+	 * representation (see find_binary_type_id), other columns fall back to
+	 * text and clients should check the format in the RowDescription.
+	 */
+	int16		resultFormatCount;
+	int16	   *resultFormats;
 }			ResponseFormat;
 
 
 /*
- * PG extended protocol also sends paramTypes, paramFormatCodes and
- * resultFormatCodes. However, DuckDB is smart to find the parameter
- * bindings from text format. And, none of its APIs support
- * resultFormatCodes etc. That's why we are not storing them here.
+ * PG extended protocol also sends paramTypes and paramFormatCodes. However,
+ * DuckDB is smart to find the parameter bindings from text format. That's
+ * why we are not storing them here. The resultFormatCodes are kept in the
+ * ResponseFormat.
  */
 typedef struct PgSessionPreparedStatement
 {
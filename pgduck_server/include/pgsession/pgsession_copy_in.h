@@ -0,0 +1,30 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Functions for receiving rows via the COPY-in sub-protocol.
+ *
+ * Copyright (c) 2025 Snowflake Computing, Inc. All rights reserved.
+ */
+#ifndef PGDUCK_PG_SESSION_COPY_IN_H
+#define PGDUCK_PG_SESSION_COPY_IN_H
+
+#include "pgsession/pgsession.h"
+
+extern int	pgsession_process_copy_in(PGSession * pgSession, const char *tableName);
+
+#endif							/* // PGDUCK_PG_SESSION_COPY_IN_H */
@@ -94,6 +94,21 @@ pq_writeint32(StringInfoData *pg_restrict buf, uint32 value)
 	buf->len += sizeof(uint32);
 }
 
+/*
+ * Append a [u]int64 to a StringInfo buffer, which already has enough space
+ * preallocated.
+ *
+ * Copied verbatim from src/include/libpq/pqformat.h except for Assert.
+ */
+static inline void
+pq_writeint64(StringInfoData *pg_restrict buf, uint64 value)
+{
+	uint64		ni = pg_hton64(value);
+
+	memcpy((char *pg_restrict) (buf->data + buf->len), &ni, sizeof(uint64));
+	buf->len += sizeof(uint64);
+}
+
 
 /*
  * Append a binary [u]int8 to a StringInfo buffer
@@ -131,6 +146,18 @@ pq_sendint32(StringInfo buf, uint32 value)
 	pq_writeint32(buf, value);
 }
 
+/*
+ * Append a binary [u]int64 to a StringInfo buffer.
+ *
+ * Copied verbatim from src/include/libpq/pqformat.h.
+ */
+static inline void
+pq_sendint64(StringInfo buf, uint64 value)
+{
+	enlargeStringInfo(buf, sizeof(uint64));
+	pq_writeint64(buf, value);
+}
+
 
 /*
  * Append a binary byte to a StringInfo buffer.
@@ -78,6 +78,13 @@ typedef struct DuckDBResultColumn
 {
 	duckdb_type duckType;
 	duckdb_logical_type logicalType;
+	DuckDBTypeInfo *typeInfo;
+
+	/* PG_WIRE_TEXT_FORMAT or PG_WIRE_BINARY_FORMAT */
+	int16		format;
+
+	/* values of the current chunk in wire format */
+	EncodedColumn encoded;
 }			DuckDBResultColumn;
 
 typedef struct DuckDBQueryResult
@@ -126,16 +133,22 @@ static DuckDBStatus process_data_chunk(duckdb_data_chunk chunk, StringInfoData *
 									   DuckDBResultColumn * resultColumns,
 									   idx_t columnCount,
 									   ResponseFormat * responseFormat);
+static DuckDBStatus encode_column_vector(DuckDBResultColumn * resultColumn,
+										 duckdb_vector vector,
+										 idx_t rowCount,
+										 ResponseFormat * responseFormat);
 static void create_result_column_state(DuckDBResultColumn * resultColumn,
 									   duckdb_data_chunk chunk,
 									   idx_t columnCount);
 static void destroy_result_column_state(DuckDBResultColumn * resultColumns, idx_t columnCount);
 static void duckdb_query_result_destroy(DuckDBQueryResult * duckdb_query_result);
-static DuckDBStatus duckdb_vector_to_pg_wire(duckdb_vector vector, duckdb_type duckType,
+static DuckDBStatus duckdb_vector_to_pg_wire(duckdb_vector vector, DuckDBTypeInfo * typeInfo,
 											 duckdb_logical_type logicalType,
 											 int row,
+											 int16 format,
 											 ResponseFormat * responseFormat,
 											 StringInfo output);
+static int16 requested_result_format(ResponseFormat * responseFormat, idx_t columnIndex);
 static bool is_set_command(const char *command);
 static void append_escaped_csv(StringInfo buffer, char *value);
 static void append_completion_tag(char *buffer, duckdb_result duckResult, idx_t rowsReturned);
@@ -663,20 +676,25 @@ duckdb_session_destroy(DuckDBSession * duckSession)
 
 /*
  * duckdb_vector_to_pg_wire writes a specific value from a DuckDB query
- * result to the output buffer in PG wire text format.
+ * result to the output buffer in PG wire text or binary format.
  */
 static DuckDBStatus
-duckdb_vector_to_pg_wire(duckdb_vector vector, duckdb_type duckType,
+duckdb_vector_to_pg_wire(duckdb_vector vector, DuckDBTypeInfo * typeMap,
 						 duckdb_logical_type logicalType,
 						 int row,
+						 int16 format,
 						 ResponseFormat * responseFormat,
 						 StringInfo output)
 {
-	DuckDBTypeInfo *typeMap = find_duck_type_info(duckType);
+	if (format == PG_WIRE_BINARY_FORMAT)
+	{
+		/* binary format is only chosen for types with to_binary */
+		return typeMap->to_binary(vector, logicalType, row, output);
+	}
 
-	if (typeMap == NULL || typeMap->to_text == NULL)
+	if (typeMap->to_text == NULL)
 	{
-		PGDUCK_SERVER_ERROR("could not find type mapping for DuckDB type: %d", duckType);
+		PGDUCK_SERVER_ERROR("could not find type mapping for DuckDB type: %d", typeMap->duckType);
 		return DUCKDB_TYPE_CONVERSION_ERROR;
 	}
 
@@ -1093,6 +1111,17 @@ duckdb_query_result_init(DuckDBQueryResult * duckdb_query_result, duckdb_result
 					   + sizeof(int16)) * duckdb_query_result->columnCount);
 	duckdb_query_result->resultColumns =
 		palloc0(sizeof(DuckDBResultColumn) * duckdb_query_result->columnCount);
+
+	/* a chunk has at most duckdb_vector_size() rows */
+	idx_t		maxRowCount = duckdb_vector_size();
+
+	for (idx_t columnIndex = 0; columnIndex < duckdb_query_result->columnCount; columnIndex++)
+	{
+		EncodedColumn *encoded = &duckdb_query_result->resultColumns[columnIndex].encoded;
+
+		initStringInfo(&encoded->data);
+		encoded->offsets = palloc(sizeof(int) * (maxRowCount + 1));
+	}
 }
 
 /*
@@ -1138,6 +1167,23 @@ duckdb_query_result_send_column_metadata(DuckDBQueryResult * duckdb_query_result
 			return DUCKDB_TYPE_CONVERSION_ERROR;
 		}
 
+		/*
+		 * Use binary format if the client asked for it and we know how to
+		 * produce the binary format of a matching PostgreSQL type.
+		 */
+		Oid			binaryTypeId = InvalidOid;
+
+		if (!responseFormat->isTransmit &&
+			requested_result_format(responseFormat, columnIndex) == PG_WIRE_BINARY_FORMAT)
+		{
+			duckdb_logical_type logicalType = duckdb_column_logical_type(duckResult, columnIndex);
+
+			binaryTypeId = find_binary_type_id(typeInfo, logicalType);
+			duckdb_destroy_logical_type(&logicalType);
+		}
+
+		int16		format = OidIsValid(binaryTypeId) ? PG_WIRE_BINARY_FORMAT : PG_WIRE_TEXT_FORMAT;
+
 		if (!responseFormat->isTransmit)
 		{
 			pq_writestring(buf, columnName);
@@ -1145,17 +1191,21 @@ duckdb_query_result_send_column_metadata(DuckDBQueryResult * duckdb_query_result
 			pq_writeint16(buf, originalColumnNumber);
 
 			/*
-			 * We always send columnTypeId=InvalidOid, columnLength=-1,
-			 * columnTypeMod=-1 see TypeInfo struct comment for the reasoning.
+			 * For text columns, we always send columnTypeId=InvalidOid, see
+			 * TypeInfo struct comment for the reasoning. Binary columns need
+			 * the type to be interpreted. We always send columnLength=-1 and
+			 * columnTypeMod=-1.
 			 */
-			pq_writeint32(buf, InvalidOid);
+			pq_writeint32(buf, binaryTypeId);
 			pq_writeint16(buf, -1);
 			pq_writeint32(buf, -1);
 		}
 
-		pq_writeint16(buf, PG_WIRE_TEXT_FORMAT);
+		pq_writeint16(buf, format);
 
 		resultColumn->duckType = duckType;
+		resultColumn->typeInfo = typeInfo;
+		resultColumn->format = format;
 	}
 
 	if (!IsOK(pq_endmessage_reuse(clientSession, buf)))
@@ -1251,6 +1301,11 @@ process_and_send_data_chunks(DuckDBQueryResult * duckdb_query_result,
  *
  * It supports both regular query results through DataRow messages or batches
  * of query results in CSV format through CopyData messages.
+ *
+ * The chunk is converted one column at a time, such that the type dispatch
+ * and NULL handling happen once per vector, and fixed-size binary columns
+ * are converted in a tight loop. The messages are then assembled from the
+ * encoded values of each row.
  */
 static DuckDBStatus
 process_data_chunk(duckdb_data_chunk chunk, StringInfoData *buf, PGSession * clientSession,
@@ -1260,6 +1315,20 @@ process_data_chunk(duckdb_data_chunk chunk, StringInfoData *buf, PGSession * cli
 	idx_t		chunkSize = duckdb_data_chunk_get_size(chunk);
 	bool		isTransmit = responseFormat->isTransmit;
 
+	for (idx_t columnIndex = 0; columnIndex < columnCount; columnIndex++)
+	{
+		DuckDBResultColumn *resultColumn = &resultColumns[columnIndex];
+		duckdb_vector vector = duckdb_data_chunk_get_vector(chunk, columnIndex);
+
+		if (!IsOK(encode_column_vector(resultColumn, vector, chunkSize, responseFormat)))
+		{
+			PGDUCK_SERVER_ERROR("could not convert column data type to PG wire format: %d",
+								resultColumn->duckType);
+
+			return DUCKDB_TYPE_CONVERSION_ERROR;
+		}
+	}
+
 	if (isTransmit)
 	{
 		/*
@@ -1292,47 +1361,33 @@ process_data_chunk(duckdb_data_chunk chunk, StringInfoData *buf, PGSession * cli
 			pq_beginmessage_reuse(buf, 'd');
 		}
 
+		/* reserve space for the whole row, including separators */
+		int			rowLength = isTransmit ? columnCount : 0;
+
 		for (idx_t columnIndex = 0; columnIndex < columnCount; columnIndex++)
 		{
-			DuckDBResultColumn *resultColumn = &resultColumns[columnIndex];
-			duckdb_type duckType = resultColumn->duckType;
-			duckdb_logical_type logicalType = resultColumn->logicalType;
-			duckdb_vector vector = duckdb_data_chunk_get_vector(chunk, columnIndex);
-			uint64_t   *validity = duckdb_vector_get_validity(vector);
+			int		   *offsets = resultColumns[columnIndex].encoded.offsets;
 
-			if (isTransmit && columnIndex > 0)
-			{
-				appendStringInfoCharMacro(buf, TRANSMIT_COLUMN_SEPARATOR_CHAR);
-			}
+			rowLength += offsets[rowInChunk + 1] - offsets[rowInChunk];
+		}
 
-			/*
-			 * In DuckDB terminology, validity is used to indicate whether a
-			 * row inside a chunk is not NULL. So, if a row is NULL, we should
-			 * send -1 to the client session.
-			 */
-			if (validity != NULL && !duckdb_validity_row_is_valid(validity, rowInChunk))
-			{
-				if (!isTransmit)
-				{
-					/* -1 indicates a NULL column value in PG protocol */
-					pq_sendint32(buf, -1);
-				}
-				else
-				{
-					appendStringInfoString(buf, TRANSMIT_NULL_STRING);
-				}
+		enlargeStringInfo(buf, rowLength);
 
-				continue;
-			}
+		for (idx_t columnIndex = 0; columnIndex < columnCount; columnIndex++)
+		{
+			EncodedColumn *encoded = &resultColumns[columnIndex].encoded;
+			int			valueStart = encoded->offsets[rowInChunk];
+			int			valueLength = encoded->offsets[rowInChunk + 1] - valueStart;
 
-			if (!IsOK(duckdb_vector_to_pg_wire(vector, duckType, logicalType, rowInChunk, responseFormat, buf)))
-			{
-				PGDUCK_SERVER_ERROR("could not convert column data type to PG wire format: %d", duckType);
+			if (isTransmit && columnIndex > 0)
+				buf->data[buf->len++] = TRANSMIT_COLUMN_SEPARATOR_CHAR;
 
-				return DUCKDB_TYPE_CONVERSION_ERROR;
-			}
+			memcpy(buf->data + buf->len, encoded->data.data + valueStart, valueLength);
+			buf->len += valueLength;
 		}
 
+		buf->data[buf->len] = '\0';
+
 		/* send the DataRow message */
 		if (!isTransmit && !IsOK(pq_endmessage_reuse(clientSession, buf)))
 		{
@@ -1361,6 +1416,68 @@ process_data_chunk(duckdb_data_chunk chunk, StringInfoData *buf, PGSession * cli
 }
 
 
+/*
+ * encode_column_vector converts all values in the vector of a result column
+ * into wire format, and stores them in the encoded column of the result
+ * column.
+ */
+static DuckDBStatus
+encode_column_vector(DuckDBResultColumn * resultColumn, duckdb_vector vector,
+					 idx_t rowCount, ResponseFormat * responseFormat)
+{
+	EncodedColumn *encoded = &resultColumn->encoded;
+	DuckDBTypeInfo *typeInfo = resultColumn->typeInfo;
+	uint64_t   *validity = duckdb_vector_get_validity(vector);
+	bool		isTransmit = responseFormat->isTransmit;
+
+	resetStringInfo(&encoded->data);
+
+	if (resultColumn->format == PG_WIRE_BINARY_FORMAT &&
+		typeInfo->to_binary_column != NULL)
+	{
+		return typeInfo->to_binary_column(vector, rowCount, validity, encoded);
+	}
+
+	for (idx_t row = 0; row < rowCount; row++)
+	{
+		encoded->offsets[row] = encoded->data.len;
+
+		/*
+		 * In DuckDB terminology, validity is used to indicate whether a row
+		 * inside a chunk is not NULL. So, if a row is NULL, we should send -1
+		 * to the client session.
+		 */
+		if (validity != NULL && !duckdb_validity_row_is_valid(validity, row))
+		{
+			if (!isTransmit)
+			{
+				/* -1 indicates a NULL column value in PG protocol */
+				pq_sendint32(&encoded->data, -1);
+			}
+			else
+			{
+				appendStringInfoString(&encoded->data, TRANSMIT_NULL_STRING);
+			}
+
+			continue;
+		}
+
+		DuckDBStatus status = duckdb_vector_to_pg_wire(vector, typeInfo,
+													   resultColumn->logicalType,
+													   row, resultColumn->format,
+													   responseFormat,
+													   &encoded->data);
+
+		if (status != DUCKDB_SUCCESS)
+			return status;
+	}
+
+	encoded->offsets[rowCount] = encoded->data.len;
+
+	return DUCKDB_SUCCESS;
+}
+
+
 /*
  * create_result_column_state sets the logical types for each of the vectors
  * in the ResultColumn
@@ -1394,6 +1511,27 @@ destroy_result_column_state(DuckDBResultColumn * resultColumns, idx_t columnCoun
 }
 
 
+/*
+ * requested_result_format returns the format code the client requested for
+ * the given result column in the Bind message.
+ */
+static int16
+requested_result_format(ResponseFormat * responseFormat, idx_t columnIndex)
+{
+	if (responseFormat->resultFormatCount == 0)
+		return PG_WIRE_TEXT_FORMAT;
+
+	/* a single format code applies to all columns */
+	if (responseFormat->resultFormatCount == 1)
+		return responseFormat->resultFormats[0];
+
+	if (columnIndex >= responseFormat->resultFormatCount)
+		return PG_WIRE_TEXT_FORMAT;
+
+	return responseFormat->resultFormats[columnIndex];
+}
+
+
 /*
  * Cleans up the resources used by the DuckDB query.
  *
@@ -1403,6 +1541,14 @@ destroy_result_column_state(DuckDBResultColumn * resultColumns, idx_t columnCoun
 static void
 duckdb_query_result_destroy(DuckDBQueryResult * duckdb_query_result)
 {
+	for (idx_t columnIndex = 0; columnIndex < duckdb_query_result->columnCount; columnIndex++)
+	{
+		EncodedColumn *encoded = &duckdb_query_result->resultColumns[columnIndex].encoded;
+
+		pfree(encoded->data.data);
+		pfree(encoded->offsets);
+	}
+
 	pfree(duckdb_query_result->buf.data);
 	pfree(duckdb_query_result->resultColumns);
 }
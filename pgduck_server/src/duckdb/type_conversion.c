@@ -31,9 +31,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "common/int.h"
+#include "datatype/timestamp.h"
 #include "duckdb/duckdb.h"
 #include "duckdb/type_conversion.h"
 #include "duckdb/duckdb_pglake.h"
+#include "pgsession/pqformat.h"
 #include "utils/pgduck_log_utils.h"
 #include "utils/hex.h"
 #include "utils/numutils.h"
@@ -65,6 +68,74 @@ static DuckDBStatus func_name(duckdb_vector vector, duckdb_logical_type logicalT
     return CHECK_OOM(toTextBuffer->buffer);								\
 }
 
+/*
+ * Encodes a whole vector of fixed-size values in binary format, as wire_type
+ * (in network byte order) preceded by its length.
+ *
+ * All cells have the same size, so when there are no NULLs, the loop is a
+ * plain strided copy without branches, which the compiler can vectorize.
+ * to_wire may set failed for values that cannot be represented.
+ */
+#define DEFINE_TO_BINARY_COLUMN_FUNCTION(func_name, data_type, wire_type, to_wire) \
+static DuckDBStatus func_name(duckdb_vector vector, idx_t rowCount, uint64_t *validity, EncodedColumn *column) \
+{                                                                  \
+    const data_type *values = (const data_type *) duckdb_vector_get_data(vector); \
+    StringInfo output = &column->data;                             \
+    const int cellSize = sizeof(uint32) + sizeof(wire_type);      \
+    const uint32 wireLength = pg_hton32(sizeof(wire_type));       \
+    const uint32 nullLength = pg_hton32((uint32) -1);              \
+    bool failed = false;                                           \
+    enlargeStringInfo(output, rowCount * cellSize);                \
+    int start = output->len;                                       \
+    char *cells = output->data + start;                            \
+    if (validity == NULL)                                          \
+    {                                                              \
+        for (idx_t row = 0; row < rowCount; row++)                 \
+        {                                                          \
+            wire_type wireValue = to_wire(values[row], &failed);   \
+            memcpy(cells + row * cellSize, &wireLength, sizeof(uint32)); \
+            memcpy(cells + row * cellSize + sizeof(uint32), &wireValue, sizeof(wire_type)); \
+            column->offsets[row] = start + row * cellSize;         \
+        }                                                          \
+        output->len += rowCount * cellSize;                        \
+    }                                                              \
+    else                                                           \
+    {                                                              \
+        char *cell = cells;                                        \
+        for (idx_t row = 0; row < rowCount; row++)                 \
+        {                                                          \
+            column->offsets[row] = start + (cell - cells);         \
+            if (!duckdb_validity_row_is_valid(validity, row))      \
+            {                                                      \
+                memcpy(cell, &nullLength, sizeof(uint32));         \
+                cell += sizeof(uint32);                            \
+                continue;                                          \
+            }                                                      \
+            wire_type wireValue = to_wire(values[row], &failed);   \
+            memcpy(cell, &wireLength, sizeof(uint32));             \
+            memcpy(cell + sizeof(uint32), &wireValue, sizeof(wire_type)); \
+            cell += cellSize;                                      \
+        }                                                          \
+        output->len += cell - cells;                               \
+    }                                                              \
+    column->offsets[rowCount] = output->len;                       \
+    return failed ? DUCKDB_TYPE_CONVERSION_ERROR : DUCKDB_SUCCESS; \
+}
+
+/* number of days between 1970-01-01 (DuckDB) and 2000-01-01 (PostgreSQL) */
+#define POSTGRES_EPOCH_OFFSET_DAYS (POSTGRES_EPOCH_JDATE - UNIX_EPOCH_JDATE)
+#define POSTGRES_EPOCH_OFFSET_USECS (POSTGRES_EPOCH_OFFSET_DAYS * USECS_PER_DAY)
+
+/* DuckDB represents (-)infinity using the largest (negated) value */
+#define DUCKDB_DATE_INFINITY (PG_INT32_MAX)
+#define DUCKDB_TIMESTAMP_INFINITY (PG_INT64_MAX)
+
+/* numeric binary format, see numeric_send */
+#define NUMERIC_BINARY_POS 0x0000
+#define NUMERIC_BINARY_NEG 0x4000
+#define NUMERIC_BINARY_DEC_DIGITS 4
+#define NUMERIC_BINARY_MAX_DIGITS 16
+
 static DuckDBStatus pg_varchar_to_text(duckdb_string_t val, TextOutputBuffer * toTextBuffer);
 static DuckDBStatus pg_uuid_to_text(duckdb_hugeint val, TextOutputBuffer * toTextBuffer);
 static DuckDBStatus pg_hugeint_to_text(duckdb_hugeint val, TextOutputBuffer * toTextBuffer);
@@ -118,6 +189,112 @@ static DuckDBStatus struct_to_text(duckdb_vector vector, duckdb_logical_type log
 
 static void AppendFieldValue(const char *value, bool useQuote, StringInfo output);
 
+/*
+ * Conversions of fixed-size values to their binary format in network byte
+ * order.
+ */
+static inline uint8
+bool_to_wire(bool value, bool *failed)
+{
+	return value ? 1 : 0;
+}
+
+static inline uint16
+int16_to_wire(int16 value, bool *failed)
+{
+	return pg_hton16((uint16) value);
+}
+
+static inline uint32
+int32_to_wire(int32 value, bool *failed)
+{
+	return pg_hton32((uint32) value);
+}
+
+static inline uint64
+int64_to_wire(int64 value, bool *failed)
+{
+	return pg_hton64((uint64) value);
+}
+
+static inline uint32
+float4_to_wire(float4 value, bool *failed)
+{
+	uint32		bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	return pg_hton32(bits);
+}
+
+static inline uint64
+float8_to_wire(float8 value, bool *failed)
+{
+	uint64		bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	return pg_hton64(bits);
+}
+
+/*
+ * date_to_wire converts a date to date binary format, which counts days
+ * since 2000-01-01 instead of 1970-01-01.
+ */
+static inline uint32
+date_to_wire(duckdb_date value, bool *failed)
+{
+	int32		pgDate = 0;
+
+	if (value.days == DUCKDB_DATE_INFINITY)
+		pgDate = PG_INT32_MAX;
+	else if (value.days == -DUCKDB_DATE_INFINITY)
+		pgDate = PG_INT32_MIN;
+	else
+		*failed |= pg_sub_s32_overflow(value.days, POSTGRES_EPOCH_OFFSET_DAYS, &pgDate);
+
+	return pg_hton32((uint32) pgDate);
+}
+
+/*
+ * timestamp_to_wire converts a timestamp or timestamptz to binary format,
+ * which counts microseconds since 2000-01-01 instead of 1970-01-01. Both
+ * DuckDB and PostgreSQL store timestamptz as UTC.
+ */
+static inline uint64
+timestamp_to_wire(duckdb_timestamp value, bool *failed)
+{
+	int64		pgTimestamp = 0;
+
+	if (value.micros == DUCKDB_TIMESTAMP_INFINITY)
+		pgTimestamp = DT_NOEND;
+	else if (value.micros == -DUCKDB_TIMESTAMP_INFINITY)
+		pgTimestamp = DT_NOBEGIN;
+	else
+		*failed |= pg_sub_s64_overflow(value.micros, POSTGRES_EPOCH_OFFSET_USECS, &pgTimestamp);
+
+	return pg_hton64((uint64) pgTimestamp);
+}
+
+DEFINE_TO_BINARY_COLUMN_FUNCTION(boolean_to_binary_column, bool, uint8, bool_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(tinyint_to_binary_column, int8_t, uint16, int16_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(smallint_to_binary_column, int16_t, uint16, int16_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(int_to_binary_column, int32_t, uint32, int32_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(bigint_to_binary_column, int64_t, uint64, int64_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(utinyint_to_binary_column, uint8_t, uint16, int16_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(usmallint_to_binary_column, uint16_t, uint32, int32_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(uint_to_binary_column, uint32_t, uint64, int64_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(float4_to_binary_column, float4, uint32, float4_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(float8_to_binary_column, float8, uint64, float8_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(date_to_binary_column, duckdb_date, uint32, date_to_wire)
+DEFINE_TO_BINARY_COLUMN_FUNCTION(timestamp_to_binary_column, duckdb_timestamp, uint64, timestamp_to_wire)
+
+/* variable-size types are sent one value at a time */
+
+static DuckDBStatus varchar_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output);
+static DuckDBStatus blob_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output);
+static DuckDBStatus uuid_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output);
+static DuckDBStatus decimal_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output);
+static void pg_decimal_to_binary(uint64 absValue, bool isNegative, int scale, StringInfo output);
+
 /*
  * This comment explains how DuckDB types are converted to PostgreSQL types
  * over the wire.
@@ -146,6 +323,12 @@ static void AppendFieldValue(const char *value, bool useQuote, StringInfo output
  * If adopting this smaller type approach, consistency is key, especially when converting
  * types for tables created from parquet files. To fully implement this, considering
  * PostgreSQL extensions for any missing types might be necessary.
+ *
+ * When a client requests binary results in the Bind message, we do follow the
+ * smallest type approach for the common scalar types that have a to_binary
+ * function. Those columns are announced with binaryTypeId in RowDescription
+ * and sent in the binary format of that PostgreSQL type. All other types are
+ * still sent as text with InvalidOid.
  */
 static DuckDBTypeInfo TypeInfo[] =
 {
@@ -164,7 +347,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * byte.
 	 */
 	{
-		 /* 1 */ DUCKDB_TYPE_BOOLEAN, boolean_to_text
+		 /* 1 */ DUCKDB_TYPE_BOOLEAN, boolean_to_text, BOOLOID, NULL, boolean_to_binary_column
 	},
 
 	/*
@@ -176,7 +359,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * can hold the value.
 	 */
 	{
-		 /* 2 */ DUCKDB_TYPE_TINYINT, tinyint_to_text
+		 /* 2 */ DUCKDB_TYPE_TINYINT, tinyint_to_text, INT2OID, NULL, tinyint_to_binary_column
 	},
 
 	/*
@@ -184,7 +367,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * is 2 bytes.
 	 */
 	{
-		 /* 3 */ DUCKDB_TYPE_SMALLINT, smallint_to_text
+		 /* 3 */ DUCKDB_TYPE_SMALLINT, smallint_to_text, INT2OID, NULL, smallint_to_binary_column
 	},
 
 	/*
@@ -192,7 +375,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * bytes.
 	 */
 	{
-		 /* 4 */ DUCKDB_TYPE_INTEGER, int_to_text
+		 /* 4 */ DUCKDB_TYPE_INTEGER, int_to_text, INT4OID, NULL, int_to_binary_column
 	},
 
 	/*
@@ -200,7 +383,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * bytes.
 	 */
 	{
-		 /* 5 */ DUCKDB_TYPE_BIGINT, bigint_to_text
+		 /* 5 */ DUCKDB_TYPE_BIGINT, bigint_to_text, INT8OID, NULL, bigint_to_binary_column
 	},
 
 	/*
@@ -212,7 +395,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * can hold the value.
 	 */
 	{
-		 /* 6 */ DUCKDB_TYPE_UTINYINT, utinyint_to_text
+		 /* 6 */ DUCKDB_TYPE_UTINYINT, utinyint_to_text, INT2OID, NULL, utinyint_to_binary_column
 	},
 
 	/*
@@ -220,7 +403,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * (INT2OID) is 2 bytes.
 	 */
 	{
-		 /* 7 */ DUCKDB_TYPE_USMALLINT, usmallint_to_text
+		 /* 7 */ DUCKDB_TYPE_USMALLINT, usmallint_to_text, INT4OID, NULL, usmallint_to_binary_column
 	},
 
 	/*
@@ -228,7 +411,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * is 4 bytes.
 	 */
 	{
-		 /* 8 */ DUCKDB_TYPE_UINTEGER, uint_to_text
+		 /* 8 */ DUCKDB_TYPE_UINTEGER, uint_to_text, INT8OID, NULL, uint_to_binary_column
 	},
 
 	/*
@@ -244,7 +427,7 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * bytes.
 	 */
 	{
-		 /* 10 */ DUCKDB_TYPE_FLOAT, float4_to_text
+		 /* 10 */ DUCKDB_TYPE_FLOAT, float4_to_text, FLOAT4OID, NULL, float4_to_binary_column
 	},
 
 	/*
@@ -252,15 +435,15 @@ static DuckDBTypeInfo TypeInfo[] =
 	 * 8 bytes.
 	 */
 	{
-		 /* 11 */ DUCKDB_TYPE_DOUBLE, float8_to_text
+		 /* 11 */ DUCKDB_TYPE_DOUBLE, float8_to_text, FLOAT8OID, NULL, float8_to_binary_column
 	},
 
 	{
-		 /* 12 */ DUCKDB_TYPE_TIMESTAMP, timestamp_to_text
+		 /* 12 */ DUCKDB_TYPE_TIMESTAMP, timestamp_to_text, TIMESTAMPOID, NULL, timestamp_to_binary_column
 	},
 
 	{
-		 /* 13 */ DUCKDB_TYPE_DATE, date_to_text
+		 /* 13 */ DUCKDB_TYPE_DATE, date_to_text, DATEOID, NULL, date_to_binary_column
 	},
 
 	{
@@ -276,14 +459,14 @@ static DuckDBTypeInfo TypeInfo[] =
 	},
 
 	{
-		 /* 17 */ DUCKDB_TYPE_VARCHAR, varchar_to_text
+		 /* 17 */ DUCKDB_TYPE_VARCHAR, varchar_to_text, TEXTOID, varchar_to_binary
 	},
 
 	{
-		 /* 18 */ DUCKDB_TYPE_BLOB, blob_to_text
+		 /* 18 */ DUCKDB_TYPE_BLOB, blob_to_text, BYTEAOID, blob_to_binary
 	},
 	{
-		 /* 19 */ DUCKDB_TYPE_DECIMAL, decimal_to_text
+		 /* 19 */ DUCKDB_TYPE_DECIMAL, decimal_to_text, NUMERICOID, decimal_to_binary
 	},
 	{
 		 /* 20 */ DUCKDB_TYPE_TIMESTAMP_S, timestampsec_to_text
@@ -307,7 +490,7 @@ static DuckDBTypeInfo TypeInfo[] =
 		 /* 26 */ DUCKDB_TYPE_MAP, map_to_text
 	},
 	{
-		 /* 27 */ DUCKDB_TYPE_UUID, uuid_to_text
+		 /* 27 */ DUCKDB_TYPE_UUID, uuid_to_text, UUIDOID, uuid_to_binary
 	},
 	{
 		 /* 28 */ DUCKDB_TYPE_UNION, NULL
@@ -319,7 +502,7 @@ static DuckDBTypeInfo TypeInfo[] =
 		 /* 30 */ DUCKDB_TYPE_TIME_TZ, time_tz_to_text
 	},
 	{
-		 /* 31 */ DUCKDB_TYPE_TIMESTAMP_TZ, timestamp_tz_to_text
+		 /* 31 */ DUCKDB_TYPE_TIMESTAMP_TZ, timestamp_tz_to_text, TIMESTAMPTZOID, NULL, timestamp_to_binary_column
 	},
 	{
 		 /* 32 */ DUCKDB_TYPE_UHUGEINT, uhugeint_to_text
@@ -342,6 +525,46 @@ find_duck_type_info(duckdb_type duckType)
 	return NULL;
 }
 
+/*
+ * find_binary_type_id returns the PostgreSQL type that values of the given
+ * DuckDB type are sent as in binary format, or InvalidOid if they can only
+ * be sent as text.
+ */
+Oid
+find_binary_type_id(DuckDBTypeInfo * typeInfo, duckdb_logical_type logicalType)
+{
+	if (typeInfo == NULL ||
+		(typeInfo->to_binary == NULL && typeInfo->to_binary_column == NULL))
+		return InvalidOid;
+
+	switch (typeInfo->duckType)
+	{
+		case DUCKDB_TYPE_BLOB:
+			{
+				/* geometry types use a dedicated text representation */
+				char	   *typeAlias = duckdb_logical_type_get_alias(logicalType);
+				bool		hasAlias = typeAlias != NULL;
+
+				if (typeAlias != NULL)
+					duckdb_free(typeAlias);
+
+				return hasAlias ? InvalidOid : typeInfo->binaryTypeId;
+			}
+
+		case DUCKDB_TYPE_DECIMAL:
+			{
+				/* hugeint-backed decimals are rare, keep those as text */
+				if (duckdb_decimal_internal_type(logicalType) == DUCKDB_TYPE_HUGEINT)
+					return InvalidOid;
+
+				return typeInfo->binaryTypeId;
+			}
+
+		default:
+			return typeInfo->binaryTypeId;
+	}
+}
+
 /*
  * This function performs necessary cleanup of a TextOutputBuffer for handling
  * error conditions.
@@ -1342,3 +1565,163 @@ AppendFieldValue(const char *value, bool useRecordQuoting, StringInfo output)
 #undef APPENDCHAR
 	}
 }
+
+
+/*
+ * varchar_to_binary sends a varchar in text binary format, which is the same
+ * as its text format.
+ */
+static DuckDBStatus
+varchar_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output)
+{
+	void	   *data = duckdb_vector_get_data(vector);
+	duckdb_string_t val = VECTOR_VALUE(data, duckdb_string_t, row);
+
+	const char *stringData = duckdb_string_t_data(&val);
+	uint32_t	stringLength = duckdb_string_t_length(val);
+
+	pq_sendcountedtext(output, stringData, stringLength, false);
+
+	return DUCKDB_SUCCESS;
+}
+
+
+/*
+ * blob_to_binary sends a blob in bytea binary format, which is the raw bytes
+ * rather than the hex encoding used in text format.
+ */
+static DuckDBStatus
+blob_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output)
+{
+	void	   *data = duckdb_vector_get_data(vector);
+	duckdb_string_t val = VECTOR_VALUE(data, duckdb_string_t, row);
+
+	const char *blobData = duckdb_string_t_data(&val);
+	uint32_t	blobLength = duckdb_string_t_length(val);
+
+	pq_sendint32(output, blobLength);
+	pq_sendbytes(output, blobData, blobLength);
+
+	return DUCKDB_SUCCESS;
+}
+
+
+/*
+ * uuid_to_binary sends a UUID as 16 bytes in network order.
+ *
+ * DuckDB stores UUIDs as a hugeint with the most significant bit flipped to
+ * get the right sort order, so we flip it back.
+ */
+static DuckDBStatus
+uuid_to_binary(duckdb_vector vector, duckdb_logical_type logicalType, int row, StringInfo output)
+{
+	void	   *data = duckdb_vector_get_data(vector);
+	duckdb_hugeint val = VECTOR_VALUE(data, duckdb_hugeint, row);
+
+	uint64		upper = ((uint64) val.upper) ^ (UINT64CONST(1) << 63);
+
+	pq_sendint32(output, 2 * sizeof(uint64));
+	pq_sendint64(output, upper);
+	pq_sendint64(output, val.lower);
+
+	return DUCKDB_SUCCESS;
+}
+
+
+/*
+ * decimal_to_binary sends a decimal in numeric binary format.
+ *
+ * Only decimals that are backed by up to 64-bit integers are supported,
+ * see find_binary_type_id.
+ */
+static DuckDBStatus
+decimal_to_binary(duckdb_vector vector, duckdb_logical_type decimalType, int row, StringInfo output)
+{
+	void	   *data = duckdb_vector_get_data(vector);
+	duckdb_type valueType = duckdb_decimal_internal_type(decimalType);
+	int			scale = duckdb_decimal_scale(decimalType);
+	int64		val;
+
+	switch (valueType)
+	{
+		case DUCKDB_TYPE_SMALLINT:
+			val = VECTOR_VALUE(data, int16_t, row);
+			break;
+
+		case DUCKDB_TYPE_INTEGER:
+			val = VECTOR_VALUE(data, int32_t, row);
+			break;
+
+		case DUCKDB_TYPE_BIGINT:
+			val = VECTOR_VALUE(data, int64_t, row);
+			break;
+
+		default:
+			return DUCKDB_TYPE_CONVERSION_ERROR;
+	}
+
+	/* negate via uint64 to not overflow on PG_INT64_MIN */
+	bool		isNegative = val < 0;
+	uint64		absValue = isNegative ? -((uint64) val) : (uint64) val;
+
+	pg_decimal_to_binary(absValue, isNegative, scale, output);
+
+	return DUCKDB_SUCCESS;
+}
+
+
+/*
+ * pg_decimal_to_binary writes absValue * 10^-scale in numeric binary format,
+ * which consists of ndigits, weight, sign and dscale followed by ndigits
+ * base-10000 digits starting at the most significant one.
+ */
+static void
+pg_decimal_to_binary(uint64 absValue, bool isNegative, int scale, StringInfo output)
+{
+	static const int16 powersOfTen[NUMERIC_BINARY_DEC_DIGITS] = {1, 10, 100, 1000};
+	int16		digits[NUMERIC_BINARY_MAX_DIGITS] = {0};
+
+	/* base-10000 digit that holds the least significant decimal digit */
+	int			lowestGroup = -((scale + NUMERIC_BINARY_DEC_DIGITS - 1) / NUMERIC_BINARY_DEC_DIGITS);
+	int			highestGroup = lowestGroup;
+	int			firstNonZeroGroup = INT_MAX;
+
+	for (int exponent = -scale; absValue > 0; exponent++, absValue /= 10)
+	{
+		int			decimalDigit = absValue % 10;
+
+		/* floor division of the decimal exponent */
+		int			group = exponent >= 0 ?
+			exponent / NUMERIC_BINARY_DEC_DIGITS :
+			-((-exponent + NUMERIC_BINARY_DEC_DIGITS - 1) / NUMERIC_BINARY_DEC_DIGITS);
+		int			groupIndex = group - lowestGroup;
+
+		digits[groupIndex] += decimalDigit * powersOfTen[exponent - group * NUMERIC_BINARY_DEC_DIGITS];
+		highestGroup = group;
+
+		if (decimalDigit != 0 && group < firstNonZeroGroup)
+			firstNonZeroGroup = group;
+	}
+
+	/* zero is represented without any digits */
+	int16		digitCount = 0;
+	int16		weight = 0;
+
+	if (firstNonZeroGroup != INT_MAX)
+	{
+		/* trailing zero digits are left out */
+		digitCount = highestGroup - firstNonZeroGroup + 1;
+		weight = highestGroup;
+	}
+	else
+		isNegative = false;
+
+	pq_sendint32(output, sizeof(int16) * (4 + digitCount));
+	pq_sendint16(output, digitCount);
+	pq_sendint16(output, weight);
+	pq_sendint16(output, isNegative ? NUMERIC_BINARY_NEG : NUMERIC_BINARY_POS);
+	pq_sendint16(output, scale);
+
+	for (int group = highestGroup; group > highestGroup - digitCount; group--)
+		pq_sendint16(output, digits[group - lowestGroup]);
+}
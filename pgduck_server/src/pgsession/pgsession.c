@@ -51,6 +51,7 @@
 #include "duckdb/duckdb.h"
 #include "pgserver/client_threadpool.h"
 #include "pgsession/pgsession.h"
+#include "pgsession/pgsession_copy_in.h"
 #include "pgsession/pgsession_io.h"
 #include "pgsession/pqformat.h"
 #include "utils/pgduck_log_utils.h"
@@ -69,6 +70,17 @@
 #define TRANSMIT_PREFIX "transmit "
 #define TRANSMIT_PREFIX_LENGTH (strlen(TRANSMIT_PREFIX))
 
+/*
+ * When queries are prefixed with receive, the remainder of the query is the
+ * name of a temporary table and we simulate what PostgreSQL does in case of
+ * COPY <table> FROM STDIN WITH (format 'csv', null '\N');
+ *
+ * This allows clients to stream rows into DuckDB without writing them to a
+ * file first. See pgsession_copy_in.c.
+ */
+#define RECEIVE_PREFIX "receive "
+#define RECEIVE_PREFIX_LENGTH (strlen(RECEIVE_PREFIX))
+
 /*
  * Convenience macro for pgsession_handle_connection to terminate
  * the connection in case of error, except regular query errors.
@@ -105,6 +117,7 @@ static int	pgsession_send_ready_for_query(PGSession * pgSession);
 static int	pgsession_init(PGSession * pgSession, PGClient * pgClient);
 static int	pgsession_destroy(PGSession * pgSession);
 static void pgsession_prepared_statement_deallocate(PGSession * pgSession);
+static void reset_result_formats(ResponseFormat * responseFormat);
 static void pgsession_log_client_info(PGClient * pgClient);
 static int	handle_pgsession_error_message(DuckDBStatus status, PGSession * pgSession,
 										   char *errorMessage);
@@ -115,6 +128,7 @@ static int	process_bind_message(PGSession * pgSession, StringInfo inputMessage);
 static int	process_execute_message(PGSession * pgSession, StringInfo inputMessage);
 
 static bool is_transmit_query(const char *queryString);
+static bool is_receive_query(const char *queryString);
 
 /*
  * Per-client entrance point for the pgsession logic.
@@ -314,10 +328,12 @@ pgsession_handle_connection(void *input)
 					/* d: copy data */
 					/* c: copy done */
 					/* f: copy fail */
-					char	   *errorMessage = "COPY command not yet supported in the protocol";
-
-					check(pgsession_send_postgres_error(&pgSession, ERROR, errorMessage), pgSession, errorMessage);
 
+					/*
+					 * Accept but ignore these messages, per protocol spec. We
+					 * get here if a receive query failed before the client
+					 * finished sending its data.
+					 */
 					break;
 				}
 
@@ -376,6 +392,17 @@ process_query_message(PGSession * pgSession, StringInfo inputMessage)
 	PGDUCK_SERVER_DEBUG("connection %d sent query: %s",
 						pgSession->pgClient->clientSocket, queryString);
 
+	if (is_receive_query(queryString))
+	{
+		const char *tableName = queryString + RECEIVE_PREFIX_LENGTH;
+
+		/* validate we read all the bytes */
+		if (!IsOK(pq_getmsgend(inputMessage)))
+			return COMM_ERROR;
+
+		return pgsession_process_copy_in(pgSession, tableName);
+	}
+
 	ResponseFormat responseFormat = {
 		.isTransmit = is_transmit_query(queryString)
 	};
@@ -731,15 +758,24 @@ process_bind_message(PGSession * pgSession, StringInfo inputMessage)
 	if (readFailed)
 		return COMM_ERROR;
 
+	ResponseFormat *responseFormat = &pgSession->pgSessionPreparedStmt.responseFormat;
+
+	/* forget the result formats of a previous bind */
+	reset_result_formats(responseFormat);
+
+	if (resultFormatCodeCount > 0)
+		responseFormat->resultFormats = palloc(sizeof(int16) * resultFormatCodeCount);
+
 	for (int16 i = 0; i < resultFormatCodeCount; i++)
 	{
 		int16		resultFormatCode = pq_getmsgint(inputMessage, 2, &readFailed);
 
-		(void) resultFormatCode;
-
 		/* error already logged */
 		if (readFailed)
 			return COMM_ERROR;
+
+		responseFormat->resultFormats[i] = resultFormatCode;
+		responseFormat->resultFormatCount++;
 	}
 
 	/* validate we read all the bytes */
@@ -1109,11 +1145,27 @@ pgsession_prepared_statement_deallocate(PGSession * pgSession)
 	{
 		duckdb_session_destroy_prepare(&pgSession->duckSession);
 		pg_free(pgSession->pgSessionPreparedStmt.queryString);
+		reset_result_formats(&pgSession->pgSessionPreparedStmt.responseFormat);
 		pgSession->pgSessionPreparedStmt.state = PREPARED_STATEMENT_INVALID;
 	}
 }
 
 
+/*
+ * reset_result_formats frees the result format codes of the given response
+ * format, such that all columns are sent as text.
+ */
+static void
+reset_result_formats(ResponseFormat * responseFormat)
+{
+	if (responseFormat->resultFormats != NULL)
+		pfree(responseFormat->resultFormats);
+
+	responseFormat->resultFormats = NULL;
+	responseFormat->resultFormatCount = 0;
+}
+
+
 /*
  * is_transmit_query returns whether the given query string starts with
  * transmit.
@@ -1126,3 +1178,16 @@ is_transmit_query(const char *queryString)
 {
 	return strncasecmp(queryString, TRANSMIT_PREFIX, TRANSMIT_PREFIX_LENGTH) == 0;
 }
+
+
+/*
+ * is_receive_query returns whether the given query string starts with
+ * receive.
+ *
+ * Receive queries use the COPY protocol to receive rows from the client.
+ */
+static bool
+is_receive_query(const char *queryString)
+{
+	return strncasecmp(queryString, RECEIVE_PREFIX, RECEIVE_PREFIX_LENGTH) == 0;
+}
@@ -0,0 +1,508 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The functions in this file implement the COPY-in sub-protocol, which
+ * clients use to stream rows into a temporary DuckDB table without staging
+ * them in a file first.
+ *
+ * The client sends "receive <table name>" as a simple query, after which we
+ * reply with CopyInResponse and the client sends CopyData messages containing
+ * CSV in the format that pg_lake uses internally (delimiter ',', quote and
+ * escape '"', unquoted \N is NULL, no header). The rows are appended to the
+ * table using a DuckDB appender. The client ends the stream with CopyDone, or
+ * aborts it with CopyFail.
+ *
+ * All columns of the table are expected to be VARCHAR, such that the client
+ * can apply the same casts that it would apply when reading a CSV file.
+ *
+ * Copyright (c) 2025 Snowflake Computing, Inc. All rights reserved.
+ */
+#include "c.h"
+#include "postgres_fe.h"
+
+#include <inttypes.h>
+
+#include <lib/stringinfo.h>
+#include <common/fe_memutils.h>
+
+#include "duckdb/duckdb.h"
+#include "pgsession/pgsession.h"
+#include "pgsession/pgsession_copy_in.h"
+#include "pgsession/pgsession_io.h"
+#include "pgsession/pqformat.h"
+#include "utils/pgduck_log_utils.h"
+#include "utils/pg_log_utils.h"
+
+#define COPY_IN_COMPLETION_TAG_BUFSIZE 64
+#define PG_WIRE_TEXT_FORMAT (0)
+
+/*
+ * CopyInParseState is the state of the incremental CSV parser, which needs
+ * to survive across CopyData messages since rows can span messages.
+ */
+typedef enum CopyInParseState
+{
+	/* at the start of a field */
+	COPY_IN_FIELD_START,
+
+	/* inside a field that did not start with a quote */
+	COPY_IN_UNQUOTED_FIELD,
+
+	/* inside a quoted field */
+	COPY_IN_QUOTED_FIELD,
+
+	/* seen a quote inside a quoted field, could be an escape or the end */
+	COPY_IN_QUOTE_IN_QUOTED_FIELD
+}			CopyInParseState;
+
+typedef struct CopyInState
+{
+	duckdb_appender appender;
+	idx_t		columnCount;
+
+	/* column of the current row that the next field goes into */
+	idx_t		currentColumn;
+
+	CopyInParseState parseState;
+
+	/* value of the current field */
+	StringInfoData field;
+	bool		fieldQuoted;
+
+	/* number of rows appended */
+	uint64_t	rowCount;
+
+	/* set when parsing or appending failed */
+	char	   *errorMessage;
+}			CopyInState;
+
+static int	send_copy_in_response(PGSession * pgSession, idx_t columnCount);
+static bool parse_copy_data(CopyInState * state, const char *data, int length);
+static bool finish_copy_data(CopyInState * state);
+static bool end_field(CopyInState * state);
+static bool end_row(CopyInState * state);
+static int	send_copy_in_error(PGSession * pgSession, CopyInState * state);
+
+
+/*
+ * pgsession_process_copy_in appends the rows that the client sends via
+ * the COPY-in sub-protocol to the given temporary table.
+ *
+ * In case of a network failure, it returns COMM_ERROR and the connection
+ * should shut down.
+ *
+ * In case of a parse or append error, it sends an error to the client and
+ * returns QUERY_ERROR. Like Postgres, we stop reading the copy stream at
+ * that point and the main loop ignores any remaining CopyData messages.
+ *
+ * Otherwise, it returns OK.
+ */
+int
+pgsession_process_copy_in(PGSession * pgSession, const char *tableName)
+{
+	CopyInState state = {
+		.parseState = COPY_IN_FIELD_START
+	};
+
+	if (duckdb_appender_create_ext(pgSession->duckSession.connection, "temp", "main",
+								   tableName, &state.appender) == DuckDBError)
+	{
+		const char *appenderError = duckdb_appender_error(state.appender);
+
+		state.errorMessage = psprintf("could not receive rows into table %s: %s",
+									  tableName,
+									  appenderError ? appenderError : "unknown error");
+
+		duckdb_appender_destroy(&state.appender);
+
+		return send_copy_in_error(pgSession, &state);
+	}
+
+	state.columnCount = duckdb_appender_column_count(state.appender);
+	initStringInfo(&state.field);
+
+	if (!IsOK(send_copy_in_response(pgSession, state.columnCount)))
+	{
+		duckdb_appender_destroy(&state.appender);
+		pg_free(state.field.data);
+		return COMM_ERROR;
+	}
+
+	StringInfoData inputMessage;
+
+	initStringInfo(&inputMessage);
+
+	bool		copyDone = false;
+	int			result = OK;
+
+	while (!copyDone && state.errorMessage == NULL)
+	{
+		int			messageType = pgsession_read_command(pgSession, &inputMessage);
+
+		switch (messageType)
+		{
+			case 'd':
+				{
+					/* copy data */
+					parse_copy_data(&state, inputMessage.data, inputMessage.len);
+					break;
+				}
+
+			case 'c':
+				{
+					/* copy done */
+					if (finish_copy_data(&state) &&
+						duckdb_appender_close(state.appender) == DuckDBError)
+					{
+						const char *appenderError = duckdb_appender_error(state.appender);
+
+						state.errorMessage = pstrdup(appenderError ? appenderError : "unknown error");
+					}
+
+					copyDone = true;
+					break;
+				}
+
+			case 'f':
+				{
+					/* copy fail */
+					const char *failMessage = pq_getmsgstring(&inputMessage);
+
+					state.errorMessage = psprintf("COPY from stdin failed: %s",
+												  failMessage ? failMessage : "");
+					break;
+				}
+
+			case 'H':
+			case 'S':
+				{
+					/* flush and sync are ignored during COPY, as in Postgres */
+					break;
+				}
+
+			case EOF:
+				{
+					PGDUCK_SERVER_DEBUG("connection %d lost during COPY from stdin",
+										pgSession->pgClient->clientSocket);
+					result = COMM_ERROR;
+					copyDone = true;
+					break;
+				}
+
+			default:
+				{
+					PGDUCK_SERVER_ERROR("unexpected message type 0x%02X during COPY from stdin on connection %d",
+										messageType, pgSession->pgClient->clientSocket);
+					result = COMM_ERROR;
+					copyDone = true;
+					break;
+				}
+		}
+	}
+
+	/* destroy also closes the appender if it was not yet closed */
+	duckdb_appender_destroy(&state.appender);
+	pg_free(state.field.data);
+	pg_free(inputMessage.data);
+
+	if (result == COMM_ERROR)
+	{
+		if (state.errorMessage != NULL)
+			pfree(state.errorMessage);
+
+		return COMM_ERROR;
+	}
+
+	if (state.errorMessage != NULL)
+		return send_copy_in_error(pgSession, &state);
+
+	char		completionTag[COPY_IN_COMPLETION_TAG_BUFSIZE];
+
+	snprintf(completionTag, COPY_IN_COMPLETION_TAG_BUFSIZE, "COPY %" PRIu64, state.rowCount);
+
+	if (!IsOK(pgsession_put_message(pgSession, 'C', completionTag, strlen(completionTag) + 1)))
+	{
+		PGDUCK_SERVER_ERROR("could not send command completion to the client");
+		return COMM_ERROR;
+	}
+
+	return OK;
+}
+
+
+/*
+ * send_copy_in_response sends a CopyInResponse message that tells the client
+ * to start sending text data for the given number of columns.
+ */
+static int
+send_copy_in_response(PGSession * pgSession, idx_t columnCount)
+{
+	StringInfoData buf;
+
+	pq_beginmessage(&buf, 'G');
+	pq_sendbyte(&buf, PG_WIRE_TEXT_FORMAT);
+	pq_sendint16(&buf, columnCount);
+
+	for (idx_t columnIndex = 0; columnIndex < columnCount; columnIndex++)
+		pq_sendint16(&buf, PG_WIRE_TEXT_FORMAT);
+
+	if (!IsOK(pq_endmessage(pgSession, &buf)))
+		return COMM_ERROR;
+
+	/* the client waits for the response before sending data */
+	return pgsession_flush(pgSession);
+}
+
+
+/*
+ * parse_copy_data parses a chunk of CSV data and appends all rows that are
+ * completed by the chunk. Partial fields and rows are kept in the state.
+ *
+ * Returns false and sets state->errorMessage on failure.
+ */
+static bool
+parse_copy_data(CopyInState * state, const char *data, int length)
+{
+	int			position = 0;
+
+	while (position < length)
+	{
+		char		c = data[position];
+
+		switch (state->parseState)
+		{
+			case COPY_IN_FIELD_START:
+				{
+					if (c == '"')
+					{
+						state->fieldQuoted = true;
+						state->parseState = COPY_IN_QUOTED_FIELD;
+						position++;
+					}
+					else
+					{
+						state->fieldQuoted = false;
+						state->parseState = COPY_IN_UNQUOTED_FIELD;
+					}
+
+					break;
+				}
+
+			case COPY_IN_UNQUOTED_FIELD:
+				{
+					/* copy the run of regular characters in one go */
+					int			runStart = position;
+
+					while (position < length &&
+						   data[position] != ',' &&
+						   data[position] != '\n' &&
+						   data[position] != '\r')
+						position++;
+
+					appendBinaryStringInfo(&state->field, data + runStart, position - runStart);
+
+					if (position == length)
+						break;
+
+					c = data[position++];
+
+					if (c == '\r')
+					{
+						/* line endings are \n, but tolerate \r\n */
+						break;
+					}
+
+					if (!end_field(state))
+						return false;
+
+					if (c == '\n' && !end_row(state))
+						return false;
+
+					break;
+				}
+
+			case COPY_IN_QUOTED_FIELD:
+				{
+					int			runStart = position;
+
+					while (position < length && data[position] != '"')
+						position++;
+
+					appendBinaryStringInfo(&state->field, data + runStart, position - runStart);
+
+					if (position < length)
+					{
+						state->parseState = COPY_IN_QUOTE_IN_QUOTED_FIELD;
+						position++;
+					}
+
+					break;
+				}
+
+			case COPY_IN_QUOTE_IN_QUOTED_FIELD:
+				{
+					position++;
+
+					if (c == '"')
+					{
+						/* escaped quote */
+						appendStringInfoChar(&state->field, '"');
+						state->parseState = COPY_IN_QUOTED_FIELD;
+					}
+					else if (c == ',')
+					{
+						if (!end_field(state))
+							return false;
+					}
+					else if (c == '\n')
+					{
+						if (!end_field(state) || !end_row(state))
+							return false;
+					}
+					else if (c == '\r')
+					{
+						/* line endings are \n, but tolerate \r\n */
+					}
+					else
+					{
+						state->errorMessage =
+							pstrdup("unexpected character after quoted CSV field");
+						return false;
+					}
+
+					break;
+				}
+		}
+	}
+
+	return true;
+}
+
+
+/*
+ * finish_copy_data completes the last row if the data did not end with
+ * a newline.
+ *
+ * Returns false and sets state->errorMessage on failure.
+ */
+static bool
+finish_copy_data(CopyInState * state)
+{
+	if (state->parseState == COPY_IN_QUOTED_FIELD)
+	{
+		state->errorMessage = pstrdup("unterminated CSV quoted field");
+		return false;
+	}
+
+	if (state->parseState == COPY_IN_FIELD_START && state->currentColumn == 0)
+	{
+		/* no partial row */
+		return true;
+	}
+
+	return end_field(state) && end_row(state);
+}
+
+
+/*
+ * end_field appends the current field to the current row.
+ *
+ * Returns false and sets state->errorMessage on failure.
+ */
+static bool
+end_field(CopyInState * state)
+{
+	duckdb_state appendState;
+
+	if (state->currentColumn >= state->columnCount)
+	{
+		state->errorMessage = pstrdup("extra data after last expected column");
+		return false;
+	}
+
+	/* only an unquoted \N means NULL, a quoted one is a regular string */
+	if (!state->fieldQuoted && state->field.len == 2 &&
+		state->field.data[0] == '\\' && state->field.data[1] == 'N')
+		appendState = duckdb_append_null(state->appender);
+	else
+		appendState = duckdb_append_varchar_length(state->appender,
+												   state->field.data,
+												   state->field.len);
+
+	if (appendState == DuckDBError)
+	{
+		const char *appenderError = duckdb_appender_error(state->appender);
+
+		state->errorMessage = pstrdup(appenderError ? appenderError : "unknown error");
+		return false;
+	}
+
+	resetStringInfo(&state->field);
+	state->fieldQuoted = false;
+	state->parseState = COPY_IN_FIELD_START;
+	state->currentColumn++;
+
+	return true;
+}
+
+
+/*
+ * end_row completes the current row.
+ *
+ * Returns false and sets state->errorMessage on failure.
+ */
+static bool
+end_row(CopyInState * state)
+{
+	if (state->currentColumn < state->columnCount)
+	{
+		state->errorMessage = psprintf("missing data for column %" PRIu64,
+									   (uint64_t) state->currentColumn + 1);
+		return false;
+	}
+
+	if (duckdb_appender_end_row(state->appender) == DuckDBError)
+	{
+		const char *appenderError = duckdb_appender_error(state->appender);
+
+		state->errorMessage = pstrdup(appenderError ? appenderError : "unknown error");
+		return false;
+	}
+
+	state->currentColumn = 0;
+	state->rowCount++;
+
+	return true;
+}
+
+
+/*
+ * send_copy_in_error sends the error in the state to the client and frees it.
+ *
+ * Returns QUERY_ERROR if the error was sent, otherwise COMM_ERROR.
+ */
+static int
+send_copy_in_error(PGSession * pgSession, CopyInState * state)
+{
+	int			sendResult = pgsession_send_postgres_error(pgSession, ERROR, state->errorMessage);
+
+	pfree(state->errorMessage);
+	state->errorMessage = NULL;
+
+	return IsOK(sendResult) ? QUERY_ERROR : COMM_ERROR;
+}
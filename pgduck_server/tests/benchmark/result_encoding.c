@@ -0,0 +1,214 @@
+/*
+ * Copyright 2025 Snowflake Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Microbenchmark for the encoding of query results in pgduck_server.
+ *
+ * Runs queries that return wide numeric and timestamp result sets against a
+ * running pgduck_server, in text and binary result format, and reports the
+ * number of rows per second received by the client.
+ *
+ * Usage: result_encoding [conninfo] [row count] [repetitions]
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libpq-fe.h"
+
+#define DEFAULT_CONNINFO "host=/tmp port=5332"
+#define DEFAULT_ROW_COUNT 1000000
+#define DEFAULT_REPETITIONS 3
+
+#define TEXT_FORMAT 0
+#define BINARY_FORMAT 1
+
+typedef struct BenchmarkQuery
+{
+	const char *name;
+	const char *query;
+}			BenchmarkQuery;
+
+/* %d is replaced by the row count */
+static const BenchmarkQuery BenchmarkQueries[] = {
+	{
+		"wide bigint",
+		"SELECT s AS c1, s + 1 AS c2, s + 2 AS c3, s + 3 AS c4, s + 4 AS c5, "
+		"s + 5 AS c6, s + 6 AS c7, s + 7 AS c8, s + 8 AS c9, s + 9 AS c10, "
+		"s + 10 AS c11, s + 11 AS c12, s + 12 AS c13, s + 13 AS c14, s + 14 AS c15, "
+		"s + 15 AS c16 FROM range(%d) r(s)"
+	},
+	{
+		"wide double",
+		"SELECT s / 3.0 AS c1, s / 7.0 AS c2, s * 1.5 AS c3, s * 2.25 AS c4, "
+		"sqrt(s) AS c5, s / 11.0 AS c6, s / 13.0 AS c7, s * 0.1 AS c8, "
+		"s / 17.0 AS c9, s / 19.0 AS c10, s * 3.5 AS c11, s / 23.0 AS c12 "
+		"FROM range(%d) r(s)"
+	},
+	{
+		"wide decimal",
+		"SELECT (s * 1.125)::decimal(18,3) AS c1, (s * 2.5)::decimal(12,2) AS c2, "
+		"(s / 3)::decimal(18,6) AS c3, (s * 7)::decimal(9,0) AS c4, "
+		"(s * 0.001)::decimal(15,4) AS c5, (s * 13.37)::decimal(18,2) AS c6, "
+		"(s / 7)::decimal(18,4) AS c7, (s * 99.99)::decimal(18,2) AS c8 "
+		"FROM range(%d) r(s)"
+	},
+	{
+		"wide timestamp",
+		"SELECT '2020-01-01'::timestamp + to_seconds(s) AS c1, "
+		"'2000-02-29'::timestamp + to_microseconds(s) AS c2, "
+		"'1970-01-01'::timestamp + to_minutes(s) AS c3, "
+		"'2020-01-01 00:00:00+00'::timestamptz + to_seconds(s) AS c4, "
+		"'1999-12-31 23:59:59+00'::timestamptz + to_microseconds(s * 7) AS c5, "
+		"'2024-06-01 12:00:00+00'::timestamptz + to_hours(s) AS c6, "
+		"'2020-01-01'::date + (s % 100000)::int AS c7, "
+		"'1965-03-04'::date + (s % 1000)::int AS c8 "
+		"FROM range(%d) r(s)"
+	}
+};
+
+static double RunQuery(PGconn *conn, const char *query, int resultFormat,
+					   long *rowCount);
+static double CurrentTimeInSeconds(void);
+
+
+int
+main(int argc, char **argv)
+{
+	const char *conninfo = argc > 1 ? argv[1] : DEFAULT_CONNINFO;
+	int			rowCount = argc > 2 ? atoi(argv[2]) : DEFAULT_ROW_COUNT;
+	int			repetitions = argc > 3 ? atoi(argv[3]) : DEFAULT_REPETITIONS;
+
+	PGconn	   *conn = PQconnectdb(conninfo);
+
+	if (PQstatus(conn) != CONNECTION_OK)
+	{
+		fprintf(stderr, "could not connect to pgduck_server: %s", PQerrorMessage(conn));
+		PQfinish(conn);
+		return 1;
+	}
+
+	printf("%-16s %-8s %12s %14s\n", "query", "format", "rows", "rows/s");
+
+	int			queryCount = sizeof(BenchmarkQueries) / sizeof(BenchmarkQueries[0]);
+
+	for (int queryIndex = 0; queryIndex < queryCount; queryIndex++)
+	{
+		const BenchmarkQuery *benchmarkQuery = &BenchmarkQueries[queryIndex];
+		char		query[4096];
+
+		snprintf(query, sizeof(query), benchmarkQuery->query, rowCount);
+
+		for (int resultFormat = TEXT_FORMAT; resultFormat <= BINARY_FORMAT; resultFormat++)
+		{
+			double		bestRowsPerSecond = 0.0;
+			long		rowsReceived = 0;
+
+			for (int repetition = 0; repetition < repetitions; repetition++)
+			{
+				double		elapsed = RunQuery(conn, query, resultFormat, &rowsReceived);
+
+				if (elapsed < 0)
+				{
+					PQfinish(conn);
+					return 1;
+				}
+
+				double		rowsPerSecond = elapsed > 0 ? rowsReceived / elapsed : 0.0;
+
+				if (rowsPerSecond > bestRowsPerSecond)
+					bestRowsPerSecond = rowsPerSecond;
+			}
+
+			printf("%-16s %-8s %12ld %14.0f\n", benchmarkQuery->name,
+				   resultFormat == BINARY_FORMAT ? "binary" : "text",
+				   rowsReceived, bestRowsPerSecond);
+		}
+	}
+
+	PQfinish(conn);
+	return 0;
+}
+
+
+/*
+ * RunQuery runs the query with the given result format, consumes all rows,
+ * and returns the elapsed time in seconds, or -1 on failure.
+ */
+static double
+RunQuery(PGconn *conn, const char *query, int resultFormat, long *rowCount)
+{
+	double		startTime = CurrentTimeInSeconds();
+
+	*rowCount = 0;
+
+	if (!PQsendQueryParams(conn, query, 0, NULL, NULL, NULL, NULL, resultFormat))
+	{
+		fprintf(stderr, "could not send query: %s", PQerrorMessage(conn));
+		return -1;
+	}
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	PQsetChunkedRowsMode(conn, 10000);
+#else
+	PQsetSingleRowMode(conn);
+#endif
+
+	bool		failed = false;
+	PGresult   *result;
+
+	while ((result = PQgetResult(conn)) != NULL)
+	{
+		ExecStatusType status = PQresultStatus(result);
+
+		if (status == PGRES_SINGLE_TUPLE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+			|| status == PGRES_TUPLES_CHUNK
+#endif
+			|| status == PGRES_TUPLES_OK)
+		{
+			*rowCount += PQntuples(result);
+		}
+		else
+		{
+			fprintf(stderr, "query failed: %s", PQresultErrorMessage(result));
+			failed = true;
+		}
+
+		PQclear(result);
+	}
+
+	if (failed)
+		return -1;
+
+	return CurrentTimeInSeconds() - startTime;
+}
+
+
+/*
+ * CurrentTimeInSeconds returns a monotonic timestamp in seconds.
+ */
+static double
+CurrentTimeInSeconds(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
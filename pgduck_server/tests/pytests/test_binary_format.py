@@ -0,0 +1,139 @@
+import pytest
+import psycopg
+import server_params
+from datetime import datetime, timezone
+from decimal import Decimal
+from utils_pytest import *
+
+BINARY_TYPES_QUERY = """
+SELECT
+    true::boolean AS boolean_col,
+    '\\xDEADBEEF00'::blob AS blob_col,
+    (-12)::tinyint AS tinyint_col,
+    (-1234)::smallint AS smallint_col,
+    (-123456)::int AS int_col,
+    (-123456789012)::bigint AS bigint_col,
+    250::utinyint AS utinyint_col,
+    65000::usmallint AS usmallint_col,
+    4000000000::uinteger AS uinteger_col,
+    1.5::float AS float4_col,
+    (-2.25)::double AS float8_col,
+    'hello wörld' AS varchar_col,
+    (-12345.678)::decimal(18,3) AS decimal_col,
+    0.0001::decimal(9,4) AS small_decimal_col,
+    120000::decimal(10,0) AS integral_decimal_col,
+    0::decimal(4,2) AS zero_decimal_col,
+    '79f3b5c4-5b2a-4d6a-9a8e-1c2b3d4e5f60'::uuid AS uuid_col,
+    '1999-12-31'::date AS date_col,
+    '1965-03-04'::date AS old_date_col,
+    '2024-02-29 12:34:56.789012'::timestamp AS timestamp_col,
+    '2024-02-29 12:34:56.789012+00'::timestamptz AS timestamptz_col,
+    NULL::int AS null_col,
+    [1,2,3] AS list_col
+"""
+
+
+@pytest.fixture(scope="module")
+def pgduck_conn_v3(pgduck_server):
+    conn = psycopg.connect(
+        host=server_params.PGDUCK_UNIX_DOMAIN_PATH,
+        port=server_params.PGDUCK_PORT,
+        autocommit=True,
+    )
+    yield conn
+    conn.close()
+
+
+def fetch_with_format(conn, query, binary):
+    with conn.cursor(binary=binary) as cur:
+        cur.execute(query)
+        rows = cur.fetchall()
+        type_oids = [column.type_code for column in cur.description]
+
+    return rows, type_oids
+
+
+def test_binary_result_format(pgduck_conn_v3):
+    binary_rows, type_oids = fetch_with_format(
+        pgduck_conn_v3, BINARY_TYPES_QUERY, binary=True
+    )
+    row = binary_rows[0]
+
+    # scalar types are sent with a PostgreSQL type in binary format
+    assert type_oids[0:22] == [
+        16,  # bool
+        17,  # bytea
+        21,  # int2
+        21,  # int2
+        23,  # int4
+        20,  # int8
+        21,  # int2
+        23,  # int4
+        20,  # int8
+        700,  # float4
+        701,  # float8
+        25,  # text
+        1700,  # numeric
+        1700,  # numeric
+        1700,  # numeric
+        1700,  # numeric
+        2950,  # uuid
+        1082,  # date
+        1082,  # date
+        1114,  # timestamp
+        1184,  # timestamptz
+        23,  # int4
+    ]
+
+    # nested types still use text
+    assert type_oids[22] == 0
+
+    assert row[0] is True
+    assert row[1] == b"\xde\xad\xbe\xef\x00"
+    assert row[2:9] == (-12, -1234, -123456, -123456789012, 250, 65000, 4000000000)
+    assert row[9] == 1.5
+    assert row[10] == -2.25
+    assert row[11] == "hello wörld"
+    assert row[12] == Decimal("-12345.678")
+    assert row[13] == Decimal("0.0001")
+    assert row[14] == Decimal("120000")
+    assert row[15] == Decimal("0.00")
+    assert str(row[16]) == "79f3b5c4-5b2a-4d6a-9a8e-1c2b3d4e5f60"
+    assert str(row[17]) == "1999-12-31"
+    assert str(row[18]) == "1965-03-04"
+    assert str(row[19]) == "2024-02-29 12:34:56.789012"
+    assert row[20] == datetime(2024, 2, 29, 12, 34, 56, 789012, tzinfo=timezone.utc)
+    assert row[21] is None
+    assert row[22] == "[1, 2, 3]"
+
+
+def test_binary_matches_text_format(pgduck_conn_v3):
+    query = """
+    SELECT
+        s::int AS int_col,
+        (s * 1000000007)::bigint AS bigint_col,
+        (s / 7.0)::double AS double_col,
+        (s * 3.14159)::decimal(12,5) AS decimal_col,
+        'value-' || s AS text_col,
+        '2020-01-01'::date + s::int AS date_col,
+        '2020-01-01 00:00:00'::timestamp + to_seconds(s * 3600) AS timestamp_col
+    FROM range(-500, 500) r(s)
+    ORDER BY s
+    """
+
+    binary_rows, _ = fetch_with_format(pgduck_conn_v3, query, binary=True)
+
+    with pgduck_conn_v3.cursor(binary=False) as cur:
+        cur.execute(query)
+        text_rows = cur.fetchall()
+
+    assert len(binary_rows) == 1000
+    for binary_row, text_row in zip(binary_rows, text_rows):
+        # text columns come back without type, compare the text output
+        assert binary_row[0] == int(text_row[0])
+        assert binary_row[1] == int(text_row[1])
+        assert binary_row[2] == float(text_row[2])
+        assert binary_row[3] == Decimal(text_row[3])
+        assert binary_row[4] == text_row[4]
+        assert str(binary_row[5]) == text_row[5]
+        assert str(binary_row[6]) == text_row[6]
@@ -246,18 +246,33 @@ def test_pg_lake_manage_cache(s3, pgduck_conn):
     # Manage the cache down to 200KB
     results = run_query(f"FROM pg_lake_manage_cache({cache_size})", pgduck_conn)
 
-    # Verify that url1 is skipped, because url2 is already cached
+    # Verify that url1 replaces url2, because url1 was read more frequently
+    assert len(results) == 2
+    assert results[0][0] == str(url2)
+    assert results[0][2] == "removed"
+    assert results[1][0] == str(url1)
+    assert results[1][2] == "added"
+
+    assert cached_path1.exists()
+    assert not cached_path2.exists()
+
+    # Read url2 once more, which is still less frequent than url1
+    run_query(f"SELECT count(*) FROM '{url2}'", pgduck_conn)
+
+    results = run_query(f"FROM pg_lake_manage_cache({cache_size})", pgduck_conn)
+
+    # Verify that url2 is skipped, because url1 is used more frequently
     assert len(results) == 1
-    assert results[0][0] == str(url1)
+    assert results[0][0] == str(url2)
     assert results[0][2].startswith("skipped")
 
-    assert not cached_path1.exists()
-    assert cached_path2.exists()
+    assert cached_path1.exists()
+    assert not cached_path2.exists()
 
     # Wipe the cache
     results = run_query("CALL pg_lake_manage_cache(0)", pgduck_conn)
     assert len(results) == 1
-    assert results[0][0] == str(url2)
+    assert results[0][0] == str(url1)
     assert results[0][2] == "removed"
 
     pgduck_conn.rollback()
@@ -852,6 +867,238 @@ def test_http_query_args(s3, pgduck_conn):
     assert results[0][0] == "world"
 
 
+@pytest.mark.parametrize("file_format", ["parquet", "csv"])
+def test_block_cache(s3, pgduck_conn, file_format):
+    url = f"s3://{TEST_BUCKET}/test_block_cache/data.{file_format}"
+    cache_dir = Path(
+        f"{server_params.PGDUCK_CACHE_DIR}/s3/{TEST_BUCKET}/test_block_cache"
+    )
+
+    # Generate a file of a few MB
+    run_command(
+        f"""
+        COPY (SELECT s, md5(s::text) AS h FROM generate_series(1,100000) AS g(s)) TO '{url}';
+        CALL pg_lake_uncache_file('{url}');
+    """,
+        pgduck_conn,
+    )
+
+    file_size = pg_lake_file_size(url, pgduck_conn)
+    assert file_size > 2 * 1024 * 1024
+
+    # Cache all files in 1MB blocks
+    run_command(
+        """
+        SET GLOBAL pg_lake_cache_block_size TO 1048576;
+        SET GLOBAL pg_lake_cache_block_min_file_size TO 1;
+        CALL pg_lake_manage_cache(1000000000);
+    """,
+        pgduck_conn,
+    )
+
+    try:
+        query = f"SELECT count(*), count(DISTINCT h), sum(s) FROM '{url}'"
+        expected = run_query(query.replace(url, f"nocache{url}"), pgduck_conn)
+
+        # Reading the file adds the blocks that were read, not the whole file
+        assert run_query(query, pgduck_conn) == expected
+        assert not (cache_dir / f"{CACHE_FILE_PREFIX}data.{file_format}").exists()
+
+        blocks_dirs = list(cache_dir.glob(f"pgl-blocks.data.{file_format}.*"))
+        assert len(blocks_dirs) == 1
+
+        blocks = list(blocks_dirs[0].glob("pgl-block.*"))
+        assert len(blocks) > 1
+        assert sum(block.stat().st_size for block in blocks) <= file_size
+
+        # Large files do not become whole file cache candidates
+        results = run_query(
+            f"SELECT * FROM pg_lake_manage_cache(1000000000) WHERE url = '{url}'",
+            pgduck_conn,
+        )
+        assert len(results) == 0
+
+        # Reading again is served from the blocks
+        assert run_query(query, pgduck_conn) == expected
+
+        # Blocks are evicted one by one
+        results = run_query(
+            f"SELECT * FROM pg_lake_manage_cache(0) WHERE url = '{url}'", pgduck_conn
+        )
+        assert len(results) == len(blocks)
+        assert all(result[2] == "removed block" for result in results)
+        assert not blocks_dirs[0].exists()
+
+        # Blocks are not added beyond the size of the last pg_lake_manage_cache
+        assert run_query(query, pgduck_conn) == expected
+        assert len(list(blocks_dirs[0].glob("pgl-block.*"))) == 0
+
+        # Reading after raising the cache size fetches the blocks again
+        run_command("CALL pg_lake_manage_cache(1000000000)", pgduck_conn)
+        assert run_query(query, pgduck_conn) == expected
+        assert len(list(blocks_dirs[0].glob("pgl-block.*"))) > 1
+
+        # Uncaching the file removes its blocks
+        results = run_query(f"CALL pg_lake_uncache_file('{url}')", pgduck_conn)
+        assert results[0][0] == "t"
+        assert not blocks_dirs[0].exists()
+    finally:
+        run_command(
+            """
+            SET GLOBAL pg_lake_cache_block_size TO 4194304;
+            SET GLOBAL pg_lake_cache_block_min_file_size TO 268435456;
+        """,
+            pgduck_conn,
+        )
+
+    pgduck_conn.rollback()
+
+
+def test_concurrent_downloads(s3, pgduck_conn):
+    prefix = f"s3://{TEST_BUCKET}/test_concurrent_downloads"
+    cache_dir = Path(
+        f"{server_params.PGDUCK_CACHE_DIR}/s3/{TEST_BUCKET}/test_concurrent_downloads"
+    )
+    urls = [f"{prefix}/data{i}.csv" for i in range(8)]
+
+    # Generate files, then remove them from the cache and read them
+    for url in urls:
+        run_command(
+            f"""
+            COPY (SELECT s, 'hello-'||s as h FROM generate_series(1,10000) as g(s)) TO '{url}';
+            CALL pg_lake_uncache_file('{url}');
+            SELECT count(*) FROM '{url}';
+        """,
+            pgduck_conn,
+        )
+
+    run_command("SET GLOBAL pg_lake_cache_max_concurrent_downloads TO 3", pgduck_conn)
+
+    try:
+        results = run_query(
+            f"""
+            SELECT url, action, download_time_ms FROM pg_lake_manage_cache(1000000000)
+            WHERE url LIKE '{prefix}/%' ORDER BY url
+        """,
+            pgduck_conn,
+        )
+    finally:
+        run_command(
+            "SET GLOBAL pg_lake_cache_max_concurrent_downloads TO 4", pgduck_conn
+        )
+
+    # All files are downloaded, and we get the time it took for each
+    assert [result[0] for result in results] == sorted(urls)
+    assert all(result[1] == "added" for result in results)
+    assert all(int(result[2]) >= 0 for result in results)
+
+    for i in range(len(urls)):
+        assert (cache_dir / f"{CACHE_FILE_PREFIX}data{i}.csv").exists()
+
+    # Downloaded files are served from cache
+    for url in urls:
+        results = run_query(f"SELECT count(*) FROM '{url}'", pgduck_conn)
+        assert results[0][0] == "10000"
+
+    pgduck_conn.rollback()
+
+
+def test_cache_access_time(s3, pgduck_conn):
+    url = f"s3://{TEST_BUCKET}/test_cache_access_time/data.csv"
+    cached_path = Path(
+        f"{server_params.PGDUCK_CACHE_DIR}/s3/{TEST_BUCKET}/test_cache_access_time/{CACHE_FILE_PREFIX}data.csv"
+    )
+
+    # Generate a file, which is cached on write
+    run_command(
+        f"""
+        COPY (SELECT s, 'hello-'||s as h FROM generate_series(1,100) as g(s)) TO '{url}';
+    """,
+        pgduck_conn,
+    )
+    assert cached_path.exists()
+
+    results = run_query(
+        f"SELECT file_size FROM pg_lake_list_cache() WHERE url = '{url}'", pgduck_conn
+    )
+    assert len(results) == 1
+    assert results[0][0] == str(cached_path.stat().st_size)
+
+    # Make the file look old
+    old_time = time.time() - 3600
+    os.utime(cached_path, (old_time, old_time))
+
+    # Reading from cache records the access, and managing the cache writes it
+    run_query(f"SELECT count(*) FROM '{url}'", pgduck_conn)
+    run_query("CALL pg_lake_manage_cache(1000000000)", pgduck_conn)
+    assert cached_path.stat().st_atime > old_time + 1
+
+    # Removed files disappear from the list
+    run_command(f"CALL pg_lake_uncache_file('{url}')", pgduck_conn)
+
+    results = run_query(
+        f"SELECT file_size FROM pg_lake_list_cache() WHERE url = '{url}'", pgduck_conn
+    )
+    assert len(results) == 0
+
+    pgduck_conn.rollback()
+
+
+def test_prefetch_files(s3, pgduck_conn):
+    prefix = f"s3://{TEST_BUCKET}/test_prefetch_files"
+    cache_dir = Path(
+        f"{server_params.PGDUCK_CACHE_DIR}/s3/{TEST_BUCKET}/test_prefetch_files"
+    )
+    urls = [f"{prefix}/data{i}.csv" for i in range(4)]
+
+    # Prefetching uses the cache index, which is loaded by pg_lake_manage_cache
+    run_command("CALL pg_lake_manage_cache(1000000000)", pgduck_conn)
+
+    # Generate files and remove them from the cache
+    for url in urls:
+        run_command(
+            f"""
+            COPY (SELECT s, 'hello-'||s as h FROM generate_series(1,10000) as g(s)) TO '{url}';
+            CALL pg_lake_uncache_file('{url}');
+        """,
+            pgduck_conn,
+        )
+
+    file_size = pg_lake_file_size(urls[0], pgduck_conn)
+    url_list = ", ".join(f"'{url}'" for url in urls)
+    size_list = ", ".join(str(file_size) for url in urls)
+
+    # Files that do not fit in the cache headroom are not prefetched
+    results = run_query(
+        f"CALL pg_lake_prefetch_files([{url_list}], [{size_list}], {file_size - 1})",
+        pgduck_conn,
+    )
+    assert results[0][0] == "0"
+
+    # Otherwise, files are downloaded in the background
+    results = run_query(
+        f"CALL pg_lake_prefetch_files([{url_list}], [{size_list}], 1000000000)",
+        pgduck_conn,
+    )
+    assert results[0][0] == str(len(urls))
+
+    for i in range(len(urls)):
+        cached_path = cache_dir / f"{CACHE_FILE_PREFIX}data{i}.csv"
+        assert check_file_exist(cached_path, timeout_seconds=30)
+
+    # Cached files are not prefetched again
+    results = run_query(
+        f"CALL pg_lake_prefetch_files([{url_list}], [{size_list}], 1000000000)",
+        pgduck_conn,
+    )
+    assert results[0][0] == "0"
+
+    for url in urls:
+        run_command(f"CALL pg_lake_uncache_file('{url}')", pgduck_conn)
+
+    pgduck_conn.rollback()
+
+
 def check_file_exist(file, timeout_seconds=3):
     end_time = time.time() + timeout_seconds  # Calculate when we should stop checking
 
@@ -0,0 +1,74 @@
+import io
+import pytest
+import psycopg2
+from utils_pytest import *
+
+
+def receive(conn, table_name, data):
+    cur = conn.cursor()
+    try:
+        cur.copy_expert(f"receive {table_name}", io.StringIO(data))
+        return cur.rowcount
+    finally:
+        cur.close()
+
+
+def test_receive_rows(pgduck_conn):
+    run_command("CREATE TEMP TABLE copy_in (a VARCHAR, b VARCHAR)", pgduck_conn)
+
+    # quoted fields can contain delimiters, quotes, and newlines, and only
+    # an unquoted \N is NULL
+    data = '1,hello\n2,"a,b"\n3,"say ""hi"""\n4,"two\nlines"\n5,\\N\n6,"\\N"\n7,\n'
+
+    assert receive(pgduck_conn, "copy_in", data) == 7
+
+    result = run_query("SELECT a, b FROM copy_in ORDER BY a", pgduck_conn)
+    assert result == [
+        ["1", "hello"],
+        ["2", "a,b"],
+        ["3", 'say "hi"'],
+        ["4", "two\nlines"],
+        ["5", None],
+        ["6", "\\N"],
+        ["7", ""],
+    ]
+
+    # rows can span multiple CopyData messages and the last newline is optional
+    run_command("DELETE FROM copy_in", pgduck_conn)
+
+    data = "".join(f"{i},value-{i}\n" for i in range(10000)) + "10000,last"
+    assert receive(pgduck_conn, "copy_in", data) == 10001
+
+    result = run_query("SELECT count(*), max(b) FROM copy_in", pgduck_conn)
+    assert result == [[10001, "value-9999"]]
+
+    run_command("DROP TABLE copy_in", pgduck_conn)
+    pgduck_conn.commit()
+
+
+def test_receive_errors(pgduck_conn):
+    run_command("CREATE TEMP TABLE copy_in_errors (a VARCHAR, b VARCHAR)", pgduck_conn)
+    pgduck_conn.commit()
+
+    with pytest.raises(psycopg2.DatabaseError, match="extra data"):
+        receive(pgduck_conn, "copy_in_errors", "1,2,3\n")
+    pgduck_conn.rollback()
+
+    with pytest.raises(psycopg2.DatabaseError, match="missing data"):
+        receive(pgduck_conn, "copy_in_errors", "1\n")
+    pgduck_conn.rollback()
+
+    with pytest.raises(psycopg2.DatabaseError, match="unterminated"):
+        receive(pgduck_conn, "copy_in_errors", '1,"abc\n')
+    pgduck_conn.rollback()
+
+    with pytest.raises(psycopg2.DatabaseError, match="does_not_exist"):
+        receive(pgduck_conn, "does_not_exist", "1,2\n")
+    pgduck_conn.rollback()
+
+    # the connection is still usable after errors
+    assert receive(pgduck_conn, "copy_in_errors", "1,2\n") == 1
+    assert run_query("SELECT a, b FROM copy_in_errors", pgduck_conn) == [["1", "2"]]
+
+    run_command("DROP TABLE copy_in_errors", pgduck_conn)
+    pgduck_conn.commit()